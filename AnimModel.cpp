@@ -23,6 +23,7 @@ http://mozilla.org/MPL/2.0/.
 #include "Globals.h"
 #include "Timer.h"
 #include "Logs.h"
+#include "sn_utils.h"
 #include "renderer.h"
 
 TAnimContainer *TAnimModel::acAnimList = NULL;
@@ -438,6 +439,11 @@ bool TAnimModel::Init(std::string const &asName, std::string const &asReplacable
 // TODO: redo the random timer initialization
 //    fBlinkTimer = Random() * ( fOnTime + fOffTime );
 
+    if( Global.ModelLoaderThreads > 0 ) {
+        // the model is loaded in the background, the instance picks it up once it's ready
+        m_modelhandle = TModelsManager::RequestModel( asName );
+        return ( m_modelhandle != null_handle );
+    }
     pModel = TModelsManager::GetModel( asName );
     return ( pModel != nullptr );
 }
@@ -448,58 +454,25 @@ bool TAnimModel::Load(cParser *parser, bool ter)
     std::string texture = parser->getToken<std::string>( false ); // tekstura (zmienia na małe)
     replace_slashes( name );
     replace_slashes( texture );
-    if (!Init( name, texture ))
-    {
-        if (name != "notload")
-        { // gdy brak modelu
-            if (ter) // jeśli teren
-            {
-				if( name.substr( name.rfind( '.' ) ) == ".t3d" ) {
-					name[ name.length() - 3 ] = 'e';
-				}
-#ifdef EU07_USE_OLD_TERRAINCODE
-                Global.asTerrainModel = name;
-                WriteLog("Terrain model \"" + name + "\" will be created.");
-#endif
-            }
-            else
-                ErrorLog("Missed file: " + name);
-        }
-    }
-    else
-    { // wiązanie świateł, o ile model wczytany
-        LightsOn[0] = pModel->GetFromName("Light_On00");
-        LightsOn[1] = pModel->GetFromName("Light_On01");
-        LightsOn[2] = pModel->GetFromName("Light_On02");
-        LightsOn[3] = pModel->GetFromName("Light_On03");
-        LightsOn[4] = pModel->GetFromName("Light_On04");
-        LightsOn[5] = pModel->GetFromName("Light_On05");
-        LightsOn[6] = pModel->GetFromName("Light_On06");
-        LightsOn[7] = pModel->GetFromName("Light_On07");
-        LightsOff[0] = pModel->GetFromName("Light_Off00");
-        LightsOff[1] = pModel->GetFromName("Light_Off01");
-        LightsOff[2] = pModel->GetFromName("Light_Off02");
-        LightsOff[3] = pModel->GetFromName("Light_Off03");
-        LightsOff[4] = pModel->GetFromName("Light_Off04");
-        LightsOff[5] = pModel->GetFromName("Light_Off05");
-        LightsOff[6] = pModel->GetFromName("Light_Off06");
-        LightsOff[7] = pModel->GetFromName("Light_Off07");
-    }
-    for (int i = 0; i < iMaxNumLights; ++i)
-        if (LightsOn[i] || LightsOff[i]) // Ra: zlikwidowałem wymóg istnienia obu
-            iNumLights = i + 1;
+    load_model( name, texture, ter );
 
     std::string token;
     do {
         token = parser->getToken<std::string>();
 
+        // light submodels of the model which is still being loaded aren't known yet, so all light settings are kept
+        auto const lightcount { (
+            m_modelhandle != null_handle ?
+                iMaxNumLights :
+                iNumLights ) };
+
         if( token == "lights" ) {
             auto i{ 0 };
             while( ( false == ( token = parser->getToken<std::string>() ).empty() )
                 && ( token != "lightcolors" )
                 && ( token != "endmodel" ) ) {
 
-                if( i < iNumLights ) {
+                if( i < lightcount ) {
                     // stan światła jest liczbą z ułamkiem
                     LightSet( i, std::stof( token ) );
                 }
@@ -513,7 +486,7 @@ bool TAnimModel::Load(cParser *parser, bool ter)
                 && ( token != "lights" )
                 && ( token != "endmodel" ) ) {
 
-                if( ( i < iNumLights )
+                if( ( i < lightcount )
                  && ( token != "-1" ) ) { // -1 leaves the default color intact
                     auto const lightcolor { std::stoi( token, 0, 16 ) };
                     m_lightcolors[i] = {
@@ -530,9 +503,103 @@ bool TAnimModel::Load(cParser *parser, bool ter)
     return true;
 }
 
+// loads specified 3d model with specified replacable texture and binds its light submodels
+void
+TAnimModel::load_model( std::string Name, std::string const &Texture, bool const Terrain ) {
+
+    // source data is retained for binary serialization
+    m_modelfile = Name;
+    m_skinfile = Texture;
+
+    if (!Init( Name, Texture ))
+    {
+        if (Name != "notload")
+        { // gdy brak modelu
+            if (Terrain) // jeśli teren
+            {
+				if( Name.substr( Name.rfind( '.' ) ) == ".t3d" ) {
+					Name[ Name.length() - 3 ] = 'e';
+				}
+#ifdef EU07_USE_OLD_TERRAINCODE
+                Global.asTerrainModel = Name;
+                WriteLog("Terrain model \"" + Name + "\" will be created.");
+#endif
+            }
+            else
+                ErrorLog("Missed file: " + Name);
+        }
+    }
+    else if( m_modelhandle == null_handle ) {
+        bind_lights();
+    }
+    else if( true == Terrain ) {
+        // terrain is converted to shapes right after the load, so it can't wait for the background load
+        finish_model();
+    }
+    else {
+        // pick up the model right away if it was loaded earlier
+        Model();
+    }
+}
+
+// completes loading of the 3d model requested from a worker thread right away. returns: the model, or nullptr if it isn't available
+TModel3d *
+TAnimModel::finish_model() {
+
+    if( m_modelhandle != null_handle ) {
+        TModelsManager::FinishModel( m_modelhandle );
+    }
+    return Model();
+}
+
+// provides 3d model of the instance, or nullptr if it isn't loaded (yet)
+TModel3d *
+TAnimModel::Model() {
+
+    if( ( pModel == nullptr )
+     && ( m_modelhandle != null_handle ) ) {
+        pModel = TModelsManager::Model( m_modelhandle );
+        if( pModel != nullptr ) {
+            m_modelhandle = null_handle;
+            bind_lights();
+            // placeholder radius used so far can be replaced with the actual one
+            m_area.radius = -1.f;
+        }
+    }
+    return pModel;
+}
+
+// binds light submodels of the loaded 3d model
+void
+TAnimModel::bind_lights() {
+
+    { // wiązanie świateł, o ile model wczytany
+        LightsOn[0] = pModel->GetFromName("Light_On00");
+        LightsOn[1] = pModel->GetFromName("Light_On01");
+        LightsOn[2] = pModel->GetFromName("Light_On02");
+        LightsOn[3] = pModel->GetFromName("Light_On03");
+        LightsOn[4] = pModel->GetFromName("Light_On04");
+        LightsOn[5] = pModel->GetFromName("Light_On05");
+        LightsOn[6] = pModel->GetFromName("Light_On06");
+        LightsOn[7] = pModel->GetFromName("Light_On07");
+        LightsOff[0] = pModel->GetFromName("Light_Off00");
+        LightsOff[1] = pModel->GetFromName("Light_Off01");
+        LightsOff[2] = pModel->GetFromName("Light_Off02");
+        LightsOff[3] = pModel->GetFromName("Light_Off03");
+        LightsOff[4] = pModel->GetFromName("Light_Off04");
+        LightsOff[5] = pModel->GetFromName("Light_Off05");
+        LightsOff[6] = pModel->GetFromName("Light_Off06");
+        LightsOff[7] = pModel->GetFromName("Light_Off07");
+    }
+    for (int i = 0; i < iMaxNumLights; ++i)
+        if (LightsOn[i] || LightsOff[i]) // Ra: zlikwidowałem wymóg istnienia obu
+            iNumLights = i + 1;
+}
+
 TAnimContainer * TAnimModel::AddContainer(std::string const &Name)
 { // dodanie sterowania submodelem dla egzemplarza
-    if (!pModel)
+    // animated submodels have to be bound when requested, so the model can't wait for the background load
+    if (!finish_model())
         return NULL;
     TSubModel *tsb = pModel->GetFromName(Name);
     if (tsb)
@@ -717,6 +784,11 @@ void TAnimModel::RaPrepare()
 
 int TAnimModel::Flags()
 { // informacja dla TGround, czy ma być w Render, RenderAlpha, czy RenderMixed
+    if( ( Model() == nullptr )
+     && ( m_modelhandle != null_handle ) ) {
+        // content of the model which is still being loaded isn't known, so it's potentially present in all render phases
+        return 0x3F3F003F;
+    }
     int i = pModel ? pModel->Flags() : 0; // pobranie flag całego modelu
     if( m_materialdata.replacable_skins[ 1 ] > 0 ) // jeśli ma wymienną teksturę 0
         i |= (i & 0x01010001) * ((m_materialdata.textures_alpha & 1) ? 0x20 : 0x10);
@@ -727,11 +799,11 @@ int TAnimModel::Flags()
 
 int TAnimModel::TerrainCount()
 { // zliczanie kwadratów kilometrowych (główna linia po Next) do tworznia tablicy
-    return pModel ? pModel->TerrainCount() : 0;
+    return finish_model() ? pModel->TerrainCount() : 0;
 };
 TSubModel * TAnimModel::TerrainSquare(int n)
 { // pobieranie wskaźników do pierwszego submodelu
-    return pModel ? pModel->TerrainSquare(n) : 0;
+    return finish_model() ? pModel->TerrainSquare(n) : 0;
 };
 
 //---------------------------------------------------------------------------
@@ -886,6 +958,13 @@ void TAnimModel::AnimUpdate(double dt)
 float
 TAnimModel::radius_() {
 
+    if( m_modelhandle != null_handle ) {
+        // the model is still being loaded, use placeholder radius for the time being
+        return (
+            Model() != nullptr ?
+                pModel->bounding_radius() :
+                TModelsManager::BoundingRadius( m_modelhandle ) );
+    }
     return (
         pModel ?
             pModel->bounding_radius() :
@@ -895,14 +974,45 @@ TAnimModel::radius_() {
 // serialize() subclass details, sends content of the subclass to provided stream
 void
 TAnimModel::serialize_( std::ostream &Output ) const {
-    
-    // TODO: implement
+
+    // 3d shape and texture
+    sn_utils::s_str( Output, m_modelfile );
+    sn_utils::s_str( Output, m_skinfile );
+    // rotation
+    sn_utils::ls_float32( Output, vAngle.x );
+    sn_utils::ls_float32( Output, vAngle.y );
+    sn_utils::ls_float32( Output, vAngle.z );
+    // light submodels activation configuration
+    for( auto const state : lsLights ) {
+        sn_utils::ls_float32( Output, state );
+    }
+    for( auto const &color : m_lightcolors ) {
+        sn_utils::ls_float32( Output, color.r );
+        sn_utils::ls_float32( Output, color.g );
+        sn_utils::ls_float32( Output, color.b );
+    }
 }
 // deserialize() subclass details, restores content of the subclass from provided stream
 void
 TAnimModel::deserialize_( std::istream &Input ) {
 
-    // TODO: implement
+    // 3d shape and texture
+    auto const modelfile { sn_utils::d_str( Input ) };
+    auto const skinfile { sn_utils::d_str( Input ) };
+    load_model( modelfile, skinfile, false );
+    // rotation
+    vAngle.x = sn_utils::ld_float32( Input );
+    vAngle.y = sn_utils::ld_float32( Input );
+    vAngle.z = sn_utils::ld_float32( Input );
+    // light submodels activation configuration
+    for( auto &state : lsLights ) {
+        state = sn_utils::ld_float32( Input );
+    }
+    for( auto &color : m_lightcolors ) {
+        color.r = sn_utils::ld_float32( Input );
+        color.g = sn_utils::ld_float32( Input );
+        color.b = sn_utils::ld_float32( Input );
+    }
 }
 
 // export() subclass details, sends basic content of the class in legacy (text) format to provided stream
@@ -920,6 +1030,8 @@ TAnimModel::export_as_text_( std::ostream &Output ) const {
     auto modelfile { (
         pModel ?
             pModel->NameGet() + ".t3d" : // rainsted requires model file names to include an extension
+        m_modelhandle != null_handle ?
+            m_modelfile : // model is still being loaded, go with the name from the scenario
             "none" ) };
     if( modelfile.find( szModelPath ) == 0 ) {
         // don't include 'models/' in the path
@@ -147,10 +147,9 @@ public:
     material_data const *
         Material() const {
             return &m_materialdata; }
-    inline
+    // provides 3d model of the instance, or nullptr if it isn't loaded (yet)
     TModel3d *
-        Model() const {
-            return pModel; }
+        Model();
     inline
     void
         Angles( glm::vec3 const &Angles ) {
@@ -164,6 +163,12 @@ public:
 
 private:
 // methods
+    // loads specified 3d model with specified replacable texture and binds its light submodels
+    void load_model( std::string Name, std::string const &Texture, bool const Terrain );
+    // completes loading of the 3d model requested from a worker thread right away. returns: the model, or nullptr if it isn't available
+    TModel3d * finish_model();
+    // binds light submodels of the loaded 3d model
+    void bind_lights();
     void RaPrepare(); // ustawienie animacji egzemplarza na wzorcu
     void RaAnimate( unsigned int const Framestamp ); // przeliczenie animacji egzemplarza
     void Advanced();
@@ -179,6 +184,9 @@ private:
 // members
     TAnimContainer *pRoot { nullptr }; // pojemniki sterujące, tylko dla aniomowanych submodeli
     TModel3d *pModel { nullptr };
+    model_handle m_modelhandle { null_handle }; // 3d model requested from a worker thread, until it's loaded
+    std::string m_modelfile; // 3d shape and texture as specified by the scenario, retained for serialization
+    std::string m_skinfile;
     glm::vec3 vAngle; // bazowe obroty egzemplarza względem osi
     material_data m_materialdata;
 
@@ -434,17 +434,29 @@ void TController::TableClear()
     eSignSkip = nullptr; // nic nie pomijamy
 };
 
-std::vector<basic_event *> TController::CheckTrackEvent( TTrack *Track, double const fDirection ) const
+TTrack::trace_data const & TController::CheckTrackEvent( TTrack *Track, double const fDirection ) const
 { // sprawdzanie eventów na podanym torze do podstawowego skanowania
-    std::vector<basic_event *> events;
+    // wynik jest zapamiętywany w torze i współdzielony przez wszystkie składy, do zmiany zwrotnic lub eventów
+    auto &trace { Track->trace( fDirection ) };
+    if( true == TTrack::trace_valid( trace ) ) {
+        return trace;
+    }
+    trace.events.clear();
     auto const &eventsequence { ( fDirection > 0 ? Track->m_events2 : Track->m_events1 ) };
     for( auto const &event : eventsequence ) {
         if( ( event.second != nullptr )
          && ( event.second->m_passive ) ) {
-            events.emplace_back( event.second );
+            // odległość liczona od wjazdu na tor, skanujący dolicza przeskanowaną długość
+            trace.events.emplace_back(
+                event.second,
+                GetDistanceToEvent( Track, event.second, fDirection, 0.0 ) );
         }
     }
-    return events;
+    if( Track->eType != tt_Cross ) {
+        // na skrzyżowaniu aktywny segment zależy od trasy wybranej przez skanujący pojazd
+        TTrack::trace_validate( trace );
+    }
+    return trace;
 }
 
 bool TController::TableAddNew()
@@ -566,8 +578,9 @@ void TController::TableTraceRoute(double fDistance, TDynamicObject *pVehicle)
                 WriteLog( "Speed table for " + OwnerName() + " tracing through track " + pTrack->name() );
             }
 
-            auto const events { CheckTrackEvent( pTrack, fLastDir ) };
-            for( auto *pEvent : events ) {
+            auto const &trace { CheckTrackEvent( pTrack, fLastDir ) };
+            for( auto const &event : trace.events ) {
+                auto *pEvent { event.first };
                 if( pEvent != nullptr ) // jeśli jest semafor na tym torze
                 { // trzeba sprawdzić tabelkę, bo dodawanie drugi raz tego samego przystanku nie jest korzystne
                     if (TableNotFound(pEvent)) // jeśli nie ma
@@ -586,7 +599,7 @@ void TController::TableTraceRoute(double fDistance, TDynamicObject *pVehicle)
 */
                         if( newspeedpoint.Set(
                             pEvent,
-                            GetDistanceToEvent( pTrack, pEvent, fLastDir, fCurrentDistance ),
+                            fCurrentDistance + event.second,
                             fLength,
                             OrderCurrentGet() ) ) {
 
@@ -1986,8 +1999,8 @@ double TController::ESMVelocity(bool Main)
 		MCPN += 1;
 	else
 		SCPN += 1;
-	if ((mvControlling->RList[MCPN].ScndAct < 255)&&(mvControlling->ScndCtrlActualPos==0))
-		SCPN = mvControlling->RList[MCPN].ScndAct;
+	if ((mvControlling->Tables->RList[MCPN].ScndAct < 255)&&(mvControlling->ScndCtrlActualPos==0))
+		SCPN = mvControlling->Tables->RList[MCPN].ScndAct;
 	double FrictionMax = mvControlling->Mass*9.81*mvControlling->Adhesive(mvControlling->RunningTrack.friction)*fFrictionCoeff;
 	double IF = mvControlling->Imax;
 	double MS = 0;
@@ -1995,7 +2008,7 @@ double TController::ESMVelocity(bool Main)
 	for (int i = 0; i < 5; i++)
 	{
 		MS = mvControlling->MomentumF(IF, IF, SCPN);
-		Fmax = MS * mvControlling->RList[MCPN].Bn * mvControlling->RList[MCPN].Mn * 2 / mvControlling->WheelDiameter * mvControlling->Transmision.Ratio;
+		Fmax = MS * mvControlling->Tables->RList[MCPN].Bn * mvControlling->Tables->RList[MCPN].Mn * 2 / mvControlling->WheelDiameter * mvControlling->Transmision.Ratio;
         if( Fmax != 0.0 ) {
             IF = 0.5 * IF * ( 1 + FrictionMax / Fmax );
         }
@@ -2006,11 +2019,11 @@ double TController::ESMVelocity(bool Main)
         }
 	}
 	IF = std::min(IF, mvControlling->Imax*fCurrentCoeff);
-	double R = mvControlling->RList[MCPN].R + mvControlling->CircuitRes + mvControlling->RList[MCPN].Mn*mvControlling->WindingRes;
-	double pole = mvControlling->MotorParam[SCPN].fi *
-		std::max(abs(IF) / (abs(IF) + mvControlling->MotorParam[SCPN].Isat) - mvControlling->MotorParam[SCPN].fi0, 0.0);
+	double R = mvControlling->Tables->RList[MCPN].R + mvControlling->CircuitRes + mvControlling->Tables->RList[MCPN].Mn*mvControlling->WindingRes;
+	double pole = mvControlling->Tables->MotorParam[SCPN].fi *
+		std::max(abs(IF) / (abs(IF) + mvControlling->Tables->MotorParam[SCPN].Isat) - mvControlling->Tables->MotorParam[SCPN].fi0, 0.0);
 	double Us = abs(mvControlling->Voltage) - IF*R;
-	double ns = std::max(0.0, Us / (pole*mvControlling->RList[MCPN].Mn));
+	double ns = std::max(0.0, Us / (pole*mvControlling->Tables->RList[MCPN].Mn));
 	ESMVel = ns * mvControlling->WheelDiameter*M_PI*3.6/mvControlling->Transmision.Ratio;
 	return ESMVel;
 }
@@ -2444,7 +2457,7 @@ bool TController::PrepareEngine()
                     ; // zerowanie napędu
                 if( mvOccupied->TrainType == dt_SN61 ) {
                     // specjalnie dla SN61 żeby nie zgasł
-                    if( mvControlling->RList[ mvControlling->MainCtrlPos ].Mn == 0 ) {
+                    if( mvControlling->Tables->RList[ mvControlling->MainCtrlPos ].Mn == 0 ) {
                         mvControlling->IncMainCtrl( 1 );
                     }
                 }
@@ -2845,8 +2858,8 @@ bool TController::IncSpeed()
                     // if it generates enough traction force
                     // to build up speed to 30/40 km/h for passenger/cargo train (10 km/h less if going uphill)
                     auto const sufficienttractionforce { std::abs( mvControlling->Ft ) > ( IsHeavyCargoTrain ? 125 : 100 ) * 1000.0 };
-                    auto const seriesmodefieldshunting { ( mvControlling->ScndCtrlPos > 0 ) && ( mvControlling->RList[ mvControlling->MainCtrlPos ].Bn == 1 ) };
-                    auto const parallelmodefieldshunting { ( mvControlling->ScndCtrlPos > 0 ) && ( mvControlling->RList[ mvControlling->MainCtrlPos ].Bn > 1 ) };
+                    auto const seriesmodefieldshunting { ( mvControlling->ScndCtrlPos > 0 ) && ( mvControlling->Tables->RList[ mvControlling->MainCtrlPos ].Bn == 1 ) };
+                    auto const parallelmodefieldshunting { ( mvControlling->ScndCtrlPos > 0 ) && ( mvControlling->Tables->RList[ mvControlling->MainCtrlPos ].Bn > 1 ) };
                     auto const useseriesmodevoltage {
                         interpolate(
                             mvControlling->EnginePowerSource.CollectorParameters.MinV,
@@ -2861,12 +2874,12 @@ bool TController::IncSpeed()
                     // (if there's only one parallel mode configuration it'll be used regardless of current speed)
                     auto const usefieldshunting = (
                         ( mvControlling->StLinFlag )
-                     && ( mvControlling->RList[ mvControlling->MainCtrlPos ].R < 0.01 )
+                     && ( mvControlling->Tables->RList[ mvControlling->MainCtrlPos ].R < 0.01 )
                      && ( useseriesmode ?
-                            mvControlling->RList[ mvControlling->MainCtrlPos ].Bn == 1 :
+                            mvControlling->Tables->RList[ mvControlling->MainCtrlPos ].Bn == 1 :
                             ( ( true == sufficienttractionforce )
                            && ( mvOccupied->Vel <= ( IsCargoTrain ? 55 : 45 ) + ( parallelmodefieldshunting ? 5 : 0 ) ) ?
-                                mvControlling->RList[ mvControlling->MainCtrlPos ].Bn > 1 :
+                                mvControlling->Tables->RList[ mvControlling->MainCtrlPos ].Bn > 1 :
                                 mvControlling->MainCtrlPos == mvControlling->MainCtrlPosNo ) ) );
 
 					double Vs = 99999;
@@ -2899,7 +2912,7 @@ bool TController::IncSpeed()
                             // keep from dropping into series mode when entering/using parallel mode, and from shutting down in the series mode
                             auto const sufficientpowermargin {
                                 fVoltage - (
-                                    mvControlling->RList[ std::min( mvControlling->MainCtrlPos + 1, mvControlling->MainCtrlPosNo ) ].Bn == 1 ? 
+                                    mvControlling->Tables->RList[ std::min( mvControlling->MainCtrlPos + 1, mvControlling->MainCtrlPosNo ) ].Bn == 1 ? 
                                         mvControlling->EnginePowerSource.CollectorParameters.MinV :
                                         useseriesmodevoltage )
                                 > ( IsHeavyCargoTrain ? 80.0 : 60.0 ) };
@@ -2968,10 +2981,10 @@ bool TController::IncSpeed()
         }
         if( true == Ready ) {
             if( ( mvControlling->Vel > mvControlling->dizel_minVelfullengage )
-             && ( mvControlling->RList[ mvControlling->MainCtrlPos ].Mn > 0 ) ) {
+             && ( mvControlling->Tables->RList[ mvControlling->MainCtrlPos ].Mn > 0 ) ) {
                 OK = mvControlling->IncMainCtrl( 1 );
             }
-            if( mvControlling->RList[ mvControlling->MainCtrlPos ].Mn == 0 ) {
+            if( mvControlling->Tables->RList[ mvControlling->MainCtrlPos ].Mn == 0 ) {
                 OK = mvControlling->IncMainCtrl( 1 );
             }
         }
@@ -3023,11 +3036,11 @@ bool TController::DecSpeed(bool force)
     case TEngineType::DieselEngine:
         if ((mvControlling->Vel > mvControlling->dizel_minVelfullengage))
         {
-            if (mvControlling->RList[mvControlling->MainCtrlPos].Mn > 0)
+            if (mvControlling->Tables->RList[mvControlling->MainCtrlPos].Mn > 0)
                 OK = mvControlling->DecMainCtrl(1);
         }
         else
-            while ((mvControlling->RList[mvControlling->MainCtrlPos].Mn > 0) &&
+            while ((mvControlling->Tables->RList[mvControlling->MainCtrlPos].Mn > 0) &&
                    (mvControlling->MainCtrlPos > 1))
                 OK = mvControlling->DecMainCtrl(1);
         if (force) // przy aktywacji kabiny jest potrzeba natychmiastowego wyzerowania
@@ -3119,7 +3132,7 @@ void TController::SpeedSet()
                     if (mvControlling->Imax * mvControlling->Voltage / (fMass * fAccGravity) < -2.8) // a na niskim się za szybko nie pojedzie
                     { // włączenie wysokiego rozruchu;
                         // (I*U)[A*V=W=kg*m*m/sss]/(m[kg]*a[m/ss])=v[m/s]; 2.8m/ss=10km/h
-                        if (mvControlling->RList[mvControlling->MainCtrlPos].Bn > 1)
+                        if (mvControlling->Tables->RList[mvControlling->MainCtrlPos].Bn > 1)
                         { // jeśli jedzie na równoległym, to zbijamy do szeregowego, aby włączyć
                             // wysoki rozruch
                             if (mvControlling->ScndCtrlPos > 0) // jeżeli jest bocznik
@@ -3127,7 +3140,7 @@ void TController::SpeedSet()
                             do // skręcanie do bezoporowej na szeregowym
                                 mvControlling->DecMainCtrl(1); // kręcimy nastawnik jazdy o 1 wstecz
                             while (mvControlling->MainCtrlPos ?
-                                       mvControlling->RList[mvControlling->MainCtrlPos].Bn > 1 :
+                                       mvControlling->Tables->RList[mvControlling->MainCtrlPos].Bn > 1 :
                                        false); // oporowa zapętla
                         }
                         if (mvControlling->Imax < mvControlling->ImaxHi) // jeśli da się na wysokim
@@ -3168,24 +3181,24 @@ void TController::SpeedSet()
         break;
     case TEngineType::DieselEngine:
         // Ra 2014-06: "automatyczna" skrzynia biegów...
-        if (!mvControlling->MotorParam[mvControlling->ScndCtrlPos].AutoSwitch) // gdy biegi ręczne
+        if (!mvControlling->Tables->MotorParam[mvControlling->ScndCtrlPos].AutoSwitch) // gdy biegi ręczne
             if ((mvControlling->ShuntMode ? mvControlling->AnPos : 1.0) * mvControlling->Vel >
-                0.75 * mvControlling->MotorParam[mvControlling->ScndCtrlPos].mfi)
+                0.75 * mvControlling->Tables->MotorParam[mvControlling->ScndCtrlPos].mfi)
             // if (mvControlling->enrot>0.95*mvControlling->dizel_nMmax) //youBy: jeśli obroty >
             // 0,95 nmax, wrzuć wyższy bieg - Ra: to nie działa
             { // jak prędkość większa niż 0.6 maksymalnej na danym biegu, wrzucić wyższy
                 mvControlling->DecMainCtrl(2);
                 if (mvControlling->IncScndCtrl(1))
-                    if (mvControlling->MotorParam[mvControlling->ScndCtrlPos].mIsat ==
+                    if (mvControlling->Tables->MotorParam[mvControlling->ScndCtrlPos].mIsat ==
                         0.0) // jeśli bieg jałowy
                         mvControlling->IncScndCtrl(1); // to kolejny
             }
             else if ((mvControlling->ShuntMode ? mvControlling->AnPos : 1.0) * mvControlling->Vel <
-                     mvControlling->MotorParam[mvControlling->ScndCtrlPos].fi)
+                     mvControlling->Tables->MotorParam[mvControlling->ScndCtrlPos].fi)
             { // jak prędkość mniejsza niż minimalna na danym biegu, wrzucić niższy
                 mvControlling->DecMainCtrl(2);
                 mvControlling->DecScndCtrl(1);
-                if (mvControlling->MotorParam[mvControlling->ScndCtrlPos].mIsat ==
+                if (mvControlling->Tables->MotorParam[mvControlling->ScndCtrlPos].mIsat ==
                     0.0) // jeśli bieg jałowy
                     if (mvControlling->ScndCtrlPos) // a jeszcze zera nie osiągnięto
                         mvControlling->DecScndCtrl(1); // to kolejny wcześniejszy
@@ -3296,6 +3309,15 @@ void TController::Doors( bool const Open, int const Side ) {
     }
 }
 
+// returns: true if the train approaches or stands at a station, where its control needs full precision
+bool
+TController::is_at_station() const {
+
+    return (
+        ( true == IsAtPassengerStop )
+     || ( ( iDrivigFlags & ( moveStopPointFound | moveDoorOpened ) ) != 0 ) );
+}
+
 // returns true if any vehicle in the consist has open doors
 bool
 TController::doors_open() const {
@@ -3933,7 +3955,7 @@ TController::UpdateSituation(double dt) {
              || ( vehicle->enrot > 0.8 * (
                     vehicle->EngineType == TEngineType::DieselEngine ?
                         vehicle->dizel_nmin :
-                        vehicle->DElist[ 0 ].RPM / 60.0 ) ) );
+                        vehicle->Tables->DElist[ 0 ].RPM / 60.0 ) ) );
         }
         p = p->Next(); // pojazd podłączony z tyłu (patrząc od czoła)
     }
@@ -4055,12 +4077,12 @@ TController::UpdateSituation(double dt) {
                     switch( mvControlling->EngineType ) {
 
                         case TEngineType::ElectricSeriesMotor: {
-                            if( mvControlling->RList[ mvControlling->MainCtrlPos ].Bn > 1 ) {
+                            if( mvControlling->Tables->RList[ mvControlling->MainCtrlPos ].Bn > 1 ) {
                                 // limit yourself to series mode
                                 if( mvControlling->ScndCtrlPos ) {
                                     mvControlling->DecScndCtrl( 2 );
                                 }
-                                while( ( mvControlling->RList[ mvControlling->MainCtrlPos ].Bn > 1 )
+                                while( ( mvControlling->Tables->RList[ mvControlling->MainCtrlPos ].Bn > 1 )
                                     && ( mvControlling->DecMainCtrl( 1 ) ) ) {
                                     ; // all work is performed in the header
                                 }
@@ -6302,7 +6324,7 @@ void TController::DirectionForward(bool forward)
             mvOccupied->DirectionBackward(); // do tyłu w obecnej kabinie
     if( mvOccupied->TrainType == dt_SN61 ) {
         // specjalnie dla SN61 żeby nie zgasł
-        if( mvControlling->RList[ mvControlling->MainCtrlPos ].Mn == 0 ) {
+        if( mvControlling->Tables->RList[ mvControlling->MainCtrlPos ].Mn == 0 ) {
             mvControlling->IncMainCtrl( 1 );
         }
     }
@@ -14,6 +14,7 @@ http://mozilla.org/MPL/2.0/.
 #include "MOVER.h"
 #include "sound.h"
 #include "DynObj.h"
+#include "Track.h"
 
 enum TOrders
 { // rozkazy dla AI
@@ -336,7 +337,7 @@ public:
         dMoveLen += distance * iDirection; } //jak jedzie do tyłu to trzeba uwzględniać, że distance jest ujemna
 private:
     // Ra: metody obsługujące skanowanie toru
-    std::vector<basic_event *> CheckTrackEvent( TTrack *Track, double const fDirection ) const;
+    TTrack::trace_data const & CheckTrackEvent( TTrack *Track, double const fDirection ) const;
     bool TableAddNew();
     bool TableNotFound( basic_event const *Event ) const;
     void TableTraceRoute( double fDistance, TDynamicObject *pVehicle );
@@ -402,6 +403,9 @@ private:
 // consist
 // methods
 public:
+    // returns: true if the train approaches or stands at a station, where its control needs full precision
+    bool
+        is_at_station() const;
 private:
     bool CheckVehicles(TOrders user = Wait_for_orders);
     bool PrepareEngine();
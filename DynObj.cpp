@@ -45,6 +45,26 @@ std::string const TDynamicObject::MED_labels[] = {
 
 bool TDynamicObject::bDynamicRemove { false };
 
+// physics sleep thresholds
+namespace dormancy {
+double const velocity { 0.0001 }; // [m/s]
+double const pipeflow { 0.001 }; // brake pipe pressure change rate [bar/s]
+double const force { 500.0 }; // coupler force [N]
+double const delay { 5.0 }; // time the vehicle has to stay quiet before it can be put to sleep [s]
+}
+
+namespace adaptivestep {
+double const tolerance { 0.0001 }; // local velocity error allowed in a single physics step [m/s]
+double const stability { 0.4 }; // highest allowed product of step length and rate of change of coupler links
+double const safety { 0.9 }; // margin of the step length picked for the estimated error
+double const shrink { 0.25 }; // largest decrease of the step length between updates
+double const grow { 2.0 }; // largest increase of the step length between updates
+double const minstep { 0.125 }; // shortest step, relative to the fixed one
+double const maxstep { 2.0 }; // longest step, relative to the fixed one
+double const pipeflow { 0.01 }; // brake pipe pressure change rate above which the step isn't made longer than the fixed one [MPa/s]
+double const couplertune { 0.1 }; // scaling of coupler damping, same as used by the physics
+}
+
 // helper, locates submodel with specified name in specified 3d model; returns: pointer to the submodel, or null
 TSubModel *
 GetSubmodelFromName( TModel3d * const Model, std::string const Name ) {
@@ -1212,6 +1232,10 @@ void TDynamicObject::ABuCheckMyTrack()
         NewTrack->AddDynamicObject(this);
     }
     iAxleFirst = 0; // pojazd powiązany z przednią osią - Axle0
+    if( MyTrack != nullptr ) {
+        // the active axle might have changed
+        MyTrack->occupancy_moved( this );
+    }
 }
 
 // Ra: w poniższej funkcji jest problem ze sprzęgami
@@ -1254,67 +1278,97 @@ TDynamicObject::ABuFindObject( int &Foundcoupler, double &Distance, TTrack const
         }
     }
 
-    double objectposition; // robocza odległość od kolejnych pojazdów na danym odcinku
-    for( auto dynamic : Track->Dynamics ) {
-
-        if( dynamic == this ) { continue; } // szukający się nie liczy
-/*
-        if( ( ( dynamic == PrevConnected ) && ( MoverParameters->Couplers[ TMoverParameters::side::front ].CouplingFlag != coupling::faux ) )
-         || ( ( dynamic == NextConnected ) && ( MoverParameters->Couplers[ TMoverParameters::side::rear  ].CouplingFlag != coupling::faux ) )  ){
-            // stop-gap check to prevent 'detection' of attached vehicles
-            // which seems to be a side-effect of inaccurate location calculation in 'simple' mode?
-            // TODO: investigate actual cause
-            continue;
-        }
-*/
-        if( Direction > 0 ) {
-            // jeśli szukanie w kierunku Point2
-            objectposition = ( dynamic->RaTranslationGet() ) - myposition; // odległogłość tamtego od szukającego
+    // vehicles in the index are sorted by their position on the track, so we can check them starting from the nearest one
+    // in the search direction, and stop at the first potential collision
+    auto const &occupancy { Track->occupancy() };
+    if( Direction > 0 ) {
+        // jeśli szukanie w kierunku Point2
+        auto candidate {
+            std::upper_bound(
+                std::begin( occupancy ), std::end( occupancy ),
+                myposition,
+                []( double const Position, TTrack::occupancy_entry const &Entry ) {
+                    return Position < Entry.position; } ) };
+        for( ; candidate != std::end( occupancy ); ++candidate ) {
+            auto const objectposition { candidate->position - myposition }; // odległogłość tamtego od szukającego
+            if( objectposition >= distance ) { break; }
             if( ( objectposition > 0 )
-             && ( objectposition < distance ) ) {
-                // gdy jest po właściwej stronie i bliżej niż jakiś wcześniejszy
-                Foundcoupler = ( dynamic->RaDirectionGet() > 0 ) ? 1 : 0; // to, bo (ScanDir>=0)
-            }
-            else { continue; }
-        }
-        else {
-            objectposition = myposition - ( dynamic->RaTranslationGet() ); //???-przesunięcie wózka względem Point1 toru
-            if( ( objectposition > 0 )
-             && ( objectposition < distance ) ) {
-                Foundcoupler = ( dynamic->RaDirectionGet() > 0 ) ? 0 : 1; // odwrotnie, bo (ScanDir<0)
+             && ( true == ABuCanCollide( candidate->vehicle, Track, Direction, Mycoupler, Foundcoupler ) ) ) {
+                foundobject = candidate->vehicle; // potencjalna kolizja
+                distance = objectposition; // odleglość pomiędzy aktywnymi osiami pojazdów
+                break;
             }
-            else { continue; }
         }
-
-        if( Track->iCategoryFlag & 254 ) {
-            // trajektoria innego typu niż tor kolejowy
-            // dla torów nie ma sensu tego sprawdzać, rzadko co jedzie po jednej szynie i się mija
-            // Ra: mijanie samochodów wcale nie jest proste
-            // Przesuniecie wzgledne pojazdow. Wyznaczane, zeby sprawdzic,
-            // czy pojazdy faktycznie sie zderzaja (moga byc przesuniete
-            // w/m siebie tak, ze nie zachodza na siebie i wtedy sie mijaja).
-            double relativeoffset; // wzajemna odległość poprzeczna
-            if( Foundcoupler != Mycoupler ) {
-                // facing the same direction
-                relativeoffset = std::abs( MoverParameters->OffsetTrackH - dynamic->MoverParameters->OffsetTrackH );
-            }
-            else {
-                relativeoffset = std::abs( MoverParameters->OffsetTrackH + dynamic->MoverParameters->OffsetTrackH );
-            }
-            if( relativeoffset + relativeoffset > MoverParameters->Dim.W + dynamic->MoverParameters->Dim.W ) {
-                // odległość większa od połowy sumy szerokości - kolizji nie będzie
-                continue;
+    }
+    else {
+        // vehicles with the same position are checked in registration order, same as in the Dynamics sequence
+        auto groupend {
+            std::lower_bound(
+                std::begin( occupancy ), std::end( occupancy ),
+                myposition,
+                []( TTrack::occupancy_entry const &Entry, double const Position ) {
+                    return Entry.position < Position; } ) };
+        while( ( groupend != std::begin( occupancy ) )
+            && ( foundobject == nullptr ) ) {
+            auto const position { std::prev( groupend )->position };
+            auto const objectposition { myposition - position }; //???-przesunięcie wózka względem Point1 toru
+            if( objectposition >= distance ) { break; }
+            auto groupbegin { std::prev( groupend ) };
+            while( ( groupbegin != std::begin( occupancy ) )
+                && ( std::prev( groupbegin )->position == position ) ) {
+                --groupbegin;
+            }
+            for( auto candidate { groupbegin }; candidate != groupend; ++candidate ) {
+                if( ( objectposition > 0 )
+                 && ( true == ABuCanCollide( candidate->vehicle, Track, Direction, Mycoupler, Foundcoupler ) ) ) {
+                    foundobject = candidate->vehicle; // potencjalna kolizja
+                    distance = objectposition; // odleglość pomiędzy aktywnymi osiami pojazdów
+                    break;
+                }
             }
-            // jeśli zahaczenie jest niewielkie, a jest miejsce na poboczu, to zjechać na pobocze
+            groupend = groupbegin;
         }
-        foundobject = dynamic; // potencjalna kolizja
-        distance = objectposition; // odleglość pomiędzy aktywnymi osiami pojazdów
     }
 
     Distance += distance; // doliczenie odległości przeszkody albo długości odcinka do przeskanowanej odległości
     return foundobject;
 }
 
+// checks whether specified vehicle found on the track ahead can collide with us. fills number of its coupler facing us
+bool
+TDynamicObject::ABuCanCollide( TDynamicObject const *Vehicle, TTrack const *Track, int const Direction, int const Mycoupler, int &Foundcoupler ) const {
+
+    if( Vehicle == this ) { return false; } // szukający się nie liczy
+
+    Foundcoupler = (
+        Direction > 0 ?
+            ( ( Vehicle->RaDirectionGet() > 0 ) ? 1 : 0 ) : // to, bo (ScanDir>=0)
+            ( ( Vehicle->RaDirectionGet() > 0 ) ? 0 : 1 ) ); // odwrotnie, bo (ScanDir<0)
+
+    if( Track->iCategoryFlag & 254 ) {
+        // trajektoria innego typu niż tor kolejowy
+        // dla torów nie ma sensu tego sprawdzać, rzadko co jedzie po jednej szynie i się mija
+        // Ra: mijanie samochodów wcale nie jest proste
+        // Przesuniecie wzgledne pojazdow. Wyznaczane, zeby sprawdzic,
+        // czy pojazdy faktycznie sie zderzaja (moga byc przesuniete
+        // w/m siebie tak, ze nie zachodza na siebie i wtedy sie mijaja).
+        double relativeoffset; // wzajemna odległość poprzeczna
+        if( Foundcoupler != Mycoupler ) {
+            // facing the same direction
+            relativeoffset = std::abs( MoverParameters->OffsetTrackH - Vehicle->MoverParameters->OffsetTrackH );
+        }
+        else {
+            relativeoffset = std::abs( MoverParameters->OffsetTrackH + Vehicle->MoverParameters->OffsetTrackH );
+        }
+        if( relativeoffset + relativeoffset > MoverParameters->Dim.W + Vehicle->MoverParameters->Dim.W ) {
+            // odległość większa od połowy sumy szerokości - kolizji nie będzie
+            return false;
+        }
+        // jeśli zahaczenie jest niewielkie, a jest miejsce na poboczu, to zjechać na pobocze
+    }
+    return true;
+}
+
 int TDynamicObject::DettachStatus(int dir)
 { // sprawdzenie odległości sprzęgów
     // rzeczywistych od strony (dir):
@@ -1614,6 +1668,8 @@ void TDynamicObject::ABuScanObjects( int Direction, double Distance )
     }
 
     if (foundobject) {
+        // wake up the obstacle, if it was put to sleep, along with vehicles linked with it
+        simulation::Vehicles.wake( foundobject );
         // siebie można bezpiecznie podłączyć jednostronnie do znalezionego
         MoverParameters->Attach( mycoupler, foundcoupler, foundobject->MoverParameters, coupling::faux );
         // MoverParameters->Couplers[MyCouplFound].Render=false; //wirtualnego nie renderujemy
@@ -1709,6 +1765,7 @@ TDynamicObject::TDynamicObject() {
     bDisplayCab = false; // 030303
     NextConnected = PrevConnected = NULL;
     NextConnectedNo = PrevConnectedNo = 2; // ABu: Numery sprzegow. 2=nie podłączony
+    m_randomengine.seed( Global.random_engine() );
     bEnabled = true;
     MyTrack = NULL;
     // McZapkie-260202
@@ -2743,14 +2800,29 @@ void TDynamicObject::LoadUpdate() {
             // bieżąca ścieżka do tekstur to dynamic/...
             Global.asCurrentTexturePath = asBaseDir;
 
-            mdLoad = LoadMMediaFile_mdload( MoverParameters->LoadType.name );
+            if( Global.ModelLoaderThreads > 0 ) {
+                // load change during the simulation shouldn't stall it, so the model is loaded in the background
+                // until it's ready, the vehicle is shown without its load
+                if( m_loadmodel == null_handle ) {
+                    m_loadmodel = LoadMMediaFile_mdload_request( MoverParameters->LoadType.name );
+                }
+                mdLoad = TModelsManager::Model( m_loadmodel );
+                if( mdLoad != nullptr ) {
+                    m_loadmodel = null_handle;
+                }
+            }
+            else {
+                mdLoad = LoadMMediaFile_mdload( MoverParameters->LoadType.name );
+            }
             // TODO: discern from vehicle component which merely uses vehicle directory and has no animations, so it can be initialized outright
             // and actual vehicles which get their initialization after their animations are set up
             if( mdLoad != nullptr ) {
                 mdLoad->Init();
             }
-            // update bindings between lowpoly sections and potential load chunks placed inside them
-            update_load_sections();
+            if( m_loadmodel == null_handle ) {
+                // update bindings between lowpoly sections and potential load chunks placed inside them
+                update_load_sections();
+            }
             // z powrotem defaultowa sciezka do tekstur
             Global.asCurrentTexturePath = std::string( szTexturePath );
         }
@@ -2760,6 +2832,7 @@ void TDynamicObject::LoadUpdate() {
         // nie ma ładunku
 //        MoverParameters->AssignLoad( "" );
         mdLoad = nullptr;
+        m_loadmodel = null_handle;
         // erase bindings between lowpoly sections and potential load chunks placed inside them
         update_load_sections();
     }
@@ -3786,7 +3859,8 @@ bool TDynamicObject::Update(double dt, double dt1)
         MoverParameters->DerailReason = 0; //żeby tylko raz
     }
 
-    if( MoverParameters->LoadStatus ) {
+    if( ( MoverParameters->LoadStatus )
+     || ( m_loadmodel != null_handle ) ) {
         LoadUpdate(); // zmiana modelu ładunku
     }
     update_exchange( dt );
@@ -3798,13 +3872,29 @@ bool TDynamicObject::FastUpdate(double dt)
 {
     if (dt == 0.0)
         return true; // Ra: pauza
-    double dDOMoveLen;
     if (!MoverParameters->PhysicActivation)
         return true; // McZapkie: wylaczanie fizyki gdy nie potrzeba
 
     if (!bEnabled)
         return false;
 
+    if( true == FastMovementUpdate( dt ) ) {
+        FastLoadUpdate( dt );
+    }
+
+    return true; // Ra: chyba tak?
+}
+
+// fast physics step, limited to the vehicle and vehicles linked with it by couplers
+// returns: true if the accompanying load update should be performed
+bool TDynamicObject::FastMovementUpdate( double dt ) {
+
+    if( dt == 0.0 ) { return false; }
+    if( false == MoverParameters->PhysicActivation ) { return false; }
+    if( false == bEnabled ) { return false; }
+
+    double dDOMoveLen;
+
     // NOTE: coordinate system swap
     // TODO: replace with regular glm vectors
     TLocation const l {
@@ -3828,12 +3918,174 @@ bool TDynamicObject::FastUpdate(double dt)
     // ResetdMoveLen();
     FastMove(dDOMoveLen);
 
-    if( MoverParameters->LoadStatus ) {
+    return true;
+}
+
+// load change part of the fast update; can touch shared resources, so it's done separately from the physics step
+void TDynamicObject::FastLoadUpdate( double dt ) {
+
+    if( ( MoverParameters->LoadStatus )
+     || ( m_loadmodel != null_handle ) ) {
         LoadUpdate(); // zmiana modelu ładunku
     }
     update_exchange( dt );
+}
 
-    return true; // Ra: chyba tak?
+// returns: true if specified track has events triggered by vehicles standing on it
+bool TDynamicObject::has_standing_events( TTrack const *Track ) {
+
+    return (
+        ( Track != nullptr )
+     && ( true == Track->m_events )
+     && ( ( false == Track->m_events0.empty() )
+       || ( false == Track->m_events0all.empty() ) ) );
+}
+
+// updates tracking of vehicle activity. returns: true if the vehicle stayed quiet long enough to be put to sleep
+bool TDynamicObject::update_dormancy( double const Timedelta ) {
+
+    if( Timedelta <= 0.0 ) { return false; }
+
+    auto const *mover { MoverParameters };
+    auto const pipeflow { std::abs( mover->PipePress - m_dormancy.pipe_pressure ) / Timedelta };
+    m_dormancy.pipe_pressure = mover->PipePress;
+
+    auto const isquiet { (
+        ( true == bEnabled )
+        // the physics object itself considers the vehicle stationary and idle
+     && ( false == mover->PhysicActivation )
+     && ( std::abs( mover->V ) < dormancy::velocity )
+     && ( pipeflow < dormancy::pipeflow )
+     && ( std::abs( mover->Couplers[ end::front ].CForce ) < dormancy::force )
+     && ( std::abs( mover->Couplers[ end::rear ].CForce ) < dormancy::force )
+        // nobody's in charge of the vehicle
+     && ( Mechanik == nullptr )
+     && ( false == MechInside )
+     && ( ( simulation::Train == nullptr ) || ( simulation::Train->Dynamic() != this ) )
+        // nothing's pending
+     && ( false == mover->PantFrontUp )
+     && ( false == mover->PantRearUp )
+     && ( true == mover->CommandIn.Command.empty() )
+     && ( mover->LoadStatus == 0 )
+     && ( m_exchange.unload_count < 0.01 )
+     && ( m_exchange.load_count < 0.01 )
+        // standing vehicles keep triggering event0 of their tracks, which only happens in the regular update
+     && ( false == has_standing_events( Axle0.GetTrack() ) )
+     && ( false == has_standing_events( Axle1.GetTrack() ) ) ) };
+
+    m_dormancy.quiet_time = (
+        isquiet ?
+            m_dormancy.quiet_time + Timedelta :
+            0.0 );
+
+    return ( m_dormancy.quiet_time >= dormancy::delay );
+}
+
+// takes the vehicle out of the physics update, recording state used to detect outside disturbances
+void TDynamicObject::sleep() {
+
+    auto const *mover { MoverParameters };
+
+    m_dormancy.dormant = true;
+    m_dormancy.pipe_pressure = mover->PipePress;
+    m_dormancy.brake_position = mover->BrakeCtrlPos;
+    m_dormancy.local_brake_position = mover->LocalBrakePosA;
+    m_dormancy.manual_brake_position = mover->ManualBrakePos;
+    m_dormancy.brake_delay = mover->BrakeDelayFlag;
+    for( int side = end::front; side <= end::rear; ++side ) {
+        m_dormancy.coupling_flags[ side ] = mover->Couplers[ side ].CouplingFlag;
+        m_dormancy.coupled[ side ] = mover->Couplers[ side ].Connected;
+    }
+}
+
+// brings the vehicle back into the physics update
+void TDynamicObject::wake() {
+
+    m_dormancy.dormant = false;
+    m_dormancy.quiet_time = 0.0;
+    // acceleration recorded before the sleep has nothing to do with the current state
+    m_substep.history = 0;
+}
+
+// returns: estimate of the highest rate of change of coupler links of the vehicle [1/s], including buffers expected to touch within specified time
+double TDynamicObject::substep_rate( double const Lookahead ) const {
+
+    auto const *mover { MoverParameters };
+    if( mover->TotalMass <= 0.0 ) { return 0.0; }
+
+    auto stiffness { 0.0 };
+    auto damping { 0.0 };
+    for( int side = end::front; side <= end::rear; ++side ) {
+        auto const &coupler { mover->Couplers[ side ] };
+        auto const *connected { coupler.Connected };
+        if( connected == nullptr ) { continue; }
+        if( ( coupler.CouplingFlag == coupling::faux )
+         && ( coupler.CoupleDist > ( std::abs( mover->V ) + std::abs( connected->V ) ) * Lookahead ) ) {
+            // uncoupled vehicles interact only through buffers, and these won't touch for a while
+            continue;
+        }
+        auto const &othercoupler { connected->Couplers[ coupler.ConnectedNr ] };
+        // the spring acting depends on direction of the load, which can change during the update, so the stiffer one is taken
+        stiffness += 0.5 * std::max(
+            coupler.SpringKC + othercoupler.SpringKC,
+            coupler.SpringKB + othercoupler.SpringKB );
+        damping +=
+            0.5 * ( coupler.FmaxC + coupler.FmaxB + othercoupler.FmaxC + othercoupler.FmaxB ) * adaptivestep::couplertune
+          * 0.5 * ( coupler.beta + othercoupler.beta );
+    }
+    // with the links on both ends, eigenvalues of the vehicle chain are bounded by twice the sum of link parameters over vehicle mass
+    return
+        std::sqrt( 2.0 * stiffness / mover->TotalMass )
+      + 2.0 * damping / mover->TotalMass;
+}
+
+// records tangential acceleration after completed physics step of specified length, and updates estimate of the local error
+void TDynamicObject::update_substep( double const Timestep ) {
+
+    auto &accelerations { m_substep.accelerations };
+    auto const acceleration { MoverParameters->AccS };
+    if( m_substep.history >= 2 ) {
+        // local velocity error of the two-step Adams-Bashforth method is 5/12 h^3 a'', with the second derivative taken from the last three samples
+        auto const error { 5.0 / 12.0 * Timestep * std::abs( acceleration - 2.0 * accelerations[ 0 ] + accelerations[ 1 ] ) };
+        m_substep.error = std::max( m_substep.error, error / adaptivestep::tolerance );
+    }
+    accelerations[ 1 ] = accelerations[ 0 ];
+    accelerations[ 0 ] = acceleration;
+    m_substep.history = std::min( m_substep.history + 1, 2 );
+}
+
+// returns: true if state of the dormant vehicle was changed from outside
+bool TDynamicObject::is_disturbed() const {
+
+    auto const *mover { MoverParameters };
+
+    if( ( false == bEnabled )
+     || ( true == mover->PhysicActivation )
+     || ( Mechanik != nullptr )
+     || ( true == MechInside )
+     || ( ( simulation::Train != nullptr ) && ( simulation::Train->Dynamic() == this ) )
+     || ( false == mover->CommandIn.Command.empty() )
+     || ( mover->LoadStatus != 0 )
+     || ( m_exchange.unload_count >= 0.01 )
+     || ( m_exchange.load_count >= 0.01 ) ) {
+        return true;
+    }
+    // brake commands
+    if( ( mover->PipePress != m_dormancy.pipe_pressure )
+     || ( mover->BrakeCtrlPos != m_dormancy.brake_position )
+     || ( mover->LocalBrakePosA != m_dormancy.local_brake_position )
+     || ( mover->ManualBrakePos != m_dormancy.manual_brake_position )
+     || ( mover->BrakeDelayFlag != m_dormancy.brake_delay ) ) {
+        return true;
+    }
+    // (de)coupling
+    for( int side = end::front; side <= end::rear; ++side ) {
+        if( ( mover->Couplers[ side ].CouplingFlag != m_dormancy.coupling_flags[ side ] )
+         || ( mover->Couplers[ side ].Connected != m_dormancy.coupled[ side ] ) ) {
+            return true;
+        }
+    }
+    return false;
 }
 
 // McZapkie-040402: liczenie pozycji uwzgledniajac wysokosc szyn itp.
@@ -3902,7 +4154,7 @@ void TDynamicObject::RenderSounds() {
     if( MoverParameters->ConverterFlag ) {
         frequency = (
             MoverParameters->EngineType == TEngineType::ElectricSeriesMotor ?
-            ( MoverParameters->RunningTraction.TractionVoltage / MoverParameters->NominalVoltage ) * MoverParameters->RList[ MoverParameters->RlistSize ].Mn :
+            ( MoverParameters->RunningTraction.TractionVoltage / MoverParameters->NominalVoltage ) * MoverParameters->Tables->RList[ MoverParameters->RlistSize ].Mn :
             1.0 );
         frequency = sConverter.m_frequencyoffset + sConverter.m_frequencyfactor * frequency;
         sConverter
@@ -5950,6 +6202,26 @@ TDynamicObject::LoadMMediaFile_mdload( std::string const &Name ) const {
     return loadmodel;
 }
 
+// queues loading of the load model on a worker thread. returns: handle of the model, or null_handle if it can't be found
+model_handle
+TDynamicObject::LoadMMediaFile_mdload_request( std::string const &Name ) const {
+
+    if( Name.empty() ) { return null_handle; }
+
+    // try first specialized version of the load model, vehiclename_loadname
+    model_handle loadmodel { null_handle };
+    auto const specializedloadfilename { asBaseDir + MoverParameters->TypeName + "_" + Name };
+    if( ( true == FileExists( specializedloadfilename + ".e3d" ) )
+     || ( true == FileExists( specializedloadfilename + ".t3d" ) ) ) {
+        loadmodel = TModelsManager::RequestModel( specializedloadfilename, true );
+    }
+    if( loadmodel == null_handle ) {
+        // if this fails, try generic load model
+        loadmodel = TModelsManager::RequestModel( asBaseDir + Name, true );
+    }
+    return loadmodel;
+}
+
 //---------------------------------------------------------------------------
 void TDynamicObject::RadioStop()
 { // zatrzymanie pojazdu
@@ -6497,13 +6769,13 @@ TDynamicObject::update_shake( double const Timedelta ) {
 
         auto shake { 1.25 * ShakeSpring.ComputateForces( shakevector, ShakeState.offset ) };
 
-        if( Random( iVel ) > 25.0 ) {
+        if( LocalRandom( iVel ) > 25.0 ) {
             // extra shake at increased velocity
             shake += ShakeSpring.ComputateForces(
                 Math3D::vector3(
-                ( Random( iVel * 2 ) - iVel ) / ( ( iVel * 2 ) * 4 ) * BaseShake.jolt_scale.x,
-                ( Random( iVel * 2 ) - iVel ) / ( ( iVel * 2 ) * 4 ) * BaseShake.jolt_scale.y,
-                ( Random( iVel * 2 ) - iVel ) / ( ( iVel * 2 ) * 4 ) * BaseShake.jolt_scale.z )
+                ( LocalRandom( iVel * 2 ) - iVel ) / ( ( iVel * 2 ) * 4 ) * BaseShake.jolt_scale.x,
+                ( LocalRandom( iVel * 2 ) - iVel ) / ( ( iVel * 2 ) * 4 ) * BaseShake.jolt_scale.y,
+                ( LocalRandom( iVel * 2 ) - iVel ) / ( ( iVel * 2 ) * 4 ) * BaseShake.jolt_scale.z )
 //                * (( 200 - DynamicObject->MyTrack->iQualityFlag ) * 0.0075 ) // scale to 75-150% based on track quality
                 * 1.25,
                 ShakeState.offset );
@@ -6631,7 +6903,7 @@ TDynamicObject::powertrain_sounds::render( TMoverParameters const &Vehicle, doub
                         engine.m_amplitudeoffset
                         + engine.m_amplitudefactor * (
                             0.25 * ( Vehicle.EnginePower / Vehicle.Power )
-                          + 0.75 * ( Vehicle.enrot * 60 ) / ( Vehicle.DElist[ Vehicle.MainCtrlPosNo ].RPM ) );
+                          + 0.75 * ( Vehicle.enrot * 60 ) / ( Vehicle.Tables->DElist[ Vehicle.MainCtrlPosNo ].RPM ) );
                     break;
                 }
                 case TEngineType::DieselEngine: {
@@ -6663,7 +6935,7 @@ TDynamicObject::powertrain_sounds::render( TMoverParameters const &Vehicle, doub
                         auto const revolutionsdifference { revolutionsperminute - engine_revs_last };
                         auto const idlerevolutionsthreshold { 1.01 * (
                             Vehicle.EngineType == TEngineType::DieselElectric ?
-                                Vehicle.DElist[ 0 ].RPM :
+                                Vehicle.Tables->DElist[ 0 ].RPM :
                                 Vehicle.dizel_nmin * 60 ) };
 
                         engine_revs_change = std::max( 0.0, engine_revs_change - 2.5 * Deltatime );
@@ -6814,7 +7086,7 @@ TDynamicObject::powertrain_sounds::render( TMoverParameters const &Vehicle, doub
                 if( ( volume < 1.0 )
                  && ( Vehicle.EnginePower < 100 ) ) {
 
-                    auto const volumevariation { Random( 100 ) * Vehicle.enrot / ( 1 + Vehicle.nmax ) };
+                    auto const volumevariation { LocalRandom( 100 ) * Vehicle.enrot / ( 1 + Vehicle.nmax ) };
                     if( volumevariation < 2 ) {
                         volume += volumevariation / 200;
                     }
@@ -6993,6 +7265,15 @@ TDynamicObject::powertrain_sounds::render( TMoverParameters const &Vehicle, doub
 }
 
 
+// adds provided vehicle to the collection. returns: true if there's no duplicate with the same name, false otherwise
+bool
+vehicle_table::insert( TDynamicObject *Vehicle ) {
+
+    m_movers[ Vehicle->MoverParameters ] = Vehicle;
+
+    return basic_table<TDynamicObject>::insert( Vehicle );
+}
+
 // legacy method, calculates changes in simulation state over specified time
 void
 vehicle_table::update( double Deltatime, int Iterationcount ) {
@@ -7000,39 +7281,783 @@ vehicle_table::update( double Deltatime, int Iterationcount ) {
     //    na którą by się zapisywały wszystkie pojazdy będące w ruchu
     //    pojazdy stojące nie potrzebują aktualizacji, chyba że np. ktoś im zmieni nastawę hamulca
     //    oddzielną listę można by zrobić na pojazdy z napędem, najlepiej posortowaną wg typu napędu
+    // NOTE: stationary vehicles nobody interacts with are put to sleep, and skipped until something disturbs them
+    update_wakeups();
+    // AI consists far from players are moved by simplified model, outside of the regular update
+    update_reductions( Deltatime * Iterationcount );
+
+    m_active.clear();
     for( auto *vehicle : m_items ) {
-        if( false == vehicle->bEnabled ) { continue; }
+        if( ( true == vehicle->bEnabled )
+         && ( false == vehicle->is_dormant() )
+         && ( false == vehicle->is_reduced() ) ) {
+            m_active.emplace_back( vehicle );
+        }
+    }
+
+    for( auto *vehicle : m_active ) {
         // Ra: zmienić warunek na sprawdzanie pantografów w jednej zmiennej: czy pantografy i czy podniesione
         if( vehicle->MoverParameters->EnginePowerSource.SourceType == TPowerSource::CurrentCollector ) {
             update_traction( vehicle );
         }
         vehicle->MoverParameters->ComputeConstans();
         vehicle->CoupleDist();
+        vehicle->MoverParameters->PipeFlowDeferred = Global.BrakePipeSolver;
+    }
+
+    auto const totaltime { Deltatime * Iterationcount }; // całkowity czas
+
+    auto threadcount { Global.PhysicsThreads };
+    if( ( threadcount == 0 )
+     && ( Global.fTimeSpeed > 1.0 ) ) {
+        // accelerated time multiplies physics workload, so spare cores are put to work even if not requested
+        threadcount = static_cast<int>( std::thread::hardware_concurrency() ) - 1;
     }
+    m_workers.resize( static_cast<std::size_t>( std::max( 0, threadcount ) ) );
+
+    auto const isadaptive { ( true == Global.AdaptiveStep ) && ( Deltatime > 0.0 ) };
+    if( true == isadaptive ) {
+        // each consist is advanced in steps of its own length, short enough for its couplers and long enough not to waste time
+        update_adaptive( Deltatime, Iterationcount );
+    }
+    else if( m_workers.size() > 0 ) {
+        // force and fast movement calculations for separate consists are independent and can be done concurrently
+        update_parallel( Deltatime, Iterationcount );
+    }
+    else {
+        // NOTE: each vehicle draws random values from its own sequence, so the results match the parallel update
+        if( Iterationcount > 1 ) {
+            // ABu: ponizsze wykonujemy tylko jesli wiecej niz jedna iteracja
+            for( int iteration = 0; iteration < ( Iterationcount - 1 ); ++iteration ) {
+                for( auto *vehicle : m_active ) {
+                    random_scope const random { vehicle->random_engine() };
+                    vehicle->UpdateForce( Deltatime, Deltatime, false );
+                }
+                for( auto *vehicle : m_active ) {
+                    random_scope const random { vehicle->random_engine() };
+                    vehicle->FastUpdate( Deltatime );
+                }
+                update_pipes( Deltatime );
+            }
+        }
+        for( auto *vehicle : m_active ) {
+            random_scope const random { vehicle->random_engine() };
+            vehicle->UpdateForce( Deltatime, totaltime, true );
+        }
+    }
+
+    for( auto *vehicle : m_active ) {
+        // Ra 2015-01: tylko tu przelicza sieć trakcyjną
+        if( true == isadaptive ) {
+            auto const step { vehicle->substep().step };
+            vehicle->Update( step, totaltime );
+            vehicle->update_substep( step );
+        }
+        else {
+            vehicle->Update( Deltatime, totaltime );
+        }
+    }
+    update_pipes( Deltatime );
+    if( true == isadaptive ) {
+        update_substeps( totaltime );
+    }
+
+    update_reduced( Deltatime, Iterationcount );
+
+    update_sleeps( totaltime );
+
+    // jeśli jest coś do usunięcia z listy, to trzeba na końcu
+    erase_disabled();
+}
+
+// completes brake pipe updates of active vehicles, left for the consist-level solver
+void
+vehicle_table::update_pipes( double const Deltatime ) {
+
+    if( false == Global.BrakePipeSolver ) { return; }
+
+    if( ( true == Global.AdaptiveStep )
+     && ( Deltatime > 0.0 ) ) {
+        // vehicle groups can use steps of different length, so each is solved on its own
+        for( std::size_t partition = 0; partition < m_partitions.size(); ++partition ) {
+            auto &solver { m_pipesolvers[ partition ] };
+            for( auto const idx : m_partitions[ partition ] ) {
+                solver.insert( *( m_active[ idx ]->MoverParameters ) );
+            }
+            solver.solve( m_substeps[ partition ].step );
+        }
+        return;
+    }
+
+    if( m_pipesolvers.empty() ) {
+        m_pipesolvers.resize( 1 );
+    }
+    auto &solver { m_pipesolvers.front() };
+    for( auto *vehicle : m_active ) {
+        solver.insert( *( vehicle->MoverParameters ) );
+    }
+    solver.solve( Deltatime );
+}
+
+// calculates force and fast movement updates with vehicle groups processed on worker threads
+void
+vehicle_table::update_parallel( double const Deltatime, int const Iterationcount ) {
+
+    update_partitions();
+    if( m_pipesolvers.size() < m_partitions.size() ) {
+        m_pipesolvers.resize( m_partitions.size() );
+    }
+
+    auto const totaltime { Deltatime * Iterationcount };
+
     if( Iterationcount > 1 ) {
-        // ABu: ponizsze wykonujemy tylko jesli wiecej niz jedna iteracja
         for( int iteration = 0; iteration < ( Iterationcount - 1 ); ++iteration ) {
-            for( auto *vehicle : m_items ) {
-                vehicle->UpdateForce( Deltatime, Deltatime, false );
+            // vehicles within a group are updated in the same order as in the serial update,
+            // and couplers don't cross the groups, so the only barrier needed is at the end of each iteration
+            m_workers.run(
+                m_partitions.size(),
+                [&]( std::size_t const Partition ) {
+                    auto const &partition { m_partitions[ Partition ] };
+                    for( auto const idx : partition ) {
+                        auto *vehicle { m_active[ idx ] };
+                        random_scope const random { vehicle->random_engine() };
+                        vehicle->UpdateForce( Deltatime, Deltatime, false );
+                    }
+                    for( auto const idx : partition ) {
+                        auto *vehicle { m_active[ idx ] };
+                        random_scope const random { vehicle->random_engine() };
+                        m_loadupdates[ idx ] = vehicle->FastMovementUpdate( Deltatime );
+                    }
+                    if( true == Global.BrakePipeSolver ) {
+                        auto &solver { m_pipesolvers[ Partition ] };
+                        for( auto const idx : partition ) {
+                            solver.insert( *( m_active[ idx ]->MoverParameters ) );
+                        }
+                        solver.solve( Deltatime );
+                    }
+                } );
+            // load changes can load models and such, so they're done on the main thread, in regular update order
+            // NOTE: these only affect state of the vehicle itself, so delaying them past physics of other vehicles is safe
+            for( std::size_t idx = 0; idx < m_active.size(); ++idx ) {
+                if( m_loadupdates[ idx ] == 0 ) { continue; }
+                auto *vehicle { m_active[ idx ] };
+                random_scope const random { vehicle->random_engine() };
+                vehicle->FastLoadUpdate( Deltatime );
             }
-            for( auto *vehicle : m_items ) {
-                vehicle->FastUpdate( Deltatime );
+        }
+    }
+
+    m_workers.run(
+        m_partitions.size(),
+        [&]( std::size_t const Partition ) {
+            for( auto const idx : m_partitions[ Partition ] ) {
+                auto *vehicle { m_active[ idx ] };
+                random_scope const random { vehicle->random_engine() };
+                vehicle->UpdateForce( Deltatime, totaltime, true );
             }
+        } );
+}
+
+// calculates force and fast movement updates with each vehicle group advanced in steps of its own length
+void
+vehicle_table::update_adaptive( double const Deltatime, int const Iterationcount ) {
+
+    update_partitions();
+    if( m_pipesolvers.size() < m_partitions.size() ) {
+        m_pipesolvers.resize( m_partitions.size() );
+    }
+    plan_substeps( Deltatime, Iterationcount );
+
+    auto const totaltime { Deltatime * Iterationcount };
+    // without worker threads the load changes can be done right away, as in the regular serial update
+    auto const isserial { m_workers.size() == 0 };
+
+    // groups finish their steps at different times, so there's no barrier between the steps
+    m_workers.run(
+        m_partitions.size(),
+        [&]( std::size_t const Partition ) {
+            auto const &partition { m_partitions[ Partition ] };
+            auto const step { m_substeps[ Partition ].step };
+            for( int iteration = 0; iteration < ( m_substeps[ Partition ].count - 1 ); ++iteration ) {
+                for( auto const idx : partition ) {
+                    auto *vehicle { m_active[ idx ] };
+                    random_scope const random { vehicle->random_engine() };
+                    vehicle->UpdateForce( step, step, false );
+                }
+                for( auto const idx : partition ) {
+                    auto *vehicle { m_active[ idx ] };
+                    random_scope const random { vehicle->random_engine() };
+                    if( true == isserial ) {
+                        vehicle->FastUpdate( step );
+                    }
+                    else if( true == vehicle->FastMovementUpdate( step ) ) {
+                        ++m_loadupdates[ idx ];
+                    }
+                    vehicle->update_substep( step );
+                }
+                if( true == Global.BrakePipeSolver ) {
+                    auto &solver { m_pipesolvers[ Partition ] };
+                    for( auto const idx : partition ) {
+                        solver.insert( *( m_active[ idx ]->MoverParameters ) );
+                    }
+                    solver.solve( step );
+                }
+            }
+            for( auto const idx : partition ) {
+                auto *vehicle { m_active[ idx ] };
+                random_scope const random { vehicle->random_engine() };
+                vehicle->UpdateForce( step, totaltime, true );
+            }
+        } );
+    // load changes can load models and such, so they're done on the main thread, in regular update order
+    for( std::size_t idx = 0; idx < m_active.size(); ++idx ) {
+        auto *vehicle { m_active[ idx ] };
+        for( ; m_loadupdates[ idx ] > 0; --m_loadupdates[ idx ] ) {
+            random_scope const random { vehicle->random_engine() };
+            vehicle->FastLoadUpdate( vehicle->substep().step );
         }
     }
+}
 
-    auto const totaltime { Deltatime * Iterationcount }; // całkowity czas
+// picks length of physics steps for each vehicle group
+void
+vehicle_table::plan_substeps( double const Deltatime, int const Iterationcount ) {
+
+    auto const totaltime { Deltatime * Iterationcount };
+
+    m_substeps.resize( m_partitions.size() );
+    m_substepsummary = {};
+    for( std::size_t partition = 0; partition < m_partitions.size(); ++partition ) {
+        auto proposal { adaptivestep::maxstep * Deltatime };
+        auto rate { 0.0 };
+        auto issteady { true };
+        for( auto const idx : m_partitions[ partition ] ) {
+            auto const *vehicle { m_active[ idx ] };
+            auto const &control { vehicle->substep() };
+            auto const *mover { vehicle->MoverParameters };
+            if( control.proposal > 0.0 ) {
+                proposal = std::min( proposal, control.proposal );
+            }
+            // buffers touching within two updates are included, as the step can't be changed in the middle of the update
+            rate = std::max( rate, vehicle->substep_rate( 2.0 * totaltime ) );
+            issteady = (
+                issteady
+             && ( control.pipe_flow < adaptivestep::pipeflow )
+             && ( false == mover->Couplers[ end::front ].CheckCollision )
+             && ( false == mover->Couplers[ end::rear ].CheckCollision ) );
+        }
+        auto step { proposal };
+        if( false == issteady ) {
+            // collisions and brake pipe transients were only ever calculated with the fixed step, so they don't get longer ones
+            step = std::min( step, Deltatime );
+        }
+        if( rate > 0.0 ) {
+            step = std::min( step, adaptivestep::stability / rate );
+        }
+        step = std::max( step, adaptivestep::minstep * Deltatime );
+        // the update time is split into equal steps, no longer than picked. small margin keeps rounding errors from adding a step
+        auto const count { std::max( 1, static_cast<int>( std::ceil( totaltime / step - 0.001 ) ) ) };
+        auto &plan { m_substeps[ partition ] };
+        plan.count = count;
+        plan.step = totaltime / count;
+
+        for( auto const idx : m_partitions[ partition ] ) {
+            auto &control { m_active[ idx ]->substep() };
+            control.step = plan.step;
+            control.rate = rate;
+            control.error = 0.0;
+        }
+
+        auto const vehiclecount { m_partitions[ partition ].size() };
+        m_substepsummary.steps += vehiclecount * count;
+        m_substepsummary.fixed_steps += vehiclecount * Iterationcount;
+        if( count > Iterationcount ) { ++m_substepsummary.refined; }
+        if( count < Iterationcount ) { ++m_substepsummary.coarsened; }
+        m_substepsummary.stiffness = std::max( m_substepsummary.stiffness, rate * plan.step );
+    }
+}
 
-    for( auto *vehicle : m_items ) {
-        vehicle->UpdateForce( Deltatime, totaltime, true );
+// updates step length suggestions of vehicle groups, from errors estimated during the last update
+void
+vehicle_table::update_substeps( double const Totaltime ) {
+
+    for( std::size_t partition = 0; partition < m_partitions.size(); ++partition ) {
+        auto error { 0.0 };
+        for( auto const idx : m_partitions[ partition ] ) {
+            error = std::max( error, m_active[ idx ]->substep().error );
+        }
+        // the local error grows with cube of the step length
+        auto const factor { (
+            error > 0.0 ?
+                clamp( adaptivestep::safety * std::cbrt( 1.0 / error ), adaptivestep::shrink, adaptivestep::grow ) :
+                adaptivestep::grow ) };
+        auto const proposal { m_substeps[ partition ].step * factor };
+
+        for( auto const idx : m_partitions[ partition ] ) {
+            auto const *mover { m_active[ idx ]->MoverParameters };
+            auto &control { m_active[ idx ]->substep() };
+            control.proposal = proposal;
+            control.pipe_flow = std::abs( mover->PipePress - control.pipe_pressure ) / Totaltime;
+            control.pipe_pressure = mover->PipePress;
+        }
+        m_substepsummary.error = std::max( m_substepsummary.error, error );
+    }
+}
+
+// groups enabled, awake vehicles into sets with no coupler links between them
+void
+vehicle_table::update_partitions() {
+
+    m_loadupdates.assign( m_active.size(), 0 );
+    // union-find over coupler links, both real and virtual (collision) ones
+    std::unordered_map<TMoverParameters const *, std::size_t> indices;
+    indices.reserve( m_active.size() );
+    for( std::size_t idx = 0; idx < m_active.size(); ++idx ) {
+        indices.emplace( m_active[ idx ]->MoverParameters, idx );
+    }
+    std::vector<std::size_t> parents( m_active.size() );
+    std::iota( std::begin( parents ), std::end( parents ), 0 );
+    auto const root = [&]( std::size_t Index ) {
+        while( parents[ Index ] != Index ) {
+            parents[ Index ] = parents[ parents[ Index ] ];
+            Index = parents[ Index ];
+        }
+        return Index; };
+    auto const join = [&]( std::size_t const Index, TMoverParameters const *Other ) {
+        if( Other == nullptr ) { return; }
+        auto const lookup { indices.find( Other ) };
+        if( lookup == indices.end() ) { return; }
+        auto const left { root( Index ) };
+        auto const right { root( lookup->second ) };
+        // keep the lower index as the root, so the group ids follow the update order
+        if( left < right ) { parents[ right ] = left; }
+        else               { parents[ left ] = right; } };
+
+    for( std::size_t idx = 0; idx < m_active.size(); ++idx ) {
+        auto const *vehicle { m_active[ idx ] };
+        for( auto const &coupler : vehicle->MoverParameters->Couplers ) {
+            join( idx, coupler.Connected );
+        }
+        if( vehicle->PrevConnected != nullptr ) { join( idx, vehicle->PrevConnected->MoverParameters ); }
+        if( vehicle->NextConnected != nullptr ) { join( idx, vehicle->NextConnected->MoverParameters ); }
+    }
+    // collect the groups. visiting the vehicles in order keeps each group sorted in the update order
+    m_partitions.clear();
+    std::vector<std::size_t> partitionindices( m_active.size(), std::numeric_limits<std::size_t>::max() );
+    for( std::size_t idx = 0; idx < m_active.size(); ++idx ) {
+        auto const groupid { root( idx ) };
+        if( partitionindices[ groupid ] == std::numeric_limits<std::size_t>::max() ) {
+            partitionindices[ groupid ] = m_partitions.size();
+            m_partitions.emplace_back();
+        }
+        m_partitions[ partitionindices[ groupid ] ].emplace_back( idx );
+    }
+}
+
+// brings back into the physics update dormant vehicles which were disturbed, or linked with active vehicles
+void
+vehicle_table::update_wakeups() {
+
+    if( m_dormantcount == 0 ) { return; }
+
+    if( false == Global.PhysicsDormancy ) {
+        for( auto *vehicle : m_items ) {
+            vehicle->wake();
+        }
+        m_dormantcount = 0;
+        return;
     }
+
     for( auto *vehicle : m_items ) {
-        // Ra 2015-01: tylko tu przelicza sieć trakcyjną
-        vehicle->Update( Deltatime, totaltime );
+        if( false == vehicle->bEnabled ) { continue; }
+        if( true == vehicle->is_dormant() ) {
+            if( true == vehicle->is_disturbed() ) {
+                wake( vehicle );
+            }
+        }
+        else {
+            // active vehicles can push, pull or brake anything linked with them
+            for( auto const &coupler : vehicle->MoverParameters->Couplers ) {
+                auto *linked { owner( coupler.Connected ) };
+                if( ( linked != nullptr ) && ( true == linked->is_dormant() ) ) {
+                    wake( linked );
+                }
+            }
+        }
     }
+}
 
-    // jeśli jest coś do usunięcia z listy, to trzeba na końcu
-    erase_disabled();
+// puts to sleep groups of vehicles which stayed quiet long enough
+void
+vehicle_table::update_sleeps( double const Deltatime ) {
+
+    if( false == Global.PhysicsDormancy ) { return; }
+
+    std::vector<char> quietvehicles( m_active.size(), 0 );
+    auto cansleep { false };
+    for( std::size_t idx = 0; idx < m_active.size(); ++idx ) {
+        // NOTE: all vehicles have to be checked, to keep their quiet time up to date
+        quietvehicles[ idx ] = m_active[ idx ]->update_dormancy( Deltatime );
+        cansleep |= ( quietvehicles[ idx ] != 0 );
+    }
+
+    if( true == cansleep ) {
+        // vehicles go to sleep only as whole groups, as a sleeping vehicle wouldn't react to its active neighbours
+        // NOTE: the groups are rebuilt as the vehicle update could (de)couple some vehicles
+        update_partitions();
+        for( auto const &partition : m_partitions ) {
+            auto const isquiet {
+                std::all_of(
+                    std::begin( partition ), std::end( partition ),
+                    [&]( std::size_t const Index ) {
+                        return ( quietvehicles[ Index ] != 0 ); } ) };
+            if( false == isquiet ) { continue; }
+            for( auto const idx : partition ) {
+                m_active[ idx ]->sleep();
+            }
+        }
+    }
+
+    m_dormantcount = std::count_if(
+        std::begin( m_items ), std::end( m_items ),
+        []( TDynamicObject const *Vehicle ) {
+            return ( ( true == Vehicle->bEnabled ) && ( true == Vehicle->is_dormant() ) ); } );
+}
+
+// wakes up specified vehicle along with all vehicles linked with it
+void
+vehicle_table::wake( TDynamicObject const *Vehicle ) {
+
+    if( ( Vehicle == nullptr )
+     || ( false == Vehicle->is_dormant() ) ) {
+        return;
+    }
+    // callers can only have read access to the vehicle, so the modifiable one is retrieved from the table
+    auto *target { owner( Vehicle->MoverParameters ) };
+    if( target == nullptr ) { return; }
+
+    std::vector<TDynamicObject *> pending { target };
+    while( false == pending.empty() ) {
+        auto *vehicle { pending.back() };
+        pending.pop_back();
+        if( false == vehicle->is_dormant() ) { continue; }
+        vehicle->wake();
+        for( auto const &coupler : vehicle->MoverParameters->Couplers ) {
+            auto *linked { owner( coupler.Connected ) };
+            if( ( linked != nullptr ) && ( true == linked->is_dormant() ) ) {
+                pending.emplace_back( linked );
+            }
+        }
+        if( vehicle->PrevConnected != nullptr ) { pending.emplace_back( vehicle->PrevConnected ); }
+        if( vehicle->NextConnected != nullptr ) { pending.emplace_back( vehicle->NextConnected ); }
+    }
+}
+
+// brings back to full physics consists which no longer qualify for the reduced one, and moves there these which do
+void
+vehicle_table::update_reductions( double const Deltatime ) {
+
+    if( Global.PhysicsLodRange <= 0.0 ) {
+        for( auto &consist : m_reduced ) {
+            restore( consist );
+        }
+        m_reduced.clear();
+        m_reductioncandidates.clear();
+        m_reducedcount = 0;
+        return;
+    }
+    // players are drivers of manned vehicles, and the observer
+    // NOTE: camera moves with the frame time, so in lockstep mode it's left out to keep the runs repeatable
+    std::vector<glm::dvec3> players;
+    if( false == Global.Lockstep ) {
+        players.emplace_back( glm::dvec3{ Global.pCamera.Pos } );
+    }
+    for( auto const *vehicle : m_items ) {
+        if( ( true == vehicle->bEnabled )
+         && ( ( true == vehicle->MechInside )
+           || ( ( vehicle->Mechanik != nullptr ) && ( false == vehicle->Mechanik->AIControllFlag ) ) ) ) {
+            players.emplace_back( glm::dvec3{ vehicle->GetPosition() } );
+        }
+    }
+
+    m_reduced.erase(
+        std::remove_if(
+            std::begin( m_reduced ), std::end( m_reduced ),
+            [&]( reduced_consist &Consist ) {
+                if( true == is_reducible( Consist, players, Global.PhysicsLodRange ) ) {
+                    return false; }
+                restore( Consist );
+                return true; } ),
+        std::end( m_reduced ) );
+
+    // new candidates are checked once per second, and have to qualify for a while to avoid frequent switches
+    m_reductiontimer += Deltatime;
+    if( m_reductiontimer >= 1.0 ) {
+        std::unordered_map<TController const *, double> candidates;
+        for( auto *vehicle : m_items ) {
+            if( ( false == vehicle->bEnabled )
+             || ( true == vehicle->is_reduced() )
+             || ( vehicle->Mechanik == nullptr )
+             || ( false == vehicle->Mechanik->AIControllFlag )
+             || ( false == vehicle->Mechanik->Primary() ) ) {
+                continue;
+            }
+            reduced_consist consist;
+            collect_consist( vehicle, consist );
+            // wider range on the way in prevents flipping between modes at the border
+            if( false == is_reducible( consist, players, Global.PhysicsLodRange * 1.1 ) ) { continue; }
+            // the brakes are left released, as the simplified model doesn't track the brake system
+            auto const isbraking {
+                std::any_of(
+                    std::begin( consist.vehicles ), std::end( consist.vehicles ),
+                    []( TDynamicObject const *Vehicle ) {
+                        return ( Vehicle->MoverParameters->BrakePress > 0.05 ); } ) };
+            if( true == isbraking ) { continue; }
+
+            auto const lookup { m_reductioncandidates.find( consist.driver ) };
+            auto const qualifiedtime { m_reductiontimer + ( lookup != m_reductioncandidates.end() ? lookup->second : 0.0 ) };
+            if( qualifiedtime < 10.0 ) {
+                candidates.emplace( consist.driver, qualifiedtime );
+                continue;
+            }
+            reduce( consist );
+            m_reduced.emplace_back( std::move( consist ) );
+        }
+        m_reductioncandidates.swap( candidates );
+        m_reductiontimer = 0.0;
+    }
+
+    m_reducedcount = 0;
+    for( auto const &consist : m_reduced ) {
+        m_reducedcount += consist.vehicles.size();
+    }
+}
+
+// moves consists which use the reduced physics
+void
+vehicle_table::update_reduced( double const Deltatime, int const Iterationcount ) {
+
+    if( true == m_reduced.empty() ) { return; }
+
+    auto const curvevalue = []( std::vector<double> const &Curve, double const Velocity ) {
+        auto const position { std::abs( Velocity ) * 3.6 / 5.0 };
+        auto const idx { std::min( static_cast<std::size_t>( position ), Curve.size() - 1 ) };
+        return (
+            idx + 1 < Curve.size() ?
+                interpolate( Curve[ idx ], Curve[ idx + 1 ], position - idx ) :
+                Curve.back() ); };
+
+    auto const totaltime { Deltatime * Iterationcount };
+
+    m_reduced.erase(
+        std::remove_if(
+            std::begin( m_reduced ), std::end( m_reduced ),
+            [&]( reduced_consist &Consist ) {
+                auto const *controlling { Consist.vehicles[ Consist.controlling ]->MoverParameters };
+                auto const tractionratio { controlling->ReducedTractionRatio() * Consist.orientations[ Consist.controlling ] };
+                // brake application requested by the driver, reached with delay similar to that of the brake pipe
+                auto const *occupied { Consist.driver->Vehicle()->MoverParameters };
+                auto const releaseposition { occupied->Handle->GetPos( bh_RP ) };
+                auto const fullposition { occupied->Handle->GetPos( bh_FB ) };
+                auto const targetbrake { (
+                    occupied->fBrakeCtrlPos >= occupied->Handle->GetPos( bh_EB ) ? 1.0 :
+                    fullposition > releaseposition ? clamp( ( occupied->fBrakeCtrlPos - releaseposition ) / ( fullposition - releaseposition ), 0.0, 1.0 ) :
+                    0.0 ) };
+                // tangential component of gravity
+                auto gravity { 0.0 };
+                for( std::size_t idx = 0; idx < Consist.vehicles.size(); ++idx ) {
+                    auto const *vehicle { Consist.vehicles[ idx ] };
+                    gravity -= vehicle->MoverParameters->TotalMassxg * vehicle->VectorFront().y * Consist.orientations[ idx ];
+                }
+
+                auto velocity { Consist.velocity };
+                auto acceleration { 0.0 };
+                auto distance { 0.0 };
+                for( int iteration = 0; iteration < Iterationcount; ++iteration ) {
+                    Consist.brake = (
+                        targetbrake > Consist.brake ?
+                            std::min( targetbrake, Consist.brake + Deltatime / 4.0 ) :
+                            std::max( targetbrake, Consist.brake - Deltatime / 10.0 ) );
+                    auto const drive { tractionratio * curvevalue( Consist.traction, velocity ) + gravity };
+                    auto const hold {
+                        Consist.resistance1 * velocity * velocity
+                        + ( std::abs( velocity ) > 0.01 ? Consist.resistance2d : Consist.resistance2s )
+                        + Consist.brake * curvevalue( Consist.braking, velocity ) };
+                    if( ( std::abs( velocity ) <= 0.01 )
+                     && ( std::abs( drive ) <= hold ) ) {
+                        // held in place
+                        velocity = 0.0;
+                        acceleration = 0.0;
+                        continue;
+                    }
+                    auto const direction { ( std::abs( velocity ) > 0.01 ? Sign( velocity ) : Sign( drive ) ) };
+                    acceleration = ( drive - direction * hold ) / Consist.mass;
+                    auto const previousvelocity { velocity };
+                    velocity += acceleration * Deltatime;
+                    if( ( velocity * previousvelocity < 0.0 )
+                     && ( std::abs( drive ) <= hold ) ) {
+                        // resistance and brakes can stop the train, but not push it back
+                        velocity = 0.0;
+                    }
+                    distance += 0.5 * ( velocity + previousvelocity ) * Deltatime;
+                }
+                Consist.velocity = velocity;
+
+                auto isenabled { true };
+                for( std::size_t idx = 0; idx < Consist.vehicles.size(); ++idx ) {
+                    auto *vehicle { Consist.vehicles[ idx ] };
+                    auto const orientation { Consist.orientations[ idx ] };
+                    vehicle->MoverParameters->ReducedMovement(
+                        totaltime,
+                        velocity * orientation,
+                        acceleration * orientation,
+                        Consist.brake * vehicle->MoverParameters->MaxBrakePress[ 0 ] );
+                    vehicle->Move( distance * orientation );
+                    if( vehicle->Mechanik != nullptr ) {
+                        vehicle->Mechanik->MoveDistanceAdd( distance * orientation );
+                        vehicle->Mechanik->UpdateSituation( totaltime ); // przebłyski świadomości AI
+                    }
+                    isenabled &= vehicle->bEnabled;
+                }
+                if( true == isenabled ) {
+                    return false;
+                }
+                // consist which left the scenery goes back to the regular update, which takes care of its removal
+                restore( Consist );
+                return true; } ),
+        std::end( m_reduced ) );
+}
+
+// collects vehicles coupled with specified vehicle into provided consist
+void
+vehicle_table::collect_consist( TDynamicObject *Vehicle, reduced_consist &Consist ) {
+
+    Consist.driver = Vehicle->Mechanik;
+    Consist.vehicles = { Vehicle };
+    Consist.orientations = { 1 };
+    Consist.links = 0;
+    for( std::size_t idx = 0; idx < Consist.vehicles.size(); ++idx ) {
+        auto const *mover { Consist.vehicles[ idx ]->MoverParameters };
+        for( int side = 0; side < 2; ++side ) {
+            auto const &coupler { mover->Couplers[ side ] };
+            if( coupler.CouplingFlag == coupling::faux ) { continue; }
+            ++Consist.links;
+            auto *linked { owner( coupler.Connected ) };
+            if( ( linked == nullptr )
+             || ( std::find( std::begin( Consist.vehicles ), std::end( Consist.vehicles ), linked ) != std::end( Consist.vehicles ) ) ) {
+                continue;
+            }
+            Consist.vehicles.emplace_back( linked );
+            // vehicles coupled with the same ends face opposite directions
+            Consist.orientations.emplace_back( Consist.orientations[ idx ] * ( coupler.ConnectedNr != side ? 1 : -1 ) );
+        }
+    }
+    auto const *controlling { Consist.driver->Controlling() };
+    for( std::size_t idx = 0; idx < Consist.vehicles.size(); ++idx ) {
+        if( Consist.vehicles[ idx ]->MoverParameters == controlling ) {
+            Consist.controlling = idx;
+        }
+    }
+}
+
+// returns: true if specified consist can be moved by the simplified model
+bool
+vehicle_table::is_reducible( reduced_consist const &Consist, std::vector<glm::dvec3> const &Players, double const Range ) const {
+
+    if( ( false == Consist.driver->AIControllFlag )
+     || ( true == Consist.driver->is_at_station() )
+     || ( Consist.vehicles[ Consist.controlling ]->MoverParameters != Consist.driver->Controlling() ) ) {
+        return false;
+    }
+    auto links { 0 };
+    for( auto const *vehicle : Consist.vehicles ) {
+        if( ( false == vehicle->bEnabled )
+         || ( true == vehicle->is_dormant() )
+         || ( true == vehicle->MechInside )
+         || ( vehicle->MyTrack == nullptr )
+         || ( true == TestFlag( vehicle->MoverParameters->DamageFlag, dtrain_out ) )
+         || ( ( vehicle->Mechanik != nullptr ) && ( false == vehicle->Mechanik->AIControllFlag ) ) ) {
+            return false;
+        }
+        auto const position { glm::dvec3{ vehicle->GetPosition() } };
+        for( auto const &player : Players ) {
+            if( glm::length2( position - player ) < Range * Range ) {
+                return false;
+            }
+        }
+        for( auto const &coupler : vehicle->MoverParameters->Couplers ) {
+            if( coupler.CouplingFlag != coupling::faux ) {
+                ++links;
+            }
+        }
+    }
+    // (de)coupling changes make-up of the consist
+    return ( links == Consist.links );
+}
+
+// switches specified consist to the reduced physics
+void
+vehicle_table::reduce( reduced_consist &Consist ) {
+
+    auto maxvelocity { 40.0 };
+    for( auto *vehicle : Consist.vehicles ) {
+        maxvelocity = std::max( maxvelocity, vehicle->MoverParameters->Vmax + 10.0 );
+    }
+    auto const curvesize { static_cast<std::size_t>( std::ceil( maxvelocity / 5.0 ) ) + 1 };
+    Consist.traction.assign( curvesize, 0.0 );
+    Consist.braking.assign( curvesize, 0.0 );
+    Consist.mass = 0.0;
+    Consist.resistance1 = 0.0;
+    Consist.resistance2s = 0.0;
+    Consist.resistance2d = 0.0;
+
+    for( auto *vehicle : Consist.vehicles ) {
+        auto *mover { vehicle->MoverParameters };
+        Consist.mass += mover->TotalMass + mover->Mred;
+        Consist.resistance1 += mover->FrictConst1;
+        Consist.resistance2s += mover->FrictConst2s;
+        Consist.resistance2d += mover->FrictConst2d;
+        for( std::size_t idx = 0; idx < curvesize; ++idx ) {
+            auto const velocity { 5.0 * idx };
+            Consist.traction[ idx ] += mover->ReducedTractionForce( velocity / 3.6 );
+            if( ( mover->BrakeSystem == TBrakeSystem::Pneumatic )
+             || ( mover->BrakeSystem == TBrakeSystem::ElectroPneumatic ) ) {
+                Consist.braking[ idx ] += mover->BrakeForceR( 1.0, velocity );
+            }
+        }
+        vehicle->reduced( true );
+    }
+    Consist.velocity = Consist.vehicles.front()->MoverParameters->V;
+    Consist.brake = 0.0;
+}
+
+// brings specified consist back to the full physics
+void
+vehicle_table::restore( reduced_consist &Consist ) {
+
+    for( auto *vehicle : Consist.vehicles ) {
+        vehicle->reduced( false );
+        if( Consist.brake < 0.01 ) { continue; }
+        // the brake system was left alone while braking was simulated, so the brake pipe is set to match the applied brakes
+        // and the distributors pick it up from there
+        auto *mover { vehicle->MoverParameters };
+        if( mover->Pipe != nullptr ) {
+            mover->Pipe->CreatePress( std::min( mover->PipePress, 0.5 - 0.15 * Consist.brake ) );
+        }
+    }
+}
+
+// returns vehicle owning specified physics object, or nullptr
+TDynamicObject *
+vehicle_table::owner( TMoverParameters const *Mover ) {
+
+    if( Mover == nullptr ) { return nullptr; }
+
+    auto const lookup { m_movers.find( Mover ) };
+    return (
+        lookup != m_movers.end() ?
+            lookup->second :
+            nullptr );
 }
 
 // legacy method, checks for presence and height of traction wire for specified vehicle
@@ -7191,6 +8216,8 @@ vehicle_table::erase_disabled() {
             }
             // remove potential entries in the light array
             simulation::Lights.remove( vehicle );
+            // the physics object can be released along with the vehicle, and its address reused by another one
+            m_movers.erase( vehicle->MoverParameters );
 /*
             // finally get rid of the vehicle and its record themselves
             // BUG: deleting the vehicle leaves dangling pointers in event->Activator and potentially elsewhere
@@ -15,10 +15,12 @@ http://mozilla.org/MPL/2.0/.
 #include "Classes.h"
 #include "material.h"
 #include "MOVER.h"
+#include "brakepipe.h"
 #include "TrkFoll.h"
 #include "Button.h"
 #include "AirCoupler.h"
 #include "Texture.h"
+#include "MdlMngr.h"
 #include "sound.h"
 #include "Spring.h"
 
@@ -196,6 +198,7 @@ public:
     // modele składowe pojazdu
     TModel3d *mdModel; // model pudła
     TModel3d *mdLoad; // model zmiennego ładunku
+    model_handle m_loadmodel { null_handle }; // load model requested during the simulation, until it's loaded
     TModel3d *mdKabina; // model kabiny dla użytkownika; McZapkie-030303: to z train.h
     TModel3d *mdLowPolyInt; // ABu 010305: wnetrze lowpoly
     std::array<TSubModel *, 3> LowPolyIntCabs {}; // pointers to low fidelity version of individual driver cabs
@@ -288,6 +291,19 @@ private:
         float time { 0.f }; // time spent on the operation
     };
 
+    struct dormancy_data {
+        bool dormant { false };
+        double quiet_time { 0.0 }; // time spent below activity thresholds
+        // state snapshot, used to detect changes
+        double pipe_pressure { 0.0 };
+        int brake_position { 0 };
+        double local_brake_position { 0.0 };
+        int manual_brake_position { 0 };
+        int brake_delay { 0 };
+        std::array<int, 2> coupling_flags { 0, 0 };
+        std::array<TMoverParameters const *, 2> coupled { nullptr, nullptr };
+    };
+
     struct coupler_sounds {
         sound_source dsbCouplerAttach { sound_placement::external }; // moved from cab
         sound_source dsbCouplerDetach { sound_placement::external }; // moved from cab
@@ -440,6 +456,9 @@ private:
     sound_source rscurve { sound_placement::external, EU07_SOUND_RUNNINGNOISECUTOFFRANGE }; // youBy
     sound_source rsDerailment { sound_placement::external, 250.f }; // McZapkie-051202
 
+    std::minstd_rand m_randomengine; // private random sequence, keeps the physics results independent of vehicle update order
+    dormancy_data m_dormancy;
+    bool m_reduced { false }; // vehicle is moved by simplified model of its consist
     exchange_data m_exchange; // state of active load exchange procedure, if any
     exchange_sounds m_exchangesounds; // sounds associated with the load exchange
 
@@ -461,6 +480,8 @@ private:
 
   private:
     TDynamicObject *ABuFindObject( int &Foundcoupler, double &Distance, TTrack const *Track, int const Direction, int const Mycoupler );
+    // checks whether specified vehicle found on the track ahead can collide with us. fills number of its coupler facing us
+    bool ABuCanCollide( TDynamicObject const *Vehicle, TTrack const *Track, int const Direction, int const Mycoupler, int &Foundcoupler ) const;
     void ABuCheckMyTrack();
 
   public:
@@ -481,6 +502,65 @@ private:
 
     int GetPneumatic(bool front, bool red);
     void SetPneumatic(bool front, bool red);
+    // source of random values used by physics calculations of the vehicle
+    std::minstd_rand &
+        random_engine() {
+            return m_randomengine; }
+    // physics sleep; dormant vehicles are left out of the physics update until something disturbs them
+    bool
+        is_dormant() const {
+            return m_dormancy.dormant; }
+    // updates tracking of vehicle activity. returns: true if the vehicle stayed quiet long enough to be put to sleep
+    bool
+        update_dormancy( double const Timedelta );
+    // returns: true if specified track has events triggered by vehicles standing on it
+    static
+    bool
+        has_standing_events( TTrack const *Track );
+    // takes the vehicle out of the physics update, recording state used to detect outside disturbances
+    void
+        sleep();
+    // brings the vehicle back into the physics update
+    void
+        wake();
+    // returns: true if state of the dormant vehicle was changed from outside
+    bool
+        is_disturbed() const;
+    // physics level of detail; vehicles of distant AI consists are moved by simplified consist model instead of the full physics
+    bool
+        is_reduced() const {
+            return m_reduced; }
+    void
+        reduced( bool const State ) {
+            m_reduced = State; }
+    // adaptive physics step; vehicles of a consist are advanced in steps of common length, picked from stability of coupler links and estimated error
+    struct substep_data {
+        double step { 0.0 }; // length of physics steps in the last update
+        double proposal { 0.0 }; // step length suggested for the next update; 0 = none
+        std::array<double, 2> accelerations { 0.0, 0.0 }; // tangential acceleration after two previous steps, latest first
+        int history { 0 }; // number of valid entries in the acceleration history
+        double error { 0.0 }; // highest ratio of estimated local velocity error to its tolerance, in the last update
+        double rate { 0.0 }; // highest rate of change of coupler links in the consist [1/s]
+        double pipe_pressure { 0.0 }; // brake pipe pressure at the end of the last update
+        double pipe_flow { 0.0 }; // brake pipe pressure change rate in the last update
+    };
+    substep_data &
+        substep() {
+            return m_substep; }
+    substep_data const &
+        substep() const {
+            return m_substep; }
+    // returns: estimate of the highest rate of change of coupler links of the vehicle [1/s], including buffers expected to touch within specified time
+    double
+        substep_rate( double const Lookahead ) const;
+    // records tangential acceleration after completed physics step of specified length, and updates estimate of the local error
+    void
+        update_substep( double const Timestep );
+
+  private:
+    substep_data m_substep;
+
+  public:
     std::string asName;
     std::string name() const {
         return this ?
@@ -536,6 +616,11 @@ private:
     void shuffle_load_sections();
     bool Update(double dt, double dt1);
     bool FastUpdate(double dt);
+    // fast physics step, limited to the vehicle and vehicles linked with it by couplers
+    // returns: true if the accompanying load update should be performed
+    bool FastMovementUpdate( double dt );
+    // load change part of the fast update; can touch shared resources, so it's done separately from the physics step
+    void FastLoadUpdate( double dt );
     void Move(double fDistance);
     void FastMove(double fDistance);
     void RenderSounds();
@@ -592,6 +677,8 @@ private:
     // McZapkie-260202
     void LoadMMediaFile(std::string const &TypeName, std::string const &ReplacableSkin);
     TModel3d *LoadMMediaFile_mdload( std::string const &Name ) const;
+    // queues loading of the load model on a worker thread. returns: handle of the model, or null_handle if it can't be found
+    model_handle LoadMMediaFile_mdload_request( std::string const &Name ) const;
 
     inline double ABuGetDirection() const { // ABu.
         return (Axle1.GetTrack() == MyTrack ? Axle1.GetDirection() : Axle0.GetDirection()); };
@@ -684,6 +771,20 @@ public:
 class vehicle_table : public basic_table<TDynamicObject> {
 
 public:
+// types
+    // summary of the last adaptive physics update
+    struct substep_summary {
+        std::size_t steps { 0 }; // physics steps made by active vehicles
+        std::size_t fixed_steps { 0 }; // physics steps the active vehicles would make with the fixed step length
+        std::size_t refined { 0 }; // consists advanced in steps shorter than the fixed one
+        std::size_t coarsened { 0 }; // consists advanced in steps longer than the fixed one
+        double error { 0.0 }; // highest ratio of estimated local velocity error to its tolerance
+        double stiffness { 0.0 }; // highest product of step length and rate of change of coupler links
+    };
+// methods
+    // adds provided vehicle to the collection. returns: true if there's no duplicate with the same name, false otherwise
+    bool
+        insert( TDynamicObject *Vehicle );
     // legacy method, calculates changes in simulation state over specified time
     void
         update( double dt, int iter );
@@ -693,11 +794,114 @@ public:
     // legacy method, sends list of vehicles over network
     void
         DynamicList( bool const Onlycontrolled = false ) const;
+    // returns number of vehicles processed by the last physics update
+    std::size_t
+        active_count() const {
+            return m_active.size(); }
+    // returns number of vehicles taken out of the physics update
+    std::size_t
+        dormant_count() const {
+            return m_dormantcount; }
+    // returns number of vehicles moved by simplified physics
+    std::size_t
+        reduced_count() const {
+            return m_reducedcount; }
+    // wakes up specified vehicle along with all vehicles linked with it
+    void
+        wake( TDynamicObject const *Vehicle );
+    // returns summary of the last adaptive physics update
+    substep_summary const &
+        substeps() const {
+            return m_substepsummary; }
 
 private:
+// types
+    using partition_sequence = std::vector< std::vector<std::size_t> >;
+    // physics steps of a partition in the adaptive update
+    struct substep_plan {
+        double step { 0.0 };
+        int count { 0 };
+    };
+    // distant AI consist, moved as a single point mass
+    // forces are derived at the switch from characteristics of the full model, and scaled by the current control settings
+    struct reduced_consist {
+        std::vector<TDynamicObject *> vehicles; // in coupling order
+        std::vector<int> orientations; // direction of each vehicle relative to the first one
+        TController *driver { nullptr };
+        std::size_t controlling { 0 }; // index of the vehicle which sets traction of the consist
+        int links { 0 }; // number of coupled ends, used to detect (de)coupling
+        double mass { 0.0 }; // including rotating masses
+        double resistance1 { 0.0 }; // velocity-dependent part of running resistance
+        double resistance2s { 0.0 }; // constant part of running resistance at standstill
+        double resistance2d { 0.0 }; // constant part of running resistance in motion
+        std::vector<double> traction; // tractive effort at full power, in steps of 5 km/h
+        std::vector<double> braking; // brake force at full service application, in steps of 5 km/h
+        double velocity { 0.0 }; // in direction of the first vehicle
+        double brake { 0.0 }; // current brake application, 0-1
+    };
+// methods
+    // calculates force and fast movement updates with vehicle groups processed on worker threads
+    void
+        update_parallel( double const Deltatime, int const Iterationcount );
+    // calculates force and fast movement updates with each vehicle group advanced in steps of its own length
+    void
+        update_adaptive( double const Deltatime, int const Iterationcount );
+    // picks length of physics steps for each vehicle group
+    void
+        plan_substeps( double const Deltatime, int const Iterationcount );
+    // updates step length suggestions of vehicle groups, from errors estimated during the last update
+    void
+        update_substeps( double const Totaltime );
+    // completes brake pipe updates of active vehicles, left for the consist-level solver
+    void
+        update_pipes( double const Deltatime );
+    // groups enabled, awake vehicles into sets with no coupler links between them
+    void
+        update_partitions();
+    // brings back into the physics update dormant vehicles which were disturbed, or linked with active vehicles
+    void
+        update_wakeups();
+    // puts to sleep groups of vehicles which stayed quiet long enough
+    void
+        update_sleeps( double const Deltatime );
+    // brings back to full physics consists which no longer qualify for the reduced one, and moves there these which do
+    void
+        update_reductions( double const Deltatime );
+    // moves consists which use the reduced physics
+    void
+        update_reduced( double const Deltatime, int const Iterationcount );
+    // collects vehicles coupled with specified vehicle into provided consist
+    void
+        collect_consist( TDynamicObject *Vehicle, reduced_consist &Consist );
+    // returns: true if specified consist can be moved by the simplified model
+    bool
+        is_reducible( reduced_consist const &Consist, std::vector<glm::dvec3> const &Players, double const Range ) const;
+    // switches specified consist to the reduced physics
+    void
+        reduce( reduced_consist &Consist );
+    // brings specified consist back to the full physics
+    void
+        restore( reduced_consist &Consist );
+    // returns vehicle owning specified physics object, or nullptr
+    TDynamicObject *
+        owner( TMoverParameters const *Mover );
     // maintenance; removes from tracks consists with vehicles marked as disabled
     bool
         erase_disabled();
+// members
+    std::vector<TDynamicObject *> m_active; // enabled vehicles, in update order
+    std::vector<int> m_loadupdates; // pending load updates for vehicles in the active list
+    partition_sequence m_partitions; // indices of active vehicles grouped into independent sets, each in update order
+    std::vector<brake_pipe_solver> m_pipesolvers; // consist-level brake pipe updates, one for each partition
+    std::vector<substep_plan> m_substeps; // physics steps of the adaptive update, one for each partition
+    substep_summary m_substepsummary;
+    std::unordered_map<TMoverParameters const *, TDynamicObject *> m_movers; // physics object to vehicle lookup
+    std::size_t m_dormantcount { 0 };
+    std::vector<reduced_consist> m_reduced; // consists moved by simplified physics
+    std::unordered_map<TController const *, double> m_reductioncandidates; // drivers of consists qualifying for the reduced physics, with time they qualified for
+    double m_reductiontimer { 0.0 };
+    std::size_t m_reducedcount { 0 };
+    threading::task_pool m_workers;
 };
 
 //---------------------------------------------------------------------------
@@ -22,7 +22,7 @@ Stele, firleju, szociu, hunter, ZiomalCl, OLI_EU and others
 #include "Logs.h"
 #include <cstdlib>
 
-#ifdef _MSC_VER 
+#if defined(_MSC_VER) && !defined(EU07_HEADLESS)
 #pragma comment(linker, "/subsystem:windows /ENTRY:mainCRTStartup") 
 #endif 
 
@@ -36,7 +36,7 @@ int main( int argc, char *argv[] )
             result = Application.run();
         }
         Application.exit();
-		std::_Exit(0); // skip destructors, there are ordering errors which causes segfaults
+		std::_Exit(result); // skip destructors, there are ordering errors which causes segfaults
         return result;
     }
     catch( std::bad_alloc const &Error )
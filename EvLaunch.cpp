@@ -25,6 +25,7 @@ http://mozilla.org/MPL/2.0/.
 #include "Console.h"
 #include "simulationtime.h"
 #include "utilities.h"
+#include "sn_utils.h"
 
 //---------------------------------------------------------------------------
 
@@ -205,6 +206,18 @@ bool TEventLauncher::IsGlobal() const {
           && ( dRadius < 0.0 ) ); // bez ograniczenia zasięgu
 }
 
+// minute of the day the launcher is activated at, or -1 if it's activated by other means
+int TEventLauncher::activation_minute() const {
+
+    if( ( DeltaTime != 0 )
+     || ( iKey != 0 )
+     || ( iHour < 0 ) || ( iHour > 23 )
+     || ( iMinute < 0 ) || ( iMinute > 59 ) ) {
+        return -1;
+    }
+    return iHour * 60 + iMinute;
+}
+
 // radius() subclass details, calculates node's bounding radius
 float
 TEventLauncher::radius_() {
@@ -216,13 +229,41 @@ TEventLauncher::radius_() {
 void
 TEventLauncher::serialize_( std::ostream &Output ) const {
 
-    // TODO: implement
+    // activation parameters
+    sn_utils::ls_float64( Output, dRadius );
+    sn_utils::ls_int32( Output, iKey );
+    sn_utils::ls_float64( Output, DeltaTime );
+    sn_utils::ls_int32( Output, iHour );
+    sn_utils::ls_int32( Output, iMinute );
+    // associated events
+    sn_utils::s_str( Output, asEvent1Name );
+    sn_utils::s_str( Output, asEvent2Name );
+    // activation condition
+    sn_utils::s_str( Output, asMemCellName );
+    sn_utils::s_str( Output, szText );
+    sn_utils::ls_float64( Output, fVal1 );
+    sn_utils::ls_float64( Output, fVal2 );
+    sn_utils::ls_int32( Output, iCheckMask );
 }
 // deserialize() subclass details, restores content of the subclass from provided stream
 void
 TEventLauncher::deserialize_( std::istream &Input ) {
 
-    // TODO: implement
+    // activation parameters
+    dRadius = sn_utils::ld_float64( Input );
+    iKey = sn_utils::ld_int32( Input );
+    DeltaTime = sn_utils::ld_float64( Input );
+    iHour = sn_utils::ld_int32( Input );
+    iMinute = sn_utils::ld_int32( Input );
+    // associated events
+    asEvent1Name = sn_utils::d_str( Input );
+    asEvent2Name = sn_utils::d_str( Input );
+    // activation condition
+    asMemCellName = sn_utils::d_str( Input );
+    szText = sn_utils::d_str( Input );
+    fVal1 = sn_utils::ld_float64( Input );
+    fVal2 = sn_utils::ld_float64( Input );
+    iCheckMask = sn_utils::ld_int32( Input );
 }
 
 // export() subclass details, sends basic content of the class in legacy (text) format to provided stream
@@ -28,6 +28,8 @@ public:
     // checks conditions associated with the event. returns: true if the conditions are met
     bool check_conditions();
     bool IsGlobal() const;
+    // minute of the day the launcher is activated at, or -1 if it's activated by other means
+    int activation_minute() const;
 // members
     std::string asEvent1Name;
     std::string asEvent2Name;
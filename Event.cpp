@@ -24,11 +24,13 @@ http://mozilla.org/MPL/2.0/.
 #include "Traction.h"
 #include "TractionPower.h"
 #include "sound.h"
+#include "sn_utils.h"
 #include "AnimModel.h"
 #include "DynObj.h"
 #include "Driver.h"
 #include "Timer.h"
 #include "Logs.h"
+#include "simulationtime.h"
 
 void
 basic_event::event_conditions::bind( basic_event::node_sequence *Nodes ) {
@@ -43,11 +45,11 @@ basic_event::event_conditions::init() {
 
     if( flags & ( flags::track_busy | flags::track_free ) ) {
         for( auto &target : *cells ) {
-            tracks.emplace_back( simulation::Paths.find( std::get<std::string>( target ) ) );
+            tracks.emplace_back( simulation::Paths.find( std::get<name_handle>( target ) ) );
             if( tracks.back() == nullptr ) {
                 // legacy compatibility behaviour, instead of disabling the event we disable the memory cell comparison test
 //                m_ignored = true; // deaktywacja
-//                ErrorLog( "Bad event: track \"" + std::get<std::string>( target ) + "\" referenced in event \"" + asName + "\" doesn't exist" );
+//                ErrorLog( "Bad event: track \"" + name_table::text( std::get<name_handle>( target ) ) + "\" referenced in event \"" + asName + "\" doesn't exist" );
                 flags &= ~( flags::track_busy | flags::track_free ); // zerowanie flag
             }
         }
@@ -175,6 +177,30 @@ basic_event::event_conditions::deserialize( cParser &Input ) { // przetwarzanie
     }
 }
 
+// stores condition data in provided stream
+void
+basic_event::event_conditions::serialize( std::ostream &Output ) const {
+
+    sn_utils::ls_uint32( Output, flags );
+    sn_utils::ls_float32( Output, probability );
+    sn_utils::ls_float64( Output, match_value_1 );
+    sn_utils::ls_float64( Output, match_value_2 );
+    sn_utils::s_str( Output, match_text );
+    sn_utils::s_bool( Output, has_else );
+}
+
+// restores condition data from provided stream
+void
+basic_event::event_conditions::deserialize( std::istream &Input ) {
+
+    flags = sn_utils::ld_uint32( Input );
+    probability = sn_utils::ld_float32( Input );
+    match_value_1 = sn_utils::ld_float64( Input );
+    match_value_2 = sn_utils::ld_float64( Input );
+    match_text = sn_utils::d_str( Input );
+    has_else = sn_utils::d_bool( Input );
+}
+
 // sends basic content of the class in legacy (text) format to provided stream
 void
 basic_event::event_conditions::export_as_text( std::ostream &Output ) const {
@@ -243,11 +269,57 @@ basic_event::deserialize_targets( std::string const &Input ) {
     while( false == ( target = targetparser.getToken<std::string>( true, "|," ) ).empty() ) {
         // actual bindings to targets of proper type are created during scenario initialization
         if( target != "none" ) {
-            m_targets.emplace_back( target, nullptr );
+            m_targets.emplace_back( name_table::intern( target ), nullptr );
         }
     }
 }
 
+// stores event data in provided stream
+void
+basic_event::serialize( std::ostream &Output ) const {
+
+    sn_utils::ls_float64( Output, m_delay );
+    sn_utils::ls_float64( Output, m_delayrandom );
+    sn_utils::s_bool( Output, m_ignored );
+    sn_utils::s_bool( Output, m_passive );
+    sn_utils::ls_uint32( Output, static_cast<std::uint32_t>( m_targets.size() ) );
+    for( auto const &target : m_targets ) {
+        sn_utils::s_str( Output, name_table::text( std::get<name_handle>( target ) ) );
+    }
+    // template method implementation
+    serialize_( Output );
+}
+
+// restores event data from provided stream
+void
+basic_event::deserialize( std::istream &Input ) {
+
+    m_delay = sn_utils::ld_float64( Input );
+    m_delayrandom = sn_utils::ld_float64( Input );
+    m_ignored = sn_utils::d_bool( Input );
+    m_passive = sn_utils::d_bool( Input );
+    m_targets.clear();
+    auto targetcount { sn_utils::ld_uint32( Input ) };
+    while( ( targetcount-- )
+        && ( true == Input.good() ) ) {
+        m_targets.emplace_back( name_table::intern( sn_utils::d_str( Input ) ), nullptr );
+    }
+    // template method implementation
+    deserialize_( Input );
+}
+
+// serialize() subclass details, sends content of the subclass to provided stream
+void
+basic_event::serialize_( std::ostream &Output ) const {
+    // nothing to do here
+}
+
+// deserialize() subclass details, restores content of the subclass from provided stream
+void
+basic_event::deserialize_( std::istream &Input ) {
+    // nothing to do here
+}
+
 void
 basic_event::run() {
 
@@ -275,7 +347,7 @@ basic_event::export_as_text( std::ostream &Output ) const {
         for( auto &target : m_targets ) {
             auto *targetnode { std::get<scene::basic_node *>( target ) };
             Output
-                << ( targetnode != nullptr ? targetnode->name() : std::get<std::string>( target ) )
+                << ( targetnode != nullptr ? targetnode->name() : name_table::text( std::get<name_handle>( target ) ) )
                 << ( ++targetidx < m_targets.size() ? '|' : ' ' );
         }
     }
@@ -372,6 +444,34 @@ input_event::input_data::data_cell() {
 
 
 
+// serialize() subclass details, sends content of the subclass to provided stream
+void
+input_event::serialize_( std::ostream &Output ) const {
+
+    sn_utils::ls_uint32( Output, m_input.flags );
+    sn_utils::s_str( Output, m_input.data_text );
+    sn_utils::ls_float64( Output, m_input.data_value_1 );
+    sn_utils::ls_float64( Output, m_input.data_value_2 );
+    sn_utils::s_str( Output, name_table::text( std::get<name_handle>( m_input.data_source ) ) );
+    sn_utils::s_dvec3( Output, m_input.location );
+    sn_utils::ls_int32( Output, static_cast<std::int32_t>( m_input.command_type ) );
+}
+
+// deserialize() subclass details, restores content of the subclass from provided stream
+void
+input_event::deserialize_( std::istream &Input ) {
+
+    m_input.flags = sn_utils::ld_uint32( Input );
+    m_input.data_text = sn_utils::d_str( Input );
+    m_input.data_value_1 = sn_utils::ld_float64( Input );
+    m_input.data_value_2 = sn_utils::ld_float64( Input );
+    std::get<name_handle>( m_input.data_source ) = name_table::intern( sn_utils::d_str( Input ) );
+    m_input.location = sn_utils::d_dvec3( Input );
+    m_input.command_type = static_cast<TCommandType>( sn_utils::ld_int32( Input ) );
+}
+
+
+
 // prepares event for use
 void
 updatevalues_event::init() {
@@ -424,6 +524,22 @@ updatevalues_event::deserialize_( cParser &Input, scene::scratch_data &Scratchpa
     }
 }
 
+// serialize() subclass details, sends content of the subclass to provided stream
+void
+updatevalues_event::serialize_( std::ostream &Output ) const {
+
+    input_event::serialize_( Output );
+    m_conditions.serialize( Output );
+}
+
+// deserialize() subclass details, restores content of the subclass from provided stream
+void
+updatevalues_event::deserialize_( std::istream &Input ) {
+
+    input_event::deserialize_( Input );
+    m_conditions.deserialize( Input );
+}
+
 // run() subclass details
 // TODO: update and copy values run_ methods are largely identical, refactor to a single helper
 void
@@ -672,6 +788,8 @@ putvalues_event::run_() {
         + to_string( m_input.data_value_2, 2 ) + "]" );
 
     if( m_activator == nullptr ) { return; }
+    // the command can change state of the vehicle, so make sure it's back in the physics update, along with its consist
+    simulation::Vehicles.wake( m_activator );
     // zamiana, bo fizyka ma inaczej niż sceneria
     // NOTE: y & z swap, negative x
     TLocation const loc {
@@ -746,10 +864,10 @@ copyvalues_event::init() {
     // skopiowanie komórki do innej
     init_targets( simulation::Memory, "memory cell" );
     // source cell
-    std::get<scene::basic_node *>( m_input.data_source ) = simulation::Memory.find( std::get<std::string>( m_input.data_source ) );
+    std::get<scene::basic_node *>( m_input.data_source ) = simulation::Memory.find( std::get<name_handle>( m_input.data_source ) );
     if( std::get<scene::basic_node *>( m_input.data_source ) == nullptr ) {
         m_ignored = true; // deaktywacja
-        ErrorLog( "Bad event: \"" + m_name + "\" (type: " + type() + ") can't find memory cell \"" + std::get<std::string>( m_input.data_source ) + "\"" );
+        ErrorLog( "Bad event: \"" + m_name + "\" (type: " + type() + ") can't find memory cell \"" + name_table::text( std::get<name_handle>( m_input.data_source ) ) + "\"" );
     }
 }
 
@@ -776,7 +894,7 @@ copyvalues_event::deserialize_( cParser &Input, scene::scratch_data &Scratchpad
         Input >> token;
         switch( ++paramidx ) {
             case 1: { // nazwa drugiej komórki (źródłowej) // previously stored in param 9
-                std::get<std::string>( m_input.data_source ) = token;
+                std::get<name_handle>( m_input.data_source ) = name_table::intern( token );
                 break;
             }
             case 2: { // maska wartości
@@ -832,7 +950,7 @@ copyvalues_event::export_as_text_( std::ostream &Output ) const {
     Output
         << ( datasource != nullptr ?
                 datasource->name() :
-                std::get<std::string>( m_input.data_source ) )
+                name_table::text( std::get<name_handle>( m_input.data_source ) ) )
         << ' ' << ( m_input.flags & ( flags::text | flags::value_1 | flags::value_2 ) ) << ' ';
 }
 
@@ -1091,6 +1209,32 @@ multi_event::deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) {
     }
 }
 
+// serialize() subclass details, sends content of the subclass to provided stream
+void
+multi_event::serialize_( std::ostream &Output ) const {
+
+    sn_utils::ls_uint32( Output, static_cast<std::uint32_t>( m_children.size() ) );
+    for( auto const &child : m_children ) {
+        sn_utils::s_str( Output, std::get<std::string>( child ) );
+        sn_utils::s_bool( Output, std::get<bool>( child ) );
+    }
+    m_conditions.serialize( Output );
+}
+
+// deserialize() subclass details, restores content of the subclass from provided stream
+void
+multi_event::deserialize_( std::istream &Input ) {
+
+    m_children.clear();
+    auto childcount { sn_utils::ld_uint32( Input ) };
+    while( ( childcount-- )
+        && ( true == Input.good() ) ) {
+        auto const childname { sn_utils::d_str( Input ) };
+        m_children.emplace_back( childname, nullptr, sn_utils::d_bool( Input ) );
+    }
+    m_conditions.deserialize( Input );
+}
+
 // run() subclass details
 void
 multi_event::run_() {
@@ -1200,6 +1344,32 @@ sound_event::deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) {
     }
 }
 
+// serialize() subclass details, sends content of the subclass to provided stream
+void
+sound_event::serialize_( std::ostream &Output ) const {
+
+    sn_utils::ls_uint32( Output, static_cast<std::uint32_t>( m_sounds.size() ) );
+    for( auto const &sound : m_sounds ) {
+        sn_utils::s_str( Output, std::get<std::string>( sound ) );
+    }
+    sn_utils::ls_int32( Output, m_soundmode );
+    sn_utils::ls_int32( Output, m_soundradiochannel );
+}
+
+// deserialize() subclass details, restores content of the subclass from provided stream
+void
+sound_event::deserialize_( std::istream &Input ) {
+
+    m_sounds.clear();
+    auto soundcount { sn_utils::ld_uint32( Input ) };
+    while( ( soundcount-- )
+        && ( true == Input.good() ) ) {
+        m_sounds.emplace_back( sn_utils::d_str( Input ), nullptr );
+    }
+    m_soundmode = sn_utils::ld_int32( Input );
+    m_soundradiochannel = sn_utils::ld_int32( Input );
+}
+
 // run() subclass details
 void
 sound_event::run_() {
@@ -1365,17 +1535,8 @@ animation_event::deserialize_( cParser &Input, scene::scratch_data &Scratchpad )
     }
     else if( token.substr( token.length() - 4, 4 ) == ".vmd" ) // na razie tu, może będzie inaczej
     { // animacja z pliku VMD
-        {
-            m_animationfilename = token;
-            std::ifstream file( szModelPath + m_animationfilename, std::ios::binary | std::ios::ate ); file.unsetf( std::ios::skipws );
-            auto size = file.tellg();   // ios::ate already positioned us at the end of the file
-            file.seekg( 0, std::ios::beg ); // rewind the caret afterwards
-            // animation size, previously held in param 7
-            m_animationfilesize = size;
-            // animation data, previously held in param 8
-            m_animationfiledata = new char[ size ];
-            file.read( m_animationfiledata, size ); // wczytanie pliku
-        }
+        m_animationfilename = token;
+        load_animation_file();
         Input.getTokens();
         // animation submodel, previously held in param 9
         Input >> m_animationsubmodel;
@@ -1393,6 +1554,48 @@ animation_event::deserialize_( cParser &Input, scene::scratch_data &Scratchpad )
     Input.getTokens();
 }
 
+// serialize() subclass details, sends content of the subclass to provided stream
+void
+animation_event::serialize_( std::ostream &Output ) const {
+
+    sn_utils::ls_int32( Output, m_animationtype );
+    for( auto const parameter : m_animationparams ) {
+        sn_utils::ls_float64( Output, parameter );
+    }
+    sn_utils::s_str( Output, m_animationsubmodel );
+    sn_utils::s_str( Output, m_animationfilename );
+}
+
+// deserialize() subclass details, restores content of the subclass from provided stream
+void
+animation_event::deserialize_( std::istream &Input ) {
+
+    m_animationtype = sn_utils::ld_int32( Input );
+    for( auto &parameter : m_animationparams ) {
+        parameter = sn_utils::ld_float64( Input );
+    }
+    m_animationsubmodel = sn_utils::d_str( Input );
+    m_animationfilename = sn_utils::d_str( Input );
+    if( m_animationtype == 4 ) {
+        // animation data isn't cached, retrieve it from the source file
+        load_animation_file();
+    }
+}
+
+// loads content of the vmd animation file
+void
+animation_event::load_animation_file() {
+
+    std::ifstream file( szModelPath + m_animationfilename, std::ios::binary | std::ios::ate ); file.unsetf( std::ios::skipws );
+    auto size = file.tellg();   // ios::ate already positioned us at the end of the file
+    file.seekg( 0, std::ios::beg ); // rewind the caret afterwards
+    // animation size, previously held in param 7
+    m_animationfilesize = size;
+    // animation data, previously held in param 8
+    m_animationfiledata = new char[ size ];
+    file.read( m_animationfiledata, size ); // wczytanie pliku
+}
+
 // run() subclass details
 void
 animation_event::run_() {
@@ -1502,6 +1705,26 @@ lights_event::deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) {
     }
 }
 
+// serialize() subclass details, sends content of the subclass to provided stream
+void
+lights_event::serialize_( std::ostream &Output ) const {
+
+    sn_utils::ls_uint32( Output, static_cast<std::uint32_t>( m_lights.size() ) );
+    for( auto const light : m_lights ) {
+        sn_utils::ls_float32( Output, light );
+    }
+}
+
+// deserialize() subclass details, restores content of the subclass from provided stream
+void
+lights_event::deserialize_( std::istream &Input ) {
+
+    m_lights.resize( sn_utils::ld_uint32( Input ) );
+    for( auto &light : m_lights ) {
+        light = sn_utils::ld_float32( Input );
+    }
+}
+
 // run() subclass details
 void
 lights_event::run_() {
@@ -1594,6 +1817,24 @@ switch_event::deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) {
     }
 }
 
+// serialize() subclass details, sends content of the subclass to provided stream
+void
+switch_event::serialize_( std::ostream &Output ) const {
+
+    sn_utils::ls_int32( Output, m_switchstate );
+    sn_utils::ls_float32( Output, m_switchmoverate );
+    sn_utils::ls_float32( Output, m_switchmovedelay );
+}
+
+// deserialize() subclass details, restores content of the subclass from provided stream
+void
+switch_event::deserialize_( std::istream &Input ) {
+
+    m_switchstate = sn_utils::ld_int32( Input );
+    m_switchmoverate = sn_utils::ld_float32( Input );
+    m_switchmovedelay = sn_utils::ld_float32( Input );
+}
+
 // run() subclass details
 void
 switch_event::run_() {
@@ -1661,6 +1902,20 @@ track_event::deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) {
     Input.getTokens();
 }
 
+// serialize() subclass details, sends content of the subclass to provided stream
+void
+track_event::serialize_( std::ostream &Output ) const {
+
+    sn_utils::ls_float32( Output, m_velocity );
+}
+
+// deserialize() subclass details, restores content of the subclass from provided stream
+void
+track_event::deserialize_( std::istream &Input ) {
+
+    m_velocity = sn_utils::ld_float32( Input );
+}
+
 // run() subclass details
 void
 track_event::run_() {
@@ -1710,6 +1965,20 @@ voltage_event::deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) {
     Input.getTokens();
 }
 
+// serialize() subclass details, sends content of the subclass to provided stream
+void
+voltage_event::serialize_( std::ostream &Output ) const {
+
+    sn_utils::ls_float32( Output, m_voltage );
+}
+
+// deserialize() subclass details, restores content of the subclass from provided stream
+void
+voltage_event::deserialize_( std::istream &Input ) {
+
+    m_voltage = sn_utils::ld_float32( Input );
+}
+
 // run() subclass details
 void
 voltage_event::run_() {
@@ -1738,7 +2007,7 @@ visible_event::init() {
     // ukrycie albo przywrócenie obiektu
     for( auto &target : m_targets ) {
         auto &targetnode{ std::get<scene::basic_node *>( target ) };
-        auto &targetname{ std::get<std::string>( target ) };
+        auto const targetname{ std::get<name_handle>( target ) };
         // najpierw model
         targetnode = simulation::Instances.find( targetname );
         if( targetnode == nullptr ) {
@@ -1751,7 +2020,7 @@ visible_event::init() {
         }
         if( targetnode == nullptr ) {
             m_ignored = true; // deaktywacja
-            ErrorLog( "Bad event: \"" + m_name + "\" (type: " + type() + ") can't find item \"" + std::get<std::string>( target ) + "\"" );
+            ErrorLog( "Bad event: \"" + m_name + "\" (type: " + type() + ") can't find item \"" + name_table::text( std::get<name_handle>( target ) ) + "\"" );
         }
     }
 }
@@ -1773,6 +2042,20 @@ visible_event::deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) {
     Input.getTokens();
 }
 
+// serialize() subclass details, sends content of the subclass to provided stream
+void
+visible_event::serialize_( std::ostream &Output ) const {
+
+    sn_utils::s_bool( Output, m_visible );
+}
+
+// deserialize() subclass details, restores content of the subclass from provided stream
+void
+visible_event::deserialize_( std::istream &Input ) {
+
+    m_visible = sn_utils::d_bool( Input );
+}
+
 // run() subclass details
 void
 visible_event::run_() {
@@ -1817,6 +2100,20 @@ friction_event::deserialize_( cParser &Input, scene::scratch_data &Scratchpad )
     Input.getTokens();
 }
 
+// serialize() subclass details, sends content of the subclass to provided stream
+void
+friction_event::serialize_( std::ostream &Output ) const {
+
+    sn_utils::ls_float32( Output, m_friction );
+}
+
+// deserialize() subclass details, restores content of the subclass from provided stream
+void
+friction_event::deserialize_( std::istream &Input ) {
+
+    m_friction = sn_utils::ld_float32( Input );
+}
+
 // run() subclass details
 void
 friction_event::run_() {
@@ -1901,6 +2198,20 @@ message_event::deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) {
     }
 }
 
+// serialize() subclass details, sends content of the subclass to provided stream
+void
+message_event::serialize_( std::ostream &Output ) const {
+
+    sn_utils::s_str( Output, m_message );
+}
+
+// deserialize() subclass details, restores content of the subclass from provided stream
+void
+message_event::deserialize_( std::istream &Input ) {
+
+    m_message = sn_utils::d_str( Input );
+}
+
 // run() subclass details
 void
 message_event::run_() {
@@ -1967,7 +2278,14 @@ event_manager::~event_manager() {
 void
 event_manager::queue( TEventLauncher *Launcher ) {
 
-    m_launcherqueue.emplace_back( Launcher );
+    auto const minute { Launcher->activation_minute() };
+    if( minute >= 0 ) {
+        // launchers activated only at specific time don't need to be checked until that time comes
+        m_launcherwheel[ minute ].emplace_back( Launcher );
+    }
+    else {
+        m_launcherqueue.emplace_back( Launcher );
+    }
 }
 
 // legacy method, updates event queues
@@ -1980,12 +2298,36 @@ event_manager::update() {
     for( auto *launcher : m_launcherqueue ) {
 
         if( true == ( launcher->check_activation() && launcher->check_conditions() ) ) {
-            // NOTE: we're presuming global events aren't going to use event2
-            WriteLog( "Eventlauncher " + launcher->name() );
-            if( launcher->Event1 ) {
-                AddToQuery( launcher->Event1, nullptr );
+            launch_event( launcher );
+        }
+    }
+    // activate launchers scheduled for minutes which passed since the last update
+    auto const minutesperday { 24 * 60 };
+    auto const catchuplimit { 60 }; // longer gaps are treated as a change of the clock rather than its passage
+    auto const minute { simulation::Time.data().wHour * 60 + simulation::Time.data().wMinute };
+    if( minute != m_launcherminute ) {
+        auto const elapsed { (
+            m_launcherminute < 0 ?
+                1 :
+                clamp_circular( minute - m_launcherminute, minutesperday ) ) };
+        for( auto step = ( elapsed <= catchuplimit ? elapsed : 1 ) - 1; step >= 0; --step ) {
+            for( auto *launcher : m_launcherwheel[ clamp_circular( minute - step, minutesperday ) ] ) {
+                if( true == launcher->check_conditions() ) {
+                    launch_event( launcher );
+                }
             }
         }
+        m_launcherminute = minute;
+    }
+}
+
+// adds events assigned to global launcher to the event query
+void
+event_manager::launch_event( TEventLauncher *Launcher ) {
+    // NOTE: we're presuming global events aren't going to use event2
+    WriteLog( "Eventlauncher " + Launcher->name() );
+    if( Launcher->Event1 ) {
+        AddToQuery( Launcher->Event1, nullptr );
     }
 }
 
@@ -1994,7 +2336,8 @@ event_manager::update() {
 bool
 event_manager::insert( basic_event *Event ) {
     // najpierw sprawdzamy, czy nie ma, a potem dopisujemy
-    auto lookup = m_eventmap.find( Event->m_name );
+    auto const eventname { name_table::intern( Event->m_name ) };
+    auto lookup = m_eventmap.find( eventname );
     if( lookup != m_eventmap.end() ) {
         // duplicate of already existing event
         auto const size = Event->m_name.size();
@@ -2036,9 +2379,11 @@ event_manager::insert( basic_event *Event ) {
     }
 
     m_events.emplace_back( Event );
+    // new or replaced event can change what the AI finds along its route
+    TTrack::trace_invalidate();
     if( lookup == m_eventmap.end() ) {
         // if it's first event with such name, it's potential candidate for the execution queue
-        m_eventmap.emplace( Event->m_name, m_events.size() - 1 );
+        m_eventmap.emplace( eventname, m_events.size() - 1 );
         if( ( Event->m_ignored != true )
          && ( Event->m_name.find( "onstart" ) != std::string::npos ) ) {
             // event uruchamiany automatycznie po starcie
@@ -2051,9 +2396,16 @@ event_manager::insert( basic_event *Event ) {
 
 // legacy method, returns pointer to specified event, or null
 basic_event *
-event_manager::FindEvent( std::string const &Name ) {
+event_manager::FindEvent( std::string_view const Name ) {
+
+    return FindEvent( name_table::find( Name ) );
+}
+
+// returns pointer to event with specified name handle, or null
+basic_event *
+event_manager::FindEvent( name_handle const Name ) {
 
-    if( Name.empty() ) { return nullptr; }
+    if( Name == null_name ) { return nullptr; }
 
     auto const lookup = m_eventmap.find( Name );
     return (
@@ -2095,61 +2447,41 @@ event_manager::AddToQuery( basic_event *Event, TDynamicObject const *Owner, doub
             // doliczenie losowego czasu opóźnienia
             Event->m_launchtime += Event->m_delayrandom * Random();
         }
-        if( QueryRootEvent != nullptr ) {
-            basic_event *target { QueryRootEvent };
-            basic_event *previous { nullptr };
-            while( ( Event->m_launchtime >= target->m_launchtime )
-                && ( target->m_next != nullptr ) ) {
-                previous = target;
-                target = target->m_next;
-            }
-            // the new event will be either before or after the one we located
-            if( Event->m_launchtime >= target->m_launchtime ) {
-                assert( target->m_next == nullptr );
-                target->m_next = Event;
-                // if we have resurrected event land at the end of list, the link from previous run could potentially "add" unwanted events to the queue
-                Event->m_next = nullptr;
-            }
-            else {
-                if( previous != nullptr ) {
-                    previous->m_next = Event;
-                    Event->m_next = target;
-                }
-                else {
-                    // special case, we're inserting our event at the very start
-                    Event->m_next = QueryRootEvent;
-                    QueryRootEvent = Event;
-                }
-            }
-        }
-        else {
-            QueryRootEvent = Event;
-            QueryRootEvent->m_next = nullptr;
-        }
+        // events with the same launch time are executed in order they were added
+        push( Event, m_queuesequence++ );
     }
 
     return true;
 }
 
+// adds specified event to the execution queue
+void
+event_manager::push( basic_event *Event, std::uint64_t const Sequence ) {
+
+    m_eventqueue.push_back( { Event->m_launchtime, Sequence, Event } );
+    std::push_heap( std::begin( m_eventqueue ), std::end( m_eventqueue ), queue_order() );
+}
+
 // legacy method, executes queued events
 bool
 event_manager::CheckQuery() {
 
-    while( ( QueryRootEvent != nullptr )
-        && ( QueryRootEvent->m_launchtime < Timer::GetTime() ) )
+    while( ( false == m_eventqueue.empty() )
+        && ( m_eventqueue.front().launch_time < Timer::GetTime() ) )
     { // eventy są posortowana wg czasu wykonania
-        m_workevent = QueryRootEvent; // wyjęcie eventu z kolejki
-        if (QueryRootEvent->m_sibling) // jeśli jest kolejny o takiej samej nazwie
+        std::pop_heap( std::begin( m_eventqueue ), std::end( m_eventqueue ), queue_order() );
+        auto const queued { m_eventqueue.back() };
+        m_eventqueue.pop_back();
+        m_workevent = queued.event; // wyjęcie eventu z kolejki
+        if (m_workevent->m_sibling) // jeśli jest kolejny o takiej samej nazwie
         { // to teraz on będzie następny do wykonania
-            QueryRootEvent = QueryRootEvent->m_sibling; // następny będzie ten doczepiony
-            QueryRootEvent->m_next = m_workevent->m_next; // pamiętając o następnym z kolejki
-            QueryRootEvent->m_launchtime = m_workevent->m_launchtime; // czas musi być ten sam, bo nie jest aktualizowany
-            QueryRootEvent->m_activator = m_workevent->m_activator; // pojazd aktywujący
-            QueryRootEvent->m_inqueue = 1;
-            // w sumie można by go dodać normalnie do kolejki, ale trzeba te połączone posortować wg czasu wykonania
-        }
-        else // a jak nazwa jest unikalna, to kolejka idzie dalej
-            QueryRootEvent = QueryRootEvent->m_next; // NULL w skrajnym przypadku
+            auto *sibling { m_workevent->m_sibling }; // następny będzie ten doczepiony
+            sibling->m_launchtime = m_workevent->m_launchtime; // czas musi być ten sam, bo nie jest aktualizowany
+            sibling->m_activator = m_workevent->m_activator; // pojazd aktywujący
+            sibling->m_inqueue = 1;
+            // reusing sequence number of the current event puts the sibling ahead of other events with the same launch time
+            push( sibling, queued.sequence );
+        }
         if( ( false == m_workevent->m_ignored ) && ( false == m_workevent->m_passive ) ) {
             // w zasadzie te wyłączone są skanowane i nie powinny się nigdy w kolejce znaleźć
             --(m_workevent->m_inqueue); // teraz moze być ponownie dodany do kolejki
@@ -2159,6 +2491,40 @@ event_manager::CheckQuery() {
     return true;
 }
 
+// returns up to specified number of queued events meeting specified criteria, in order of execution
+std::vector<basic_event const *>
+event_manager::queued( std::size_t const Count, std::function<bool( basic_event const * )> const &Filter ) const {
+
+    // the heap is walked from its top through a small heap of candidates, which receives children of each visited entry
+    // in this way only the entries which come first are visited, without copying or modifying the whole queue
+    // NOTE: relies on the standard heap layout, with children of entry n at 2n+1 and 2n+2
+    auto const order {
+        [&]( std::size_t const Left, std::size_t const Right ) {
+            return queue_order()( m_eventqueue[ Left ], m_eventqueue[ Right ] ); } };
+    std::vector<std::size_t> candidates;
+    if( false == m_eventqueue.empty() ) {
+        candidates.emplace_back( 0 );
+    }
+    std::vector<basic_event const *> events;
+    while( ( false == candidates.empty() )
+        && ( events.size() < Count ) ) {
+        std::pop_heap( std::begin( candidates ), std::end( candidates ), order );
+        auto const index { candidates.back() };
+        candidates.pop_back();
+        for( auto const child : { 2 * index + 1, 2 * index + 2 } ) {
+            if( child < m_eventqueue.size() ) {
+                candidates.emplace_back( child );
+                std::push_heap( std::begin( candidates ), std::end( candidates ), order );
+            }
+        }
+        auto const *event { m_eventqueue[ index ].event };
+        if( true == Filter( event ) ) {
+            events.emplace_back( event );
+        }
+    }
+    return events;
+}
+
 // legacy method, initializes events after deserialization from scenario file
 void
 event_manager::InitEvents() {
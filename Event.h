@@ -45,6 +45,12 @@ public:
     virtual
     void
         deserialize( cParser &Input, scene::scratch_data &Scratchpad );
+    // stores event data in provided stream
+    void
+        serialize( std::ostream &Output ) const;
+    // restores event data from provided stream
+    void
+        deserialize( std::istream &Input );
     // prepares event for use
     virtual
     void
@@ -80,7 +86,6 @@ public:
     void group( scene::group_handle Group );
     scene::group_handle group() const;
 // members
-    basic_event *m_next { nullptr }; // następny w kolejce // TODO: replace with event list in the manager
     basic_event *m_sibling { nullptr }; // kolejny event z tą samą nazwą - od wersji 378
     std::string m_name;
     bool m_ignored { false }; // replacement for tp_ignored
@@ -93,7 +98,7 @@ public:
 
 protected:
 // types
-    using basic_node = std::tuple<std::string, scene::basic_node *>;
+    using basic_node = std::tuple<name_handle, scene::basic_node *>;
     using node_sequence = std::vector<basic_node>;
 
     struct event_conditions {
@@ -107,6 +112,10 @@ protected:
         bool has_else { false };
 
         void deserialize( cParser &Input );
+        // stores condition data in provided stream
+        void serialize( std::ostream &Output ) const;
+        // restores condition data from provided stream
+        void deserialize( std::istream &Input );
         void bind( basic_event::node_sequence *Nodes );
         void init();
         // verifies whether event meets execution condition(s)
@@ -131,6 +140,10 @@ private:
     virtual void deserialize_targets( std::string const &Input );
     // deserialize() subclass details
     virtual void deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) = 0;
+    // serialize() subclass details, sends content of the subclass to provided stream
+    virtual void serialize_( std::ostream &Output ) const;
+    // deserialize() subclass details, restores content of the subclass from provided stream
+    virtual void deserialize_( std::istream &Input );
     // run() subclass details
     virtual void run_() = 0;
     // export_as_text() subclass details
@@ -154,7 +167,7 @@ protected:
         std::string data_text;
         double data_value_1 { 0.0 };
         double data_value_2 { 0.0 };
-        basic_node data_source { "", nullptr };
+        basic_node data_source { null_name, nullptr };
         glm::dvec3 location { 0.0 };
         TCommandType command_type { TCommandType::cm_Unknown };
 
@@ -162,6 +175,11 @@ protected:
         TMemCell * data_cell();
     };
 
+// methods
+    // serialize() subclass details, sends content of the subclass to provided stream
+    void serialize_( std::ostream &Output ) const override;
+    // deserialize() subclass details, restores content of the subclass from provided stream
+    void deserialize_( std::istream &Input ) override;
 // members
     input_data m_input;
 };
@@ -183,6 +201,10 @@ private:
     std::string type() const override;
     // deserialize() subclass details
     void deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) override;
+    // serialize() subclass details, sends content of the subclass to provided stream
+    void serialize_( std::ostream &Output ) const override;
+    // deserialize() subclass details, restores content of the subclass from provided stream
+    void deserialize_( std::istream &Input ) override;
     // run() subclass details
     void run_() override;
     // export_as_text() subclass details
@@ -328,6 +350,10 @@ private:
     std::string type() const override;
     // deserialize() subclass details
     void deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) override;
+    // serialize() subclass details, sends content of the subclass to provided stream
+    void serialize_( std::ostream &Output ) const override;
+    // deserialize() subclass details, restores content of the subclass from provided stream
+    void deserialize_( std::istream &Input ) override;
     // run() subclass details
     void run_() override;
     // export_as_text() subclass details
@@ -355,6 +381,10 @@ private:
     void deserialize_targets( std::string const &Input ) override;
     // deserialize() subclass details
     void deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) override;
+    // serialize() subclass details, sends content of the subclass to provided stream
+    void serialize_( std::ostream &Output ) const override;
+    // deserialize() subclass details, restores content of the subclass from provided stream
+    void deserialize_( std::istream &Input ) override;
     // run() subclass details
     void run_() override;
     // export_as_text() subclass details
@@ -380,10 +410,16 @@ private:
     std::string type() const override;
     // deserialize() subclass details
     void deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) override;
+    // serialize() subclass details, sends content of the subclass to provided stream
+    void serialize_( std::ostream &Output ) const override;
+    // deserialize() subclass details, restores content of the subclass from provided stream
+    void deserialize_( std::istream &Input ) override;
     // run() subclass details
     void run_() override;
     // export_as_text() subclass details
     void export_as_text_( std::ostream &Output ) const override;
+    // loads content of the vmd animation file
+    void load_animation_file();
 // members
     int m_animationtype{ 0 };
     std::array<double, 4> m_animationparams{ 0.0 };
@@ -407,6 +443,10 @@ private:
     std::string type() const override;
     // deserialize() subclass details
     void deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) override;
+    // serialize() subclass details, sends content of the subclass to provided stream
+    void serialize_( std::ostream &Output ) const override;
+    // deserialize() subclass details, restores content of the subclass from provided stream
+    void deserialize_( std::istream &Input ) override;
     // run() subclass details
     void run_() override;
     // export_as_text() subclass details
@@ -428,6 +468,10 @@ private:
     std::string type() const override;
     // deserialize() subclass details
     void deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) override;
+    // serialize() subclass details, sends content of the subclass to provided stream
+    void serialize_( std::ostream &Output ) const override;
+    // deserialize() subclass details, restores content of the subclass from provided stream
+    void deserialize_( std::istream &Input ) override;
     // run() subclass details
     void run_() override;
     // export_as_text() subclass details
@@ -451,6 +495,10 @@ private:
     std::string type() const override;
     // deserialize() subclass details
     void deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) override;
+    // serialize() subclass details, sends content of the subclass to provided stream
+    void serialize_( std::ostream &Output ) const override;
+    // deserialize() subclass details, restores content of the subclass from provided stream
+    void deserialize_( std::istream &Input ) override;
     // run() subclass details
     void run_() override;
     // export_as_text() subclass details
@@ -472,6 +520,10 @@ private:
     std::string type() const override;
     // deserialize() subclass details
     void deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) override;
+    // serialize() subclass details, sends content of the subclass to provided stream
+    void serialize_( std::ostream &Output ) const override;
+    // deserialize() subclass details, restores content of the subclass from provided stream
+    void deserialize_( std::istream &Input ) override;
     // run() subclass details
     void run_() override;
     // export_as_text() subclass details
@@ -493,6 +545,10 @@ private:
     std::string type() const override;
     // deserialize() subclass details
     void deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) override;
+    // serialize() subclass details, sends content of the subclass to provided stream
+    void serialize_( std::ostream &Output ) const override;
+    // deserialize() subclass details, restores content of the subclass from provided stream
+    void deserialize_( std::istream &Input ) override;
     // run() subclass details
     void run_() override;
     // export_as_text() subclass details
@@ -514,6 +570,10 @@ private:
     std::string type() const override;
     // deserialize() subclass details
     void deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) override;
+    // serialize() subclass details, sends content of the subclass to provided stream
+    void serialize_( std::ostream &Output ) const override;
+    // deserialize() subclass details, restores content of the subclass from provided stream
+    void deserialize_( std::istream &Input ) override;
     // run() subclass details
     void run_() override;
     // export_as_text() subclass details
@@ -550,6 +610,10 @@ private:
     std::string type() const override;
     // deserialize() subclass details
     void deserialize_( cParser &Input, scene::scratch_data &Scratchpad ) override;
+    // serialize() subclass details, sends content of the subclass to provided stream
+    void serialize_( std::ostream &Output ) const override;
+    // deserialize() subclass details, restores content of the subclass from provided stream
+    void deserialize_( std::istream &Input ) override;
     // run() subclass details
     void run_() override;
     // export_as_text() subclass details
@@ -587,14 +651,15 @@ public:
     bool
         insert( TEventLauncher *Launcher ) {
             return m_launchers.insert( Launcher ); }
-    // returns first event in the queue
-    inline
-    basic_event *
-        begin() {
-            return QueryRootEvent; }
+    // returns up to specified number of queued events meeting specified criteria, in order of execution
+    std::vector<basic_event const *>
+        queued( std::size_t const Count, std::function<bool( basic_event const * )> const &Filter ) const;
     // legacy method, returns pointer to specified event, or null
     basic_event *
-        FindEvent( std::string const &Name );
+        FindEvent( std::string_view const Name );
+    // returns pointer to event with specified name handle, or null
+    basic_event *
+        FindEvent( name_handle const Name );
     // legacy method, inserts specified event in the event query
     bool
         AddToQuery( basic_event *Event, TDynamicObject const *Owner, double delay = 0.0 );
@@ -614,20 +679,39 @@ public:
 private:
 // types
     using event_sequence = std::deque<basic_event *>;
-    using event_map = std::unordered_map<std::string, std::size_t>;
+    using event_map = std::unordered_map<name_handle, std::size_t>;
     using eventlauncher_sequence = std::vector<TEventLauncher *>;
+    struct queued_event {
+        double launch_time;
+        std::uint64_t sequence; // order of insertion, keeps events with the same launch time in fifo order
+        basic_event *event;
+    };
+    // heap comparator, puts the earliest event at the top
+    struct queue_order {
+        bool operator()( queued_event const &Left, queued_event const &Right ) const {
+            return (
+                Left.launch_time != Right.launch_time ?
+                    Left.launch_time > Right.launch_time :
+                    Left.sequence > Right.sequence ); }
+    };
+    using event_queue = std::vector<queued_event>;
+// methods
+    // adds specified event to the execution queue
+    void
+        push( basic_event *Event, std::uint64_t const Sequence );
+    // adds events assigned to global launcher to the event query
+    void
+        launch_event( TEventLauncher *Launcher );
 // members
     event_sequence m_events;
-/*
-    // NOTE: disabled until event class refactoring
-    event_sequence m_eventqueue;
-*/
-    // legacy version of the above
-    basic_event *QueryRootEvent { nullptr };
+    event_queue m_eventqueue; // binary heap of events waiting for execution
+    std::uint64_t m_queuesequence { 0 };
     basic_event *m_workevent { nullptr };
     event_map m_eventmap;
     basic_table<TEventLauncher> m_launchers;
-    eventlauncher_sequence m_launcherqueue;
+    eventlauncher_sequence m_launcherqueue; // global launchers which have to be polled every frame
+    std::array<eventlauncher_sequence, 24 * 60> m_launcherwheel; // global launchers activated at specific time, bucketed by minute of the day
+    int m_launcherminute { -1 }; // last minute of the day processed by the launcher wheel
 };
 
 
@@ -649,11 +733,11 @@ void
 basic_event::init_targets( TableType_ &Repository, std::string const &Targettype, bool const Logerrors ) {
 
     for( auto &target : m_targets ) {
-        std::get<scene::basic_node *>( target ) = Repository.find( std::get<std::string>( target ) );
+        std::get<scene::basic_node *>( target ) = Repository.find( std::get<name_handle>( target ) );
         if( std::get<scene::basic_node *>( target ) == nullptr ) {
             m_ignored = true; // deaktywacja
             if( Logerrors )
-                ErrorLog( "Bad event: \"" + m_name + "\" (type: " + type() + ") can't find " + Targettype +" \"" + std::get<std::string>( target ) + "\"" );
+                ErrorLog( "Bad event: \"" + m_name + "\" (type: " + type() + ") can't find " + Targettype +" \"" + name_table::text( std::get<name_handle>( target ) ) + "\"" );
         }
     }
 }
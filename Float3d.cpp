@@ -25,6 +25,18 @@ void float4x4::deserialize_float64(std::istream &s)
 		e[i] = (float)sn_utils::ld_float64(s);
 }
 
+void float4x4::deserialize_float32(sn_reader &s)
+{
+	for (size_t i = 0; i < 16; i++)
+		e[i] = sn_utils::ld_float32(s);
+}
+
+void float4x4::deserialize_float64(sn_reader &s)
+{
+	for (size_t i = 0; i < 16; i++)
+		e[i] = (float)sn_utils::ld_float64(s);
+}
+
 void float4x4::serialize_float32(std::ostream &s)
 {
 	for (size_t i = 0; i < 16; i++)
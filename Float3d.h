@@ -210,6 +210,8 @@ public:
 
 	void deserialize_float32(std::istream&);
 	void deserialize_float64(std::istream&);
+	void deserialize_float32(class sn_reader&);
+	void deserialize_float64(class sn_reader&);
 	void serialize_float32(std::ostream&);
     float4x4(void){};
     float4x4(float f[16])
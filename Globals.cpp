@@ -141,12 +141,54 @@ global_settings::ConfigParse(cParser &Parser) {
             Parser.getTokens();
             Parser >> WriteLogFlag;
         }
+        else if( token == "simulation.lockstep" ) {
+            // fixed step simulation, independent of frame time
+            Parser.getTokens();
+            Parser >> Lockstep;
+        }
+        else if( token == "simulation.randomseed" ) {
+            // seed of random sequence used by the simulation
+            Parser.getTokens( 1, false );
+            Parser >> RandomSeed;
+        }
         else if (token == "fullphysics")
         { // McZapkie-291103 - usypianie fizyki
 
             Parser.getTokens();
             Parser >> FullPhysics;
         }
+        else if( token == "physics.dormancy" ) {
+            // skipping physics update for stationary, unattended vehicles
+            Parser.getTokens();
+            Parser >> PhysicsDormancy;
+        }
+        else if( token == "physics.threads" ) {
+            // worker threads for parallel vehicle physics update
+            Parser.getTokens( 1, false );
+            Parser >> PhysicsThreads;
+            PhysicsThreads = clamp( PhysicsThreads, 0, 64 );
+        }
+        else if( token == "physics.lodrange" ) {
+            // distance from players beyond which AI consists are moved by simplified physics
+            Parser.getTokens( 1, false );
+            Parser >> PhysicsLodRange;
+            PhysicsLodRange = std::max( 0.0, PhysicsLodRange );
+        }
+        else if( token == "physics.brakepipesolver" ) {
+            // consist-level calculation of brake pipe flows
+            Parser.getTokens();
+            Parser >> BrakePipeSolver;
+        }
+        else if( token == "physics.exactfriction" ) {
+            // reference runs, with brake shoe friction calculated without lookup tables
+            Parser.getTokens();
+            Parser >> ExactFriction;
+        }
+        else if( token == "physics.adaptivestep" ) {
+            // error-controlled length of physics steps, picked for each consist
+            Parser.getTokens();
+            Parser >> AdaptiveStep;
+        }
         else if (token == "debuglog")
         {
             // McZapkie-300402 - wylaczanie log.txt
@@ -169,6 +211,10 @@ global_settings::ConfigParse(cParser &Parser) {
             Parser.getTokens();
             Parser >> MultipleLogs;
         }
+        else if( token == "logs.async" ) {
+            Parser.getTokens();
+            Parser >> AsyncLogs;
+        }
         else if( token == "logs.filter" ) {
             Parser.getTokens();
             Parser >> DisabledLogTypes;
@@ -326,6 +372,24 @@ global_settings::ConfigParse(cParser &Parser) {
             Parser.getTokens( 1, false );
             Parser >> ScenarioTimeOffset;
         }
+        else if( token == "scenario.loader.threads" ) {
+            // worker threads for scenario file preloading
+            Parser.getTokens( 1, false );
+            Parser >> ScenarioLoaderThreads;
+            ScenarioLoaderThreads = clamp( ScenarioLoaderThreads, 0, 64 );
+        }
+        else if( token == "model.loader.threads" ) {
+            // worker threads for asynchronous model loading
+            Parser.getTokens( 1, false );
+            Parser >> ModelLoaderThreads;
+            ModelLoaderThreads = clamp( ModelLoaderThreads, 0, 16 );
+        }
+        else if( token == "model.loader.budget" ) {
+            // asynchronously loaded models handed to the renderer per frame
+            Parser.getTokens( 1, false );
+            Parser >> ModelLoaderBudget;
+            ModelLoaderBudget = std::max( 1, ModelLoaderBudget );
+        }
         else if( token == "scenario.time.current" ) {
             // sync simulation time with local clock
             Parser.getTokens( 1, false );
@@ -377,6 +441,12 @@ global_settings::ConfigParse(cParser &Parser) {
             Parser >> splinefidelity;
             SplineFidelity = clamp( splinefidelity, 1.f, 4.f );
         }
+        else if( token == "splinetolerance" ) {
+            // max error of distance to spline parameter conversion
+            Parser.getTokens();
+            Parser >> SplineTolerance;
+            SplineTolerance = clamp( SplineTolerance, 0.00001, 0.1 );
+        }
         else if( token == "createswitchtrackbeds" ) {
             // podwójna jasność ambient
             Parser.getTokens();
@@ -392,6 +462,18 @@ global_settings::ConfigParse(cParser &Parser) {
             Parser.getTokens();
             Parser >> ResourceMove;
         }
+        else if( token == "gfx.texture.loaderthreads" ) {
+
+            Parser.getTokens( 1, false );
+            Parser >> TextureLoaderThreads;
+            TextureLoaderThreads = clamp( TextureLoaderThreads, 0, 16 );
+        }
+        else if( token == "gfx.texture.uploadbudget" ) {
+
+            Parser.getTokens( 1, false );
+            Parser >> TextureUploadBudget;
+            TextureUploadBudget = std::max( 0, TextureUploadBudget );
+        }
         else if( token == "gfx.reflections.framerate" ) {
 
             auto const updatespersecond { std::abs( Parser.getToken<double>() ) };
@@ -405,6 +487,7 @@ global_settings::ConfigParse(cParser &Parser) {
             // przyspieszenie czasu, zmienna do testów
             Parser.getTokens(1, false);
             Parser >> fTimeSpeed;
+            fTimeSpeed = std::min( fTimeSpeed, 50.0 );
         }
         else if (token == "multisampling")
         {
@@ -429,6 +512,11 @@ global_settings::ConfigParse(cParser &Parser) {
                     iConvertModels - 128 :
                     0 );
         }
+        else if( token == "fizcache" ) {
+            // binary copies of parsed vehicle definitions
+            Parser.getTokens();
+            Parser >> FizCache;
+        }
         else if (token == "inactivepause")
         {
             // automatyczna pauza, gdy okno nieaktywne
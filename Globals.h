@@ -27,6 +27,7 @@ struct global_settings {
     bool ctrlState{ false };
     bool altState{ false };
     std::mt19937 random_engine{ std::mt19937( static_cast<unsigned int>( std::time( NULL ) ) ) };
+    std::mt19937 local_random_engine{ std::mt19937( static_cast<unsigned int>( std::time( NULL ) ) ) }; // for presentation, doesn't affect simulation results
     TDynamicObject *changeDynObj{ nullptr };// info o zmianie pojazdu
     TCamera pCamera; // parametry kamery
     TCamera pDebugCamera;
@@ -59,10 +60,17 @@ struct global_settings {
     std::string szDefaultExt{ szTexturesDDS };
     std::string SceneryFile{ "td.scn" };
     std::string asHumanCtrlVehicle{ "EU07-424" };
+    double HeadlessDuration{ 60.0 }; // simulated time of unattended run without window, in seconds
+    double HeadlessTimestep{ 0.05 }; // simulation step of unattended run without window, in seconds
+    std::vector<std::string> BenchmarkVehicles; // .fiz files used by vehicle physics benchmarks; the last one doubles as consist wagon
+    std::string BenchmarkOutput{ "benchmark.json" }; // file receiving benchmark results
+    int BenchmarkRepetitions{ 10 }; // number of timed runs of each benchmark
     int iConvertModels{ 0 }; // tworzenie plików binarnych
+    bool FizCache{ true }; // parsed vehicle definitions are kept in binary files next to their .fiz sources
     // logs
     int iWriteLogEnabled{ 3 }; // maska bitowa: 1-zapis do pliku, 2-okienko, 4-nazwy torów
     bool MultipleLogs{ false };
+    bool AsyncLogs{ true }; // log files are written by a background thread
     unsigned int DisabledLogTypes{ 0 };
     // simulation
     bool RealisticControlMode{ false }; // controls ability to steer the vehicle from outside views
@@ -77,6 +85,16 @@ struct global_settings {
     std::string Season{}; // season of the year, based on simulation date
     std::string Weather{ "cloudy:" }; // current weather
     bool FullPhysics{ true }; // full calculations performed for each simulation step
+    bool PhysicsDormancy{ true }; // stationary, unattended vehicles are left out of the physics update
+    int PhysicsThreads{ 0 }; // number of worker threads used for vehicle physics; 0 = serial update
+    double PhysicsLodRange{ 0.0 }; // distance from players beyond which AI consists are moved by simplified physics; 0 = disabled
+    bool BrakePipeSolver{ false }; // brake pipe flows are calculated for entire consists at once, instead of vehicle by vehicle
+    bool ExactFriction{ false }; // friction coefficients of brake shoes are calculated from formulas, instead of lookup tables
+    bool AdaptiveStep{ false }; // consists are updated in physics steps of their own length, picked from stability of couplers and estimated error
+    bool Lockstep{ false }; // simulation advances in fixed steps independent of frame time, runs with the same input give the same results
+    unsigned int RandomSeed{ 0 }; // seed of random sequence used by the simulation; 0 = based on clock
+    std::string CommandRecordFile; // file receiving vehicle control commands of lockstep run
+    std::string CommandReplayFile; // file with recorded vehicle control commands, replayed instead of live input
     bool bnewAirCouplers{ true };
     double fMoveLight{ -1 }; // numer dnia w roku albo -1
     bool FakeLight{ false }; // toggle between fixed and dynamic daylight
@@ -85,6 +103,9 @@ struct global_settings {
     float ScenarioTimeOverride { std::numeric_limits<float>::quiet_NaN() }; // requested scenario start time
     float ScenarioTimeOffset { 0.f }; // time shift (in hours) applied to train timetables
     bool ScenarioTimeCurrent { false }; // automatic time shift to match scenario time with local clock
+    int ScenarioLoaderThreads { 0 }; // number of worker threads used to preload scenario files; 0 = serial preload
+    int ModelLoaderThreads { 0 }; // number of worker threads reading models requested for asynchronous load; 0 = read on the main thread
+    int ModelLoaderBudget { 2 }; // number of asynchronously loaded models handed to the renderer in single frame
     bool bInactivePause{ true }; // automatyczna pauza, gdy okno nieaktywne
     int iSlowMotionMask{ -1 }; // maska wyłączanych właściwości
     bool bHideConsole{ false }; // hunter-271211: ukrywanie konsoli
@@ -124,9 +145,12 @@ struct global_settings {
     int iMultisampling{ 2 }; // tryb antyaliasingu: 0=brak,1=2px,2=4px,3=8px,4=16px
     bool bSmoothTraction{ true }; // wygładzanie drutów starym sposobem
     float SplineFidelity{ 1.f }; // determines segment size during conversion of splines to geometry
+    double SplineTolerance{ 0.001 }; // max error of distance to spline parameter conversion, in metres
     bool ResourceSweep{ true }; // gfx resource garbage collection
     bool ResourceMove{ false }; // gfx resources are moved between cpu and gpu side instead of sending a copy
     bool compress_tex{ true }; // all textures are compressed on gpu side
+    int TextureLoaderThreads{ 0 }; // number of worker threads decoding texture files; 0 = textures are decoded on the main thread
+    int TextureUploadBudget{ 0 }; // amount of texture data uploaded to the gpu in single frame, in kb; 0 = no limit
     std::string asSky{ "1" };
     double fFpsAverage{ 20.0 }; // oczekiwana wartosć FPS
     double fFpsDeviation{ 5.0 }; // odchylenie standardowe FPS
@@ -19,9 +19,236 @@ std::ofstream output; // standardowy "log.txt", można go wyłączyć
 std::ofstream errors; // lista błędów "errors.txt", zawsze działa
 std::ofstream comms; // lista komunikatow "comms.txt", można go wyłączyć
 char logbuffer[ 256 ];
+std::mutex logmutex; // guards the log files. log functions can be called from worker threads
 
 char endstring[10] = "\n";
 
+namespace {
+
+enum class log_target {
+    log,
+    errors
+};
+
+struct log_entry {
+    log_target target { log_target::log };
+    std::string text;
+};
+
+// bounded lock-free multiple producer, single consumer queue
+class log_queue {
+
+public:
+// constructors
+    explicit log_queue( std::size_t const Capacity ) :
+        m_cells( new cell[ Capacity ] ),
+        m_mask( Capacity - 1 ) {
+        // NOTE: capacity has to be a power of two
+        assert( ( Capacity & m_mask ) == 0 );
+        for( std::size_t idx = 0; idx < Capacity; ++idx ) {
+            m_cells[ idx ].sequence.store( idx, std::memory_order_relaxed ); } }
+// methods
+    // adds provided entry to the queue. returns: false if the queue is full
+    bool
+        push( log_entry &&Entry ) {
+            auto position { m_pushposition.load( std::memory_order_relaxed ) };
+            cell *target;
+            while( true ) {
+                target = &m_cells[ position & m_mask ];
+                auto const sequence { target->sequence.load( std::memory_order_acquire ) };
+                auto const difference { static_cast<std::ptrdiff_t>( sequence ) - static_cast<std::ptrdiff_t>( position ) };
+                if( difference == 0 ) {
+                    if( true == m_pushposition.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) ) {
+                        break;
+                    }
+                }
+                else if( difference < 0 ) {
+                    return false;
+                }
+                else {
+                    position = m_pushposition.load( std::memory_order_relaxed );
+                }
+            }
+            target->entry = std::move( Entry );
+            target->sequence.store( position + 1, std::memory_order_release );
+            return true; }
+    // retrieves oldest entry from the queue. returns: false if the queue is empty
+    // NOTE: only one thread at a time can retrieve the entries
+    bool
+        pop( log_entry &Entry ) {
+            // the consumer is the only writer of the position, other threads only read it to estimate the queue size
+            auto const position { m_popposition.load( std::memory_order_relaxed ) };
+            auto &source { m_cells[ position & m_mask ] };
+            if( source.sequence.load( std::memory_order_acquire ) != position + 1 ) {
+                return false;
+            }
+            Entry = std::move( source.entry );
+            source.sequence.store( position + m_mask + 1, std::memory_order_release );
+            m_popposition.store( position + 1, std::memory_order_relaxed );
+            return true; }
+    // returns: approximate number of entries in the queue
+    std::size_t
+        size() const {
+            auto const popposition { m_popposition.load( std::memory_order_relaxed ) };
+            auto const pushposition { m_pushposition.load( std::memory_order_relaxed ) };
+            // the positions are read at slightly different moments, so the difference is guarded against underflow
+            return (
+                pushposition > popposition ?
+                    pushposition - popposition :
+                    0 ); }
+    std::size_t
+        capacity() const {
+            return m_mask + 1; }
+
+private:
+// types
+    struct cell {
+        std::atomic<std::size_t> sequence;
+        log_entry entry;
+    };
+// members
+    std::unique_ptr<cell[]> m_cells;
+    std::size_t const m_mask;
+    std::atomic<std::size_t> m_pushposition { 0 };
+    std::atomic<std::size_t> m_popposition { 0 };
+};
+
+void write_log( const char *str );
+void write_error( const char *str );
+
+// moves log file writes off the calling threads, to a background thread
+class log_writer {
+
+public:
+// destructor
+    ~log_writer() {
+        stop(); }
+// methods
+    // queues provided line for writing, or writes it directly if the queue isn't available
+    void
+        write( log_target const Target, const char *Text ) {
+            if( ( true == m_running )
+             || ( true == start() ) ) {
+                if( true == m_queue.push( { Target, Text } ) ) {
+                    if( ( Target == log_target::errors )
+                     || ( m_queue.size() > m_queue.capacity() / 2 ) ) {
+                        // errors are written out without waiting for the timer, and we don't want the queue to run full
+                        m_flushrequested = true;
+                        m_condition.notify_one();
+                    }
+                    return;
+                }
+                if( Target != log_target::errors ) {
+                    // under heavy load regular lines are dropped, but errors are always recorded
+                    ++m_dropped;
+                    return;
+                }
+            }
+            // synchronous fallback
+            std::lock_guard<std::mutex> lock( logmutex );
+            drain( false );
+            write( { Target, Text } );
+            flush_files(); }
+    // writes out pending lines on the calling thread. returns: true if the lines were written
+    // NOTE: with Wait == false the call doesn't block, so it's safe to use in crash handlers
+    bool
+        flush( bool const Wait = true ) {
+            std::unique_lock<std::mutex> lock( logmutex, std::defer_lock );
+            if( true == Wait ) { lock.lock(); }
+            else if( false == lock.try_lock() ) { return false; }
+            drain( true );
+            return true; }
+    // terminates the background thread. pending lines are written out, further lines are written by the callers
+    void
+        stop() {
+            {
+                std::lock_guard<std::mutex> lock( m_threadmutex );
+                m_exit = true;
+                if( false == m_thread.joinable() ) { return; }
+            }
+            m_condition.notify_one();
+            m_thread.join();
+            m_running = false;
+            flush(); }
+    // returns number of lines dropped due to queue overflow
+    std::uint64_t
+        dropped() const {
+            return m_dropped; }
+
+private:
+// methods
+    bool
+        start() {
+            if( false == Global.AsyncLogs ) { return false; }
+            std::lock_guard<std::mutex> lock( m_threadmutex );
+            if( true == m_exit ) { return false; }
+            if( false == m_running ) {
+                m_thread = std::thread( &log_writer::work, this );
+                m_running = true;
+            }
+            return true; }
+    // background thread loop, writes out queued lines in batches
+    void
+        work() {
+            while( true ) {
+                {
+                    std::unique_lock<std::mutex> lock( m_threadmutex );
+                    m_condition.wait_for(
+                        lock,
+                        std::chrono::milliseconds( 250 ),
+                        [this]() {
+                            return ( m_exit || m_flushrequested ); } );
+                    if( true == m_exit ) { return; }
+                }
+                m_flushrequested = false;
+                flush();
+            } }
+    // writes out queued lines. NOTE: requires locked log mutex
+    void
+        drain( bool const Flush ) {
+            log_entry entry;
+            auto written { false };
+            while( true == m_queue.pop( entry ) ) {
+                write( entry );
+                written = true;
+            }
+            auto const dropped { m_dropped.load() };
+            if( dropped != m_droppedreported ) {
+                write( { log_target::log, "Log queue overflow, " + std::to_string( dropped - m_droppedreported ) + " line(s) dropped" } );
+                m_droppedreported = dropped;
+                written = true;
+            }
+            if( ( true == written )
+             && ( true == Flush ) ) {
+                flush_files();
+            } }
+    void
+        write( log_entry const &Entry ) const {
+            switch( Entry.target ) {
+                case log_target::log:    { write_log( Entry.text.c_str() ); break; }
+                case log_target::errors: { write_error( Entry.text.c_str() ); break; }
+                default: { break; }
+            } }
+    void
+        flush_files() const {
+            if( output.is_open() ) { output.flush(); }
+            if( errors.is_open() ) { errors.flush(); } }
+// members
+    log_queue m_queue { 8192 };
+    std::atomic<bool> m_running { false };
+    std::atomic<bool> m_flushrequested { false };
+    std::atomic<std::uint64_t> m_dropped { 0 };
+    std::uint64_t m_droppedreported { 0 }; // guarded by log mutex
+    bool m_exit { false }; // guarded by thread mutex
+    std::mutex m_threadmutex;
+    std::condition_variable m_condition;
+    std::thread m_thread;
+};
+
+log_writer logwriter;
+
+} // anonymous namespace
+
 std::string filename_date() {
     ::SYSTEMTIME st;
 
@@ -65,10 +292,10 @@ std::string filename_scenery() {
     }
 }
 
-void WriteLog( const char *str, logtype const Type ) {
+namespace {
 
-    if( str == nullptr ) { return; }
-    if( true == TestFlag( Global.DisabledLogTypes, (int)Type ) ) { return; }
+// NOTE: requires locked log mutex
+void write_log( const char *str ) {
 
     if (Global.iWriteLogEnabled & 1) {
         if( !output.is_open() ) {
@@ -80,7 +307,6 @@ void WriteLog( const char *str, logtype const Type ) {
             output.open( filename, std::ios::trunc );
         }
         output << str << "\n";
-        output.flush();
     }
 
 #ifdef _WIN32
@@ -96,11 +322,8 @@ void WriteLog( const char *str, logtype const Type ) {
 #endif
 }
 
-// Ra: bezwarunkowa rejestracja poważnych błędów
-void ErrorLog( const char *str, logtype const Type ) {
-
-    if( str == nullptr ) { return; }
-    if( true == TestFlag( Global.DisabledLogTypes, (int)Type ) ) { return; }
+// NOTE: requires locked log mutex
+void write_error( const char *str ) {
 
     if (!errors.is_open()) {
 
@@ -113,9 +336,46 @@ void ErrorLog( const char *str, logtype const Type ) {
     }
 
     errors << str << "\n";
-    errors.flush();
+}
+
+} // anonymous namespace
+
+void WriteLog( const char *str, logtype const Type ) {
+
+    if( str == nullptr ) { return; }
+    if( true == TestFlag( Global.DisabledLogTypes, (int)Type ) ) { return; }
+
+    logwriter.write( log_target::log, str );
+}
+
+// Ra: bezwarunkowa rejestracja poważnych błędów
+void ErrorLog( const char *str, logtype const Type ) {
+
+    if( str == nullptr ) { return; }
+    if( true == TestFlag( Global.DisabledLogTypes, (int)Type ) ) { return; }
+
+    logwriter.write( log_target::errors, str );
 };
 
+// writes out pending log lines on the calling thread
+// NOTE: doesn't block if the logs are being written by another thread, so it can be used by crash handlers
+void FlushLogs() {
+
+    logwriter.flush( false );
+}
+
+// terminates background log writing. lines logged afterwards are written directly by the caller
+void CloseLogs() {
+
+    logwriter.stop();
+}
+
+// returns number of log lines dropped due to log queue overflow
+std::uint64_t DroppedLogLines() {
+
+    return logwriter.dropped();
+}
+
 void Error(const std::string &asMessage, bool box)
 {
     // if (box)
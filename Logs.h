@@ -27,4 +27,10 @@ void ErrorLog( const std::string &str, logtype const Type = logtype::generic );
 void WriteLog( const std::string &str, logtype const Type = logtype::generic );
 void CommLog( const char *str );
 void CommLog( const std::string &str );
+// writes out pending log lines on the calling thread
+void FlushLogs();
+// terminates background log writing. lines logged afterwards are written directly by the caller
+void CloseLogs();
+// returns number of log lines dropped due to log queue overflow
+std::uint64_t DroppedLogLines();
 
@@ -572,6 +572,33 @@ struct TMotorParameters
     }
 };
 
+// tables of vehicle parameters read from the .fiz file. the data doesn't change once loaded,
+// so a single copy is shared by all vehicles of the same type, and vehicles keep only their mutable state
+struct TMoverTables
+{
+	TBrakePressureTable BrakePressureTable; /*wyszczegolnienie cisnien w rurze*/
+	int Lights[2][17]; // pozycje świateł, przód - tył, 1 .. 16
+	TSchemeTable RList;     /*lista rezystorow rozruchowych i polaczen silnikow, dla dizla: napelnienia*/
+	TMotorParameters MotorParam[MotorParametersArraySize + 1];
+	/*rozne parametry silnika przy bocznikowaniach*/
+	/*dla lokomotywy spalinowej z przekladnia mechaniczna: przelozenia biegow*/
+	TDESchemeTable DElist;
+	TMPTRelayTable MPTRelay;
+	TShuntSchemeTable SST;
+
+	TMoverTables();
+	// returns pipe pressure settings for specified brake controller position, or empty settings for undefined positions
+	TBrakePressure const &
+		BrakePressure( int const Position ) const;
+	// returns memory used by the tables, in bytes
+	std::size_t
+		Size() const;
+	// returns tables shared by vehicles without loaded definition
+	static
+	std::shared_ptr<TMoverTables const>
+		Empty();
+};
+
 struct TSecuritySystem
 {
     int SystemType { 0 }; /*0: brak, 1: czuwak aktywny, 2: SHP/sygnalizacja kabinowa*/
@@ -825,6 +852,7 @@ public:
 							/*--sekcja stalych typowych parametrow*/
 	std::string TypeName;         /*nazwa serii/typu*/
 								  //TrainType: string;       {typ: EZT/elektrowoz - Winger 040304}
+	std::shared_ptr<TMoverTables const> Tables; // tables of the type, shared with other vehicles of the same type
 	int TrainType = 0; /*Ra: powinno być szybciej niż string*/
 	TEngineType EngineType = TEngineType::None;               /*typ napedu*/
 	TPowerParameters EnginePowerSource;    /*zrodlo mocy dla silnikow*/
@@ -877,7 +905,6 @@ public:
 	std::shared_ptr<TReservoir> Pipe2;
 
 	TLocalBrake LocalBrake = TLocalBrake::NoBrake;  /*rodzaj hamulca indywidualnego*/
-	TBrakePressureTable BrakePressureTable; /*wyszczegolnienie cisnien w rurze*/
 	TBrakePressure BrakePressureActual; //wartości ważone dla aktualnej pozycji kranu
 	int ASBType = 0;            /*0: brak hamulca przeciwposlizgowego, 1: reczny, 2: automat*/
 	int TurboTest = 0;
@@ -923,18 +950,13 @@ public:
 	int LightsPosNo = 0;
     int LightsDefPos = 1;
 	bool LightsWrap = false;
-	int Lights[2][17]; // pozycje świateł, przód - tył, 1 .. 16
     int ScndInMain{ 0 };     /*zaleznosc bocznika od nastawnika*/
 	bool MBrake = false;     /*Czy jest hamulec reczny*/
 	double StopBrakeDecc = 0.0;
 	TSecuritySystem SecuritySystem;
 
 	/*-sekcja parametrow dla lokomotywy elektrycznej*/
-	TSchemeTable RList;     /*lista rezystorow rozruchowych i polaczen silnikow, dla dizla: napelnienia*/
 	int RlistSize = 0;
-	TMotorParameters MotorParam[MotorParametersArraySize + 1];
-	/*rozne parametry silnika przy bocznikowaniach*/
-	/*dla lokomotywy spalinowej z przekladnia mechaniczna: przelozenia biegow*/
 	TTransmision Transmision;
 	// record   {liczba zebow przekladni}
 	//  NToothM, NToothW : byte;
@@ -1020,11 +1042,8 @@ public:
 
 	bool Flat = false;
 	double Vhyp = 1.0;
-	TDESchemeTable DElist;
 	double Vadd = 1.0;
-	TMPTRelayTable MPTRelay;
 	int RelayType = 0;
-	TShuntSchemeTable SST;
 	double PowerCorRatio = 1.0; //Wspolczynnik korekcyjny
     /*- dla uproszczonego modelu silnika (dumb) oraz dla drezyny*/
 	double Ftmax = 0.0;
@@ -1107,6 +1126,8 @@ public:
 	double PipeBrakePress = 0.0;                /*!o cisnienie w cylindrach hamulcowych z przewodu*/
 	double PipePress = 0.0;                    /*!o cisnienie w przewodzie glownym*/
 	double EqvtPipePress = 0.0;                /*!o cisnienie w przewodzie glownym skladu*/
+	bool PipeFlowDeferred = false;             /*przeplywy zaworu i miedzy pojazdami liczone dla calego skladu przez brake_pipe_solver*/
+	bool PipeFlowPending = false;              /*przeplywy przewodu glownego czekaja na brake_pipe_solver*/
 	double Volume = 0.0;                       /*objetosc spr. powietrza w zbiorniku hamulca*/
 	double CompressedVolume = 0.0;              /*objetosc spr. powietrza w ukl. zasilania*/
 	double PantVolume = 0.48;                    /*objetosc spr. powietrza w ukl. pantografu*/ // aby podniesione pantografy opadły w krótkim czasie przy wyłączonej sprężarce
@@ -1336,6 +1357,13 @@ public:
 	double ComputeMovement(double dt, double dt1, const TTrackShape &Shape, TTrackParam &Track, TTractionParam &ElectricTraction, const TLocation &NewLoc, TRotation &NewRot); //oblicza przesuniecie pojazdu
 	double FastComputeMovement(double dt, const TTrackShape &Shape, TTrackParam &Track, const TLocation &NewLoc, TRotation &NewRot); //oblicza przesuniecie pojazdu - wersja zoptymalizowana
     void compute_movement_( double const Deltatime );
+    // reduced fidelity physics of distant consists:
+    // returns tractive effort (in N) available at specified speed (in m/s) with full power setting
+    double ReducedTractionForce( double const Velocity ) const;
+    // returns fraction of available tractive effort requested by current controller setting, signed with requested direction
+    double ReducedTractionRatio() const;
+    // updates state observed by the AI and linked vehicles, for movement calculated by the simplified consist model
+    void ReducedMovement( double const Deltatime, double const Velocity, double const Acceleration, double const Brakepressure );
 	double ShowEngineRotation(int VehN);
 
 	// Q *******************************************************************************************
@@ -1404,6 +1432,7 @@ public:
 	/*pomocnicze funkcje dla ukladow pneumatycznych*/
 	void UpdateBrakePressure(double dt);
 	void UpdatePipePressure(double dt);
+	void FinishPipePressure(); // completes brake pipe update, after valve and inter-vehicle flows were applied
 	void CompressorCheck(double dt);/*wlacza, wylacza kompresor, laduje zbiornik*/
 	void UpdatePantVolume(double dt);             //Ra
 	void UpdateScndPipePressure(double dt);
@@ -1531,17 +1560,17 @@ private:
     TPowerType LoadFIZ_PowerDecode( std::string const &Power );
     TPowerSource LoadFIZ_SourceDecode( std::string const &Source );
     TEngineType LoadFIZ_EngineDecode( std::string const &Engine );
-    bool readMPT0( std::string const &line );
-    bool readMPT( std::string const &line );                                             //Q 20160717
-    bool readMPTElectricSeries( std::string const &line );
-    bool readMPTDieselElectric( std::string const &line );
-    bool readMPTDieselEngine( std::string const &line );
-	bool readBPT(/*int const ln,*/ std::string const &line);                                             //Q 20160721
-    bool readRList( std::string const &Input );
-    bool readDList( std::string const &line );
-    bool readFFList( std::string const &line );
-    bool readWWList( std::string const &line );
-    bool readLightsList( std::string const &Input );
+    bool readMPT0( std::string const &line, TMoverTables &Target );
+    bool readMPT( std::string const &line, TMoverTables &Target );                                             //Q 20160717
+    bool readMPTElectricSeries( std::string const &line, TMoverTables &Target );
+    bool readMPTDieselElectric( std::string const &line, TMoverTables &Target );
+    bool readMPTDieselEngine( std::string const &line, TMoverTables &Target );
+	bool readBPT(/*int const ln,*/ std::string const &line, TMoverTables &Target);                                             //Q 20160721
+    bool readRList( std::string const &Input, TMoverTables &Target );
+    bool readDList( std::string const &line, TMoverTables &Target );
+    bool readFFList( std::string const &line, TMoverTables &Target );
+    bool readWWList( std::string const &line, TMoverTables &Target );
+    bool readLightsList( std::string const &Input, TMoverTables &Target );
     void BrakeValveDecode( std::string const &s );                                                            //Q 20160719
 	void BrakeSubsystemDecode();                                                                     //Q 20160719
 };
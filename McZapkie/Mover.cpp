@@ -11,6 +11,7 @@ http://mozilla.org/MPL/2.0/.
 #include "MOVER.h"
 
 #include "Oerlikon_ESt.h"
+#include "fizcache.h"
 #include "utilities.h"
 #include "Globals.h"
 #include "Logs.h"
@@ -123,25 +124,25 @@ double TMoverParameters::Current(double n, double U)
         //-     WriteLog("B");
     }
 
-    ResistorsFlag = (RList[MainCtrlActualPos].R > 0.01); // and (!DelayCtrlFlag)
+    ResistorsFlag = (Tables->RList[MainCtrlActualPos].R > 0.01); // and (!DelayCtrlFlag)
     ResistorsFlag =
         (ResistorsFlag || ((DynamicBrakeFlag == true) && (DynamicBrakeType == dbrake_automatic)));
 
     if ((TrainType == dt_ET22) && (DelayCtrlFlag) && (MainCtrlActualPos > 1))
-        Bn = 1.0 - 1.0 / RList[MainCtrlActualPos].Bn;
+        Bn = 1.0 - 1.0 / Tables->RList[MainCtrlActualPos].Bn;
     else
         Bn = 1; // to jest wykonywane dla EU07
 
-    R = RList[MainCtrlActualPos].R * Bn + CircuitRes;
+    R = Tables->RList[MainCtrlActualPos].R * Bn + CircuitRes;
 
     if( ( TrainType != dt_EZT )
      || ( Imin != IminLo )
      || ( false == ScndS ) ) {
         // yBARC - boczniki na szeregu poprawnie
-        Mn = RList[ MainCtrlActualPos ].Mn; // to jest wykonywane dla EU07
+        Mn = Tables->RList[ MainCtrlActualPos ].Mn; // to jest wykonywane dla EU07
     }
     else {
-        Mn = RList[ MainCtrlActualPos ].Mn * RList[ MainCtrlActualPos ].Bn;
+        Mn = Tables->RList[ MainCtrlActualPos ].Mn * Tables->RList[ MainCtrlActualPos ].Bn;
     }
 
     if (DynamicBrakeFlag && (!FuseFlag) && (DynamicBrakeType == dbrake_automatic) &&
@@ -149,9 +150,9 @@ double TMoverParameters::Current(double n, double U)
     {
         // TODO: zrobic bardziej uniwersalne nie tylko dla EP09
         MotorCurrent =
-            -Max0R(MotorParam[0].fi * (Vadd / (Vadd + MotorParam[0].Isat) - MotorParam[0].fi0), 0) * n * 2.0 / DynamicBrakeRes;
+            -Max0R(Tables->MotorParam[0].fi * (Vadd / (Vadd + Tables->MotorParam[0].Isat) - Tables->MotorParam[0].fi0), 0) * n * 2.0 / DynamicBrakeRes;
     }
-    else if( ( RList[ MainCtrlActualPos ].Bn == 0 )
+    else if( ( Tables->RList[ MainCtrlActualPos ].Bn == 0 )
           || ( false == StLinFlag ) ) {
         // wylaczone
         MotorCurrent = 0;
@@ -163,8 +164,8 @@ double TMoverParameters::Current(double n, double U)
         if (ScndCtrlActualPos < 255) // tak smiesznie bede wylaczal
         {
             if( ( ScndInMain )
-             && ( RList[ MainCtrlActualPos ].ScndAct != 255 ) ) {
-                SP = RList[ MainCtrlActualPos ].ScndAct;
+             && ( Tables->RList[ MainCtrlActualPos ].ScndAct != 255 ) ) {
+                SP = Tables->RList[ MainCtrlActualPos ].ScndAct;
             }
 
             Rz = Mn * WindingRes + R;
@@ -185,7 +186,7 @@ double TMoverParameters::Current(double n, double U)
 					{ // z Megapacka
 						Rz = WindingRes + R;
 						MotorCurrent =
-							-MotorParam[SP].fi * n / Rz; //{hamowanie silnikiem na oporach rozruchowych}
+							-Tables->MotorParam[SP].fi * n / Rz; //{hamowanie silnikiem na oporach rozruchowych}
 					}
 				}
                 else
@@ -193,13 +194,13 @@ double TMoverParameters::Current(double n, double U)
             }
             else
             {
-                U1 = U + Mn * n * MotorParam[SP].fi0 * MotorParam[SP].fi;
+                U1 = U + Mn * n * Tables->MotorParam[SP].fi0 * Tables->MotorParam[SP].fi;
                 //          writepaslog("U1             ", FloatToStr(U1));
                 //          writepaslog("Isat           ", FloatToStr(MotorParam[SP].Isat));
                 //          writepaslog("fi             ", FloatToStr(MotorParam[SP].fi));
-                Isf = Sign(U1) * MotorParam[SP].Isat;
+                Isf = Sign(U1) * Tables->MotorParam[SP].Isat;
                 //          writepaslog("Isf            ", FloatToStr(Isf));
-                Delta = square(Isf * Rz + Mn * MotorParam[SP].fi * n - U1) +
+                Delta = square(Isf * Rz + Mn * Tables->MotorParam[SP].fi * n - U1) +
                         4.0 * U1 * Isf * Rz; // 105 * 1.67 + Mn * 140.9 * 20.532 - U1
                 //          DeltaQ = Isf * Rz + Mn * MotorParam[SP].fi * n - U1 + 4 * U1 * Isf * Rz;
                 //          writepaslog("Delta          ", FloatToStr(Delta));
@@ -209,10 +210,10 @@ double TMoverParameters::Current(double n, double U)
                 {
                     if (U > 0)
                         MotorCurrent =
-                            (U1 - Isf * Rz - Mn * MotorParam[SP].fi * n + std::sqrt(Delta)) / (2.0 * Rz);
+                            (U1 - Isf * Rz - Mn * Tables->MotorParam[SP].fi * n + std::sqrt(Delta)) / (2.0 * Rz);
                     else
                         MotorCurrent =
-                            (U1 - Isf * Rz - Mn * MotorParam[SP].fi * n - std::sqrt(Delta)) / (2.0 * Rz);
+                            (U1 - Isf * Rz - Mn * Tables->MotorParam[SP].fi * n - std::sqrt(Delta)) / (2.0 * Rz);
                 }
                 else
                     MotorCurrent = 0;
@@ -234,7 +235,7 @@ double TMoverParameters::Current(double n, double U)
 	else
 		Im = MotorCurrent;
 
-    EnginePower = abs(Itot) * (1 + RList[MainCtrlActualPos].Mn) * abs(U) / 1000.0;
+    EnginePower = abs(Itot) * (1 + Tables->RList[MainCtrlActualPos].Mn) * abs(U) / 1000.0;
 
     // awarie
     MotorCurrent = abs(Im); // zmienna pomocnicza
@@ -260,32 +261,18 @@ double TMoverParameters::Current(double n, double U)
 }
 
 // *************************************************************************************************
-//  główny konstruktor
+//  tablice parametrów typu pojazdu
 // *************************************************************************************************
-TMoverParameters::TMoverParameters(double VelInitial, std::string TypeNameInit, std::string NameInit, int Cab) :
-TypeName( TypeNameInit ),
-Name( NameInit ),
-ActiveCab( Cab )
-{
-    WriteLog(
-        "------------------------------------------------------");
-    WriteLog("init default physic values for " + NameInit + ", [" + TypeNameInit + "]");
-    Dim = TDimension();
+namespace {
 
-    // BrakeLevelSet(-2); //Pascal ustawia na 0, przestawimy na odcięcie (CHK jest jeszcze nie wczytane!)
-    iLights[ 0 ] = 0;
-    iLights[ 1 ] = 0; //światła zgaszone
+// tables of vehicle types loaded in the current session, keyed by their .fiz file
+std::unordered_map<std::string, std::shared_ptr<TMoverTables const>> typetables;
+std::mutex typetablesmutex;
 
-    // inicjalizacja stalych
-    for (int b = 0; b < ResArraySize + 1; ++b)
-    {
-        RList[b] = TScheme();
-    }
-    RlistSize = 0;
-    for(int b = 0; b < MotorParametersArraySize + 1; ++b) {
-        MotorParam[ b ] = TMotorParameters();
-    }
+} // namespace
 
+TMoverTables::TMoverTables()
+{
     for (int b = 0; b < 2; ++b)
         for (int k = 0; k < 17; ++k)
             Lights[b][k] = 0;
@@ -302,6 +289,59 @@ ActiveCab( Cab )
         BrakePressureTable[-2].BrakePressureVal = -1.0;
         BrakePressureTable[-2].FlowSpeedVal = 0.0;
     }
+}
+
+// returns pipe pressure settings for specified brake controller position, or empty settings for undefined positions
+TBrakePressure const &
+TMoverTables::BrakePressure( int const Position ) const {
+
+    static TBrakePressure const undefined {};
+
+    auto const lookup { BrakePressureTable.find( Position ) };
+    return (
+        lookup != BrakePressureTable.end() ?
+            lookup->second :
+            undefined );
+}
+
+// returns memory used by the tables, in bytes
+std::size_t
+TMoverTables::Size() const {
+    // NOTE: map nodes are estimated as key, value and three pointers plus colour flag of the tree
+    return (
+        sizeof( TMoverTables )
+        + BrakePressureTable.size() * ( sizeof( TBrakePressureTable::value_type ) + 4 * sizeof( void * ) ) );
+}
+
+// returns tables shared by vehicles without loaded definition
+std::shared_ptr<TMoverTables const>
+TMoverTables::Empty() {
+
+    static auto const empty { std::make_shared<TMoverTables const>() };
+    return empty;
+}
+
+// *************************************************************************************************
+//  główny konstruktor
+// *************************************************************************************************
+TMoverParameters::TMoverParameters(double VelInitial, std::string TypeNameInit, std::string NameInit, int Cab) :
+TypeName( TypeNameInit ),
+Name( NameInit ),
+ActiveCab( Cab )
+{
+    WriteLog(
+        "------------------------------------------------------");
+    WriteLog("init default physic values for " + NameInit + ", [" + TypeNameInit + "]");
+    Dim = TDimension();
+
+    // BrakeLevelSet(-2); //Pascal ustawia na 0, przestawimy na odcięcie (CHK jest jeszcze nie wczytane!)
+    iLights[ 0 ] = 0;
+    iLights[ 1 ] = 0; //światła zgaszone
+
+    // inicjalizacja stalych
+    Tables = TMoverTables::Empty();
+    RlistSize = 0;
+
     for( int b = 0; b < 4; ++b ) {
         BrakeDelay[ b ] = 0.0;
     }
@@ -584,7 +624,7 @@ void TMoverParameters::BrakeLevelSet(double b)
     while ((x < BrakeCtrlPos) && (BrakeCtrlPos >= -1)) // jeśli zmniejszyło się o 1
         if (!DecBrakeLevelOld()) // T_MoverParameters::
             break;
-    BrakePressureActual = BrakePressureTable[BrakeCtrlPos]; // skopiowanie pozycji
+    BrakePressureActual = Tables->BrakePressure( BrakeCtrlPos ); // skopiowanie pozycji
     /*
     //youBy: obawiam sie, ze tutaj to nie dziala :P
     //Ra 2014-03: było tak zrobione, że działało - po każdej zmianie pozycji była wywoływana ta
@@ -596,10 +636,10 @@ void TMoverParameters::BrakeLevelSet(double b)
        double u=fBrakeCtrlPos-double(x); //ułamek ponad wartość całkowitą
        if (u>0.0)
        {//wyliczamy wartości ważone
-        BrakePressureActual.PipePressureVal+=-u*BrakePressureActual.PipePressureVal+u*BrakePressureTable[BrakeCtrlPos+1+2].PipePressureVal;
+        BrakePressureActual.PipePressureVal+=-u*BrakePressureActual.PipePressureVal+u*Tables->BrakePressure( BrakeCtrlPos+1+2 ).PipePressureVal;
         //BrakePressureActual.BrakePressureVal+=-u*BrakePressureActual.BrakePressureVal+u*BrakePressureTable[BrakeCtrlPos+1].BrakePressureVal;
     //to chyba nie będzie tak działać, zwłaszcza w EN57
-        BrakePressureActual.FlowSpeedVal+=-u*BrakePressureActual.FlowSpeedVal+u*BrakePressureTable[BrakeCtrlPos+1+2].FlowSpeedVal;
+        BrakePressureActual.FlowSpeedVal+=-u*BrakePressureActual.FlowSpeedVal+u*Tables->BrakePressure( BrakeCtrlPos+1+2 ).FlowSpeedVal;
        }
       }
     */
@@ -1468,6 +1508,53 @@ void TMoverParameters::compute_movement_( double const Deltatime ) {
     update_doors( Deltatime );
 }
 
+// returns tractive effort (in N) available at specified speed (in m/s) with full power setting
+// NOTE: follows the model of 'dumb' engine, with starting effort limited by adhesion of powered axles
+double TMoverParameters::ReducedTractionForce( double const Velocity ) const {
+
+    if( ( Power <= 0.0 ) || ( NPoweredAxles == 0 ) ) { return 0.0; }
+
+    auto const adhesionlimit { TotalMassxg * Adhesive( RunningTrack.friction ) * NPoweredAxles / std::max( 1, NAxles ) };
+    auto const maxforce { (
+        Ftmax > 0.0 ?
+            std::min( Ftmax, adhesionlimit ) :
+            adhesionlimit ) };
+
+    return (
+        std::abs( Velocity ) > 0.1 ?
+            std::min( 1000.0 * Power / std::abs( Velocity ), maxforce ) :
+            maxforce );
+}
+
+// returns fraction of available tractive effort requested by current controller setting, signed with requested direction
+double TMoverParameters::ReducedTractionRatio() const {
+
+    if( ( false == Mains )
+     || ( DirAbsolute == 0 )
+     || ( MainCtrlPosNo <= 0 ) ) {
+        return 0.0;
+    }
+    return DirAbsolute * clamp( static_cast<double>( MainCtrlPos ) / MainCtrlPosNo, 0.0, 1.0 );
+}
+
+// updates state observed by the AI and linked vehicles, for movement calculated by the simplified consist model
+void TMoverParameters::ReducedMovement( double const Deltatime, double const Velocity, double const Acceleration, double const Brakepressure ) {
+
+    V = Velocity;
+    Vel = std::abs( V ) * 3.6;
+    nrot = v2n();
+    AccS = Acceleration;
+    AccSVBased = Acceleration;
+    AccN = 0.0;
+    AccVert = 0.0;
+    FTotal = Acceleration * TotalMass;
+    BrakePress = Brakepressure;
+    DistCounter += std::abs( V ) * Deltatime / 1000.0;
+    LastSwitchingTime += Deltatime;
+    // controller settings of multiple unit setups are passed as commands
+    RunInternalCommand();
+}
+
 double TMoverParameters::ShowEngineRotation(int VehN)
 { // Zwraca wartość prędkości obrotowej silnika wybranego pojazdu. Do 3 pojazdów (3×SN61).
     int b;
@@ -1579,7 +1666,7 @@ void TMoverParameters::OilPumpCheck( double const Timestep ) {
     auto const maxrevolutions {
         EngineType == TEngineType::DieselEngine ?
             dizel_nmax :
-            DElist[ MainCtrlPosNo ].RPM / 60.0 };
+            Tables->DElist[ MainCtrlPosNo ].RPM / 60.0 };
     auto const minpressure {
         OilPump.pressure_minimum > 0.f ?
             OilPump.pressure_minimum :
@@ -1722,7 +1809,7 @@ bool TMoverParameters::IncMainCtrl(int CtrlSpeed)
 					if( TrainType == dt_ET40 ) {
 						break; // this means ET40 won't react at all to fast acceleration command. should it issue just IncMainCtrl(1) instead?
                     }
-					while( ( RList[ MainCtrlPos ].R > 0.0 )
+					while( ( Tables->RList[ MainCtrlPos ].R > 0.0 )
 						&& IncMainCtrl( 1 ) ) {
 						// all work is done in the loop header
 						;
@@ -1737,7 +1824,7 @@ bool TMoverParameters::IncMainCtrl(int CtrlSpeed)
 					++MainCtrlPos;
 					OK = true;
 					if( Imax == ImaxHi ) {
-						if( RList[ MainCtrlPos ].Bn > 1 ) {
+						if( Tables->RList[ MainCtrlPos ].Bn > 1 ) {
 							if( true == MaxCurrentSwitch( false )) {
 								// wylaczanie wysokiego rozruchu
 								SetFlag( SoundFlag, sound::relay );
@@ -1892,9 +1979,9 @@ bool TMoverParameters::DecMainCtrl(int CtrlSpeed)
                         else if (CtrlSpeed > 1) /*and (ScndCtrlPos=0)*/
                         {
                             OK = true;
-                            if (RList[MainCtrlPos].R == 0) // Q: tu zrobilem = ;]
+                            if (Tables->RList[MainCtrlPos].R == 0) // Q: tu zrobilem = ;]
                                 DecMainCtrl(1);
-                            while ((RList[MainCtrlPos].R > 0) && DecMainCtrl(1))
+                            while ((Tables->RList[MainCtrlPos].R > 0) && DecMainCtrl(1))
                                 ; // takie chamskie, potem poprawie}
                         }
                         break;
@@ -1909,7 +1996,7 @@ bool TMoverParameters::DecMainCtrl(int CtrlSpeed)
                         }
                         else if (CtrlSpeed > 1)
                         {
-                            while ((MainCtrlPos > 0) || (RList[MainCtrlPos].Mn > 0))
+                            while ((MainCtrlPos > 0) || (Tables->RList[MainCtrlPos].Mn > 0))
                                 DecMainCtrl(1);
                             OK = true;
                         }
@@ -2871,7 +2958,7 @@ bool TMoverParameters::IncBrakeLevelOld(void)
             // youBy: EP po nowemu
             IBLO = true;
             if ((BrakePressureActual.PipePressureVal < 0) &&
-                (BrakePressureTable[BrakeCtrlPos - 1].PipePressureVal > 0))
+                (Tables->BrakePressure( BrakeCtrlPos - 1 ).PipePressureVal > 0))
                 LimPipePress = PipePress;
         }
         else {
@@ -3298,7 +3385,7 @@ void TMoverParameters::CompressorCheck(double dt)
                     CompressedVolume +=
                         CompressorSpeed
                         * ( 2.0 * MaxCompressor - Compressor ) / MaxCompressor
-                        * ( ( 60.0 * std::abs( enrot ) ) / DElist[ MainCtrlPosNo ].RPM )
+                        * ( ( 60.0 * std::abs( enrot ) ) / Tables->DElist[ MainCtrlPosNo ].RPM )
                         * dt;
                 }
                 else {
@@ -3463,7 +3550,7 @@ void TMoverParameters::CompressorCheck(double dt)
                 // the compressor is coupled with the diesel engine, engine revolutions affect the output
                 if( false == CompressorGovernorLock ) {
                     auto const enginefactor { (
-                        EngineType == TEngineType::DieselElectric ? ( ( 60.0 * std::abs( enrot ) ) / DElist[ MainCtrlPosNo ].RPM ) :
+                        EngineType == TEngineType::DieselElectric ? ( ( 60.0 * std::abs( enrot ) ) / Tables->DElist[ MainCtrlPosNo ].RPM ) :
                         EngineType == TEngineType::DieselEngine ? ( std::abs( enrot ) / nmax ) :
                         1.0 ) }; // shouldn't ever get here but, eh
                     CompressedVolume +=
@@ -3712,12 +3799,31 @@ void TMoverParameters::UpdatePipePressure(double dt)
 
     Pipe->Act();
     PipePress = Pipe->P();
+
+    dpMainValve = dpMainValve / (100.0 * dt); // normalizacja po czasie do syczenia;
+
+    if (CompressedVolume < 0.0)
+        CompressedVolume = 0.0;
+
+    if( true == PipeFlowDeferred ) {
+        // flows through the brake valve and to coupled vehicles are calculated for the whole consist at once,
+        // the solver completes the update afterwards
+        PipeFlowPending = true;
+        return;
+    }
+
     if( ( Hamulec->GetBrakeStatus() & b_dmg ) == b_dmg ) // jesli hamulec wyłączony
         temp = 0.0; // odetnij
     else
         temp = 1.0; // połącz
     Pipe->Flow( temp * Hamulec->GetPF( temp * PipePress, dt, Vel ) + GetDVc( dt ) );
 
+    FinishPipePressure();
+}
+
+// completes brake pipe update, after valve and inter-vehicle flows were applied
+void TMoverParameters::FinishPipePressure() {
+
     if (ASBType == 128)
         Hamulec->ASB(int(SlippingWheels));
 
@@ -3727,17 +3833,12 @@ void TMoverParameters::UpdatePipePressure(double dt)
     Pipe->Act();
     PipePress = Pipe->P();
 
-    dpMainValve = dpMainValve / (100.0 * dt); // normalizacja po czasie do syczenia;
-
     if (PipePress < -1.0)
     {
         PipePress = -1.0;
         Pipe->CreatePress(-1.0);
         Pipe->Act();
     }
-
-    if (CompressedVolume < 0.0)
-        CompressedVolume = 0.0;
 }
 
 // *************************************************************************************************
@@ -4435,7 +4536,7 @@ double TMoverParameters::TractionForce( double dt ) {
             if( ( true == Mains )
              && ( true == FuelPump.is_active ) ) {
 
-                tmp = DElist[ MainCtrlPos ].RPM / 60.0;
+                tmp = Tables->DElist[ MainCtrlPos ].RPM / 60.0;
 
                 if( ( true == Heating )
                  && ( HeatingPower > 0 )
@@ -4445,7 +4546,7 @@ double TMoverParameters::TractionForce( double dt ) {
                         std::max(
                             tmp,
                             std::min(
-                                DElist[ MainCtrlPosNo ].RPM,
+                                Tables->DElist[ MainCtrlPosNo ].RPM,
                                 EngineHeatingRPM )
                                 / 60.0 );
                 }
@@ -4469,9 +4570,9 @@ double TMoverParameters::TractionForce( double dt ) {
         }
         case TEngineType::DieselEngine: {
             if( ShuntMode ) // dodatkowa przekładnia np. dla 2Ls150
-                dtrans = AnPos * Transmision.Ratio * MotorParam[ ScndCtrlActualPos ].mIsat;
+                dtrans = AnPos * Transmision.Ratio * Tables->MotorParam[ ScndCtrlActualPos ].mIsat;
             else
-                dtrans = Transmision.Ratio * MotorParam[ ScndCtrlActualPos ].mIsat;
+                dtrans = Transmision.Ratio * Tables->MotorParam[ ScndCtrlActualPos ].mIsat;
 
             dmoment = dizel_Momentum( dizel_fill, dtrans * nrot * ActiveDir, dt ); // oblicza tez enrot
             break;
@@ -4501,7 +4602,7 @@ double TMoverParameters::TractionForce( double dt ) {
 
                     case 1: { // manual
                         if( ( ActiveDir != 0 )
-                         && ( RList[ MainCtrlActualPos ].R > RVentCutOff ) ) {
+                         && ( Tables->RList[ MainCtrlActualPos ].R > RVentCutOff ) ) {
                             RventRot += ( RVentnmax - RventRot ) * RVentSpeed * dt;
                         }
                         else {
@@ -4513,7 +4614,7 @@ double TMoverParameters::TractionForce( double dt ) {
                     case 2: { // automatic
                         auto const motorcurrent{ std::min<double>( ImaxHi, std::abs( Im ) ) };
                         if( ( std::abs( Itot ) > RVentMinI )
-                         && ( RList[ MainCtrlActualPos ].R > RVentCutOff ) ) {
+                         && ( Tables->RList[ MainCtrlActualPos ].R > RVentCutOff ) ) {
 
                             RventRot +=
                                 ( RVentnmax
@@ -4711,8 +4812,8 @@ double TMoverParameters::TractionForce( double dt ) {
             }
 
             if ((TrainType == dt_ET22) && (DelayCtrlFlag)) // szarpanie przy zmianie układu w byku
-                Mm = Mm * RList[MainCtrlActualPos].Bn /
-                     (RList[MainCtrlActualPos].Bn +
+                Mm = Mm * Tables->RList[MainCtrlActualPos].Bn /
+                     (Tables->RList[MainCtrlActualPos].Bn +
                       1); // zrobione w momencie, żeby nie dawac elektryki w przeliczaniu sił
 
 			if (abs(Im) > Imax)
@@ -4727,7 +4828,7 @@ double TMoverParameters::TractionForce( double dt ) {
             else if ((TrainType == dt_EZT) && (Imin == IminLo) && (ScndS)) // yBARC - boczniki na szeregu poprawnie
                 Itot = Im;
             else
-                Itot = Im * RList[MainCtrlActualPos].Bn; // prad silnika * ilosc galezi
+                Itot = Im * Tables->RList[MainCtrlActualPos].Bn; // prad silnika * ilosc galezi
             Mw = Mm * Transmision.Ratio;
             Fw = Mw * 2.0 / WheelDiameter;
             Ft = Fw * NPoweredAxles; // sila trakcyjna
@@ -4751,11 +4852,11 @@ double TMoverParameters::TractionForce( double dt ) {
             // jazda manewrowa
             if( true == ShuntMode ) {
                 if( ( true == Mains ) && ( MainCtrlPos > 0 ) ) {
-                    Voltage = ( SST[ MainCtrlPos ].Umax * AnPos ) + ( SST[ MainCtrlPos ].Umin * ( 1.0 - AnPos ) );
+                    Voltage = ( Tables->SST[ MainCtrlPos ].Umax * AnPos ) + ( Tables->SST[ MainCtrlPos ].Umin * ( 1.0 - AnPos ) );
                     // NOTE: very crude way to approximate power generated at current rpm instead of instant top output
                     // NOTE, TODO: doesn't take into account potentially increased revolutions if heating is on, fix it
-                    auto const rpmratio { 60.0 * enrot / DElist[ MainCtrlPos ].RPM };
-                    tmp = rpmratio * ( SST[ MainCtrlPos ].Pmax * AnPos ) + ( SST[ MainCtrlPos ].Pmin * ( 1.0 - AnPos ) );
+                    auto const rpmratio { 60.0 * enrot / Tables->DElist[ MainCtrlPos ].RPM };
+                    tmp = rpmratio * ( Tables->SST[ MainCtrlPos ].Pmax * AnPos ) + ( Tables->SST[ MainCtrlPos ].Pmin * ( 1.0 - AnPos ) );
                     Ft = tmp * 1000.0 / ( abs( tmpV ) + 1.6 );
                 }
                 else {
@@ -4772,21 +4873,21 @@ double TMoverParameters::TractionForce( double dt ) {
                 // NOTE: very crude way to approximate power generated at current rpm instead of instant top output
                 // NOTE, TODO: doesn't take into account potentially increased revolutions if heating is on, fix it
                 auto const currentgenpower { (
-                    DElist[ MainCtrlPos ].RPM > 0 ?
-                        DElist[ MainCtrlPos ].GenPower * ( 60.0 * enrot / DElist[ MainCtrlPos ].RPM ) :
+                    Tables->DElist[ MainCtrlPos ].RPM > 0 ?
+                        Tables->DElist[ MainCtrlPos ].GenPower * ( 60.0 * enrot / Tables->DElist[ MainCtrlPos ].RPM ) :
                         0.0 ) };
                     
                 tmp = std::min( power, currentgenpower );
 
-                PosRatio = currentgenpower / DElist[MainCtrlPosNo].GenPower;
+                PosRatio = currentgenpower / Tables->DElist[MainCtrlPosNo].GenPower;
                 // stosunek mocy teraz do mocy max
                 // NOTE: Mains in this context is working diesel engine
                 if( ( true == Mains ) && ( MainCtrlPos > 0 ) ) {
 
-                    if( tmpV < ( Vhyp * power / DElist[ MainCtrlPosNo ].GenPower ) ) {
+                    if( tmpV < ( Vhyp * power / Tables->DElist[ MainCtrlPosNo ].GenPower ) ) {
                         // czy na czesci prostej, czy na hiperboli
                         Ft = ( Ftmax
-                               - ( ( Ftmax - 1000.0 * DElist[ MainCtrlPosNo ].GenPower / ( Vhyp + Vadd ) )
+                               - ( ( Ftmax - 1000.0 * Tables->DElist[ MainCtrlPosNo ].GenPower / ( Vhyp + Vadd ) )
                                    * ( tmpV / Vhyp )
                                    / PowerCorRatio ) )
                             * PosRatio; // posratio - bo sila jakos tam sie rozklada
@@ -4801,7 +4902,7 @@ double TMoverParameters::TractionForce( double dt ) {
                 else
                     Ft = 0; // jak nastawnik na zero, to sila tez zero
 
-                PosRatio = tmp / DElist[MainCtrlPosNo].GenPower;
+                PosRatio = tmp / Tables->DElist[MainCtrlPosNo].GenPower;
             }
 
             if (FuseFlag)
@@ -4813,11 +4914,11 @@ double TMoverParameters::TractionForce( double dt ) {
             Mm = Mw / Transmision.Ratio; // moment silnika trakcyjnego
 
             // with MotorParam[ScndCtrlPos] do
-            if (abs(Mm) > MotorParam[ScndCtrlPos].fi)
+            if (abs(Mm) > Tables->MotorParam[ScndCtrlPos].fi)
                 Im = NPoweredAxles *
-                     abs(abs(Mm) / MotorParam[ScndCtrlPos].mfi + MotorParam[ScndCtrlPos].mIsat);
+                     abs(abs(Mm) / Tables->MotorParam[ScndCtrlPos].mfi + Tables->MotorParam[ScndCtrlPos].mIsat);
             else
-                Im = NPoweredAxles * sqrt(abs(Mm * MotorParam[ScndCtrlPos].Isat));
+                Im = NPoweredAxles * sqrt(abs(Mm * Tables->MotorParam[ScndCtrlPos].Isat));
 
             if( ShuntMode ) {
                 EnginePower = Voltage * Im / 1000.0;
@@ -4831,10 +4932,10 @@ double TMoverParameters::TractionForce( double dt ) {
             }
             else
             {
-                if (abs(Im) > DElist[MainCtrlPos].Imax)
+                if (abs(Im) > Tables->DElist[MainCtrlPos].Imax)
                 { // nie ma nadmiarowego, tylko Imax i zwarcie na pradnicy
-                    Ft = Ft / Im * DElist[MainCtrlPos].Imax;
-                    Im = DElist[MainCtrlPos].Imax;
+                    Ft = Ft / Im * Tables->DElist[MainCtrlPos].Imax;
+                    Im = Tables->DElist[MainCtrlPos].Imax;
                 }
 
                 if( Im > 0 ) {
@@ -4848,10 +4949,10 @@ double TMoverParameters::TractionForce( double dt ) {
                         Voltage =
                             std::sqrt(
                                 std::abs(
-                                    square( DElist[ MainCtrlPos ].Umax )
-                                    - square( DElist[ MainCtrlPos ].Umax * Im / DElist[ MainCtrlPos ].Imax ) ) )
+                                    square( Tables->DElist[ MainCtrlPos ].Umax )
+                                    - square( Tables->DElist[ MainCtrlPos ].Umax * Im / Tables->DElist[ MainCtrlPos ].Imax ) ) )
                             * ( MainCtrlPos - 1 )
-                            + ( 1.0 - Im / DElist[ MainCtrlPos ].Imax ) * DElist[ MainCtrlPos ].Umax * ( MainCtrlPosNo - MainCtrlPos );
+                            + ( 1.0 - Im / Tables->DElist[ MainCtrlPos ].Imax ) * Tables->DElist[ MainCtrlPos ].Umax * ( MainCtrlPosNo - MainCtrlPos );
                         Voltage /= ( MainCtrlPosNo - 1 );
                         Voltage = clamp(
                             Voltage,
@@ -4859,10 +4960,10 @@ double TMoverParameters::TractionForce( double dt ) {
                     }
                 }
 
-                if( ( Voltage > DElist[ MainCtrlPos ].Umax )
+                if( ( Voltage > Tables->DElist[ MainCtrlPos ].Umax )
                  || ( Im == 0 ) ) {
                     // gdy wychodzi za duze napiecie albo przy biegu jalowym (jest cos takiego?)
-                    Voltage = DElist[ MainCtrlPos ].Umax * ( ConverterFlag ? 1 : 0 ); 
+                    Voltage = Tables->DElist[ MainCtrlPos ].Umax * ( ConverterFlag ? 1 : 0 ); 
                 }
 
                 EnginePower = Voltage * Im / 1000.0;
@@ -4896,11 +4997,11 @@ double TMoverParameters::TractionForce( double dt ) {
                         case 0: {
 
                             if( ( ScndCtrlPos < ScndCtrlPosNo )
-                             && ( Im <= ( MPTRelay[ ScndCtrlPos ].Iup * PosRatio ) ) ) {
+                             && ( Im <= ( Tables->MPTRelay[ ScndCtrlPos ].Iup * PosRatio ) ) ) {
                                 ++ScndCtrlPos;
                             }
                             if( ( ScndCtrlPos > 0 )
-                             && ( Im >= ( MPTRelay[ScndCtrlPos].Idown * PosRatio ) ) ) {
+                             && ( Im >= ( Tables->MPTRelay[ScndCtrlPos].Idown * PosRatio ) ) ) {
                                 --ScndCtrlPos;
                             }
                             break;
@@ -4908,11 +5009,11 @@ double TMoverParameters::TractionForce( double dt ) {
                         case 1: {
 
                             if( ( ScndCtrlPos < ScndCtrlPosNo )
-                             && ( MPTRelay[ ScndCtrlPos ].Iup < Vel ) ) {
+                             && ( Tables->MPTRelay[ ScndCtrlPos ].Iup < Vel ) ) {
                                 ++ScndCtrlPos;
                             }
                             if( ( ScndCtrlPos > 0 )
-                             && ( MPTRelay[ ScndCtrlPos ].Idown > Vel ) ) {
+                             && ( Tables->MPTRelay[ ScndCtrlPos ].Idown > Vel ) ) {
                                 --ScndCtrlPos;
                             }
                             break;
@@ -4920,12 +5021,12 @@ double TMoverParameters::TractionForce( double dt ) {
                         case 2: {
 
                             if( ( ScndCtrlPos < ScndCtrlPosNo )
-                             && ( MPTRelay[ ScndCtrlPos ].Iup < Vel )
+                             && ( Tables->MPTRelay[ ScndCtrlPos ].Iup < Vel )
                              && ( EnginePower < ( tmp * 0.99 ) ) ) {
                                 ++ScndCtrlPos;
                             }
                             if( ( ScndCtrlPos > 0 )
-                             && ( MPTRelay[ ScndCtrlPos ].Idown < Im ) ) {
+                             && ( Tables->MPTRelay[ ScndCtrlPos ].Idown < Im ) ) {
                                 --ScndCtrlPos;
                             }
                             break;
@@ -4934,12 +5035,12 @@ double TMoverParameters::TractionForce( double dt ) {
                         {
                             if( ( ScndCtrlPos < ScndCtrlPosNo )
                              && ( MainCtrlPos == MainCtrlPosNo )
-                             && ( tmpV * 3.6 > MPTRelay[ ScndCtrlPos ].Iup ) ) {
+                             && ( tmpV * 3.6 > Tables->MPTRelay[ ScndCtrlPos ].Iup ) ) {
                                 ++ScndCtrlPos;
                                 enrot = enrot * 0.73;
                             }
                             if( ( ScndCtrlPos > 0 )
-                             && ( Im > MPTRelay[ ScndCtrlPos ].Idown ) ) {
+                             && ( Im > Tables->MPTRelay[ ScndCtrlPos ].Idown ) ) {
                                 --ScndCtrlPos;
                             }
                             break;
@@ -4949,12 +5050,12 @@ double TMoverParameters::TractionForce( double dt ) {
                             if( ( ScndCtrlPos < ScndCtrlPosNo )
                              && ( MainCtrlPos >= 11 ) ) {
 
-                                if( Im < MPTRelay[ ScndCtrlPos ].Iup ) {
+                                if( Im < Tables->MPTRelay[ ScndCtrlPos ].Iup ) {
                                     ++ScndCtrlPos;
                                 }
                                 // check for cases where the speed drops below threshold for level 2 or 3
                                 if( ( ScndCtrlPos > 1 )
-                                 && ( Vel < MPTRelay[ ScndCtrlPos - 1 ].Idown ) ) {
+                                 && ( Vel < Tables->MPTRelay[ ScndCtrlPos - 1 ].Idown ) ) {
                                     --ScndCtrlPos;
                                 }
                             }
@@ -4962,12 +5063,12 @@ double TMoverParameters::TractionForce( double dt ) {
                             if( ( ScndCtrlPos > 0 ) && ( MainCtrlPos < 11 ) ) {
 
                                 if( ScndCtrlPos == 1 ) {
-                                    if( Im > MPTRelay[ ScndCtrlPos - 1 ].Idown ) {
+                                    if( Im > Tables->MPTRelay[ ScndCtrlPos - 1 ].Idown ) {
                                         --ScndCtrlPos;
                                     }
                                 }
                                 else {
-                                    if( Vel < MPTRelay[ ScndCtrlPos ].Idown ) {
+                                    if( Vel < Tables->MPTRelay[ ScndCtrlPos ].Idown ) {
                                         --ScndCtrlPos;
                                     }
                                 }
@@ -4984,7 +5085,7 @@ double TMoverParameters::TractionForce( double dt ) {
                             // crude woodward approximation; difference between rpm for consecutive positions is ~5%
                             // so we get full throttle until ~half way between desired and previous position, or zero on rpm reduction
                             auto const woodward { clamp(
-                                ( DElist[ MainCtrlPos ].RPM / ( enrot * 60.0 ) - 1.0 ) * 50.0,
+                                ( Tables->DElist[ MainCtrlPos ].RPM / ( enrot * 60.0 ) - 1.0 ) * 50.0,
                                 0.0, 1.0 ) };
 */
                             break;
@@ -4995,13 +5096,13 @@ double TMoverParameters::TractionForce( double dt ) {
                             if( ( MainCtrlPos >= 12 )
                              && ( ScndCtrlPos < ScndCtrlPosNo ) ) {
                                 if( ( ScndCtrlPos ) % 2 == 0 ) {
-                                    if( ( MPTRelay[ ScndCtrlPos ].Iup > Im ) ) {
+                                    if( ( Tables->MPTRelay[ ScndCtrlPos ].Iup > Im ) ) {
                                 ++ScndCtrlPos;
                                     }
                                 }
                                 else {
-                                    if( ( MPTRelay[ ScndCtrlPos - 1 ].Iup > Im )
-                                     && ( MPTRelay[ ScndCtrlPos ].Iup < Vel ) ) {
+                                    if( ( Tables->MPTRelay[ ScndCtrlPos - 1 ].Iup > Im )
+                                     && ( Tables->MPTRelay[ ScndCtrlPos ].Iup < Vel ) ) {
                                 ++ScndCtrlPos;
                                     }
                                 }
@@ -5012,13 +5113,13 @@ double TMoverParameters::TractionForce( double dt ) {
                                 if( Vel < 50.0 ) {
                                     // above 50 km/h already active shunt field can be maintained until lower controller setting
                                     if( ( ScndCtrlPos ) % 2 == 0 ) {
-                                        if( ( MPTRelay[ ScndCtrlPos ].Idown < Im ) ) {
+                                        if( ( Tables->MPTRelay[ ScndCtrlPos ].Idown < Im ) ) {
                                             --ScndCtrlPos;
                                         }
                                     }
                                     else {
-                                        if( ( MPTRelay[ ScndCtrlPos + 1 ].Idown < Im )
-                                            && ( MPTRelay[ ScndCtrlPos ].Idown > Vel ) ) {
+                                        if( ( Tables->MPTRelay[ ScndCtrlPos + 1 ].Idown < Im )
+                                            && ( Tables->MPTRelay[ ScndCtrlPos ].Idown > Vel ) ) {
                                             --ScndCtrlPos;
                                         }
                                     }
@@ -5259,14 +5360,14 @@ double TMoverParameters::TractionForce( double dt ) {
 
                     int i = 0;
                     while( ( i < RlistSize - 1 )
-                        && ( DElist[ i + 1 ].RPM < tmpV ) ) {
+                        && ( Tables->DElist[ i + 1 ].RPM < tmpV ) ) {
                         ++i;
                     }
                     InverterFrequency =
-                        ( tmpV - DElist[ i ].RPM )
-                        / std::max( 1.0, ( DElist[ i + 1 ].RPM - DElist[ i ].RPM ) )
-                        * ( DElist[ i + 1 ].GenPower - DElist[ i ].GenPower )
-                        + DElist[ i ].GenPower;
+                        ( tmpV - Tables->DElist[ i ].RPM )
+                        / std::max( 1.0, ( Tables->DElist[ i + 1 ].RPM - Tables->DElist[ i ].RPM ) )
+                        * ( Tables->DElist[ i + 1 ].GenPower - Tables->DElist[ i ].GenPower )
+                        + Tables->DElist[ i ].GenPower;
                 }
                 else {
                     InverterFrequency = 0.0;
@@ -5307,8 +5408,8 @@ double TMoverParameters::TractionForce( double dt ) {
     switch( EngineType ) {
         case TEngineType::DieselElectric: {
             // rough approximation of extra effort to overcome friction etc
-            auto const rpmratio{ 60.0 * enrot / DElist[ MainCtrlPosNo ].RPM };
-            EnginePower += rpmratio * 0.15 * DElist[ MainCtrlPosNo ].GenPower;
+            auto const rpmratio{ 60.0 * enrot / Tables->DElist[ MainCtrlPosNo ].RPM };
+            EnginePower += rpmratio * 0.15 * Tables->DElist[ MainCtrlPosNo ].GenPower;
             break;
         }
         default: {
@@ -5435,12 +5536,12 @@ double TMoverParameters::Momentum(double I)
 
     SP = ScndCtrlActualPos;
     if (ScndInMain)
-        if (!(RList[MainCtrlActualPos].ScndAct == 255))
-            SP = RList[MainCtrlActualPos].ScndAct;
+        if (!(Tables->RList[MainCtrlActualPos].ScndAct == 255))
+            SP = Tables->RList[MainCtrlActualPos].ScndAct;
 
     //     Momentum:=mfi*I*(1-1.0/(Abs(I)/mIsat+1));
-    return (MotorParam[SP].mfi * I *
-            (abs(I) / (abs(I) + MotorParam[SP].mIsat) - MotorParam[SP].mfi0));
+    return (Tables->MotorParam[SP].mfi * I *
+            (abs(I) / (abs(I) + Tables->MotorParam[SP].mIsat) - Tables->MotorParam[SP].mfi0));
 }
 
 // *************************************************************************************************
@@ -5451,8 +5552,8 @@ double TMoverParameters::MomentumF(double I, double Iw, int SCP)
 {
     // umozliwia dokladne sterowanie wzbudzeniem
 
-    return (MotorParam[SCP].mfi * I *
-            Max0R(abs(Iw) / (abs(Iw) + MotorParam[SCP].mIsat) - MotorParam[SCP].mfi0, 0));
+    return (Tables->MotorParam[SCP].mfi * I *
+            Max0R(abs(Iw) / (abs(Iw) + Tables->MotorParam[SCP].mIsat) - Tables->MotorParam[SCP].mfi0, 0));
 }
 
 // *************************************************************************************************
@@ -5483,7 +5584,7 @@ bool TMoverParameters::MaxCurrentSwitch(bool State)
     if (EngineType == TEngineType::ElectricSeriesMotor)
         if (ImaxHi > ImaxLo)
         {
-            if (State && (Imax == ImaxLo) && (RList[MainCtrlPos].Bn < 2) &&
+            if (State && (Imax == ImaxLo) && (Tables->RList[MainCtrlPos].Bn < 2) &&
                 !((TrainType == dt_ET42) && (MainCtrlPos > 0)))
             {
                 Imax = ImaxHi;
@@ -5598,11 +5699,11 @@ bool TMoverParameters::AutoRelayCheck(void)
     // sprawdzenie wszystkich warunkow (AutoRelayFlag, AutoSwitch, Im<Imin)
     auto const ARFASI2 { (
         ( false == AutoRelayFlag )
-     || ( ( MotorParam[ ScndCtrlActualPos ].AutoSwitch ) && ( abs( Im ) < Imin ) ) ) };
+     || ( ( Tables->MotorParam[ ScndCtrlActualPos ].AutoSwitch ) && ( abs( Im ) < Imin ) ) ) };
     auto const ARFASI { (
         ( false == AutoRelayFlag )
-     || ( ( RList[ MainCtrlActualPos ].AutoSwitch ) && ( abs( Im ) < Imin ) )
-     || ( ( !RList[ MainCtrlActualPos ].AutoSwitch ) && ( RList[ MainCtrlActualPos ].Relay < MainCtrlPos ) ) ) };
+     || ( ( Tables->RList[ MainCtrlActualPos ].AutoSwitch ) && ( abs( Im ) < Imin ) )
+     || ( ( !Tables->RList[ MainCtrlActualPos ].AutoSwitch ) && ( Tables->RList[ MainCtrlActualPos ].Relay < MainCtrlPos ) ) ) };
     // brak PSR                   na tej pozycji działa PSR i prąd poniżej progu
     // na tej pozycji nie działa PSR i pozycja walu ponizej
     //                         chodzi w tym wszystkim o to, żeby można było zatrzymać rozruch na
@@ -5612,9 +5713,9 @@ bool TMoverParameters::AutoRelayCheck(void)
     {
         if (StLinFlag)
         {
-            if ((RList[MainCtrlActualPos].R == 0) &&
+            if ((Tables->RList[MainCtrlActualPos].R == 0) &&
                 ((ScndCtrlActualPos > 0) || (ScndCtrlPos > 0)) &&
-                (!(CoupledCtrl) || (RList[MainCtrlActualPos].Relay == MainCtrlPos)))
+                (!(CoupledCtrl) || (Tables->RList[MainCtrlActualPos].Relay == MainCtrlPos)))
             { // zmieniaj scndctrlactualpos
                 // scnd bez samoczynnego rozruchu
                 if (ScndCtrlActualPos < ScndCtrlPos)
@@ -5641,20 +5742,20 @@ bool TMoverParameters::AutoRelayCheck(void)
             else
             { // zmieniaj mainctrlactualpos
                 if ((ActiveDir < 0) && (TrainType != dt_PseudoDiesel))
-                    if (RList[MainCtrlActualPos + 1].Bn > 1)
+                    if (Tables->RList[MainCtrlActualPos + 1].Bn > 1)
                     {
                         return false; // nie poprawiamy przy konwersji
                         // return ARC;// bbylo exit; //Ra: to powoduje, że EN57 nie wyłącza się przy
                         // IminLo
                     }
                 // main bez samoczynnego rozruchu
-                if( ( MainCtrlActualPos < ( sizeof( RList ) / sizeof( TScheme ) - 1 ) ) // crude guard against running out of current fixed table
-                 && ( ( RList[ MainCtrlActualPos ].Relay < MainCtrlPos )
-                   || ( RList[ MainCtrlActualPos + 1 ].Relay == MainCtrlPos )
+                if( ( MainCtrlActualPos < ( sizeof( Tables->RList ) / sizeof( TScheme ) - 1 ) ) // crude guard against running out of current fixed table
+                 && ( ( Tables->RList[ MainCtrlActualPos ].Relay < MainCtrlPos )
+                   || ( Tables->RList[ MainCtrlActualPos + 1 ].Relay == MainCtrlPos )
                    || ( ( TrainType == dt_ET22 )
                      && ( DelayCtrlFlag ) ) ) ) {
 
-                    if( ( RList[MainCtrlPos].R == 0 )
+                    if( ( Tables->RList[MainCtrlPos].R == 0 )
                      && ( MainCtrlPos > 0 )
                      && ( MainCtrlPos != MainCtrlPosNo )
                      && ( FastSerialCircuit == 1 ) ) {
@@ -5667,7 +5768,7 @@ bool TMoverParameters::AutoRelayCheck(void)
                             // TBD, TODO: move the basic sound event here and enable it with call parameter
                             OK = true;
                         }
-                        if( RList[ MainCtrlActualPos ].R == 0 ) {
+                        if( Tables->RList[ MainCtrlActualPos ].R == 0 ) {
                             SetFlag( SoundFlag, sound::parallel | sound::loud );
                             OK = true;
                         }
@@ -5678,7 +5779,7 @@ bool TMoverParameters::AutoRelayCheck(void)
                         // FloatToStr(CtrlDelay));
                         if( ( TrainType == dt_ET22 )
                          && ( MainCtrlPos > 1 )
-                         && ( ( RList[ MainCtrlActualPos ].Bn < RList[ MainCtrlActualPos + 1 ].Bn )
+                         && ( ( Tables->RList[ MainCtrlActualPos ].Bn < Tables->RList[ MainCtrlActualPos + 1 ].Bn )
                            || ( DelayCtrlFlag ) ) ) {
                            // et22 z walem grupowym
                             if( !DelayCtrlFlag ) // najpierw przejscie
@@ -5706,22 +5807,22 @@ bool TMoverParameters::AutoRelayCheck(void)
                         //---------
                         // hunter-111211: poprawki
                         if( MainCtrlActualPos > 0 ) {
-                            if( ( RList[ MainCtrlActualPos ].R == 0 )
+                            if( ( Tables->RList[ MainCtrlActualPos ].R == 0 )
                              && ( MainCtrlActualPos != MainCtrlPosNo ) ) {
                                 // wejscie na bezoporowa
                                 SetFlag( SoundFlag, sound::parallel | sound::loud );
                             }
-                            else if( ( RList[ MainCtrlActualPos ].R > 0 )
-                                  && ( RList[ MainCtrlActualPos - 1 ].R == 0 ) ) {
+                            else if( ( Tables->RList[ MainCtrlActualPos ].R > 0 )
+                                  && ( Tables->RList[ MainCtrlActualPos - 1 ].R == 0 ) ) {
                                 // wejscie na drugi uklad
                                 SetFlag( SoundFlag, sound::parallel );
                             }
                         }
                     }
                 }
-                else if (RList[MainCtrlActualPos].Relay > MainCtrlPos)
+                else if (Tables->RList[MainCtrlActualPos].Relay > MainCtrlPos)
                 {
-                    if( ( RList[ MainCtrlPos ].R == 0 )
+                    if( ( Tables->RList[ MainCtrlPos ].R == 0 )
                      && ( MainCtrlPos > 0 )
                      && ( !( MainCtrlPos == MainCtrlPosNo ) )
                      && ( FastSerialCircuit == 1 ) ) {
@@ -5729,7 +5830,7 @@ bool TMoverParameters::AutoRelayCheck(void)
                         // MainCtrlActualPos:=MainCtrlPos; //hunter-111012:
                         --MainCtrlActualPos;
                         OK = true;
-                        if( RList[ MainCtrlActualPos ].R == 0 ) {
+                        if( Tables->RList[ MainCtrlActualPos ].R == 0 ) {
                             SetFlag( SoundFlag, sound::parallel );
                         }
                     }
@@ -5741,13 +5842,13 @@ bool TMoverParameters::AutoRelayCheck(void)
                             OK = true;
                         }
                         if (MainCtrlActualPos > 0) // hunter-111211: poprawki
-                            if (RList[MainCtrlActualPos].R == 0) {
+                            if (Tables->RList[MainCtrlActualPos].R == 0) {
                                 // dzwieki schodzenia z bezoporowej}
                                 SetFlag(SoundFlag, sound::parallel);
                             }
                     }
                 }
-                else if ((RList[MainCtrlActualPos].R > 0) && (ScndCtrlActualPos > 0))
+                else if ((Tables->RList[MainCtrlActualPos].R > 0) && (ScndCtrlActualPos > 0))
                 {
                     if (LastRelayTime > CtrlDownDelay)
                     {
@@ -6033,9 +6134,9 @@ bool TMoverParameters::dizel_AutoGearCheck(void)
     bool OK;
 
     OK = false;
-    if (MotorParam[ScndCtrlActualPos].AutoSwitch && Mains)
+    if (Tables->MotorParam[ScndCtrlActualPos].AutoSwitch && Mains)
     {
-        if ((RList[MainCtrlPos].Mn == 0)&&(!hydro_TC))
+        if ((Tables->RList[MainCtrlPos].Mn == 0)&&(!hydro_TC))
         {
             if (dizel_engagestate > 0)
                 dizel_EngageSwitch(0);
@@ -6044,17 +6145,17 @@ bool TMoverParameters::dizel_AutoGearCheck(void)
         }
         else
         {
-            if (MotorParam[ScndCtrlActualPos].AutoSwitch &&
+            if (Tables->MotorParam[ScndCtrlActualPos].AutoSwitch &&
                 (dizel_automaticgearstatus == 0)) // sprawdz czy zmienic biegi
             {
-                if( Vel > MotorParam[ ScndCtrlActualPos ].mfi ) {
+                if( Vel > Tables->MotorParam[ ScndCtrlActualPos ].mfi ) {
                     // shift up
                     if( ScndCtrlActualPos < ScndCtrlPosNo ) {
                         dizel_automaticgearstatus = 1;
                         OK = true;
                     }
                 }
-                else if( Vel < MotorParam[ ScndCtrlActualPos ].fi ) {
+                else if( Vel < Tables->MotorParam[ ScndCtrlActualPos ].fi ) {
                     // shift down
                     if( ScndCtrlActualPos > 0 ) {
                         dizel_automaticgearstatus = -1;
@@ -6078,7 +6179,7 @@ bool TMoverParameters::dizel_AutoGearCheck(void)
     if (Mains)
     {
         if (dizel_automaticgearstatus == 0) // ustaw cisnienie w silowniku sprzegla}
-            switch (RList[MainCtrlPos].Mn)
+            switch (Tables->RList[MainCtrlPos].Mn)
             {
             case 1:
                 dizel_EngageSwitch(0.5);
@@ -6102,7 +6203,7 @@ bool TMoverParameters::dizel_AutoGearCheck(void)
 				if (Vel>dizel_minVelfullengage)
 					dizel_EngageSwitch(1.0);
 				else
-					dizel_EngageSwitch(0.35*(1+RList[MainCtrlPos].R)*RList[MainCtrlPos].R);
+					dizel_EngageSwitch(0.35*(1+Tables->RList[MainCtrlPos].R)*Tables->RList[MainCtrlPos].R);
 				break;
             default:
 				if (hydro_TC && hydro_TC_Fill>0.01)
@@ -6112,7 +6213,7 @@ bool TMoverParameters::dizel_AutoGearCheck(void)
             }
         else
             dizel_EngageSwitch(0.0);
-        if (!(MotorParam[ScndCtrlActualPos].mIsat > 0))
+        if (!(Tables->MotorParam[ScndCtrlActualPos].mIsat > 0))
             dizel_EngageSwitch(0.0); // wylacz sprzeglo na pozycjach neutralnych
         if (!AutoRelayFlag)
             ScndCtrlActualPos = ScndCtrlPos;
@@ -6182,7 +6283,7 @@ bool TMoverParameters::dizel_Update(double dt) {
             0.35 * ( // TODO: dac zaleznie od temperatury i baterii
                 EngineType == TEngineType::DieselEngine ?
                     dizel_nmin :
-                    DElist[ 0 ].RPM / 60.0 ) );
+                    Tables->DElist[ 0 ].RPM / 60.0 ) );
 
     }
 
@@ -6192,7 +6293,7 @@ bool TMoverParameters::dizel_Update(double dt) {
         && ( enrot < 0.95 * (
             EngineType == TEngineType::DieselEngine ?
                 dizel_nmin :
-                DElist[ 0 ].RPM / 60.0 ) ) );
+                Tables->DElist[ 0 ].RPM / 60.0 ) ) );
 
     if( ( true == Mains )
      && ( false == FuelPump.is_active ) ) {
@@ -6236,12 +6337,12 @@ double TMoverParameters::dizel_fillcheck(int mcp)
         }
         else {
             // napelnienie zalezne od MainCtrlPos
-            realfill = RList[ mcp ].R;
+            realfill = Tables->RList[ mcp ].R;
         }
         if (dizel_nmax_cutoff > 0)
         {
             auto nreg { 0.0 };
-            switch (RList[MainCtrlPos].Mn)
+            switch (Tables->RList[MainCtrlPos].Mn)
             {
             case 0:
             case 1:
@@ -6269,7 +6370,7 @@ double TMoverParameters::dizel_fillcheck(int mcp)
 				if (Vel > dizel_minVelfullengage)
 					nreg = dizel_nmax;
 				else
-					nreg = dizel_nmin + 0.8 * (dizel_nmax - dizel_nmin) * RList[mcp].R;
+					nreg = dizel_nmin + 0.8 * (dizel_nmax - dizel_nmin) * Tables->RList[mcp].R;
 				break;
             default:
                 realfill = 0; // sluczaj
@@ -6279,7 +6380,7 @@ double TMoverParameters::dizel_fillcheck(int mcp)
 				realfill = 0; 
 			if (enrot < nreg) //pod predkoscia regulatora dawka zadana
 				realfill = realfill;
-			if ((enrot < dizel_nmin * 0.98)&&(RList[mcp].R>0.001)) //jesli ponizej biegu jalowego i niezerowa dawka, to dawaj pelna
+			if ((enrot < dizel_nmin * 0.98)&&(Tables->RList[mcp].R>0.001)) //jesli ponizej biegu jalowego i niezerowa dawka, to dawaj pelna
 				realfill = 1;
         }
     }
@@ -6296,7 +6397,7 @@ double TMoverParameters::dizel_Momentum(double dizel_fill, double n, double dt)
     double Moment = 0, enMoment = 0, gearMoment = 0, eps = 0, newn = 0, friction = 0, neps = 0;
 	double TorqueH = 0, TorqueL = 0, TorqueC = 0;
 	n = n * CabNo;
-	if ((MotorParam[ScndCtrlActualPos].mIsat < 0.001)||(ActiveDir == 0))
+	if ((Tables->MotorParam[ScndCtrlActualPos].mIsat < 0.001)||(ActiveDir == 0))
 		n = enrot;
     friction = dizel_engagefriction;
 	hydro_TC_nIn = enrot; //wal wejsciowy przetwornika momentu
@@ -6471,7 +6572,7 @@ void TMoverParameters::dizel_Heat( double const dt ) {
     // TODO: calculate this once and cache for further use, instead of doing it repeatedly all over the place
     auto const maxrevolutions { (
         EngineType == TEngineType::DieselEngine ? dizel_nmax * 60 :
-        EngineType == TEngineType::DieselElectric ? DElist[ MainCtrlPosNo ].RPM :
+        EngineType == TEngineType::DieselElectric ? Tables->DElist[ MainCtrlPosNo ].RPM :
         std::numeric_limits<double>::max() ) }; // shouldn't ever get here but, eh
     auto const revolutionsfactor { clamp( rpm / maxrevolutions, 0.0, 1.0 ) };
     auto const waterpump { WaterPump.is_active ? 1 : 0 };
@@ -7176,11 +7277,6 @@ bool TMoverParameters::Physic_ReActivation(void) // DO PRZETLUMACZENIA NA KONCU
 // *************************************************************************************************
 // FUNKCJE PARSERA WCZYTYWANIA PLIKU FIZYKI POJAZDU
 // *************************************************************************************************
-bool startBPT;
-bool startMPT, startMPT0;
-bool startRLIST;
-bool startDLIST, startFFLIST, startWWLIST;
-bool startLIGHTSLIST;
 int LISTLINE;
 
 bool issection( std::string const &Name, std::string const &Input ) {
@@ -7216,7 +7312,7 @@ int s2NNW(std::string s)
 // Q: 20160717
 // *************************************************************************************************
 // parsowanie Motor Param Table
-bool TMoverParameters::readMPT0( std::string const &line ) {
+bool TMoverParameters::readMPT0( std::string const &line, TMoverTables &Target ) {
 
     cParser parser( line );
     if( false == parser.getTokens( 7, false ) ) {
@@ -7226,37 +7322,37 @@ bool TMoverParameters::readMPT0( std::string const &line ) {
     int idx = 0; // numer pozycji
     parser >> idx;
     parser
-        >> MotorParam[ idx ].mfi
-        >> MotorParam[ idx ].mIsat
-        >> MotorParam[ idx ].mfi0
-        >> MotorParam[ idx ].fi
-        >> MotorParam[ idx ].Isat
-        >> MotorParam[ idx ].fi0;
+        >> Target.MotorParam[ idx ].mfi
+        >> Target.MotorParam[ idx ].mIsat
+        >> Target.MotorParam[ idx ].mfi0
+        >> Target.MotorParam[ idx ].fi
+        >> Target.MotorParam[ idx ].Isat
+        >> Target.MotorParam[ idx ].fi0;
     if( true == parser.getTokens( 1, false ) ) {
         int autoswitch;
         parser >> autoswitch;
-        MotorParam[ idx ].AutoSwitch = ( autoswitch == 1 );
+        Target.MotorParam[ idx ].AutoSwitch = ( autoswitch == 1 );
     }
     else {
-        MotorParam[ idx ].AutoSwitch = false;
+        Target.MotorParam[ idx ].AutoSwitch = false;
     }
     return true;
 }
 
-bool TMoverParameters::readMPT( std::string const &line ) {
+bool TMoverParameters::readMPT( std::string const &line, TMoverTables &Target ) {
 
     ++LISTLINE;
 
     switch( EngineType ) {
 
-        case TEngineType::ElectricSeriesMotor: { return readMPTElectricSeries( line ); }
-        case TEngineType::DieselElectric:      { return readMPTDieselElectric( line ); }
-        case TEngineType::DieselEngine:        { return readMPTDieselEngine( line ); }
+        case TEngineType::ElectricSeriesMotor: { return readMPTElectricSeries( line, Target ); }
+        case TEngineType::DieselElectric:      { return readMPTDieselElectric( line, Target ); }
+        case TEngineType::DieselEngine:        { return readMPTDieselEngine( line, Target ); }
         default:                               { return false; }
     }
 }
 
-bool TMoverParameters::readMPTElectricSeries(std::string const &line) {
+bool TMoverParameters::readMPTElectricSeries(std::string const &line, TMoverTables &Target) {
 
     cParser parser( line );
     if( false == parser.getTokens( 5, false ) ) {
@@ -7266,21 +7362,21 @@ bool TMoverParameters::readMPTElectricSeries(std::string const &line) {
     int idx = 0; // numer pozycji
     parser >> idx;
     parser
-        >> MotorParam[ idx ].mfi
-        >> MotorParam[ idx ].mIsat
-        >> MotorParam[ idx ].fi
-        >> MotorParam[ idx ].Isat;
+        >> Target.MotorParam[ idx ].mfi
+        >> Target.MotorParam[ idx ].mIsat
+        >> Target.MotorParam[ idx ].fi
+        >> Target.MotorParam[ idx ].Isat;
     if( true == parser.getTokens( 1, false ) ) {
         int autoswitch;
         parser >> autoswitch;
-        MotorParam[ idx ].AutoSwitch = (autoswitch == 1); }
+        Target.MotorParam[ idx ].AutoSwitch = (autoswitch == 1); }
     else{
-        MotorParam[ idx ].AutoSwitch = false;
+        Target.MotorParam[ idx ].AutoSwitch = false;
     }
     return true;
 }
 
-bool TMoverParameters::readMPTDieselElectric( std::string const &line ) {
+bool TMoverParameters::readMPTDieselElectric( std::string const &line, TMoverTables &Target ) {
 
     cParser parser( line );
     if( false == parser.getTokens( 7, false ) ) {
@@ -7290,17 +7386,17 @@ bool TMoverParameters::readMPTDieselElectric( std::string const &line ) {
     int idx = 0; // numer pozycji
     parser >> idx;
     parser
-        >> MotorParam[ idx ].mfi
-        >> MotorParam[ idx ].mIsat
-        >> MotorParam[ idx ].fi
-        >> MotorParam[ idx ].Isat
-        >> MPTRelay[ idx ].Iup
-        >> MPTRelay[ idx ].Idown;
+        >> Target.MotorParam[ idx ].mfi
+        >> Target.MotorParam[ idx ].mIsat
+        >> Target.MotorParam[ idx ].fi
+        >> Target.MotorParam[ idx ].Isat
+        >> Target.MPTRelay[ idx ].Iup
+        >> Target.MPTRelay[ idx ].Idown;
 
     return true;
 }
 
-bool TMoverParameters::readMPTDieselEngine( std::string const &line ) {
+bool TMoverParameters::readMPTDieselEngine( std::string const &line, TMoverTables &Target ) {
 
     cParser parser( line );
     if( false == parser.getTokens( 4, false ) ) {
@@ -7310,21 +7406,21 @@ bool TMoverParameters::readMPTDieselEngine( std::string const &line ) {
     int idx = 0; // numer pozycji
     parser >> idx;
     parser
-        >> MotorParam[ idx ].mIsat
-        >> MotorParam[ idx ].fi
-        >> MotorParam[ idx ].mfi;
+        >> Target.MotorParam[ idx ].mIsat
+        >> Target.MotorParam[ idx ].fi
+        >> Target.MotorParam[ idx ].mfi;
     if( true == parser.getTokens( 1, false ) ) {
         int autoswitch;
         parser >> autoswitch;
-        MotorParam[ idx ].AutoSwitch = ( autoswitch == 1 );
+        Target.MotorParam[ idx ].AutoSwitch = ( autoswitch == 1 );
     }
     else {
-        MotorParam[ idx ].AutoSwitch = false;
+        Target.MotorParam[ idx ].AutoSwitch = false;
     }
     return true;
 }
 
-bool TMoverParameters::readBPT( std::string const &line ) {
+bool TMoverParameters::readBPT( std::string const &line, TMoverTables &Target ) {
 
     cParser parser( line );
     if( false == parser.getTokens( 5, false ) ) {
@@ -7336,18 +7432,18 @@ bool TMoverParameters::readBPT( std::string const &line ) {
     std::string braketype; int idx = 0;
     parser >> idx;
     parser
-        >> BrakePressureTable[ idx ].PipePressureVal
-        >> BrakePressureTable[ idx ].BrakePressureVal
-        >> BrakePressureTable[ idx ].FlowSpeedVal
+        >> Target.BrakePressureTable[ idx ].PipePressureVal
+        >> Target.BrakePressureTable[ idx ].BrakePressureVal
+        >> Target.BrakePressureTable[ idx ].FlowSpeedVal
         >> braketype;
-              if( braketype == "Pneumatic" )        { BrakePressureTable[ idx ].BrakeType = TBrakeSystem::Pneumatic; } 
-         else if( braketype == "ElectroPneumatic" ) { BrakePressureTable[ idx ].BrakeType = TBrakeSystem::ElectroPneumatic; }
-         else                                       { BrakePressureTable[ idx ].BrakeType = TBrakeSystem::Individual; }
+              if( braketype == "Pneumatic" )        { Target.BrakePressureTable[ idx ].BrakeType = TBrakeSystem::Pneumatic; } 
+         else if( braketype == "ElectroPneumatic" ) { Target.BrakePressureTable[ idx ].BrakeType = TBrakeSystem::ElectroPneumatic; }
+         else                                       { Target.BrakePressureTable[ idx ].BrakeType = TBrakeSystem::Individual; }
 
     return true;
 }
 
-bool TMoverParameters::readRList( std::string const &Input ) {
+bool TMoverParameters::readRList( std::string const &Input, TMoverTables &Target ) {
 
     cParser parser( Input );
     if( false == parser.getTokens( 5, false ) ) {
@@ -7356,41 +7452,41 @@ bool TMoverParameters::readRList( std::string const &Input ) {
         return false;
     }
     auto idx = LISTLINE++;
-    if( idx >= sizeof( RList ) / sizeof( TScheme ) ) {
+    if( idx >= sizeof( Target.RList ) / sizeof( TScheme ) ) {
         WriteLog( "Read RList: number of entries exceeded capacity of the data table" );
         return false;
     }
     parser
-        >> RList[ idx ].Relay
-        >> RList[ idx ].R
-        >> RList[ idx ].Bn
-        >> RList[ idx ].Mn
-        >> RList[ idx ].AutoSwitch;
+        >> Target.RList[ idx ].Relay
+        >> Target.RList[ idx ].R
+        >> Target.RList[ idx ].Bn
+        >> Target.RList[ idx ].Mn
+        >> Target.RList[ idx ].AutoSwitch;
 
-    if( true == parser.getTokens( 1, false ) ) { parser >> RList[ idx ].ScndAct; }
-    else                                       {           RList[ idx ].ScndAct = 0; }
+    if( true == parser.getTokens( 1, false ) ) { parser >> Target.RList[ idx ].ScndAct; }
+    else                                       {           Target.RList[ idx ].ScndAct = 0; }
 
     return true;
 }
 
-bool TMoverParameters::readDList( std::string const &line ) {
+bool TMoverParameters::readDList( std::string const &line, TMoverTables &Target ) {
 
     cParser parser( line );
     parser.getTokens( 3, false );
     auto idx = LISTLINE++;
-    if( idx >= sizeof( RList ) / sizeof( TScheme ) ) {
+    if( idx >= sizeof( Target.RList ) / sizeof( TScheme ) ) {
         WriteLog( "Read DList: number of entries exceeded capacity of the data table" );
         return false;
     }
     parser
-        >> RList[ idx ].Relay
-        >> RList[ idx ].R
-        >> RList[ idx ].Mn;
+        >> Target.RList[ idx ].Relay
+        >> Target.RList[ idx ].R
+        >> Target.RList[ idx ].Mn;
 
     return true;
 }
 
-bool TMoverParameters::readFFList( std::string const &line ) {
+bool TMoverParameters::readFFList( std::string const &line, TMoverTables &Target ) {
 
     cParser parser( line );
     if( false == parser.getTokens( 2, false ) ) {
@@ -7398,19 +7494,19 @@ bool TMoverParameters::readFFList( std::string const &line ) {
     return false;
     }
     int idx = LISTLINE++;
-    if( idx >= sizeof( DElist ) / sizeof( TDEScheme ) ) {
+    if( idx >= sizeof( Target.DElist ) / sizeof( TDEScheme ) ) {
         WriteLog( "Read FList: number of entries exceeded capacity of the data table" );
         return false;
     }
     parser
-        >> DElist[ idx ].RPM
-        >> DElist[ idx ].GenPower;
+        >> Target.DElist[ idx ].RPM
+        >> Target.DElist[ idx ].GenPower;
 
     return true;
 }
 
 // parsowanie WWList
-bool TMoverParameters::readWWList( std::string const &line ) {
+bool TMoverParameters::readWWList( std::string const &line, TMoverTables &Target ) {
 
     cParser parser( line );
     if( false == parser.getTokens( 4, false ) ) {
@@ -7418,31 +7514,31 @@ bool TMoverParameters::readWWList( std::string const &line ) {
         return false;
     }
     int idx = LISTLINE++;
-    if( idx >= sizeof( DElist ) / sizeof( TDEScheme ) ) {
+    if( idx >= sizeof( Target.DElist ) / sizeof( TDEScheme ) ) {
         WriteLog( "Read WWList: number of entries exceeded capacity of the data table" );
         return false;
     }
     parser
-        >> DElist[ idx ].RPM
-        >> DElist[ idx ].GenPower
-        >> DElist[ idx ].Umax
-        >> DElist[ idx ].Imax;
+        >> Target.DElist[ idx ].RPM
+        >> Target.DElist[ idx ].GenPower
+        >> Target.DElist[ idx ].Umax
+        >> Target.DElist[ idx ].Imax;
 
     if( true == parser.getTokens( 3, false ) ) {
         // optional parameters for shunt mode
         parser
-            >> SST[ idx ].Umin
-            >> SST[ idx ].Umax
-            >> SST[ idx ].Pmax;
+            >> Target.SST[ idx ].Umin
+            >> Target.SST[ idx ].Umax
+            >> Target.SST[ idx ].Pmax;
 
-        SST[ idx ].Pmin = std::sqrt( std::pow( SST[ idx ].Umin, 2 ) / 47.6 );
-        SST[ idx ].Pmax = std::min( SST[ idx ].Pmax, std::pow( SST[ idx ].Umax, 2 ) / 47.6 );
+        Target.SST[ idx ].Pmin = std::sqrt( std::pow( Target.SST[ idx ].Umin, 2 ) / 47.6 );
+        Target.SST[ idx ].Pmax = std::min( Target.SST[ idx ].Pmax, std::pow( Target.SST[ idx ].Umax, 2 ) / 47.6 );
     }
 
     return true;
 }
 
-bool TMoverParameters::readLightsList( std::string const &Input ) {
+bool TMoverParameters::readLightsList( std::string const &Input, TMoverTables &Target ) {
 
     cParser parser( Input );
     if( false == parser.getTokens( 2, false ) ) {
@@ -7455,8 +7551,8 @@ bool TMoverParameters::readLightsList( std::string const &Input ) {
         return false;
     }
     parser
-        >> Lights[ 0 ][ idx ]
-        >> Lights[ 1 ][ idx ];
+        >> Target.Lights[ 0 ][ idx ]
+        >> Target.Lights[ 1 ][ idx ];
 
     return true;
 }
@@ -7552,26 +7648,15 @@ void TMoverParameters::BrakeSubsystemDecode()
 // *************************************************************************************************
 bool TMoverParameters::LoadFIZ(std::string chkpath)
 {
-    const int param_ok = 1;
-    const int wheels_ok = 2;
-    const int dimensions_ok = 4;
-
     ConversionError = 666;
     LISTLINE = 0;
-    startBPT = false;
-    startMPT = false;
-    startMPT0 = false;
-    startRLIST = false;
-    startDLIST = false;
-    startFFLIST = false;
-    startWWLIST = false;
-    startLIGHTSLIST = false;
     std::string file = chkpath + TypeName + ".fiz";
 
     WriteLog("LOAD FIZ FROM " + file);
 
-    std::ifstream in(file);
-	if (!in.is_open())
+    // the file is parsed once, vehicles of the same type share the result
+    auto const definition { fiz_cache::find( file ) };
+	if (definition == nullptr)
 	{
 		WriteLog("E8 - FIZ FILE NOT EXIST.");
 		return false;
@@ -7579,311 +7664,83 @@ bool TMoverParameters::LoadFIZ(std::string chkpath)
 
     ConversionError = 0;
 
-    // Zbieranie danych zawartych w pliku FIZ
-    // ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
-    std::unordered_map<std::string, std::string> fizlines;
-    std::string inputline;
-    while (std::getline(in, inputline))
+    // tables don't change after load, so only the first vehicle of the type reads them and the others share its copy
+    std::shared_ptr<TMoverTables> tables;
     {
-        bool comment = ( ( inputline.find('#') != std::string::npos )
-			          || ( inputline.compare( 0, 2, "//" ) == 0 ) );
-        if( true == comment ) {
-            // skip commented lines
-            continue;
-        }
-
-        if( inputline[ 0 ] == ' ' ) {
-            // guard against malformed config files with leading spaces
-            inputline.erase( 0, inputline.find_first_not_of( ' ' ) );
-        }
-
-		// trim CR at end (mainly for linux)
-		if (!inputline.empty() && inputline.back() == '\r')
-			inputline.pop_back();
-
-		if( inputline.length() == 0 ) {
-			startBPT = false;
-			continue;
-		}
-
-        // checking if table parsing should be switched off goes first...
-		if( issection( "END-MPT", inputline ) ) {
-			startBPT = false;
-			startMPT = false;
-            startMPT0 = false;
-			continue;
-		}
-        if( issection( "END-RL", inputline ) ) {
-			startBPT = false;
-			startRLIST = false;
-			continue;
-		}
-        if( issection( "END-DL", inputline ) ) {
-            startBPT = false;
-            startDLIST = false;
-            continue;
-        }
-        if( issection( "endff", inputline ) ) {
-            startBPT = false;
-            startFFLIST = false;
-            continue;
-        }
-        if( issection( "END-WWL", inputline ) ) {
-            startBPT = false;
-            startWWLIST = false;
-            continue;
-        }
-        if( issection( "endL", inputline ) ) {
-            startBPT = false;
-            startLIGHTSLIST = false;
-            continue;
-        }
-        // ...then all recognized sections...
-        if( issection( "Param.", inputline ) )
-        {
-			startBPT = false;
-            fizlines.emplace( "Param", inputline );
-            LoadFIZ_Param( inputline );
-			continue;
-        }
-
-        if( issection( "Load:", inputline ) )
-        {
-			startBPT = false;
-            fizlines.emplace( "Load", inputline );
-            LoadFIZ_Load( inputline );
-            continue;
-        }
-
-        if( issection( "Dimensions:", inputline ) )
-        {
-			startBPT = false;
-            fizlines.emplace( "Dimensions", inputline );
-            LoadFIZ_Dimensions( inputline );
-            continue;
-        }
-
-        if( issection( "Wheels:", inputline ) )
-        {
-			startBPT = false;
-            fizlines.emplace( "Wheels", inputline );
-            LoadFIZ_Wheels( inputline );
-            continue;
-        }
-
-        if( issection( "Brake:", inputline ) )
-        {
-			startBPT = false;
-            fizlines.emplace( "Brake", inputline );
-            LoadFIZ_Brake( inputline );
-            continue;
-        }
-
-        if( issection( "Doors:", inputline ) ) {
-
-            startBPT = false;
-            fizlines.emplace( "Doors", inputline );
-            LoadFIZ_Doors( inputline );
-            continue;
-        }
-
-        if( issection( "BuffCoupl.", inputline ) ) {
-
-            startBPT = false;
-            fizlines.emplace( "BuffCoupl", inputline );
-            LoadFIZ_BuffCoupl( inputline, 0 );
-            continue;
-        }
-
-        else if( issection( "BuffCoupl1.", inputline ) ) {
-
-            startBPT = false;
-            fizlines.emplace( "BuffCoupl1", inputline );
-            LoadFIZ_BuffCoupl( inputline, 1 );
-            continue;
-        }
-            
-        else if( issection( "BuffCoupl2.", inputline ) ) {
-
-            startBPT = false;
-            fizlines.emplace( "BuffCoupl2", inputline );
-            LoadFIZ_BuffCoupl( inputline, 2 );
-            continue;
-        }
-
-        if( issection( "TurboPos:", inputline ) ) {
-
-            startBPT = false;
-            fizlines.emplace( "TurboPos", inputline );
-            LoadFIZ_TurboPos( inputline );
-            continue;
-        }
-
-        if( issection( "Cntrl.", inputline ) ) {
-
-            startBPT = true; LISTLINE = 0;
-            fizlines.emplace( "Cntrl", inputline );
-            LoadFIZ_Cntrl( inputline );
-            continue;
-        }
-
-		if (issection("Blending:", inputline)) {
-
-			startBPT = true; LISTLINE = 0;
-			fizlines.emplace( "Blending", inputline);
-			LoadFIZ_Blending( inputline );
-			continue;
-		}
-
-        if( issection( "Light:", inputline ) ) {
-
-            startBPT = false;
-            fizlines.emplace( "Light", inputline );
-            LoadFIZ_Light( inputline );
-            continue;
-        }
-
-        if( issection( "Security:", inputline ) )
-        {
-			startBPT = false;
-            fizlines.emplace( "Security", inputline );
-            LoadFIZ_Security( inputline );
-            continue;
-        }
-
-        if( issection( "Clima:", inputline ) ) {
-
-            startBPT = false;
-            fizlines.emplace( "Clima", inputline );
-            LoadFIZ_Clima( inputline );
-            continue;
-        }
-
-        if( issection( "Power:", inputline ) )
-        {
-			startBPT = false;
-            fizlines.emplace( "Power", inputline );
-            LoadFIZ_Power( inputline );
-            continue;
-        }
-
-        if( issection( "Engine:", inputline ) )
-        {
-			startBPT = false;
-            fizlines.emplace( "Engine", inputline );
-            LoadFIZ_Engine( inputline );
-			continue;
-        }
-
-        if( issection( "Switches:", inputline ) ) {
-            startBPT = false;
-            fizlines.emplace( "Switches", inputline );
-            LoadFIZ_Switches( inputline );
-            continue;
-        }
-
-        if( issection( "MotorParamTable:", inputline ) ) {
-            startBPT = false;
-            startMPT = true; LISTLINE = 0;
-            fizlines.emplace( "MotorParamTable", inputline );
-            LoadFIZ_MotorParamTable( inputline );
-            continue;
-        }
-
-        if( issection( "MotorParamTable0:", inputline ) ) {
-            startBPT = false;
-            startMPT0 = true; LISTLINE = 0;
-            continue;
-        }
-
-        if( issection( "Circuit:", inputline ) )
-        {
-			startBPT = false;
-            fizlines.emplace( "Circuit", inputline );
-            LoadFIZ_Circuit( inputline );
-            continue;
-        }
-
-        if( issection( "RList:", inputline ) )
-        {
-			startBPT = false;
-            fizlines.emplace( "RList", inputline );
-            startRLIST = true; LISTLINE = 0;
-            LoadFIZ_RList( inputline );
-            continue;
-        }
-
-        if( issection( "DList:", inputline ) )
-        {
-			startBPT = false;
-            fizlines.emplace( "DList", inputline );
-            startDLIST = true; LISTLINE = 0;
-            LoadFIZ_DList( inputline );
-            continue;
+        std::lock_guard<std::mutex> lock { typetablesmutex };
+        auto const lookup { typetables.find( file ) };
+        if( lookup != typetables.end() ) {
+            Tables = lookup->second;
         }
-
-        if( issection( "ffList:", inputline ) ) {
-			startBPT = false;
-            startFFLIST = true; LISTLINE = 0;
-            LoadFIZ_FFList( inputline );
-            continue;
-        }
-
-        if( issection( "WWList:", inputline ) )
-        {
-			startBPT = false;
-            startWWLIST = true; LISTLINE = 0;
-			continue;
+        else {
+            tables = std::make_shared<TMoverTables>();
         }
+    }
 
-        if( issection( "LightsList:", inputline ) ) {
-            startBPT = false;
-            fizlines.emplace( "LightsList", inputline );
-            startLIGHTSLIST = true; LISTLINE = 0;
-            LoadFIZ_LightsList( inputline );
-            continue;
-        }
+    // Zbieranie danych zawartych w pliku FIZ
+    // ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+    for( auto const &line : definition->lines ) {
 
-        // ...and finally, table parsers.
-        // NOTE: once table parsing is enabled it lasts until switched off, when another section is recognized
-        if( true == startBPT ) {
-            readBPT( inputline );
-            continue;
-        }
-        if( true == startMPT ) {
-            readMPT( inputline );
+        if( ( line.type >= fiz_data::section::bpt_row )
+         && ( tables == nullptr ) ) {
+            // table rows, already read by another vehicle of the type
             continue;
         }
-        if( true == startMPT0 ) {
-            readMPT0( inputline );
-            continue;
-        }
-        if( true == startRLIST ) {
-            readRList( inputline );
-            continue;
+        auto const &inputline { line.text };
+        switch( line.type ) {
+            // sections...
+            case fiz_data::section::param:            { LoadFIZ_Param( inputline ); break; }
+            case fiz_data::section::load:             { LoadFIZ_Load( inputline ); break; }
+            case fiz_data::section::dimensions:       { LoadFIZ_Dimensions( inputline ); break; }
+            case fiz_data::section::wheels:           { LoadFIZ_Wheels( inputline ); break; }
+            case fiz_data::section::brake:            { LoadFIZ_Brake( inputline ); break; }
+            case fiz_data::section::doors:            { LoadFIZ_Doors( inputline ); break; }
+            case fiz_data::section::buffcoupl:        { LoadFIZ_BuffCoupl( inputline, 0 ); break; }
+            case fiz_data::section::buffcoupl1:       { LoadFIZ_BuffCoupl( inputline, 1 ); break; }
+            case fiz_data::section::buffcoupl2:       { LoadFIZ_BuffCoupl( inputline, 2 ); break; }
+            case fiz_data::section::turbopos:         { LoadFIZ_TurboPos( inputline ); break; }
+            case fiz_data::section::cntrl:            { LISTLINE = 0; LoadFIZ_Cntrl( inputline ); break; }
+            case fiz_data::section::blending:         { LISTLINE = 0; LoadFIZ_Blending( inputline ); break; }
+            case fiz_data::section::light:            { LoadFIZ_Light( inputline ); break; }
+            case fiz_data::section::security:         { LoadFIZ_Security( inputline ); break; }
+            case fiz_data::section::clima:            { LoadFIZ_Clima( inputline ); break; }
+            case fiz_data::section::power:            { LoadFIZ_Power( inputline ); break; }
+            case fiz_data::section::engine:           { LoadFIZ_Engine( inputline ); break; }
+            case fiz_data::section::switches:         { LoadFIZ_Switches( inputline ); break; }
+            case fiz_data::section::motorparamtable:  { LISTLINE = 0; LoadFIZ_MotorParamTable( inputline ); break; }
+            case fiz_data::section::motorparamtable0: { LISTLINE = 0; break; }
+            case fiz_data::section::circuit:          { LoadFIZ_Circuit( inputline ); break; }
+            case fiz_data::section::rlist:            { LISTLINE = 0; LoadFIZ_RList( inputline ); break; }
+            case fiz_data::section::dlist:            { LISTLINE = 0; LoadFIZ_DList( inputline ); break; }
+            case fiz_data::section::fflist:           { LISTLINE = 0; LoadFIZ_FFList( inputline ); break; }
+            case fiz_data::section::wwlist:           { LISTLINE = 0; break; }
+            case fiz_data::section::lightslist:       { LISTLINE = 0; LoadFIZ_LightsList( inputline ); break; }
+            // ...and table rows
+            case fiz_data::section::bpt_row:          { readBPT( inputline, *tables ); break; }
+            case fiz_data::section::mpt_row:          { readMPT( inputline, *tables ); break; }
+            case fiz_data::section::mpt0_row:         { readMPT0( inputline, *tables ); break; }
+            case fiz_data::section::rlist_row:        { readRList( inputline, *tables ); break; }
+            case fiz_data::section::dlist_row:        { readDList( inputline, *tables ); break; }
+            case fiz_data::section::fflist_row:       { readFFList( inputline, *tables ); break; }
+            case fiz_data::section::wwlist_row:       { readWWList( inputline, *tables ); break; }
+            case fiz_data::section::lightslist_row:   { readLightsList( inputline, *tables ); break; }
+            default: { break; }
         }
-        if( true == startDLIST ) {
-            readDList( inputline );
-            continue;
-        }
-        if( true == startFFLIST ) {
-            readFFList( inputline );
-            continue;
-		}
-        if( true == startWWLIST ) {
-            readWWList( inputline );
-			continue;
-		}
-        if( true == startLIGHTSLIST ) {
-            readLightsList( inputline );
-            continue;
-        }
-    } // while line
-    in.close();
+    }
 
     // Operacje na zebranych parametrach - przypisywanie do wlasciwych zmiennych i ustawianie
     // zaleznosci
 
+    if( tables != nullptr ) {
+        // if another vehicle of the type was quicker, use its copy
+        std::lock_guard<std::mutex> lock { typetablesmutex };
+        Tables = typetables.emplace( file, tables ).first->second;
+        WriteLog(
+            "Vehicle data: " + std::to_string( sizeof( TMoverParameters ) ) + " bytes per vehicle"
+            + " (" + std::to_string( sizeof( TMoverParameters ) + Tables->Size() ) + " bytes without shared tables),"
+            + " shared tables: " + std::to_string( Tables->Size() ) + " bytes" );
+    }
+
     bool result;
     if (ConversionError == 0)
         result = true;
@@ -9056,7 +8913,7 @@ bool TMoverParameters::CheckLocomotiveParameters(bool ReadyFlag, int Dir)
 
     if( ( AxleArangement.find( "o" ) != std::string::npos ) && ( EngineType == TEngineType::ElectricSeriesMotor ) ) {
         // test poprawnosci ilosci osi indywidualnie napedzanych
-        OK = ( ( RList[ 1 ].Bn * RList[ 1 ].Mn ) == NPoweredAxles );
+        OK = ( ( Tables->RList[ 1 ].Bn * Tables->RList[ 1 ].Mn ) == NPoweredAxles );
         // WriteLogSS("aa ok", BoolToYN(OK));
     }
 
@@ -9487,7 +9344,7 @@ bool TMoverParameters::RunCommand( std::string Command, double CValue1, double C
 	{
 		Hamulec->SetEPS(CValue1);
 		// fBrakeCtrlPos:=BrakeCtrlPos; //to powinnno być w jednym miejscu, aktualnie w C++!!!
-		BrakePressureActual = BrakePressureTable[BrakeCtrlPos];
+		BrakePressureActual = Tables->BrakePressure( BrakeCtrlPos );
         OK = SendCtrlToNext( Command, CValue1, CValue2, Couplertype );
 	} // youby - odluzniacz hamulcow, przyda sie
 	else if (Command == "BrakeReleaser")
@@ -10005,7 +9862,7 @@ double TMoverParameters::ShowCurrentP(int AmpN) const
 
     // ClearPendingExceptions;
     Grupowy = ((DelayCtrlFlag) && (TrainType == dt_ET22)); // przerzucanie walu grupowego w ET22;
-    Bn = RList[MainCtrlActualPos].Bn; // ile równoległych gałęzi silników
+    Bn = Tables->RList[MainCtrlActualPos].Bn; // ile równoległych gałęzi silników
 
     if ((DynamicBrakeType == dbrake_automatic) && (DynamicBrakeFlag))
         Bn = DynamicBrakeAmpmeters;
@@ -0,0 +1,186 @@
+/*
+This Source Code Form is subject to the
+terms of the Mozilla Public License, v.
+2.0. If a copy of the MPL was not
+distributed with this file, You can
+obtain one at
+http://mozilla.org/MPL/2.0/.
+*/
+
+#include "stdafx.h"
+#include "brakepipe.h"
+
+#include <typeinfo>
+#include "MOVER.h"
+#include "Oerlikon_ESt.h"
+#include "utilities.h"
+
+namespace {
+
+double const DPL { 0.25 }; // same as default pressure difference of PF()
+
+// air flow between two sections of the pipe; same as PF( P1, P2, S ), but with branches replaced by selection of the result,
+// so the loop over all hoses of the consist can be vectorized
+inline
+double
+pipe_flow( double const P1, double const P2, double const S ) {
+
+    double const PH { std::max( P1, P2 ) + 1.0 }; // wyzsze cisnienie absolutne
+    double const PL { P1 + P2 - PH + 2.0 }; // nizsze cisnienie absolutne
+    double const sg { PL / PH }; // bezwymiarowy stosunek cisnien
+    double const FM { PH * 197.0 * S * ( P2 >= P1 ? 1.0 : -1.0 ) }; // najwyzszy mozliwy przeplyw, wraz z kierunkiem
+    // NOTE: both square roots are calculated for every hose, so they're guarded against arguments which PF() never sees
+    double const small { ( 1.0 - sg ) / DPL * FM * 2.0 * std::sqrt( DPL * std::max( 0.0, PH - DPL ) ) }; // niewielka roznica cisnien
+    double const large { FM * 2.0 * std::sqrt( std::max( 0.0, sg * ( 1.0 - sg ) ) ) };
+    return (
+        sg > 0.5 ? // jesli ponizej stosunku krytycznego
+            ( ( PH - PL ) < DPL ? small : large ) :
+            FM );
+}
+
+// returns: conductance of the pipe section of specified vehicle, as used by TMoverParameters::GetDVc()
+double
+conductance( TMoverParameters const &Vehicle ) {
+
+    return Vehicle.Spg / ( 1.0 + 0.015 / Vehicle.Spg * Vehicle.Dim.L );
+}
+
+// applies flows between the pipe and brake valves of specified type
+// NOTE: the caller guarantees exact type of the valves, so the calls can bypass virtual dispatch
+template <class Valve_>
+void
+valve_flows( std::vector<TMoverParameters *> const &Vehicles, double const Deltatime ) {
+
+    for( auto *vehicle : Vehicles ) {
+        auto &valve { static_cast<Valve_ &>( *vehicle->Hamulec ) };
+        auto const open { ( ( valve.GetBrakeStatus() & b_dmg ) == b_dmg ? 0.0 : 1.0 ) }; // jesli hamulec wyłączony, odetnij
+        vehicle->Pipe->Flow( open * valve.Valve_::GetPF( open * vehicle->PipePress, Deltatime, vehicle->Vel ) );
+    }
+}
+
+} // namespace
+
+// adds specified vehicle to the batch, if its pipe update waits for the solver
+void
+brake_pipe_solver::insert( TMoverParameters &Vehicle ) {
+
+    if( false == Vehicle.PipeFlowPending ) { return; }
+
+    m_vehicles.emplace_back( &Vehicle );
+
+    auto const &type { typeid( *Vehicle.Hamulec ) };
+    auto const group { (
+        type == typeid( TWest ) ?    valve::west :
+        type == typeid( TKE ) ?      valve::ke :
+        type == typeid( TNESt3 ) ?   valve::nest3 :
+        type == typeid( TLSt ) ?     valve::lst :
+        type == typeid( TEStED ) ?   valve::ested :
+        type == typeid( TEStEP2 ) ?  valve::estep2 :
+        type == typeid( TCV1 ) ?     valve::cv1 :
+        type == typeid( TCV1L_TR ) ? valve::cv1l_tr :
+        type == typeid( TBrake ) ?   valve::basic :
+                                     valve::other ) };
+    m_valves[ group ].emplace_back( &Vehicle );
+}
+
+// calculates and applies flows over specified time for vehicles in the batch, and empties the batch
+void
+brake_pipe_solver::solve( double const Deltatime ) {
+
+    if( true == m_vehicles.empty() ) { return; }
+
+    gather_links();
+    compute_links( Deltatime );
+    // flows are only accumulated until the pipes are updated, so the order of these two doesn't matter
+    update_valves( Deltatime );
+    scatter_links();
+
+    for( auto *vehicle : m_vehicles ) {
+        vehicle->FinishPipePressure();
+        vehicle->PipeFlowPending = false;
+    }
+
+    m_vehicles.clear();
+    for( auto &group : m_valves ) {
+        group.clear();
+    }
+}
+
+// collects pressures and conductances of hoses linking vehicles in the batch
+void
+brake_pipe_solver::gather_links() {
+
+    m_firstvehicles.clear();
+    m_secondvehicles.clear();
+    m_firstpressures.clear();
+    m_secondpressures.clear();
+    m_conductances.clear();
+
+    for( auto *vehicle : m_vehicles ) {
+        for( auto const &coupler : vehicle->Couplers ) {
+            auto *other { coupler.Connected };
+            if( ( other == nullptr )
+             || ( false == TestFlag( coupler.CouplingFlag, ctrain_pneumatic ) ) ) {
+                continue;
+            }
+            // as with the per-vehicle update, each vehicle calculates flow through its own hoses at half rate,
+            // so the hose between two vehicles in the batch is accounted for from both ends
+            m_firstvehicles.emplace_back( vehicle );
+            m_secondvehicles.emplace_back( other );
+            m_firstpressures.emplace_back( vehicle->PipePress );
+            m_secondpressures.emplace_back( other->PipePress );
+            m_conductances.emplace_back( conductance( *vehicle ) );
+        }
+    }
+}
+
+// calculates flows through collected hoses
+void
+brake_pipe_solver::compute_links( double const Deltatime ) {
+
+    auto const linkcount { m_conductances.size() };
+    m_flows.resize( linkcount );
+
+    auto const *firstpressures { m_firstpressures.data() };
+    auto const *secondpressures { m_secondpressures.data() };
+    auto const *conductances { m_conductances.data() };
+    auto *flows { m_flows.data() };
+    for( std::size_t idx = 0; idx < linkcount; ++idx ) {
+        flows[ idx ] = 0.5 * Deltatime * pipe_flow( firstpressures[ idx ], secondpressures[ idx ], conductances[ idx ] );
+    }
+}
+
+// applies calculated hose flows to the pipes of linked vehicles
+void
+brake_pipe_solver::scatter_links() {
+
+    for( std::size_t idx = 0; idx < m_flows.size(); ++idx ) {
+        auto const flow { m_flows[ idx ] };
+        auto *second { m_secondvehicles[ idx ] };
+        if( flow * flow > 0.00000000000001 ) {
+            second->Physic_ReActivation();
+        }
+        m_firstvehicles[ idx ]->Pipe->Flow( flow );
+        second->Pipe->Flow( -flow );
+    }
+}
+
+// applies flows between brake valves and the pipe
+void
+brake_pipe_solver::update_valves( double const Deltatime ) const {
+
+    valve_flows<TWest>( m_valves[ valve::west ], Deltatime );
+    valve_flows<TKE>( m_valves[ valve::ke ], Deltatime );
+    valve_flows<TNESt3>( m_valves[ valve::nest3 ], Deltatime );
+    valve_flows<TLSt>( m_valves[ valve::lst ], Deltatime );
+    valve_flows<TEStED>( m_valves[ valve::ested ], Deltatime );
+    valve_flows<TEStEP2>( m_valves[ valve::estep2 ], Deltatime );
+    valve_flows<TCV1>( m_valves[ valve::cv1 ], Deltatime );
+    valve_flows<TCV1L_TR>( m_valves[ valve::cv1l_tr ], Deltatime );
+    valve_flows<TBrake>( m_valves[ valve::basic ], Deltatime );
+
+    for( auto *vehicle : m_valves[ valve::other ] ) {
+        auto const open { ( ( vehicle->Hamulec->GetBrakeStatus() & b_dmg ) == b_dmg ? 0.0 : 1.0 ) };
+        vehicle->Pipe->Flow( open * vehicle->Hamulec->GetPF( open * vehicle->PipePress, Deltatime, vehicle->Vel ) );
+    }
+}
@@ -0,0 +1,72 @@
+/*
+This Source Code Form is subject to the
+terms of the Mozilla Public License, v.
+2.0. If a copy of the MPL was not
+distributed with this file, You can
+obtain one at
+http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+class TMoverParameters;
+
+// calculates flows of the main brake pipe for whole consists, in place of the per-vehicle TMoverParameters::GetDVc()
+// vehicles with PipeFlowDeferred flag stop their pipe update before the brake valve and coupler flows, and are collected here.
+// flows through all hoses are then calculated in a single pass from pressures taken at the same moment, while
+// brake valves are processed in groups of the same type
+class brake_pipe_solver {
+
+public:
+// methods
+    // adds specified vehicle to the batch, if its pipe update waits for the solver
+    void
+        insert( TMoverParameters &Vehicle );
+    // calculates and applies flows over specified time for vehicles in the batch, and empties the batch
+    void
+        solve( double const Deltatime );
+
+private:
+// types
+    // brake valve types processed without virtual dispatch, i.e. the ones created by TMoverParameters::CheckLocomotiveParameters()
+    enum valve : std::size_t {
+        west,
+        ke,
+        nest3,
+        lst,
+        ested,
+        estep2,
+        cv1,
+        cv1l_tr,
+        basic,
+        other, // anything else goes through the virtual call
+        count_
+    };
+// methods
+    // collects pressures and conductances of hoses of vehicles in the batch
+    void
+        gather_links();
+    // calculates flows through collected hoses
+    void
+        compute_links( double const Deltatime );
+    // applies calculated hose flows to the pipes of linked vehicles
+    void
+        scatter_links();
+    // applies flows between brake valves and the pipe
+    void
+        update_valves( double const Deltatime ) const;
+// members
+    std::vector<TMoverParameters *> m_vehicles; // the batch, in order of insertion
+    std::array<std::vector<TMoverParameters *>, valve::count_> m_valves; // the batch, grouped by brake valve type
+    // hoses between coupled vehicles. NOTE: kept as separate arrays, so the flow calculation can be vectorized
+    std::vector<TMoverParameters *> m_firstvehicles;
+    std::vector<TMoverParameters *> m_secondvehicles;
+    std::vector<double> m_firstpressures;
+    std::vector<double> m_secondpressures;
+    std::vector<double> m_conductances; // of the pipe sections of the first vehicles
+    std::vector<double> m_flows; // from the second vehicle into the first one
+};
@@ -0,0 +1,301 @@
+/*
+This Source Code Form is subject to the
+terms of the Mozilla Public License, v.
+2.0. If a copy of the MPL was not
+distributed with this file, You can
+obtain one at
+http://mozilla.org/MPL/2.0/.
+*/
+
+#include "stdafx.h"
+#include "fizcache.h"
+
+#include "Globals.h"
+#include "Logs.h"
+#include "sn_utils.h"
+#include "utilities.h"
+
+namespace {
+
+std::uint32_t const cache_magic { MAKE_ID4( 'F', 'I', 'Z', 'C' ) };
+std::uint32_t const cache_version { 1 }; // bump whenever parsing rules or tags change
+
+// returns name of binary cache file for specified .fiz file
+std::string
+cache_name( std::string const &File ) {
+
+    return File + "c";
+}
+
+bool
+issection( std::string_view const Name, std::string const &Input ) {
+
+    return ( Input.compare( 0, Name.size(), Name ) == 0 );
+}
+
+} // namespace
+
+fiz_cache::data_map fiz_cache::m_data;
+std::mutex fiz_cache::m_mutex;
+
+// returns parsed content of specified .fiz file, or null if the file can't be read
+std::shared_ptr<fiz_data const>
+fiz_cache::find( std::string const &File ) {
+
+    std::lock_guard<std::mutex> lock { m_mutex };
+
+    auto const lookup { m_data.find( File ) };
+    if( lookup != m_data.end() ) {
+        return lookup->second;
+    }
+    auto data { load( File ) };
+    if( data != nullptr ) {
+        // failed attempts aren't remembered, in case the file shows up later
+        m_data.emplace( File, data );
+    }
+    return data;
+}
+
+// retrieves content of specified file from its binary cache, or by parsing the source
+std::shared_ptr<fiz_data const>
+fiz_cache::load( std::string const &File ) {
+
+    auto const modified { static_cast<std::uint64_t>( last_modified( File ) ) };
+    if( modified == 0 ) {
+        // no such file
+        return nullptr;
+    }
+
+    auto const cachefile { cache_name( File ) };
+    source_signature cachesignature;
+    std::ifstream input;
+    bool cacheusable { false }; // signature of the cache was read, and the data following it wasn't tried yet
+    if( true == Global.FizCache ) {
+        input.open( cachefile, std::ios::binary );
+        if( ( true == input.is_open() )
+         && ( true == deserialize( input, cachesignature ) ) ) {
+            if( cachesignature.modified == modified ) {
+                // unchanged source, we can skip reading it altogether
+                auto data { deserialize( input ) };
+                if( data != nullptr ) {
+                    return data;
+                }
+                // damaged cache, the read position is somewhere in the data so the source is parsed instead
+            }
+            else {
+                cacheusable = true;
+            }
+        }
+    }
+
+    mapped_file const source { File };
+    if( false == source.is_open() ) {
+        return nullptr;
+    }
+    source_signature const signature { modified, source.size(), content_hash( source.data() ) };
+
+    std::shared_ptr<fiz_data> data;
+    if( ( true == cacheusable )
+     && ( cachesignature.size == signature.size )
+     && ( cachesignature.hash == signature.hash ) ) {
+        // touched or copied, but otherwise the same source
+        data = deserialize( input );
+    }
+    if( data == nullptr ) {
+        data = parse( source.data() );
+    }
+    input.close();
+
+    if( true == Global.FizCache ) {
+        // update the cache, so the next session can use it without looking at the source
+        // NOTE: failure to write is harmless, the data directory can be read-only
+        std::ofstream output( cachefile, std::ios::binary | std::ios::trunc );
+        if( true == output.is_open() ) {
+            serialize( output, signature, *data );
+        }
+    }
+
+    return data;
+}
+
+// splits provided text of .fiz file into tagged lines
+std::shared_ptr<fiz_data>
+fiz_cache::parse( std::string_view const Input ) {
+
+    auto data { std::make_shared<fiz_data>() };
+    auto &lines { data->lines };
+    // table parsing is enabled by table headers, and lasts until switched off by end marker or another header
+    bool
+        bpt { false },
+        mpt { false },
+        mpt0 { false },
+        rlist { false },
+        dlist { false },
+        fflist { false },
+        wwlist { false },
+        lightslist { false };
+
+    std::size_t position { 0 };
+    while( position < Input.size() ) {
+
+        auto lineend { Input.find( '\n', position ) };
+        if( lineend == std::string_view::npos ) {
+            lineend = Input.size();
+        }
+        std::string inputline { Input.substr( position, lineend - position ) };
+        position = lineend + 1;
+
+        bool comment = ( ( inputline.find('#') != std::string::npos )
+			          || ( inputline.compare( 0, 2, "//" ) == 0 ) );
+        if( true == comment ) {
+            // skip commented lines
+            continue;
+        }
+
+        if( inputline[ 0 ] == ' ' ) {
+            // guard against malformed config files with leading spaces
+            inputline.erase( 0, inputline.find_first_not_of( ' ' ) );
+        }
+
+		// trim CR at end (mainly for linux)
+		if (!inputline.empty() && inputline.back() == '\r')
+			inputline.pop_back();
+
+		if( inputline.length() == 0 ) {
+			bpt = false;
+			continue;
+		}
+
+        // checking if table parsing should be switched off goes first...
+        if( issection( "END-MPT", inputline ) ) { bpt = false; mpt = false; mpt0 = false; continue; }
+        if( issection( "END-RL", inputline ) )  { bpt = false; rlist = false; continue; }
+        if( issection( "END-DL", inputline ) )  { bpt = false; dlist = false; continue; }
+        if( issection( "endff", inputline ) )   { bpt = false; fflist = false; continue; }
+        if( issection( "END-WWL", inputline ) ) { bpt = false; wwlist = false; continue; }
+        if( issection( "endL", inputline ) )    { bpt = false; lightslist = false; continue; }
+
+        // ...then all recognized sections...
+        struct section_header {
+            std::string_view name;
+            fiz_data::section type;
+        };
+        static std::vector<section_header> const headers {
+            { "Param.", fiz_data::section::param },
+            { "Load:", fiz_data::section::load },
+            { "Dimensions:", fiz_data::section::dimensions },
+            { "Wheels:", fiz_data::section::wheels },
+            { "Brake:", fiz_data::section::brake },
+            { "Doors:", fiz_data::section::doors },
+            { "BuffCoupl.", fiz_data::section::buffcoupl },
+            { "BuffCoupl1.", fiz_data::section::buffcoupl1 },
+            { "BuffCoupl2.", fiz_data::section::buffcoupl2 },
+            { "TurboPos:", fiz_data::section::turbopos },
+            { "Cntrl.", fiz_data::section::cntrl },
+            { "Blending:", fiz_data::section::blending },
+            { "Light:", fiz_data::section::light },
+            { "Security:", fiz_data::section::security },
+            { "Clima:", fiz_data::section::clima },
+            { "Power:", fiz_data::section::power },
+            { "Engine:", fiz_data::section::engine },
+            { "Switches:", fiz_data::section::switches },
+            { "MotorParamTable:", fiz_data::section::motorparamtable },
+            { "MotorParamTable0:", fiz_data::section::motorparamtable0 },
+            { "Circuit:", fiz_data::section::circuit },
+            { "RList:", fiz_data::section::rlist },
+            { "DList:", fiz_data::section::dlist },
+            { "ffList:", fiz_data::section::fflist },
+            { "WWList:", fiz_data::section::wwlist },
+            { "LightsList:", fiz_data::section::lightslist } };
+
+        auto const header {
+            std::find_if(
+                std::begin( headers ), std::end( headers ),
+                [&]( section_header const &Header ) {
+                    return issection( Header.name, inputline ); } ) };
+        if( header != std::end( headers ) ) {
+            bpt = false;
+            switch( header->type ) {
+                case fiz_data::section::cntrl:
+                case fiz_data::section::blending: { bpt = true; break; }
+                case fiz_data::section::motorparamtable: { mpt = true; break; }
+                case fiz_data::section::motorparamtable0: { mpt0 = true; break; }
+                case fiz_data::section::rlist: { rlist = true; break; }
+                case fiz_data::section::dlist: { dlist = true; break; }
+                case fiz_data::section::fflist: { fflist = true; break; }
+                case fiz_data::section::wwlist: { wwlist = true; break; }
+                case fiz_data::section::lightslist: { lightslist = true; break; }
+                default: { break; }
+            }
+            lines.push_back( { header->type, inputline } );
+            continue;
+        }
+
+        // ...and finally, table rows.
+        // NOTE: once table parsing is enabled it lasts until switched off, when another section is recognized
+             if( true == bpt )        { lines.push_back( { fiz_data::section::bpt_row, inputline } ); }
+        else if( true == mpt )        { lines.push_back( { fiz_data::section::mpt_row, inputline } ); }
+        else if( true == mpt0 )       { lines.push_back( { fiz_data::section::mpt0_row, inputline } ); }
+        else if( true == rlist )      { lines.push_back( { fiz_data::section::rlist_row, inputline } ); }
+        else if( true == dlist )      { lines.push_back( { fiz_data::section::dlist_row, inputline } ); }
+        else if( true == fflist )     { lines.push_back( { fiz_data::section::fflist_row, inputline } ); }
+        else if( true == wwlist )     { lines.push_back( { fiz_data::section::wwlist_row, inputline } ); }
+        else if( true == lightslist ) { lines.push_back( { fiz_data::section::lightslist_row, inputline } ); }
+    }
+
+    return data;
+}
+
+// retrieves signature of the source from provided binary cache stream. returns: true on success
+bool
+fiz_cache::deserialize( std::istream &Input, source_signature &Signature ) {
+
+    if( ( sn_utils::ld_uint32( Input ) != cache_magic )
+     || ( sn_utils::ld_uint32( Input ) != cache_version ) ) {
+        return false;
+    }
+    Signature.modified = sn_utils::ld_uint64( Input );
+    Signature.size = sn_utils::ld_uint64( Input );
+    Signature.hash = sn_utils::ld_uint64( Input );
+
+    return Input.good();
+}
+
+// restores parsed content from provided binary cache stream, past the signature
+std::shared_ptr<fiz_data>
+fiz_cache::deserialize( std::istream &Input ) {
+
+    auto data { std::make_shared<fiz_data>() };
+    auto linecount { sn_utils::ld_uint32( Input ) };
+    data->lines.reserve( linecount );
+    while( ( linecount-- )
+        && ( true == Input.good() ) ) {
+        auto const type { sn_utils::ld_uint16( Input ) };
+        auto text { sn_utils::d_str( Input ) };
+        if( type >= static_cast<std::uint16_t>( fiz_data::section::count_ ) ) {
+            return nullptr;
+        }
+        data->lines.push_back( { static_cast<fiz_data::section>( type ), std::move( text ) } );
+    }
+
+    return (
+        true == Input.good() ?
+            data :
+            nullptr );
+}
+
+// stores parsed content with signature of its source in provided stream
+void
+fiz_cache::serialize( std::ostream &Output, source_signature const &Signature, fiz_data const &Data ) {
+
+    sn_utils::ls_uint32( Output, cache_magic );
+    sn_utils::ls_uint32( Output, cache_version );
+    sn_utils::ls_uint64( Output, Signature.modified );
+    sn_utils::ls_uint64( Output, Signature.size );
+    sn_utils::ls_uint64( Output, Signature.hash );
+
+    sn_utils::ls_uint32( Output, static_cast<std::uint32_t>( Data.lines.size() ) );
+    for( auto const &line : Data.lines ) {
+        sn_utils::ls_uint16( Output, static_cast<std::uint16_t>( line.type ) );
+        sn_utils::s_str( Output, line.text );
+    }
+}
@@ -0,0 +1,117 @@
+/*
+This Source Code Form is subject to the
+terms of the Mozilla Public License, v.
+2.0. If a copy of the MPL was not
+distributed with this file, You can
+obtain one at
+http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// content of .fiz vehicle definition file, stripped of comments and empty lines
+// each remaining line is tagged with the part of the definition it belongs to, so it can be handed directly to its reader
+struct fiz_data {
+// types
+    enum class section : std::uint8_t {
+        // section headers
+        param,
+        load,
+        dimensions,
+        wheels,
+        brake,
+        doors,
+        buffcoupl,
+        buffcoupl1,
+        buffcoupl2,
+        turbopos,
+        cntrl,
+        blending,
+        light,
+        security,
+        clima,
+        power,
+        engine,
+        switches,
+        motorparamtable,
+        motorparamtable0,
+        circuit,
+        rlist,
+        dlist,
+        fflist,
+        wwlist,
+        lightslist,
+        // rows of tables following some of the headers. NOTE: keep them after the headers, the loader relies on the order
+        bpt_row,
+        mpt_row,
+        mpt0_row,
+        rlist_row,
+        dlist_row,
+        fflist_row,
+        wwlist_row,
+        lightslist_row,
+        count_
+    };
+    struct line {
+        section type;
+        std::string text;
+    };
+// members
+    std::vector<line> lines;
+};
+
+// parsed .fiz files, shared by all vehicles of the same type
+// each file is parsed once per session. parsed content is also stored in a binary file next to the source,
+// and reused in later sessions for as long as modification time or content hash of the source match
+class fiz_cache {
+
+public:
+// methods
+    // returns parsed content of specified .fiz file, or null if the file can't be read
+    static
+    std::shared_ptr<fiz_data const>
+        find( std::string const &File );
+
+private:
+// types
+    using data_map = std::unordered_map<std::string, std::shared_ptr<fiz_data const>>;
+    // identifies version of the source file used to create binary cache
+    struct source_signature {
+        std::uint64_t modified { 0 }; // modification time
+        std::uint64_t size { 0 };
+        std::uint64_t hash { 0 };
+    };
+// methods
+    // retrieves content of specified file from its binary cache, or by parsing the source
+    static
+    std::shared_ptr<fiz_data const>
+        load( std::string const &File );
+    // splits provided text of .fiz file into tagged lines
+    static
+    std::shared_ptr<fiz_data>
+        parse( std::string_view const Input );
+    // retrieves signature of the source from provided binary cache stream. returns: true on success
+    static
+    bool
+        deserialize( std::istream &Input, source_signature &Signature );
+    // restores parsed content from provided binary cache stream, past the signature
+    static
+    std::shared_ptr<fiz_data>
+        deserialize( std::istream &Input );
+    // stores parsed content with signature of its source in provided stream
+    static
+    void
+        serialize( std::ostream &Output, source_signature const &Signature, fiz_data const &Data );
+// members
+    static data_map m_data;
+    static std::mutex m_mutex;
+};
@@ -15,6 +15,35 @@ Copyright (C) 2007-2013 Maciej Cierniak
 #include "stdafx.h"
 #include "friction.h"
 
+#include <typeinfo>
+#include "Logs.h"
+#include "utilities.h"
+
+namespace {
+
+// layout of friction tables. bilinear interpolation error grows with square of the step,
+// and is the largest at low velocity, where the exponential terms bend the most
+double const tableforcestep { 2.0 }; // kN
+double const tablevelocitystep { 1.0 }; // km/h
+std::size_t const tableforcecells { 100 }; // 0-200 kN
+std::size_t const tablevelocitycells { 300 }; // 0-300 km/h
+double const tablemaxerror { 0.001 }; // less accurate tables are discarded in favour of the exact formula
+
+// returns: name of specified material if its formula is costly enough to be tabulated, or empty string
+std::string
+tabulated_name( TFricMat const &Material ) {
+
+    auto const &type { typeid( Material ) };
+    return (
+        type == typeid( TP10Bg ) ?   "P10Bg" :
+        type == typeid( TP10Bgu ) ?  "P10Bgu" :
+        type == typeid( TP10yBg ) ?  "P10yBg" :
+        type == typeid( TP10yBgu ) ? "P10yBgu" :
+                                     "" );
+}
+
+} // namespace
+
 double TFricMat::GetFC(double N, double Vel)
 {
     return 1;
@@ -110,4 +139,82 @@ double TFR510::GetFC(double N, double Vel)
     return 0.15;
 }
 
+friction_table::table_map friction_table::m_tables;
+std::mutex friction_table::m_mutex;
+
+// returns table for specified material, or null if the material should be calculated exactly
+std::shared_ptr<friction_table const>
+friction_table::find( std::shared_ptr<TFricMat> const &Material ) {
+
+    if( Material == nullptr ) { return nullptr; }
+
+    auto const name { tabulated_name( *Material ) };
+    if( true == name.empty() ) { return nullptr; }
+
+    std::lock_guard<std::mutex> lock { m_mutex };
+
+    std::type_index const type { typeid( *Material ) };
+    auto const lookup { m_tables.find( type ) };
+    if( lookup != m_tables.end() ) {
+        return lookup->second;
+    }
+    std::shared_ptr<friction_table const> table { new friction_table( Material ) };
+    if( table->max_error() > tablemaxerror ) {
+        ErrorLog( "Bad friction table: interpolation error " + to_string( table->max_error(), 6 ) + " for " + name + " material exceeds the limit, exact formula is used instead" );
+        table.reset();
+    }
+    else {
+        WriteLog( "Friction table for " + name + " material built, interpolation error up to " + to_string( table->max_error(), 6 ) );
+    }
+    // failed attempts are remembered as well, there's no point in repeating them
+    m_tables.emplace( type, table );
+
+    return table;
+}
+
+// builds the table from the exact formula of specified material
+friction_table::friction_table( std::shared_ptr<TFricMat> const &Material ) :
+    m_material( Material ) {
+
+    auto const rowsize { tablevelocitycells + 1 };
+    m_values.resize( ( tableforcecells + 1 ) * rowsize );
+    for( std::size_t force = 0; force <= tableforcecells; ++force ) {
+        for( std::size_t velocity = 0; velocity <= tablevelocitycells; ++velocity ) {
+            m_values[ force * rowsize + velocity ] = static_cast<float>( m_material->GetFC( force * tableforcestep, velocity * tablevelocitystep ) );
+        }
+    }
+    // validation. the error of bilinear interpolation peaks around the middle of the cell
+    for( std::size_t force = 0; force < tableforcecells; ++force ) {
+        for( std::size_t velocity = 0; velocity < tablevelocitycells; ++velocity ) {
+            auto const N { ( force + 0.5 ) * tableforcestep };
+            auto const Vel { ( velocity + 0.5 ) * tablevelocitystep };
+            m_maxerror = std::max( m_maxerror, std::abs( GetFC( N, Vel ) - m_material->GetFC( N, Vel ) ) );
+        }
+    }
+}
+
+// returns: friction coefficient for specified force (kN) and velocity (km/h). values outside of the table are calculated exactly
+double
+friction_table::GetFC( double const N, double const Vel ) const {
+
+    auto const force { N / tableforcestep };
+    auto const velocity { Vel / tablevelocitystep };
+    // NOTE: negated test, to send NaNs to the exact formula as well
+    if( false == ( ( force >= 0.0 ) && ( force < tableforcecells )
+                && ( velocity >= 0.0 ) && ( velocity < tablevelocitycells ) ) ) {
+        return m_material->GetFC( N, Vel );
+    }
+    auto const forceidx { static_cast<std::size_t>( force ) };
+    auto const velocityidx { static_cast<std::size_t>( velocity ) };
+    auto const forceweight { force - forceidx };
+    auto const velocityweight { velocity - velocityidx };
+
+    auto const *low { &m_values[ forceidx * ( tablevelocitycells + 1 ) + velocityidx ] }; // lower force
+    auto const *high { low + ( tablevelocitycells + 1 ) }; // higher force
+    auto const lowvalue { low[ 0 ] + ( low[ 1 ] - low[ 0 ] ) * velocityweight };
+    auto const highvalue { high[ 0 ] + ( high[ 1 ] - high[ 0 ] ) * velocityweight };
+
+    return lowvalue + ( highvalue - lowvalue ) * forceweight;
+}
+
 //END
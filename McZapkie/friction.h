@@ -34,6 +34,12 @@ Zrobione:
 
 
 //uses hamulce;
+
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
  
 
 class TFricMat
@@ -145,7 +151,37 @@ public:
 
 
 
-
+// friction coefficient of a material, tabulated over brake shoe force and velocity, and interpolated bilinearly.
+// tables are built from the exact formulas on first use, and shared by all brakes using the same material
+class friction_table
+{
+public:
+// methods
+    // returns table for specified material, or null if the material should be calculated exactly
+    static
+    std::shared_ptr<friction_table const>
+        find( std::shared_ptr<TFricMat> const &Material );
+    // returns: friction coefficient for specified force (kN) and velocity (km/h). values outside of the table are calculated exactly
+    double
+        GetFC( double const N, double const Vel ) const;
+    // returns: the largest difference from the exact formula, measured at centres of table cells
+    double
+        max_error() const {
+            return m_maxerror; }
+
+private:
+// types
+    using table_map = std::unordered_map<std::type_index, std::shared_ptr<friction_table const>>;
+// methods
+    // builds the table from the exact formula of specified material
+    explicit friction_table( std::shared_ptr<TFricMat> const &Material );
+// members
+    std::shared_ptr<TFricMat> m_material; // source of the table, and of values outside of it
+    std::vector<float> m_values; // rows of constant force, columns of constant velocity
+    double m_maxerror { 0.0 };
+    static table_map m_tables;
+    static std::mutex m_mutex;
+};
 
 #endif//INCLUDED_FRICTION_H
 //END
@@ -17,6 +17,7 @@ Copyright (C) 2007-2014 Maciej Cierniak
 #include <typeinfo>
 #include "MOVER.h"
 #include "utilities.h"
+#include "Globals.h"
 
 //---FUNKCJE OGOLNE---
 
@@ -298,6 +299,9 @@ TBrake::TBrake(double i_mbp, double i_bcr, double i_bcd, double i_brc, int i_bcn
     default: // domyslnie
         FM = std::make_shared<TP10>();
     }
+    if( false == Global.ExactFriction ) {
+        FMTable = friction_table::find( FM );
+    }
 }
 
 // inicjalizacja hamulca (stan poczatkowy)
@@ -309,7 +313,10 @@ void TBrake::Init( double const PP, double const HPP, double const LPP, double c
 // pobranie wspolczynnika tarcia materialu
 double TBrake::GetFC( double const Vel, double const N )
 {
-    return FM->GetFC(N, Vel);
+    return (
+        FMTable != nullptr ?
+            FMTable->GetFC( N, Vel ) :
+            FM->GetFC( N, Vel ) );
 }
 
 // cisnienie cylindra hamulcowego
@@ -175,6 +175,7 @@ class TBrake {
 		int BrakeDelays = 0; //dostepne opoznienia
 		int BrakeDelayFlag = 0; //aktualna nastawa
 		std::shared_ptr<TFricMat> FM; //material cierny
+		std::shared_ptr<friction_table const> FMTable; //stablicowany wspolczynnik tarcia materialu, jesli uzywany
 		double MaxBP = 0.0; //najwyzsze cisnienie
 		int BA = 0; //osie hamowane
 		int NBpA = 0; //klocki na os
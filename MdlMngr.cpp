@@ -39,6 +39,10 @@ TMdlContainer::LoadModel(std::string const &Name, bool const Dynamic) {
 
 TModelsManager::modelcontainer_sequence TModelsManager::m_models { 1, TMdlContainer{} };
 TModelsManager::stringmodelcontainerindex_map TModelsManager::m_modelsmap;
+TModelsManager::modelrequest_sequence TModelsManager::m_requests;
+threading::task_pool TModelsManager::m_loaders;
+std::size_t TModelsManager::m_completedcount { 0 };
+float const TModelsManager::m_placeholderradius { 50.f };
 
 // wczytanie modelu do tablicy
 TModel3d *
@@ -79,14 +83,8 @@ TModelsManager::GetModel(std::string const &Name, bool const Dynamic)
     // - wczytanie uproszczonego wnętrza, ścieżka dokładna, tekstury z katalogu modelu
     // - niebo animowane, ścieżka brana ze wpisu, tekstury nieokreślone
     // - wczytanie modelu animowanego - Init() - sprawdzić
-    std::string const buftp { Global.asCurrentTexturePath }; // zapamiętanie aktualnej ścieżki do tekstur,
+    std::string const buftp { set_texture_path( Name, Dynamic ) }; // zapamiętanie aktualnej ścieżki do tekstur,
     std::string filename { Name };
-    if( Name.find( '/' ) != std::string::npos && !Dynamic ) {
-        // pobieranie tekstur z katalogu, w którym jest model
-        // when loading vehicles the path is set by the calling routine, so we can skip it here
-        Global.asCurrentTexturePath += Name;
-        Global.asCurrentTexturePath.erase( Global.asCurrentTexturePath.rfind( '/' ) + 1 );
-    }
     erase_extension( filename );
     filename = ToLower( filename );
 
@@ -114,6 +112,185 @@ TModelsManager::GetModel(std::string const &Name, bool const Dynamic)
     return model; // NULL jeśli błąd
 };
 
+// queues loading of specified model on a worker thread. returns handle of the model, or null_handle if it can't be found
+model_handle
+TModelsManager::RequestModel( std::string const &Name, bool const Dynamic ) {
+
+    std::string filename { Name };
+    erase_extension( filename );
+    filename = ToLower( filename );
+
+    for( auto const &name : { filename, szModelPath + filename } ) {
+        auto const lookup { m_modelsmap.find( name ) };
+        if( lookup != m_modelsmap.end() ) {
+            return static_cast<model_handle>( lookup->second );
+        }
+    }
+
+    std::string const disklookup { find_on_disk( filename ) };
+    if( disklookup.empty() ) {
+        ErrorLog( "Bad file: failed do locate 3d model file \"" + filename + "\"", logtype::file );
+        m_modelsmap.emplace( filename, null_handle );
+        return null_handle;
+    }
+    if( false == FileExists( disklookup + ".e3d" ) ) {
+        // text format models fetch their materials during parsing, so they can be only loaded synchronously
+        GetModel( Name, Dynamic );
+        auto const lookup { m_modelsmap.find( disklookup ) };
+        return (
+            lookup != m_modelsmap.end() ?
+                static_cast<model_handle>( lookup->second ) :
+                null_handle );
+    }
+
+    if( m_loaders.size() != static_cast<std::size_t>( Global.ModelLoaderThreads ) ) {
+        m_loaders.resize( Global.ModelLoaderThreads );
+    }
+
+    auto request { std::make_shared<model_request>() };
+    request->container = m_models.size();
+    request->name = disklookup;
+    request->dynamic = Dynamic;
+    request->model = std::make_shared<TModel3d>();
+    request->result = request->loaded.get_future();
+    // texture path is picked up the same way as for synchronous load, but it's only used once the request is finished
+    auto const texturepath { set_texture_path( Name, Dynamic ) };
+    request->texturepath = Global.asCurrentTexturePath;
+    Global.asCurrentTexturePath = texturepath;
+
+    m_models.emplace_back();
+    m_modelsmap.emplace( disklookup, request->container );
+    m_requests.emplace_back( request );
+
+    m_loaders.push(
+        [ request ]() {
+            try {
+                request->model->LoadBinData( request->name + ".e3d" );
+                request->is_good = true;
+            }
+            catch( std::exception const &Error ) {
+                ErrorLog( "Bad model: failed to load 3d model \"" + request->name + "\" (" + Error.what() + ")" );
+            }
+            request->loaded.set_value(); } );
+
+    return static_cast<model_handle>( request->container );
+}
+
+// provides model associated with specified handle, or nullptr if the model isn't loaded (yet)
+TModel3d *
+TModelsManager::Model( model_handle const Handle ) {
+
+    if( ( Handle <= 0 )
+     || ( Handle >= static_cast<model_handle>( m_models.size() ) ) ) {
+        return nullptr;
+    }
+    return m_models[ Handle ].Model.get();
+}
+
+// provides bounding radius of specified model, or a placeholder value if the model isn't loaded (yet)
+float
+TModelsManager::BoundingRadius( model_handle const Handle ) {
+
+    auto const *model { Model( Handle ) };
+    return (
+        model != nullptr ?
+            model->bounding_radius() :
+            m_placeholderradius );
+}
+
+// completes loading of specified model right away, waiting for the worker thread if needed. returns: the model, or nullptr if it failed to load
+TModel3d *
+TModelsManager::FinishModel( model_handle const Handle ) {
+
+    if( ( Handle <= 0 )
+     || ( Handle >= static_cast<model_handle>( m_models.size() ) ) ) {
+        return nullptr;
+    }
+    wait_for_request( Handle );
+    return m_models[ Handle ].Model.get();
+}
+
+// completes loading of models processed by the worker threads, within the per-frame budget
+void
+TModelsManager::update() {
+
+    auto budget { Global.ModelLoaderBudget };
+    auto request { std::begin( m_requests ) };
+    while( ( request != std::end( m_requests ) )
+        && ( budget > 0 ) ) {
+
+        if( ( *request )->result.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready ) {
+            ++request;
+            continue;
+        }
+        finish_request( **request );
+        request = m_requests.erase( request );
+        --budget;
+    }
+}
+
+// debug performance string
+std::string
+TModelsManager::info() {
+
+    if( ( true == m_requests.empty() )
+     && ( m_completedcount == 0 ) ) {
+        return "";
+    }
+    return
+        "; models: "
+        + std::to_string( m_requests.size() ) + " loading, "
+        + std::to_string( m_completedcount ) + " loaded";
+}
+
+// moves model data loaded by the worker to the model bank
+void
+TModelsManager::finish_request( model_request &Request ) {
+
+    Request.result.wait();
+
+    auto &container { m_models[ Request.container ] };
+    if( true == Request.is_good ) {
+        std::swap( Request.texturepath, Global.asCurrentTexturePath );
+        if( true == Request.model->FinishBinLoad( Request.name, Request.dynamic ) ) {
+            container.Model = Request.model;
+            container.m_name = Request.name;
+        }
+        std::swap( Request.texturepath, Global.asCurrentTexturePath );
+    }
+    Request.model.reset();
+    ++m_completedcount;
+}
+
+// completes pending request for specified bank slot, if there's any, waiting for the worker if needed
+void
+TModelsManager::wait_for_request( modelcontainer_sequence::size_type const Container ) {
+
+    auto const request {
+        std::find_if(
+            std::begin( m_requests ), std::end( m_requests ),
+            [&]( std::shared_ptr<model_request> const &Request ) {
+                return Request->container == Container; } ) };
+    if( request == std::end( m_requests ) ) { return; }
+
+    finish_request( **request );
+    m_requests.erase( request );
+}
+
+// sets texture path for models located in the specified directory. returns the previous path
+std::string
+TModelsManager::set_texture_path( std::string const &Name, bool const Dynamic ) {
+
+    std::string const texturepath { Global.asCurrentTexturePath };
+    if( Name.find( '/' ) != std::string::npos && !Dynamic ) {
+        // pobieranie tekstur z katalogu, w którym jest model
+        // when loading vehicles the path is set by the calling routine, so we can skip it here
+        Global.asCurrentTexturePath += Name;
+        Global.asCurrentTexturePath.erase( Global.asCurrentTexturePath.rfind( '/' ) + 1 );
+    }
+    return texturepath;
+}
+
 std::pair<bool, TModel3d *>
 TModelsManager::find_in_databank( std::string const &Name ) {
 
@@ -124,6 +301,8 @@ TModelsManager::find_in_databank( std::string const &Name ) {
     for( auto const &filename : filenames ) {
         auto const lookup { m_modelsmap.find( filename ) };
         if( lookup != m_modelsmap.end() ) {
+            // model requested earlier may be still in the works, finish it before handing it over
+            wait_for_request( lookup->second );
             return { true, m_models[ lookup->second ].Model.get() };
         }
     }
@@ -9,6 +9,9 @@ http://mozilla.org/MPL/2.0/.
 #pragma once
 
 #include "Classes.h"
+#include "utilities.h"
+
+typedef int model_handle;
 
 class TMdlContainer {
     friend class TModelsManager;
@@ -23,15 +26,48 @@ class TModelsManager {
 public:
     // McZapkie: dodalem sciezke, notabene Path!=Patch :)
     static TModel3d *GetModel( std::string const &Name, bool dynamic = false );
+    // queues loading of specified model on a worker thread. returns handle of the model, or null_handle if it can't be found
+    static model_handle RequestModel( std::string const &Name, bool const Dynamic = false );
+    // provides model associated with specified handle, or nullptr if the model isn't loaded (yet)
+    static TModel3d *Model( model_handle const Handle );
+    // provides bounding radius of specified model, or a placeholder value if the model isn't loaded (yet)
+    static float BoundingRadius( model_handle const Handle );
+    // completes loading of specified model right away, waiting for the worker thread if needed. returns: the model, or nullptr if it failed to load
+    static TModel3d *FinishModel( model_handle const Handle );
+    // completes loading of models processed by the worker threads, within the per-frame budget
+    static void update();
+    // debug performance string
+    static std::string info();
 
 private:
 // types:
     typedef std::deque<TMdlContainer> modelcontainer_sequence;
     typedef std::unordered_map<std::string, modelcontainer_sequence::size_type> stringmodelcontainerindex_map;
+    struct model_request {
+        modelcontainer_sequence::size_type container; // slot in the model bank to receive the model
+        std::string name; // name of the model file, without extension
+        std::string texturepath; // texture path active when the request was made
+        bool dynamic;
+        std::shared_ptr<TModel3d> model;
+        bool is_good { false }; // set by the worker if the model data was read without errors
+        std::promise<void> loaded;
+        std::future<void> result;
+    };
+    typedef std::deque<std::shared_ptr<model_request>> modelrequest_sequence;
 // members:
     static modelcontainer_sequence m_models;
     static stringmodelcontainerindex_map m_modelsmap;
+    static modelrequest_sequence m_requests; // models being loaded by the worker threads
+    static threading::task_pool m_loaders;
+    static std::size_t m_completedcount; // number of finished asynchronous loads
+    static float const m_placeholderradius; // bounding radius reported for models which aren't loaded yet
 // methods:
+    // moves model data loaded by the worker to the model bank
+    static void finish_request( model_request &Request );
+    // completes pending request for specified bank slot, if there's any, waiting for the worker if needed
+    static void wait_for_request( modelcontainer_sequence::size_type const Container );
+    // sets texture path for models located in the specified directory. returns the previous path
+    static std::string set_texture_path( std::string const &Name, bool const Dynamic );
     static TModel3d *LoadModel( std::string const &Name, bool const Dynamic );
     static std::pair<bool, TModel3d *> find_in_databank( std::string const &Name );
     // checks whether specified file exists. returns name of the located file, or empty string.
@@ -20,6 +20,7 @@ http://mozilla.org/MPL/2.0/.
 #include "Driver.h"
 #include "Event.h"
 #include "Logs.h"
+#include "sn_utils.h"
 
 //---------------------------------------------------------------------------
 
@@ -170,13 +171,25 @@ void TMemCell::AssignEvents(basic_event *e)
 void
 TMemCell::serialize_( std::ostream &Output ) const {
 
-    // TODO: implement
+    // cell data
+    sn_utils::s_str( Output, szText );
+    sn_utils::ls_float64( Output, fValue1 );
+    sn_utils::ls_float64( Output, fValue2 );
+    // associated track
+    sn_utils::s_str( Output, asTrackName );
 }
 // deserialize() subclass details, restores content of the subclass from provided stream
 void
 TMemCell::deserialize_( std::istream &Input ) {
 
-    // TODO: implement
+    // cell data
+    szText = sn_utils::d_str( Input );
+    fValue1 = sn_utils::ld_float64( Input );
+    fValue2 = sn_utils::ld_float64( Input );
+    // associated track
+    asTrackName = sn_utils::d_str( Input );
+
+    CommandCheck();
 }
 
 // export() subclass details, sends basic content of the class in legacy (text) format to provided stream
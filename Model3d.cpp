@@ -1494,6 +1494,17 @@ void TModel3d::SaveToBinFile(std::string const &FileName)
 }
 
 void TSubModel::deserialize(std::istream &s)
+{
+	deserialize_(s);
+}
+
+void TSubModel::deserialize(sn_reader &s)
+{
+	deserialize_(s);
+}
+
+template <typename Input_>
+void TSubModel::deserialize_(Input_ &s)
 {
 	iNext = sn_utils::ld_int32(s);
 	iChild = sn_utils::ld_int32(s);
@@ -1537,19 +1548,41 @@ void TSubModel::deserialize(std::istream &s)
 }
 
 void TModel3d::deserialize(std::istream &s, size_t size, bool dynamic)
+{
+    deserialize_data( s, size );
+    deserialize_finish( dynamic );
+}
+
+// reads model chunks from provided stream. doesn't touch the renderer, so it's safe to call from a worker thread
+void TModel3d::deserialize_data(std::istream &s, size_t size)
+{
+    // the stream is only a source of data for the memory reader, which does the actual work
+    std::vector<char> data( size );
+    s.read( data.data(), size );
+    if( static_cast<size_t>( s.gcount() ) != size )
+        throw std::runtime_error( "e3d: unexpected end of file" );
+
+    sn_reader input { data.data(), data.size() };
+    deserialize_data( input, size );
+}
+
+// reads model chunks from provided memory block. doesn't touch the renderer, so it's safe to call from a worker thread
+void TModel3d::deserialize_data(sn_reader &s, size_t size)
 {
 	Root = nullptr;
-    if( m_geometrybank == null_handle ) {
-        m_geometrybank = GfxRenderer.Create_Bank();
-    }
 
-	std::streampos end = s.tellg() + (std::streampos)size;
+	size_t const end = s.tell() + size;
+	if (end > s.size())
+		throw std::runtime_error("e3d: main chunk exceeds file size");
 
-	while (s.tellg() < end)
+	while (s.tell() + 8 <= end)
 	{
 		uint32_t type = sn_utils::ld_uint32(s);
-		uint32_t size = sn_utils::ld_uint32(s) - 8;
-		std::streampos end = s.tellg() + (std::streampos)size;
+		uint32_t size = sn_utils::ld_uint32(s);
+		if ((size < 8) || (s.tell() + size - 8 > end))
+			throw std::runtime_error("e3d: invalid chunk size");
+		size -= 8;
+		size_t const end = s.tell() + size;
 
 		if ((type & 0x00FFFFFF) == MAKE_ID4('S', 'U', 'B', 0))
 		{
@@ -1560,26 +1593,15 @@ void TModel3d::deserialize(std::istream &s, size_t size, bool dynamic)
 			size_t sm_cnt = size / sm_size;
 			iSubModelsCount = (int)sm_cnt;
 			Root = new TSubModel[sm_cnt];
-			size_t pos = s.tellg();
+			size_t pos = s.tell();
 			for (size_t i = 0; i < sm_cnt; ++i)
 			{
-				s.seekg(pos + sm_size * i);
+				s.seek(pos + sm_size * i);
 				Root[i].deserialize(s);
 			}
 		}
 		else if (type == MAKE_ID4('V', 'N', 'T', '0'))
 		{
-/*
-            if (m_pVNT != nullptr)
-				throw std::runtime_error("e3d: duplicated VNT chunk");
-
-            size_t vt_cnt = size / 32;
-			iNumVerts = (int)vt_cnt;
-			m_nVertexCount = (int)vt_cnt;
-            m_pVNT.resize( vt_cnt );
-			for (size_t i = 0; i < vt_cnt; i++)
-				m_pVNT[i].deserialize(s);
-*/
             // we rely on the SUB chunk coming before the vertex data, and on the overall vertex count matching the size of data in the chunk.
             // geometry associated with chunks isn't stored in the same order as the chunks themselves, so we need to sort that out first
             if( Root == nullptr )
@@ -1596,36 +1618,37 @@ void TModel3d::deserialize(std::istream &s, size_t size, bool dynamic)
                 submodeloffsets.end(),
                 []( std::pair<int, int> const &Left, std::pair<int, int> const &Right ) {
                     return (Left.first) < (Right.first); } );
+            // vertex data is stored as 8 floats per vertex, matching the memory layout of our vertices
+            // on little endian hosts it can be copied in bulk
+            auto const isbulkcopy { ( sizeof( gfx::basic_vertex ) == 32 ) && ( true == sn_utils::is_little_endian() ) };
             // once sorted we can grab geometry as it comes, and assign it to the chunks it belongs to
             for( auto const &submodeloffset : submodeloffsets ) {
                 auto &submodel = Root[ submodeloffset.second ];
                 gfx::vertex_array vertices; vertices.resize( submodel.iNumVerts );
                 iNumVerts += submodel.iNumVerts;
-                for( auto &vertex : vertices ) {
-                    vertex.deserialize( s );
-                    if( submodel.eType < TP_ROTATOR ) {
-                        // normal vectors debug routine
-                        auto normallength = glm::length2( vertex.normal );
-                        if( ( false == submodel.m_normalizenormals )
-                         && ( std::abs( normallength - 1.0f ) > 0.01f ) ) {
-                            submodel.m_normalizenormals = TSubModel::normalize; // we don't know if uniform scaling would suffice
-                            WriteLog( "Bad model: non-unit normal vector(s) encountered during sub-model geometry deserialization", logtype::model );
-                        }
+                if( true == isbulkcopy ) {
+                    s.read( vertices.data(), vertices.size() * sizeof( gfx::basic_vertex ) );
+                }
+                else {
+                    for( auto &vertex : vertices ) {
+                        vertex.deserialize( s );
                     }
                 }
-                // remap geometry type for custom type submodels
-                int type;
-                switch( submodel.eType ) {
-                    case TP_FREESPOTLIGHT:
-                    case TP_STARS: {
-                        type = GL_POINTS;
-                        break; }
-                    default: {
-                        type = submodel.eType;
-                        break;
+                if( submodel.eType < TP_ROTATOR ) {
+                    // normal vectors debug routine
+                    for( auto const &vertex : vertices ) {
+                        auto normallength = glm::length2( vertex.normal );
+                        if( std::abs( normallength - 1.0f ) > 0.01f ) {
+                            if( false == submodel.m_normalizenormals ) {
+                                submodel.m_normalizenormals = TSubModel::normalize; // we don't know if uniform scaling would suffice
+                                WriteLog( "Bad model: non-unit normal vector(s) encountered during sub-model geometry deserialization", logtype::model );
+                            }
+                            break;
+                        }
                     }
                 }
-                submodel.m_geometry = GfxRenderer.Insert( vertices, m_geometrybank, type );
+                // geometry is handed to the renderer after the whole model is read
+                m_vertexdata.emplace_back( submodeloffset.second, std::move( vertices ) );
             }
 
 		}
@@ -1653,9 +1676,10 @@ void TModel3d::deserialize(std::istream &s, size_t size, bool dynamic)
 		{
 			if (Textures.size())
 				throw std::runtime_error("e3d: duplicated TEX chunk");
-			while (s.tellg() < end)
+			sn_reader chunk { s.skip(size), size };
+			while (chunk.tell() < chunk.size())
 			{
-				std::string str = sn_utils::d_str(s);
+				std::string str = sn_utils::d_str(chunk);
 				std::replace(str.begin(), str.end(), '\\', '/');
 				Textures.push_back(str);
 			}
@@ -1664,15 +1688,42 @@ void TModel3d::deserialize(std::istream &s, size_t size, bool dynamic)
 		{
 			if (Names.size())
 				throw std::runtime_error("e3d: duplicated NAM chunk");
-			while (s.tellg() < end)
-				Names.push_back(sn_utils::d_str(s));
+			sn_reader chunk { s.skip(size), size };
+			while (chunk.tell() < chunk.size())
+				Names.push_back(sn_utils::d_str(chunk));
 		}
 
-		s.seekg(end);
+		s.seek(end);
 	}
 
 	if (!Root)
 		throw std::runtime_error("e3d: no submodels");
+}
+
+// passes model data read by deserialize_data() to the renderer and sets up submodels
+void TModel3d::deserialize_finish(bool dynamic)
+{
+    if( m_geometrybank == null_handle ) {
+        m_geometrybank = GfxRenderer.Create_Bank();
+    }
+
+    for( auto &vertexdata : m_vertexdata ) {
+        auto &submodel = Root[ vertexdata.first ];
+        // remap geometry type for custom type submodels
+        int type;
+        switch( submodel.eType ) {
+            case TP_FREESPOTLIGHT:
+            case TP_STARS: {
+                type = GL_POINTS;
+                break; }
+            default: {
+                type = submodel.eType;
+                break;
+            }
+        }
+        submodel.m_geometry = GfxRenderer.Insert( vertexdata.second, m_geometrybank, type );
+    }
+    m_vertexdata = decltype( m_vertexdata )();
 
     for (size_t i = 0; (int)i < iSubModelsCount; ++i)
 	{
@@ -1792,8 +1843,35 @@ void TSubModel::BinInit(TSubModel *s, float4x4 *m, std::vector<std::string> *t,
 
 void TModel3d::LoadFromBinFile(std::string const &FileName, bool dynamic)
 { // wczytanie modelu z pliku binarnego
+    LoadBinData( FileName );
+    deserialize_finish( dynamic );
+
+    WriteLog( "Finished loading 3d model data from \"" + FileName + "\"", logtype::model );
+};
+
+// reads content of binary model file, without creating gfx resources. safe to call from a worker thread
+void TModel3d::LoadBinData(std::string const &FileName)
+{
     WriteLog( "Loading binary format 3d model data from \"" + FileName + "\"...", logtype::model );
-	
+
+    mapped_file mapping;
+    if( true == mapping.open( FileName ) ) {
+        // read the data straight from the mapped file
+        auto const content { mapping.data() };
+        sn_reader input { content.data(), content.size() };
+
+        uint32_t type = sn_utils::ld_uint32(input);
+        uint32_t size = sn_utils::ld_uint32(input);
+
+        if (type != MAKE_ID4('E', '3', 'D', '0'))
+            throw std::runtime_error("e3d: unknown main chunk");
+        if (size < 8)
+            throw std::runtime_error("e3d: invalid main chunk size");
+
+        deserialize_data(input, size - 8);
+        return;
+    }
+    // fallback for files which can't be mapped
 	std::ifstream file(FileName, std::ios::binary);
 
 	uint32_t type = sn_utils::ld_uint32(file);
@@ -1802,11 +1880,28 @@ void TModel3d::LoadFromBinFile(std::string const &FileName, bool dynamic)
 	if (type != MAKE_ID4('E', '3', 'D', '0'))
 		throw std::runtime_error("e3d: unknown main chunk");
 
-	deserialize(file, size, dynamic);
+	deserialize_data(file, size);
 	file.close();
+}
 
-    WriteLog( "Finished loading 3d model data from \"" + FileName + "\"", logtype::model );
-};
+// completes loading of binary model data read by LoadBinData(). returns true if the model is usable
+bool TModel3d::FinishBinLoad(std::string const &Name, bool dynamic)
+{
+    m_filename = Name;
+    asBinary = ""; // wyłączenie zapisu
+    deserialize_finish( dynamic );
+    Init();
+
+    WriteLog( "Finished loading 3d model data from \"" + Name + ".e3d\"", logtype::model );
+
+	bool const result =
+		Root ? (iSubModelsCount > 0) : false;
+	if (false == result)
+	{
+		ErrorLog("Bad model: failed to load 3d model \"" + Name + "\"");
+	}
+	return result;
+}
 
 void TModel3d::LoadFromTextFile(std::string const &FileName, bool dynamic)
 { // wczytanie submodelu z pliku tekstowego
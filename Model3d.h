@@ -15,6 +15,8 @@ http://mozilla.org/MPL/2.0/.
 #include "openglgeometrybank.h"
 #include "material.h"
 
+class sn_reader;
+
 // Ra: specjalne typy submodeli, poza tym GL_TRIANGLES itp.
 const int TP_ROTATOR = 256;
 const int TP_FREESPOTLIGHT = 257;
@@ -214,6 +216,7 @@ public:
 	float MaxY( float4x4 const &m );
 
 	void deserialize(std::istream&);
+	void deserialize(sn_reader&);
 	void serialize(std::ostream&,
 		std::vector<TSubModel*>&,
 		std::vector<std::string>&,
@@ -221,6 +224,10 @@ public:
 		std::vector<float4x4>&);
     void serialize_geometry( std::ostream &Output ) const;
     // places contained geometry in provided ground node
+
+private:
+    template <typename Input_>
+    void deserialize_(Input_&);
 };
 
 class TModel3d
@@ -241,6 +248,7 @@ private:
 	int iSubModelsCount; // Ra: używane do tworzenia binarnych
 	std::string asBinary; // nazwa pod którą zapisać model binarny
     std::string m_filename;
+    std::vector<std::pair<int, gfx::vertex_array>> m_vertexdata; // submodel index, geometry read from binary file but not yet passed to the renderer
 
 public:
     TModel3d();
@@ -256,6 +264,10 @@ public:
 	void AddTo(TSubModel *tmp, TSubModel *SubModel);
 	void LoadFromTextFile(std::string const &FileName, bool dynamic);
 	void LoadFromBinFile(std::string const &FileName, bool dynamic);
+    // reads content of binary model file, without creating gfx resources. safe to call from a worker thread
+	void LoadBinData(std::string const &FileName);
+    // completes loading of binary model data read by LoadBinData(). returns true if the model is usable
+	bool FinishBinLoad(std::string const &Name, bool dynamic);
 	bool LoadFromFile(std::string const &FileName, bool dynamic);
 	void SaveToBinFile(std::string const &FileName);
 	uint32_t Flags() const { return iFlags; };
@@ -264,6 +276,11 @@ public:
 	int TerrainCount() const;
 	TSubModel * TerrainSquare(int n);
 	void deserialize(std::istream &s, size_t size, bool dynamic);
+
+private:
+    void deserialize_data(std::istream &s, size_t size);
+    void deserialize_data(sn_reader &s, size_t size);
+    void deserialize_finish(bool dynamic);
 };
 
 //---------------------------------------------------------------------------
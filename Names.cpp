@@ -7,7 +7,62 @@ obtain one at
 http://mozilla.org/MPL/2.0/.
 */
 
-#include"stdafx.h"
+#include "stdafx.h"
 #include "Names.h"
 
-//---------------------------------------------------------------------------
+// returns handle of provided name, adding it to the table if it isn't there yet
+name_handle
+name_table::intern( std::string_view const Name ) {
+
+    if( true == Name.empty() ) { return null_name; }
+
+    auto &handles { name_table::handles() };
+    auto const lookup { handles.find( Name ) };
+    if( lookup != handles.end() ) {
+        return lookup->second;
+    }
+    auto &names { name_table::names() };
+    auto const handle { static_cast<name_handle>( names.size() ) };
+    names.emplace_back( Name );
+    // the map refers to the stored copy, which stays in place for the lifetime of the table
+    handles.emplace( names.back(), handle );
+
+    return handle;
+}
+
+// returns handle of provided name, or null_name if the name isn't in the table
+name_handle
+name_table::find( std::string_view const Name ) {
+
+    auto const &handles { name_table::handles() };
+    auto const lookup { handles.find( Name ) };
+    return (
+        lookup != handles.end() ?
+            lookup->second :
+            null_name );
+}
+
+// returns text of the name with specified handle
+std::string const &
+name_table::text( name_handle const Handle ) {
+
+    auto const &names { name_table::names() };
+    return (
+        Handle < names.size() ?
+            names[ Handle ] :
+            names.front() );
+}
+
+name_table::name_sequence &
+name_table::names() {
+
+    static name_sequence names { std::string() }; // handle 0 is reserved for null_name
+    return names;
+}
+
+name_table::handle_map &
+name_table::handles() {
+
+    static handle_map handles;
+    return handles;
+}
@@ -11,6 +11,52 @@ http://mozilla.org/MPL/2.0/.
 
 #include <unordered_map>
 #include <string>
+#include <string_view>
+#include <deque>
+#include <cstdint>
+
+// handle of a name stored in the global name table
+using name_handle = std::uint32_t;
+name_handle const null_name { 0 };
+
+// global collection of unique names, shared by nodes, events and other named items
+// each name is stored once and identified by stable handle, which can be hashed and compared without touching the text
+// NOTE: not thread-safe, names are expected to be interned and looked up on the main thread
+class name_table {
+
+public:
+// methods
+    // returns handle of provided name, adding it to the table if it isn't there yet
+    static
+    name_handle
+        intern( std::string_view const Name );
+    // returns handle of provided name, or null_name if the name isn't in the table
+    static
+    name_handle
+        find( std::string_view const Name );
+    // returns text of the name with specified handle
+    static
+    std::string const &
+        text( name_handle const Handle );
+    // returns number of names in the table
+    static
+    std::size_t
+        size() {
+            return names().size(); }
+
+private:
+// types
+    using name_sequence = std::deque<std::string>; // deque keeps the strings in place, so the map can refer to their content
+    using handle_map = std::unordered_map<std::string_view, name_handle>;
+// methods
+    // provide access to table storage, constructed on first use to be safe for use during static initialization
+    static
+    name_sequence &
+        names();
+    static
+    handle_map &
+        handles();
+};
 
 template <typename Type_>
 class basic_table {
@@ -30,7 +76,7 @@ public:
             }
             auto const itemhandle { m_items.size() - 1 };
             // add item name to the map
-            auto mapping = m_itemmap.emplace( itemname, itemhandle );
+            auto mapping = m_itemmap.emplace( name_table::intern( itemname ), itemhandle );
             if( true == mapping.second ) {
                 return true;
             }
@@ -43,17 +89,31 @@ public:
 	}
     // locates item with specified name. returns pointer to the item, or nullptr
     Type_ *
-        find( std::string const &Name ) const {
+        find( name_handle const Name ) const {
             auto lookup = m_itemmap.find( Name );
             return (
                 lookup != m_itemmap.end() ?
                     m_items[ lookup->second ] :
                     nullptr ); }
+    Type_ *
+        find( std::string_view const Name ) const {
+            // names which were never interned can't belong to any item
+            auto const handle { name_table::find( Name ) };
+            return (
+                handle != null_name ?
+                    find( handle ) :
+                    nullptr ); }
+    Type_ *
+        find( std::string const &Name ) const {
+            return find( std::string_view( Name ) ); }
+    Type_ *
+        find( char const *Name ) const {
+            return find( std::string_view( Name ) ); }
 
 protected:
 // types
     using type_sequence = std::deque<Type_ *>;
-    using index_map = std::unordered_map<std::string, std::size_t>;
+    using index_map = std::unordered_map<name_handle, std::size_t>;
 // members
     type_sequence m_items;
     index_map m_itemmap;
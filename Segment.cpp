@@ -131,6 +131,8 @@ bool TSegment::Init( Math3D::vector3 &NewPoint1, Math3D::vector3 NewCPointOut, M
 
     fStep = fLength / iSegCount; // update step to equalize size of individual pieces
 
+    build_arclength_table();
+
     fTsBuffer.resize( iSegCount + 1 );
     fTsBuffer[ 0 ] = 0.0;
     for( int i = 1; i < iSegCount; ++i ) {
@@ -193,6 +195,14 @@ double TSegment::RombergIntegral(double const fA, double const fB) const
 }
 
 double TSegment::GetTFromS(double const s) const
+{
+    return (
+        m_arclength.empty() ?
+            SolveTFromS( s ) :
+            interpolate_arclength( s ) );
+}
+
+double TSegment::SolveTFromS(double const s) const
 {
     // initial guess for Newton's method
     double fTolerance = 0.001;
@@ -219,6 +229,101 @@ double TSegment::GetTFromS(double const s) const
 	return fTime;
 };
 
+// builds arc length table used to convert distance to curve parameter, refining it until it meets the error bound
+void TSegment::build_arclength_table() {
+
+    m_arclength.clear();
+    m_arcspeed.clear();
+
+    if( false == bCurve ) {
+        // straight track has linear relation between distance and curve parameter, no need for the table
+        return;
+    }
+
+    auto const tolerance { Global.SplineTolerance };
+    int const maxcount { 1024 };
+
+    for( int count = 8; count <= maxcount; count *= 2 ) {
+
+        m_arclength.resize( count + 1 );
+        m_arcspeed.resize( count + 1 );
+        m_arclength[ 0 ] = 0.0;
+        m_arcspeed[ 0 ] = GetFirstDerivative( 0.0 ).Length();
+        for( int idx = 1; idx <= count; ++idx ) {
+            auto const t { double( idx ) / count };
+            m_arclength[ idx ] = m_arclength[ idx - 1 ] + RombergIntegral( double( idx - 1 ) / count, t );
+            m_arcspeed[ idx ] = GetFirstDerivative( t ).Length();
+        }
+        // check the error at the middle of each interval, where it's the largest
+        auto error { 0.0 };
+        for( int idx = 0; idx < count; ++idx ) {
+            auto const t { ( idx + 0.5 ) / count };
+            auto const distance { m_arclength[ idx ] + RombergIntegral( double( idx ) / count, t ) };
+            error = std::max(
+                error,
+                std::abs( interpolate_arclength( distance ) - t ) * GetFirstDerivative( t ).Length() );
+        }
+        if( error <= tolerance ) {
+            return;
+        }
+        if( count == maxcount ) {
+            WriteLog( "Bad track: arc length table for spline \"" + pOwner->name() + "\" exceeds error bound (" + to_string( error, 4 ) + " m)" );
+        }
+    }
+}
+
+// converts distance from the start to curve parameter, using the arc length table
+double TSegment::interpolate_arclength(double const s) const {
+
+    auto const count { static_cast<int>( m_arclength.size() ) - 1 };
+    // outside of the curve extrapolate along the end tangents, for consistency with the newton's method
+    if( s <= 0.0 ) {
+        return (
+            m_arcspeed.front() > 0.0 ?
+                s / m_arcspeed.front() :
+                0.0 );
+    }
+    if( s >= m_arclength.back() ) {
+        return 1.0 + (
+            m_arcspeed.back() > 0.0 ?
+                ( s - m_arclength.back() ) / m_arcspeed.back() :
+                0.0 );
+    }
+    auto const idx {
+        clamp(
+            static_cast<int>( std::upper_bound( std::begin( m_arclength ), std::end( m_arclength ), s ) - std::begin( m_arclength ) ) - 1,
+            0, count - 1 ) };
+
+    auto const s0 { m_arclength[ idx ] };
+    auto const s1 { m_arclength[ idx + 1 ] };
+    auto const t0 { double( idx ) / count };
+    auto const t1 { double( idx + 1 ) / count };
+    auto const length { s1 - s0 };
+    if( length <= 0.0 ) {
+        return t0;
+    }
+    // cubic hermite interpolation of t(s), with slopes dt/ds limited to keep the result monotone (fritsch-carlson)
+    auto const secant { ( t1 - t0 ) / length };
+    auto slope0 { m_arcspeed[ idx ] > 0.0 ? 1.0 / m_arcspeed[ idx ] : 3.0 * secant };
+    auto slope1 { m_arcspeed[ idx + 1 ] > 0.0 ? 1.0 / m_arcspeed[ idx + 1 ] : 3.0 * secant };
+    auto const alpha { slope0 / secant };
+    auto const beta { slope1 / secant };
+    auto const magnitude { alpha * alpha + beta * beta };
+    if( magnitude > 9.0 ) {
+        auto const scale { 3.0 / std::sqrt( magnitude ) };
+        slope0 = scale * alpha * secant;
+        slope1 = scale * beta * secant;
+    }
+    auto const u { ( s - s0 ) / length };
+    auto const u2 { u * u };
+    auto const u3 { u2 * u };
+    return
+        ( 2.0 * u3 - 3.0 * u2 + 1.0 ) * t0
+        + ( u3 - 2.0 * u2 + u ) * length * slope0
+        + ( -2.0 * u3 + 3.0 * u2 ) * t1
+        + ( u3 - u2 ) * length * slope1;
+}
+
 Math3D::vector3 TSegment::RaInterpolate(double const t) const
 { // wyliczenie XYZ na krzywej Beziera z użyciem współczynników
     return t * (t * (t * vA + vB) + vC) + Point1; // 9 mnożeń, 9 dodawań
@@ -41,6 +41,8 @@ class TSegment
         fRoll2 { 0.f }; // przechyłka na końcach
     double fLength { -1.0 }; // długość policzona
     std::vector<double> fTsBuffer; // wartości parametru krzywej dla równych odcinków
+    std::vector<double> m_arclength; // arc length of the curve at uniformly spaced values of curve parameter
+    std::vector<double> m_arcspeed; // length of the curve tangent at the same points, used as slopes for interpolation
     double fStep = 0.0;
     int iSegCount = 0; // ilość odcinków do rysowania krzywej
     double fDirection = 0.0; // Ra: kąt prostego w planie; dla łuku kąt od Point1
@@ -48,12 +50,9 @@ class TSegment
     Math3D::vector3 vA, vB, vC; // współczynniki wielomianów trzeciego stopnia vD==Point1
     TTrack *pOwner = nullptr; // wskaźnik na właściciela
 
-    Math3D::vector3
-        GetFirstDerivative(double const fTime) const;
-    double
-        RombergIntegral(double const fA, double const fB) const;
-    double
-        GetTFromS(double const s) const;
+    // builds arc length table used to convert distance to curve parameter, refining it until it meets the error bound
+    void
+        build_arclength_table();
     Math3D::vector3
         RaInterpolate(double const t) const;
     Math3D::vector3
@@ -69,6 +68,21 @@ public:
         Init( Math3D::vector3 &NewPoint1, Math3D::vector3 NewCPointOut, Math3D::vector3 NewCPointIn, Math3D::vector3 &NewPoint2, double fNewStep, double fNewRoll1 = 0, double fNewRoll2 = 0, bool bIsCurve = true);
     double
         ComputeLength() const; // McZapkie-150503
+    // length of the curve between specified values of curve parameter, through romberg integration
+    double
+        RombergIntegral(double const fA, double const fB) const;
+    // converts distance from the start of the segment to value of curve parameter
+    double
+        GetTFromS(double const s) const;
+    // finds value of curve parameter for specified distance from the start, through newton's method
+    double
+        SolveTFromS(double const s) const;
+    // converts distance from the start to curve parameter, using the arc length table. valid only for curves, straight segments have no table
+    double
+        interpolate_arclength(double const s) const;
+    // tangent of the curve at specified value of curve parameter
+    Math3D::vector3
+        GetFirstDerivative(double const fTime) const;
     // finds point on segment closest to specified point in 3d space. returns: point on segment as value in range 0-1
     double
         find_nearest_point( glm::dvec3 const &Point ) const;
@@ -35,11 +35,27 @@ texture_manager::texture_manager() {
     m_textures.emplace_back( new opengl_texture(), std::chrono::steady_clock::time_point() );
 }
 
+texture_manager::~texture_manager() {
+    // finish pending work before the textures are gone
+    m_loaders.resize( 0 );
+    delete_textures();
+    if( m_stub != 0 ) {
+        ::glDeleteTextures( 1, &m_stub );
+    }
+}
+
 // loads texture data from specified file
-// TODO: wrap it in a workitem class, for the job system deferred loading
 void
 opengl_texture::load() {
 
+    load_data();
+    load_finish();
+}
+
+// loads texture data from specified file. safe to call from a worker thread
+void
+opengl_texture::load_data() {
+
     if( type == "make:" ) {
         // for generated texture we delay data creation until texture is bound
         // this ensures the script will receive all simulation data it might potentially want
@@ -58,28 +74,108 @@ opengl_texture::load() {
         else if( type == ".png" ) { load_PNG(); }
         else if( type == ".bmp" ) { load_BMP(); }
         else if( type == ".tex" ) { load_TEX(); }
-        else { goto fail; }
+        else { data_state = resource_state::failed; }
     }
 
+    if( data_state != resource_state::good ) {
+        data_state = resource_state::failed;
+        ErrorLog( "Bad texture: failed to load texture \"" + name + type + "\"" );
+    }
+}
+
+// updates texture properties based on loaded texture data
+void
+opengl_texture::load_finish() {
+
+    auto const wasasync { is_async };
+    is_async = false;
+
     // data state will be set by called loader, so we're all done here
     if( data_state == resource_state::good ) {
 
-        has_alpha = (
-            data_components == GL_RGBA ?
-                true :
-                false );
+        if( false == wasasync ) {
+            // materials of textures loaded by worker threads were already set up with the alpha flag retrieved from the file header
+            // so it stays as it was, to keep the texture and its materials in agreement
+            has_alpha = (
+                data_components == GL_RGBA ?
+                    true :
+                    false );
+        }
+        image_width = data_width;
+        image_height = data_height;
 
         size = data.size() / 1024;
 
         return;
     }
-
-fail:
-    data_state = resource_state::failed;
-    ErrorLog( "Bad texture: failed to load texture \"" + name + type + "\"" );
     // NOTE: temporary workaround for texture assignment errors
     id = 0;
-    return;
+}
+
+// retrieves basic properties of the texture from the header of the source file, without loading texture data
+// NOTE: the alpha channel flag is used by materials during their creation, so it has to be known before the data arrives
+// NOTE: retrieved values are stored in members not touched by the worker thread loading the texture data
+void
+opengl_texture::probe() {
+
+    if( type == "make:" ) {
+        has_alpha = false;
+        image_width = image_height = 2;
+        return;
+    }
+
+    std::ifstream file( name + type, std::ios::binary ); file.unsetf( std::ios::skipws );
+
+    if( type == ".dds" ) {
+
+        char filecode[ 5 ] {};
+        file.read( filecode, 4 );
+        if( filecode != std::string( "DDS " ) ) { return; }
+        auto const ddsd { deserialize_ddsd( file ) };
+        image_width = ddsd.dwWidth;
+        image_height = ddsd.dwHeight;
+        has_alpha = ( ddsd.ddpfPixelFormat.dwFourCC != FOURCC_DXT1 );
+    }
+    else if( type == ".tga" ) {
+
+        unsigned char tgaheader[ 18 ] {};
+        file.read( (char *)tgaheader, sizeof( unsigned char ) * 18 );
+        image_width = tgaheader[ 13 ] * 256 + tgaheader[ 12 ];
+        image_height = tgaheader[ 15 ] * 256 + tgaheader[ 14 ];
+        has_alpha = ( tgaheader[ 16 ] / 8 == 4 );
+    }
+    else if( type == ".png" ) {
+
+        file.close();
+        png_image png;
+        memset( &png, 0, sizeof( png_image ) );
+        png.version = PNG_IMAGE_VERSION;
+        png_image_begin_read_from_file( &png, ( name + type ).c_str() );
+        if( false == png.warning_or_error ) {
+            image_width = png.width;
+            image_height = png.height;
+            has_alpha = ( ( png.format & PNG_FORMAT_FLAG_ALPHA ) != 0 );
+        }
+        png_image_free( &png );
+    }
+    else if( type == ".bmp" ) {
+
+        BITMAPFILEHEADER header;
+        BITMAPINFOHEADER info {};
+        file.read( (char *)&header, sizeof( BITMAPFILEHEADER ) );
+        file.read( (char *)&info, sizeof( BITMAPINFOHEADER ) );
+        image_width = info.biWidth;
+        image_height = info.biHeight;
+        has_alpha = ( info.biBitCount == 32 );
+    }
+    else if( type == ".tex" ) {
+
+        char head[ 5 ] {};
+        file.read( head, 4 );
+        file.read( (char *)&image_width, sizeof( int ) );
+        file.read( (char *)&image_height, sizeof( int ) );
+        has_alpha = ( std::string( "RGBA" ) == head );
+    }
 }
 
 void opengl_texture::load_PNG()
@@ -622,6 +718,14 @@ opengl_texture::bind() {
 bool
 opengl_texture::create() {
 
+    if( true == is_async ) {
+        if( false == is_loaded.load( std::memory_order_acquire ) ) {
+            // worker thread didn't finish with the texture yet
+            return false;
+        }
+        load_finish();
+    }
+
     if( data_state != resource_state::good ) {
         // don't bother until we have useful texture data
         return false;
@@ -934,7 +1038,23 @@ texture_manager::create( std::string Filename, bool const Loadnow ) {
 
     if( true == Loadnow ) {
 
-        texture_manager::texture( textureindex ).load();
+        if( m_loaders.size() != static_cast<std::size_t>( Global.TextureLoaderThreads ) ) {
+            m_loaders.resize( Global.TextureLoaderThreads );
+        }
+        if( ( m_loaders.size() > 0 )
+         && ( false == isgenerated ) ) {
+            // decode texture data in the background. the main thread picks it up once it's done
+            texture->probe();
+            texture->is_async = true;
+            texture->is_loaded = false;
+            m_loaders.push(
+                [ texture ]() {
+                    texture->load_data();
+                    texture->is_loaded.store( true, std::memory_order_release ); } );
+        }
+        else {
+            texture_manager::texture( textureindex ).load();
+        }
 #ifndef EU07_DEFERRED_TEXTURE_UPLOAD
         texture_manager::texture( textureindex ).create();
         // texture creation binds a different texture, force a re-bind on next use
@@ -966,8 +1086,25 @@ texture_manager::bind( std::size_t const Unit, texture_handle const Texture ) {
         ::glBindTexture( GL_TEXTURE_2D, texture(Texture).id );
         m_units[ Unit ].texture = Texture;
 #else
-        if( true == texture( Texture ).bind() ) {
+        auto &boundtexture { texture( Texture ) };
+        auto const isupload { false == boundtexture.is_ready };
+        if( ( true == isupload )
+         && ( Global.TextureUploadBudget > 0 )
+         && ( m_uploadbudget <= 0 ) ) {
+            // upload limit for this frame is reached, use the placeholder until the next one
+            bind_stub();
+            m_units[ Unit ].texture = 0;
+        }
+        else if( true == boundtexture.bind() ) {
             m_units[ Unit ].texture = Texture;
+            if( true == isupload ) {
+                m_uploadbudget -= std::max<std::ptrdiff_t>( boundtexture.size, 1 );
+            }
+        }
+        else if( false == boundtexture.is_loaded.load( std::memory_order_acquire ) ) {
+            // texture data is still being decoded
+            bind_stub();
+            m_units[ Unit ].texture = 0;
         }
         else {
             // TODO: bind a special 'error' texture on failure
@@ -1007,6 +1144,32 @@ texture_manager::update() {
     }
 }
 
+// starts a new frame, renewing texture upload budget
+void
+texture_manager::begin_frame() {
+
+    m_uploadbudget = Global.TextureUploadBudget;
+}
+
+// binds placeholder texture to the active texture unit
+void
+texture_manager::bind_stub() {
+
+    if( m_stub == 0 ) {
+        // tiny 2x2 grey texture, same as the stub used for generated textures
+        std::array<unsigned char, 2 * 2 * 3> const data { 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0 };
+        ::glGenTextures( 1, &m_stub );
+        ::glBindTexture( GL_TEXTURE_2D, m_stub );
+        ::glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+        ::glTexImage2D( GL_TEXTURE_2D, 0, GL_RGB, 2, 2, 0, GL_RGB, GL_UNSIGNED_BYTE, data.data() );
+        ::glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+        ::glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+        ::glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+        return;
+    }
+    ::glBindTexture( GL_TEXTURE_2D, m_stub );
+}
+
 // debug performance string
 std::string
 texture_manager::info() const {
@@ -1018,10 +1181,14 @@ texture_manager::info() const {
     std::size_t readytexturecount{ 0 };
     std::size_t readytexturesize{ 0 };
 #endif
+    std::size_t pendingtexturecount{ 0 };
 
     for( auto const& texture : m_textures ) {
 
         totaltexturesize += texture.first->size;
+        if( false == texture.first->is_loaded.load( std::memory_order_relaxed ) ) {
+            ++pendingtexturecount;
+        }
 #ifdef EU07_DEFERRED_TEXTURE_UPLOAD
 
         if( texture.first->is_ready ) {
@@ -1043,7 +1210,10 @@ texture_manager::info() const {
         + std::to_string( totaltexturecount )
         + " ("
         + to_string( totaltexturesize / 1024.0f, 2 ) + " mb)"
-        + " total";
+        + " total"
+        + ( pendingtexturecount > 0 ?
+            ", " + std::to_string( pendingtexturecount ) + " loading" :
+            "" );
 }
 
 // checks whether specified texture is in the texture bank. returns texture id, or npos.
@@ -13,6 +13,7 @@ http://mozilla.org/MPL/2.0/.
 #include "winheaders.h"
 #include <string>
 #include "ResourceManager.h"
+#include "utilities.h"
 
 struct opengl_texture {
 	static DDSURFACEDESC2 deserialize_ddsd(std::istream&);
@@ -23,8 +24,15 @@ struct opengl_texture {
 // constructors
     opengl_texture() = default;
 // methods
+    // loads texture data from specified file
     void
         load();
+    // retrieves basic properties of the texture from the header of the source file, without loading texture data
+    void
+        probe();
+    // loads texture data from specified file. safe to call from a worker thread
+    void
+        load_data();
     bool
         bind();
     bool
@@ -35,24 +43,28 @@ struct opengl_texture {
     inline
     int
         width() const {
-            return data_width; }
+            return image_width; }
     inline
     int
         height() const {
-            return data_height; }
+            return image_height; }
 // members
     GLuint id{ (GLuint)-1 }; // associated GL resource
-    bool has_alpha{ false }; // indicates the texture has alpha channel
+    bool has_alpha{ false }; // indicates the texture has alpha channel. for textures loaded by a worker thread, set from the file header only
     bool is_ready{ false }; // indicates the texture was processed and is ready for use
     std::string traits; // requested texture attributes: wrapping modes etc
     std::string name; // name of the texture source file
     std::string type; // type of the texture source file
     std::size_t size{ 0 }; // size of the texture data, in kb
+    std::atomic<bool> is_loaded{ true }; // indicates the texture data was loaded and can be processed
+    bool is_async{ false }; // texture data is loaded by a worker thread and waits for processing on the main thread
 
 private:
 // methods
     void make_stub();
     void make_request();
+    // updates texture properties based on loaded texture data
+    void load_finish();
     void load_BMP();
 	void load_PNG();
     void load_DDS();
@@ -63,6 +75,7 @@ private:
     void flip_vertical();
 
 // members
+    // NOTE: while the texture is loaded by a worker thread, data_* members belong to the worker and can't be accessed until is_loaded is set
     std::vector<char> data; // texture data (stored GL-style, bottom-left origin)
     resource_state data_state{ resource_state::none }; // current state of texture data
     int data_width{ 0 },
@@ -70,10 +83,8 @@ private:
         data_mapcount{ 0 };
     GLint data_format{ 0 },
         data_components{ 0 };
-/*
-    std::atomic<bool> is_loaded{ false }; // indicates the texture data was loaded and can be processed
-    std::atomic<bool> is_good{ false }; // indicates the texture data was retrieved without errors
-*/
+    int image_width{ 0 }, // texture dimensions reported to the outside, updated only on the main thread
+        image_height{ 0 };
 };
 
 typedef int texture_handle;
@@ -82,7 +93,7 @@ class texture_manager {
 
 public:
     texture_manager();
-    ~texture_manager() { delete_textures(); }
+    ~texture_manager();
 
     void
         assign_units( GLint const Helper, GLint const Shadows, GLint const Normals, GLint const Diffuse );
@@ -101,6 +112,9 @@ public:
     // performs a resource sweep
     void
         update();
+    // starts a new frame, renewing texture upload budget
+    void
+        begin_frame();
     // debug performance string
     std::string
         info() const;
@@ -129,6 +143,9 @@ private:
         find_on_disk( std::string const &Texturename ) const;
     void
         delete_textures();
+    // binds placeholder texture to the active texture unit
+    void
+        bind_stub();
 
 // members:
     texture_handle const npos { 0 }; // should be -1, but the rest of the code uses -1 for something else
@@ -137,6 +154,9 @@ private:
     garbage_collector<texturetimepointpair_sequence> m_garbagecollector { m_textures, 600, 60, "texture" };
     std::array<texture_unit, 4> m_units;
     GLint m_activeunit { 0 };
+    threading::task_pool m_loaders; // worker threads decoding texture files
+    std::ptrdiff_t m_uploadbudget { 0 }; // amount of texture data which can be yet uploaded in current frame, in kb
+    GLuint m_stub { 0 }; // placeholder texture, bound in place of textures still being loaded
 };
 
 // reduces provided data image to half of original size, using basic 2x2 average
@@ -65,6 +65,18 @@ void ResetTimers()
 uint64_t fr, count, oldCount;
 
 void UpdateTimers(bool pause)
+{
+    DeltaTime = UpdateRenderTimers(pause);
+    if (!pause)
+    {
+        fSoundTimer += DeltaTime;
+        if (fSoundTimer > 0.1)
+            fSoundTimer = 0.0;
+    }
+    fSimulationTime += DeltaTime;
+};
+
+double UpdateRenderTimers(bool pause)
 {
 #ifdef _WIN32
     QueryPerformanceFrequency((LARGE_INTEGER *)&fr);
@@ -76,18 +88,10 @@ void UpdateTimers(bool pause)
 	fr = 1000000000;
 #endif
     DeltaRenderTime = double(count - oldCount) / double(fr);
-    if (!pause)
-    {
-        DeltaTime = Global.fTimeSpeed * DeltaRenderTime;
-        fSoundTimer += DeltaTime;
-        if (fSoundTimer > 0.1)
-            fSoundTimer = 0.0;
-
-        if (DeltaTime > 1.0)
-            DeltaTime = 1.0;
-    }
-    else
-        DeltaTime = 0.0; // wszystko stoi, bo czas nie płynie
+    auto const deltatime = (
+        pause ?
+            0.0 : // wszystko stoi, bo czas nie płynie
+            std::min( DeltaRenderTime, 1.0 ) * Global.fTimeSpeed ); // long stalls are cut short before acceleration
 
     oldCount = count;
     // Keep track of the time lapse and frame count
@@ -106,6 +110,16 @@ void UpdateTimers(bool pause)
         fLastTime = fTime;
         dwFrames = 0L;
     }
+    return deltatime;
+};
+
+void StepTimers(double const Deltatime)
+{ // krok czasu niezależny od zegara systemowego
+    // NOTE: render time is left intact, as the fixed steps can be taken in between frames
+    DeltaTime = Deltatime;
+    fSoundTimer += DeltaTime;
+    if (fSoundTimer > 0.1)
+        fSoundTimer = 0.0;
     fSimulationTime += DeltaTime;
 };
 
@@ -26,6 +26,13 @@ void ResetTimers();
 
 void UpdateTimers(bool pause);
 
+// measures real time elapsed since the previous update, leaving simulation timers to be advanced by StepTimers()
+// returns: simulation time corresponding to the elapsed real time
+double UpdateRenderTimers(bool pause);
+
+// advances simulation timers by specified fixed step, for runs which aren't tied to real time
+void StepTimers(double const Deltatime);
+
 class stopwatch {
 
 public:
@@ -26,17 +26,20 @@ http://mozilla.org/MPL/2.0/.
 #include "Logs.h"
 #include "renderer.h"
 #include "utilities.h"
+#include "sn_utils.h"
 
 // 101206 Ra: trapezoidalne drogi i tory
 // 110720 Ra: rozprucie zwrotnicy i odcinki izolowane
 
 static float const fMaxOffset = 0.1f; // double(0.1f)==0.100000001490116
+
 // const int NextMask[4]={0,1,0,1}; //tor następny dla stanów 0, 1, 2, 3
 // const int PrevMask[4]={0,0,1,1}; //tor poprzedni dla stanów 0, 1, 2, 3
 const int iLewo4[4] = {5, 3, 4, 6}; // segmenty (1..6) do skręcania w lewo
 const int iPrawo4[4] = {-4, -6, -3, -5}; // segmenty (1..6) do skręcania w prawo
 const int iProsto4[4] = {1, -1, 2, -2}; // segmenty (1..6) do jazdy prosto
 const int iEnds4[13] = {3, 0, 2, 1, 2, 0, -1, 1, 3, 2, 0, 3, 1}; // numer sąsiedniego toru na końcu segmentu "-1"
+
 const int iLewo3[4] = {1, 3, 2, 1}; // segmenty do skręcania w lewo
 const int iPrawo3[4] = {-2, -1, -3, -2}; // segmenty do skręcania w prawo
 const int iProsto3[4] = {1, -1, 2, 1}; // segmenty do jazdy prosto
@@ -45,6 +48,7 @@ TIsolated *TIsolated::pRoot = NULL;
 
 TTrack::profiles_array TTrack::m_profiles;
 TTrack::profiles_map TTrack::m_profilesmap;
+std::uint32_t TTrack::m_traceepoch { 1 };
 
 TSwitchExtension::TSwitchExtension(TTrack *owner, int const what)
 { // na początku wszystko puste
@@ -372,8 +376,7 @@ void TTrack::ConnectNextNext(TTrack *pTrack, int typ)
 
 void TTrack::Load(cParser *parser, glm::dvec3 const &pOrigin)
 { // pobranie obiektu trajektorii ruchu
-    Math3D::vector3 pt, vec, p1, p2, cp1, cp2, p3, p4, cp3, cp4; // dodatkowe punkty potrzebne do skrzyżowań
-	double a1, a2, r1, r2, r3, r4;
+	double a1, a2;
     std::string str;
     size_t i; //,state; //Ra: teraz już nie ma początkowego stanu zwrotnicy we wpisie
     std::string token;
@@ -465,6 +468,7 @@ void TTrack::Load(cParser *parser, glm::dvec3 const &pOrigin)
     {
         parser->getTokens();
         *parser >> str; // railtex
+        m_materialnames[ 0 ] = str;
         m_material1 = (
             str == "none" ?
                 null_handle :
@@ -475,6 +479,7 @@ void TTrack::Load(cParser *parser, glm::dvec3 const &pOrigin)
             fTexLength = 4; // Ra: zabezpiecznie przed zawieszeniem
         parser->getTokens();
         *parser >> str; // sub || railtex
+        m_materialnames[ 1 ] = str;
         m_material2 = (
             str == "none" ?
                 null_handle :
@@ -491,7 +496,6 @@ void TTrack::Load(cParser *parser, glm::dvec3 const &pOrigin)
     else if (Global.iWriteLogEnabled & 4)
         WriteLog("unvis");
     Init(); // ustawia SwitchExtension
-    double segsize = 5.0; // długość odcinka segmentowania
 
     // path data
     // all subtypes contain at least one path
@@ -511,6 +515,153 @@ void TTrack::Load(cParser *parser, glm::dvec3 const &pOrigin)
         }
     }
 
+    init_segments();
+
+    // optional attributes
+    parser->getTokens();
+    *parser >> token;
+    str = token;
+    while (str != "endtrack")
+    {
+        if (str == "event0")
+        {
+            parser->getTokens();
+            *parser >> token;
+            m_events0.emplace_back( token, nullptr );
+        }
+        else if (str == "event1")
+        {
+            parser->getTokens();
+            *parser >> token;
+            m_events1.emplace_back( token, nullptr );
+        }
+        else if (str == "event2")
+        {
+            parser->getTokens();
+            *parser >> token;
+            m_events2.emplace_back( token, nullptr );
+        }
+        else if (str == "eventall0")
+        {
+            parser->getTokens();
+            *parser >> token;
+            m_events0all.emplace_back( token, nullptr );
+        }
+        else if (str == "eventall1")
+        {
+            parser->getTokens();
+            *parser >> token;
+            m_events1all.emplace_back( token, nullptr );
+        }
+        else if (str == "eventall2")
+        {
+            parser->getTokens();
+            *parser >> token;
+            m_events2all.emplace_back( token, nullptr );
+        }
+        else if (str == "velocity")
+        {
+            parser->getTokens();
+            *parser >> fVelocity; //*0.28; McZapkie-010602
+            if (SwitchExtension) // jeśli tor ruchomy
+                if (std::abs(fVelocity) >= 1.0) //żeby zero nie ograniczało dożywotnio
+                    // zapamiętanie głównego ograniczenia; a np. -40 ogranicza tylko na bok
+                    SwitchExtension->fVelocity = static_cast<float>(fVelocity);
+        }
+        else if (str == "isolated")
+        { // obwód izolowany, do którego tor należy
+            parser->getTokens();
+            *parser >> token;
+            pIsolated = TIsolated::Find(token);
+        }
+        else if (str == "angle1")
+        { // kąt ścięcia końca od strony 1
+            // NOTE: not used/implemented
+            parser->getTokens();
+            *parser >> a1;
+            //Segment->AngleSet(0, a1);
+        }
+        else if (str == "angle2")
+        { // kąt ścięcia końca od strony 2
+          // NOTE: not used/implemented
+            parser->getTokens();
+            *parser >> a2;
+            //Segment->AngleSet(1, a2);
+        }
+        else if (str == "fouling1")
+        { // wskazanie modelu ukresu w kierunku 1
+          // NOTE: not used/implemented
+            parser->getTokens();
+            *parser >> token;
+            // nFouling[0]=
+        }
+        else if (str == "fouling2")
+        { // wskazanie modelu ukresu w kierunku 2
+          // NOTE: not used/implemented
+            parser->getTokens();
+            *parser >> token;
+            // nFouling[1]=
+        }
+        else if (str == "overhead")
+        { // informacja o stanie sieci: 0-jazda bezprądowa, >0-z opuszczonym i ograniczeniem prędkości
+            parser->getTokens();
+            *parser >> fOverhead;
+            if (fOverhead > 0.0)
+                iAction |= 0x40; // flaga opuszczenia pantografu (tor uwzględniany w skanowaniu jako
+            // ograniczenie dla pantografujących)
+        }
+        else if( str == "vradius" ) {
+            // y-axis track radius
+            // NOTE: not used/implemented
+            parser->getTokens();
+            *parser >> fVerticalRadius;
+        }
+        else if( str == "trackbed" ) {
+            // switch trackbed texture
+            auto const trackbedtexture { parser->getToken<std::string>() };
+            if( eType == tt_Switch ) {
+                m_materialnames[ 2 ] = trackbedtexture;
+                SwitchExtension->m_material3 = GfxRenderer.Fetch_Material( trackbedtexture );
+            }
+        }
+        else if( str == "railprofile" ) {
+            // rail profile
+            auto const railprofile { parser->getToken<std::string>() };
+            if( iCategoryFlag == 1 ) {
+                m_profile1 = fetch_track_rail_profile( railprofile );
+            }
+        }
+        else
+            ErrorLog("Bad track: unknown property: \"" + str + "\" defined for track \"" + m_name + "\"");
+        parser->getTokens();
+        *parser >> token;
+		str = token;
+    }
+    // alternatywny zapis nazwy odcinka izolowanego - po znaku "@" w nazwie toru
+    if (!pIsolated)
+        if ((i = m_name.find("@")) != std::string::npos)
+            if (i < m_name.length()) // nie może być puste
+            {
+                pIsolated = TIsolated::Find(m_name.substr(i + 1, m_name.length()));
+                m_name = m_name.substr(0, i - 1); // usunięcie z nazwy
+            }
+
+    // calculate path location
+    location( (
+        CurrentSegment()->FastGetPoint_0()
+        + CurrentSegment()->FastGetPoint( 0.5 )
+        + CurrentSegment()->FastGetPoint_1() )
+        / 3.0 );
+}
+
+// generates segments of the track from stored path data
+void
+TTrack::init_segments() {
+
+    Math3D::vector3 p1, p2, cp1, cp2, p3, p4, cp3, cp4; // dodatkowe punkty potrzebne do skrzyżowań
+    double r1, r2, r3, r4;
+    double segsize = 5.0; // długość odcinka segmentowania
+
     switch (eType) {
         // Ra: łuki segmentowane co 5m albo 314-kątem foremnym
     case tt_Table: {
@@ -786,140 +937,6 @@ void TTrack::Load(cParser *parser, glm::dvec3 const &pOrigin)
         }
     }
 
-    // optional attributes
-    parser->getTokens();
-    *parser >> token;
-    str = token;
-    while (str != "endtrack")
-    {
-        if (str == "event0")
-        {
-            parser->getTokens();
-            *parser >> token;
-            m_events0.emplace_back( token, nullptr );
-        }
-        else if (str == "event1")
-        {
-            parser->getTokens();
-            *parser >> token;
-            m_events1.emplace_back( token, nullptr );
-        }
-        else if (str == "event2")
-        {
-            parser->getTokens();
-            *parser >> token;
-            m_events2.emplace_back( token, nullptr );
-        }
-        else if (str == "eventall0")
-        {
-            parser->getTokens();
-            *parser >> token;
-            m_events0all.emplace_back( token, nullptr );
-        }
-        else if (str == "eventall1")
-        {
-            parser->getTokens();
-            *parser >> token;
-            m_events1all.emplace_back( token, nullptr );
-        }
-        else if (str == "eventall2")
-        {
-            parser->getTokens();
-            *parser >> token;
-            m_events2all.emplace_back( token, nullptr );
-        }
-        else if (str == "velocity")
-        {
-            parser->getTokens();
-            *parser >> fVelocity; //*0.28; McZapkie-010602
-            if (SwitchExtension) // jeśli tor ruchomy
-                if (std::abs(fVelocity) >= 1.0) //żeby zero nie ograniczało dożywotnio
-                    // zapamiętanie głównego ograniczenia; a np. -40 ogranicza tylko na bok
-                    SwitchExtension->fVelocity = static_cast<float>(fVelocity);
-        }
-        else if (str == "isolated")
-        { // obwód izolowany, do którego tor należy
-            parser->getTokens();
-            *parser >> token;
-            pIsolated = TIsolated::Find(token);
-        }
-        else if (str == "angle1")
-        { // kąt ścięcia końca od strony 1
-            // NOTE: not used/implemented
-            parser->getTokens();
-            *parser >> a1;
-            //Segment->AngleSet(0, a1);
-        }
-        else if (str == "angle2")
-        { // kąt ścięcia końca od strony 2
-          // NOTE: not used/implemented
-            parser->getTokens();
-            *parser >> a2;
-            //Segment->AngleSet(1, a2);
-        }
-        else if (str == "fouling1")
-        { // wskazanie modelu ukresu w kierunku 1
-          // NOTE: not used/implemented
-            parser->getTokens();
-            *parser >> token;
-            // nFouling[0]=
-        }
-        else if (str == "fouling2")
-        { // wskazanie modelu ukresu w kierunku 2
-          // NOTE: not used/implemented
-            parser->getTokens();
-            *parser >> token;
-            // nFouling[1]=
-        }
-        else if (str == "overhead")
-        { // informacja o stanie sieci: 0-jazda bezprądowa, >0-z opuszczonym i ograniczeniem prędkości
-            parser->getTokens();
-            *parser >> fOverhead;
-            if (fOverhead > 0.0)
-                iAction |= 0x40; // flaga opuszczenia pantografu (tor uwzględniany w skanowaniu jako
-            // ograniczenie dla pantografujących)
-        }
-        else if( str == "vradius" ) {
-            // y-axis track radius
-            // NOTE: not used/implemented
-            parser->getTokens();
-            *parser >> fVerticalRadius;
-        }
-        else if( str == "trackbed" ) {
-            // switch trackbed texture
-            auto const trackbedtexture { parser->getToken<std::string>() };
-            if( eType == tt_Switch ) {
-                SwitchExtension->m_material3 = GfxRenderer.Fetch_Material( trackbedtexture );
-            }
-        }
-        else if( str == "railprofile" ) {
-            // rail profile
-            auto const railprofile { parser->getToken<std::string>() };
-            if( iCategoryFlag == 1 ) {
-                m_profile1 = fetch_track_rail_profile( railprofile );
-            }
-        }
-        else
-            ErrorLog("Bad track: unknown property: \"" + str + "\" defined for track \"" + m_name + "\"");
-        parser->getTokens();
-        *parser >> token;
-		str = token;
-    }
-    // alternatywny zapis nazwy odcinka izolowanego - po znaku "@" w nazwie toru
-    if (!pIsolated)
-        if ((i = m_name.find("@")) != std::string::npos)
-            if (i < m_name.length()) // nie może być puste
-            {
-                pIsolated = TIsolated::Find(m_name.substr(i + 1, m_name.length()));
-                m_name = m_name.substr(0, i - 1); // usunięcie z nazwy
-            }
-
-    // calculate path location
-    location( (
-        CurrentSegment()->FastGetPoint_0()
-        + CurrentSegment()->FastGetPoint( 0.5 )
-        + CurrentSegment()->FastGetPoint_1() )
-        / 3.0 );
 }
 
 bool TTrack::AssignEvents() {
@@ -959,6 +976,8 @@ bool TTrack::AssignEvents() {
         }
     }
 
+    trace_modified(); // lista eventów mogła się zmienić
+
     return ( lookupfail == false );
 }
 
@@ -1003,6 +1022,17 @@ std::string TTrack::IsolatedName()
 };
 
 // ABu: przeniesione z Path.h i poprawione!!!
+// orders vehicles by their position on the track. vehicles with the same position are kept in registration order, same as in the Dynamics sequence
+static
+bool
+occupancy_before( TTrack::occupancy_entry const &Left, TTrack::occupancy_entry const &Right ) {
+
+    return (
+        Left.position != Right.position ?
+            Left.position < Right.position :
+            Left.order < Right.order );
+}
+
 bool TTrack::AddDynamicObject(TDynamicObject *Dynamic)
 { // dodanie pojazdu do trajektorii
     // Ra: tymczasowo wysyłanie informacji o zajętości konkretnego toru
@@ -1023,6 +1053,16 @@ bool TTrack::AddDynamicObject(TDynamicObject *Dynamic)
         }
     }
     Dynamics.emplace_back( Dynamic );
+    {
+        // new vehicle is registered last, so it goes after all vehicles with the same position
+        occupancy_entry const entry { Dynamic->RaTranslationGet(), m_occupancyorder++, Dynamic };
+        m_occupancy.insert(
+            std::upper_bound(
+                std::begin( m_occupancy ), std::end( m_occupancy ),
+                entry,
+                occupancy_before ),
+            entry );
+    }
     Dynamic->MyTrack = this; // ABu: na ktorym torze jesteśmy
     if( Dynamic->iOverheadMask ) {
         // jeśli ma pantografy
@@ -1031,6 +1071,74 @@ bool TTrack::AddDynamicObject(TDynamicObject *Dynamic)
     return true;
 };
 
+// updates cached position of specified vehicle, moving it to its new place in the sorted sequence
+void
+TTrack::occupancy_moved( TDynamicObject const *Dynamic ) {
+
+    auto const position { Dynamic->RaTranslationGet() };
+    auto const count { m_occupancy.size() };
+    // vehicles move only a little between updates, so the entry is looked for outwards from the new position
+    auto const start {
+        static_cast<std::size_t>(
+            std::lower_bound(
+                std::begin( m_occupancy ), std::end( m_occupancy ),
+                position,
+                []( occupancy_entry const &Entry, double const Position ) {
+                    return Entry.position < Position; } )
+            - std::begin( m_occupancy ) ) };
+    auto index { count };
+    for( std::size_t offset = 0; ( offset <= start ) || ( start + offset < count ); ++offset ) {
+        if( ( start + offset < count )
+         && ( m_occupancy[ start + offset ].vehicle == Dynamic ) ) {
+            index = start + offset;
+            break;
+        }
+        if( ( offset > 0 )
+         && ( offset <= start )
+         && ( m_occupancy[ start - offset ].vehicle == Dynamic ) ) {
+            index = start - offset;
+            break;
+        }
+    }
+    if( index == count ) {
+        // vehicle isn't registered on this track
+        return;
+    }
+    if( m_occupancy[ index ].position == position ) { return; }
+    m_occupancy[ index ].position = position;
+    // shift the entry to its new place, it's typically at most a step or two away
+    while( ( index > 0 )
+        && ( true == occupancy_before( m_occupancy[ index ], m_occupancy[ index - 1 ] ) ) ) {
+        std::swap( m_occupancy[ index ], m_occupancy[ index - 1 ] );
+        --index;
+    }
+    while( ( index + 1 < count )
+        && ( true == occupancy_before( m_occupancy[ index + 1 ], m_occupancy[ index ] ) ) ) {
+        std::swap( m_occupancy[ index ], m_occupancy[ index + 1 ] );
+        ++index;
+    }
+}
+
+// marks route data cached for the track as outdated
+void
+TTrack::trace_modified() {
+
+    for( auto &trace : m_trace ) {
+        trace.epoch = 0;
+    }
+}
+
+// marks route data cached for all tracks as outdated
+void
+TTrack::trace_invalidate() {
+    // distances to events can be measured through adjacent tracks, so change of any switch affects routes beyond its own paths
+    ++m_traceepoch;
+    if( m_traceepoch == 0 ) {
+        // skip the value reserved for outdated data
+        ++m_traceepoch;
+    }
+}
+
 const int numPts = 4;
 
 bool TTrack::CheckDynamicObject(TDynamicObject *Dynamic)
@@ -1045,6 +1153,14 @@ bool TTrack::CheckDynamicObject(TDynamicObject *Dynamic)
 
 bool TTrack::RemoveDynamicObject(TDynamicObject *Dynamic)
 { // usunięcie pojazdu z listy przypisanych do toru
+    // removal doesn't change order of the remaining vehicles, so the index stays sorted
+    m_occupancy.erase(
+        std::remove_if(
+            std::begin( m_occupancy ), std::end( m_occupancy ),
+            [&]( occupancy_entry const &Entry ) {
+                return Entry.vehicle == Dynamic; } ),
+        std::end( m_occupancy ) );
+
     bool result = false;
     if( *Dynamics.begin() == Dynamic ) {
         // most likely the object getting removed is at the front...
@@ -1563,6 +1679,7 @@ bool TTrack::SetConnections(int i)
 
 bool TTrack::Switch(int i, float const t, float const d)
 { // przełączenie torów z uruchomieniem animacji
+    trace_invalidate(); // zmiana połączeń lub aktywnej drogi unieważnia przeskanowane trasy
     if (SwitchExtension) // tory przełączalne mają doklejkę
         if (eType == tt_Switch)
         { // przekładanie zwrotnicy jak zwykle
@@ -2025,13 +2142,118 @@ TTrack::radius_() {
 void
 TTrack::serialize_( std::ostream &Output ) const {
 
-    // TODO: implement
+    // header
+    sn_utils::ls_int32( Output, eType );
+    sn_utils::ls_int32( Output, iCategoryFlag );
+    sn_utils::ls_float32( Output, fTrackWidth );
+    sn_utils::ls_float32( Output, fTrackWidth2 );
+    sn_utils::ls_float32( Output, fFriction );
+    sn_utils::ls_float32( Output, fSoundDistance );
+    sn_utils::ls_int32( Output, iQualityFlag );
+    sn_utils::ls_int32( Output, iDamageFlag );
+    sn_utils::ls_int32( Output, eEnvironment );
+    // materials
+    for( auto const &materialname : m_materialnames ) {
+        sn_utils::s_str( Output, materialname );
+    }
+    sn_utils::ls_float32( Output, fTexLength );
+    sn_utils::ls_float32( Output, fTexHeight1 );
+    sn_utils::ls_float32( Output, fTexWidth );
+    sn_utils::ls_float32( Output, fTexSlope );
+    // path data
+    sn_utils::ls_uint32( Output, static_cast<std::uint32_t>( m_paths.size() ) );
+    for( auto const &path : m_paths ) {
+        for( auto const &point : path.points ) {
+            sn_utils::s_dvec3( Output, point );
+        }
+        sn_utils::ls_float32( Output, path.rolls[ 0 ] );
+        sn_utils::ls_float32( Output, path.rolls[ 1 ] );
+        sn_utils::ls_float32( Output, path.radius );
+    }
+    // optional attributes
+    for( auto const *events : { &m_events0, &m_events1, &m_events2, &m_events0all, &m_events1all, &m_events2all } ) {
+        sn_utils::ls_uint32( Output, static_cast<std::uint32_t>( events->size() ) );
+        for( auto const &event : *events ) {
+            sn_utils::s_str( Output, event.first );
+        }
+    }
+    sn_utils::ls_float64( Output, fVelocity );
+    sn_utils::s_str( Output, ( pIsolated ? pIsolated->asName : "" ) );
+    sn_utils::ls_float32( Output, fOverhead );
+    sn_utils::ls_float32( Output, fVerticalRadius );
+    sn_utils::s_str( Output, m_profile1.first );
+    sn_utils::ls_int32( Output, iAction );
 }
 // deserialize() subclass details, restores content of the subclass from provided stream
 void
 TTrack::deserialize_( std::istream &Input ) {
 
-    // TODO: implement
+    // header
+    eType = static_cast<TTrackType>( sn_utils::ld_int32( Input ) );
+    iCategoryFlag = sn_utils::ld_int32( Input );
+    fTrackWidth = sn_utils::ld_float32( Input );
+    fTrackWidth2 = sn_utils::ld_float32( Input );
+    fFriction = sn_utils::ld_float32( Input );
+    fSoundDistance = sn_utils::ld_float32( Input );
+    iQualityFlag = sn_utils::ld_int32( Input );
+    iDamageFlag = sn_utils::ld_int32( Input );
+    eEnvironment = static_cast<TEnvironmentType>( sn_utils::ld_int32( Input ) );
+    Init(); // ustawia SwitchExtension
+    // materials
+    for( auto &materialname : m_materialnames ) {
+        materialname = sn_utils::d_str( Input );
+    }
+    m_material1 = (
+        ( m_materialnames[ 0 ].empty() || m_materialnames[ 0 ] == "none" ) ?
+            null_handle :
+            GfxRenderer.Fetch_Material( m_materialnames[ 0 ] ) );
+    m_material2 = (
+        ( m_materialnames[ 1 ].empty() || m_materialnames[ 1 ] == "none" ) ?
+            null_handle :
+            GfxRenderer.Fetch_Material( m_materialnames[ 1 ] ) );
+    if( ( eType == tt_Switch )
+     && ( false == m_materialnames[ 2 ].empty() ) ) {
+        SwitchExtension->m_material3 = GfxRenderer.Fetch_Material( m_materialnames[ 2 ] );
+    }
+    fTexLength = sn_utils::ld_float32( Input );
+    fTexHeight1 = sn_utils::ld_float32( Input );
+    fTexWidth = sn_utils::ld_float32( Input );
+    fTexSlope = sn_utils::ld_float32( Input );
+    // path data
+    m_paths.resize( sn_utils::ld_uint32( Input ) );
+    for( auto &path : m_paths ) {
+        for( auto &point : path.points ) {
+            point = sn_utils::d_dvec3( Input );
+        }
+        path.rolls[ 0 ] = sn_utils::ld_float32( Input );
+        path.rolls[ 1 ] = sn_utils::ld_float32( Input );
+        path.radius = sn_utils::ld_float32( Input );
+    }
+    init_segments();
+    // optional attributes
+    for( auto *events : { &m_events0, &m_events1, &m_events2, &m_events0all, &m_events1all, &m_events2all } ) {
+        events->resize( sn_utils::ld_uint32( Input ) );
+        for( auto &event : *events ) {
+            event = { sn_utils::d_str( Input ), nullptr };
+        }
+    }
+    fVelocity = sn_utils::ld_float64( Input );
+    if( ( SwitchExtension )
+     && ( std::abs( fVelocity ) >= 1.0 ) ) {
+        SwitchExtension->fVelocity = static_cast<float>( fVelocity );
+    }
+    auto const isolatedname { sn_utils::d_str( Input ) };
+    if( false == isolatedname.empty() ) {
+        pIsolated = TIsolated::Find( isolatedname );
+    }
+    fOverhead = sn_utils::ld_float32( Input );
+    fVerticalRadius = sn_utils::ld_float32( Input );
+    auto const railprofile { sn_utils::d_str( Input ) };
+    if( ( false == railprofile.empty() )
+     && ( iCategoryFlag == 1 ) ) {
+        m_profile1 = fetch_track_rail_profile( railprofile );
+    }
+    iAction |= sn_utils::ld_int32( Input );
 }
 
 // export() subclass details, sends basic content of the class in legacy (text) format to provided stream
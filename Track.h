@@ -169,9 +169,9 @@ private:
     float fTexSlope = 0.9f;
 
     glm::dvec3 m_origin;
-    // TODO: store material names as strings, for lossless serialization and export
     material_handle m_material1 = 0; // tekstura szyn albo nawierzchni
     material_handle m_material2 = 0; // tekstura automatycznej podsypki albo pobocza
+    std::array<std::string, 3> m_materialnames; // source names of materials 1, 2 and switch trackbed, for lossless serialization
     std::pair<std::string, int> m_profile1 {}; // profile of geometry chunks textured with texture 1
     using geometryhandle_sequence = std::vector<gfx::geometry_handle>;
     geometryhandle_sequence Geometry1; // geometry chunks textured with texture 1
@@ -180,8 +180,20 @@ private:
     std::vector<segment_data> m_paths; // source data for owned paths
 
 public:
+    // vehicle registered on the track, with its position along the track
+    struct occupancy_entry {
+        double position; // translation of the vehicle's active axle relative to Point1, cached
+        std::size_t order; // registration order, resolves ties the same way as the order of Dynamics
+        TDynamicObject *vehicle;
+    };
     using dynamics_sequence = std::deque<TDynamicObject *>;
+    using occupancy_sequence = std::vector<occupancy_entry>;
     using event_sequence = std::vector<std::pair<std::string, basic_event *> >;
+    // route data gathered by AI scan for one direction of travel, shared by all drivers
+    struct trace_data {
+        std::vector<std::pair<basic_event *, double>> events; // passive events with distance from the point of entry
+        std::uint32_t epoch { 0 }; // state of the route at the time of the scan, 0 if outdated
+    };
 
     dynamics_sequence Dynamics;
     event_sequence
@@ -264,6 +276,36 @@ public:
     bool CheckDynamicObject(TDynamicObject *Dynamic);
     bool AddDynamicObject(TDynamicObject *Dynamic);
     bool RemoveDynamicObject(TDynamicObject *Dynamic);
+    // provides vehicles on the track sorted by their position, from Point1 to Point2
+    inline
+    occupancy_sequence const &
+        occupancy() const {
+            return m_occupancy; }
+    // updates cached position of specified vehicle, moving it to its new place in the sorted sequence
+    void
+        occupancy_moved( TDynamicObject const *Dynamic );
+    // provides route data cached for specified direction of travel
+    inline
+    trace_data &
+        trace( double const Direction ) {
+            return m_trace[ Direction > 0 ? 1 : 0 ]; }
+    // returns true if provided route data reflects current state of the route
+    static
+    bool
+        trace_valid( trace_data const &Trace ) {
+            return Trace.epoch == m_traceepoch; }
+    // marks provided route data as matching current state of the route
+    static
+    void
+        trace_validate( trace_data &Trace ) {
+            Trace.epoch = m_traceepoch; }
+    // marks route data cached for the track as outdated
+    void
+        trace_modified();
+    // marks route data cached for all tracks as outdated
+    static
+    void
+        trace_invalidate();
 
     // set origin point
     void
@@ -319,6 +361,8 @@ private:
     static gfx::vertex_array const & track_rail_profile( int const Profile );
     // returns texture length for specified material
     float texture_length( material_handle const Material );
+    // generates segments of the track from stored path data
+    void init_segments();
     // creates profile for a part of current path
     void create_switch_trackbed( gfx::vertex_array &Output );
     void create_track_rail_profile( gfx::vertex_array &Right, gfx::vertex_array &Left );
@@ -329,6 +373,10 @@ private:
 // members
     static profiles_array m_profiles; // shared database of path element profiles
     static profiles_map m_profilesmap;
+    occupancy_sequence m_occupancy; // vehicles on the track sorted by position, for neighbour queries
+    std::size_t m_occupancyorder { 0 }; // registration counter for vehicles added to the track
+    std::array<trace_data, 2> m_trace; // route data for travel towards Point1 and Point2
+    static std::uint32_t m_traceepoch; // current state of switches and events, shared by all tracks
 };
 
 
@@ -21,6 +21,7 @@ http://mozilla.org/MPL/2.0/.
 #include "Logs.h"
 #include "renderer.h"
 #include "utilities.h"
+#include "sn_utils.h"
 
 //---------------------------------------------------------------------------
 /*
@@ -680,13 +681,53 @@ TTraction::radius_() {
 void
 TTraction::serialize_( std::ostream &Output ) const {
 
-    // TODO: implement
+    // basic attributes
+    sn_utils::s_str( Output, asPowerSupplyName );
+    sn_utils::ls_float32( Output, NominalVoltage );
+    sn_utils::ls_float32( Output, MaxCurrent );
+    sn_utils::ls_float32( Output, fResistivity );
+    sn_utils::ls_uint32( Output, Material );
+    sn_utils::ls_float32( Output, WireThickness );
+    sn_utils::ls_uint32( Output, DamageFlag );
+    // path data
+    sn_utils::s_dvec3( Output, pPoint1 );
+    sn_utils::s_dvec3( Output, pPoint2 );
+    sn_utils::s_dvec3( Output, pPoint3 );
+    sn_utils::s_dvec3( Output, pPoint4 );
+    sn_utils::ls_float64( Output, fHeightDifference );
+    sn_utils::ls_int32( Output, iNumSections );
+    // wire data
+    sn_utils::ls_int32( Output, Wires );
+    sn_utils::ls_float32( Output, WireOffset );
+    // optional attributes
+    sn_utils::s_str( Output, asParallel );
 }
 // deserialize() subclass details, restores content of the subclass from provided stream
 void
 TTraction::deserialize_( std::istream &Input ) {
 
-    // TODO: implement
+    // basic attributes
+    asPowerSupplyName = sn_utils::d_str( Input );
+    NominalVoltage = sn_utils::ld_float32( Input );
+    MaxCurrent = sn_utils::ld_float32( Input );
+    fResistivity = sn_utils::ld_float32( Input );
+    Material = sn_utils::ld_uint32( Input );
+    WireThickness = sn_utils::ld_float32( Input );
+    DamageFlag = sn_utils::ld_uint32( Input );
+    // path data
+    pPoint1 = sn_utils::d_dvec3( Input );
+    pPoint2 = sn_utils::d_dvec3( Input );
+    pPoint3 = sn_utils::d_dvec3( Input );
+    pPoint4 = sn_utils::d_dvec3( Input );
+    fHeightDifference = sn_utils::ld_float64( Input );
+    iNumSections = sn_utils::ld_int32( Input );
+    // wire data
+    Wires = sn_utils::ld_int32( Input );
+    WireOffset = sn_utils::ld_float32( Input );
+    // optional attributes
+    asParallel = sn_utils::d_str( Input );
+
+    Init(); // przeliczenie parametrów
 }
 
 // export() subclass details, sends basic content of the class in legacy (text) format to provided stream
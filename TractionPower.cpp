@@ -18,6 +18,7 @@ http://mozilla.org/MPL/2.0/.
 
 #include "parser.h"
 #include "Logs.h"
+#include "sn_utils.h"
 
 //---------------------------------------------------------------------------
 
@@ -145,14 +146,34 @@ void TTractionPowerSource::PowerSet(TTractionPowerSource *ps)
 void
 TTractionPowerSource::serialize_( std::ostream &Output ) const {
 
-    // TODO: implement
+    // basic attributes
+    sn_utils::ls_float64( Output, NominalVoltage );
+    sn_utils::ls_float64( Output, VoltageFrequency );
+    sn_utils::ls_float64( Output, InternalRes );
+    sn_utils::ls_float64( Output, MaxOutputCurrent );
+    sn_utils::ls_float64( Output, FastFuseTimeOut );
+    sn_utils::ls_int32( Output, FastFuseRepetition );
+    sn_utils::ls_float64( Output, SlowFuseTimeOut );
+    // optional attributes
+    sn_utils::s_bool( Output, Recuperation );
+    sn_utils::s_bool( Output, bSection );
 }
 
 // deserialize() subclass details, restores content of the subclass from provided stream
 void
 TTractionPowerSource::deserialize_( std::istream &Input ) {
 
-    // TODO: implement
+    // basic attributes
+    NominalVoltage = sn_utils::ld_float64( Input );
+    VoltageFrequency = sn_utils::ld_float64( Input );
+    InternalRes = sn_utils::ld_float64( Input );
+    MaxOutputCurrent = sn_utils::ld_float64( Input );
+    FastFuseTimeOut = sn_utils::ld_float64( Input );
+    FastFuseRepetition = sn_utils::ld_int32( Input );
+    SlowFuseTimeOut = sn_utils::ld_float64( Input );
+    // optional attributes
+    Recuperation = sn_utils::d_bool( Input );
+    bSection = sn_utils::d_bool( Input );
 }
 
 // export() subclass details, sends basic content of the class in legacy (text) format to provided stream
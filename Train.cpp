@@ -5316,14 +5316,14 @@ bool TTrain::Update( double const Deltatime )
                     x = 1;
                 else
                     x = 2;
-                if ((mvControlled->RList[mvControlled->MainCtrlActualPos].Mn > 0) &&
+                if ((mvControlled->Tables->RList[mvControlled->MainCtrlActualPos].Mn > 0) &&
                     (abs(mvControlled->Im) > 0))
                 {
                     ggEngineVoltage.UpdateValue(
                         (x * (mvControlled->RunningTraction.TractionVoltage -
-                              mvControlled->RList[mvControlled->MainCtrlActualPos].R *
+                              mvControlled->Tables->RList[mvControlled->MainCtrlActualPos].R *
                                   abs(mvControlled->Im)) /
-                         mvControlled->RList[mvControlled->MainCtrlActualPos].Mn));
+                         mvControlled->Tables->RList[mvControlled->MainCtrlActualPos].Mn));
                 }
                 else
                 {
@@ -5481,8 +5481,8 @@ bool TTrain::Update( double const Deltatime )
 
             if( ( false == mvControlled->DelayCtrlFlag )
              && ( ( mvControlled->ScndCtrlActualPos > 0 )
-               || ( ( mvControlled->RList[ mvControlled->MainCtrlActualPos ].ScndAct != 0 )
-                 && ( mvControlled->RList[ mvControlled->MainCtrlActualPos ].ScndAct != 255 ) ) ) ) {
+               || ( ( mvControlled->Tables->RList[ mvControlled->MainCtrlActualPos ].ScndAct != 0 )
+                 && ( mvControlled->Tables->RList[ mvControlled->MainCtrlActualPos ].ScndAct != 255 ) ) ) ) {
                 btLampkaBoczniki.Turn( true );
             }
             else {
@@ -5497,7 +5497,7 @@ bool TTrain::Update( double const Deltatime )
             unsigned char scp; // Ra: dopisałem "unsigned"
             // Ra: w SU45 boczniki wchodzą na MainCtrlPos, a nie na MainCtrlActualPos
             // - pokićkał ktoś?
-            scp = mvControlled->RList[mvControlled->MainCtrlPos].ScndAct;
+            scp = mvControlled->Tables->RList[mvControlled->MainCtrlPos].ScndAct;
             scp = (scp == 255 ? 0 : scp); // Ra: whatta hella is this?
             if ((mvControlled->ScndCtrlPos > 0) || (mvControlled->ScndInMain != 0) && (scp > 0))
             { // boczniki pojedynczo
@@ -7042,8 +7042,8 @@ void TTrain::SetLights()
     int xs = (kier ? 0 : 1);
     if (kier ? p->NextC(1) : p->PrevC(1)) // jesli jest nastepny, to tylko przod
     {
-        p->RaLightsSet(mvOccupied->Lights[xs][mvOccupied->LightsPos - 1] * (1 - xs),
-                       mvOccupied->Lights[1 - xs][mvOccupied->LightsPos - 1] * xs);
+        p->RaLightsSet(mvOccupied->Tables->Lights[xs][mvOccupied->LightsPos - 1] * (1 - xs),
+                       mvOccupied->Tables->Lights[1 - xs][mvOccupied->LightsPos - 1] * xs);
         p = (kier ? p->NextC(4) : p->PrevC(4));
         while (p)
         {
@@ -7053,16 +7053,16 @@ void TTrain::SetLights()
             }
             else
             {
-                p->RaLightsSet(mvOccupied->Lights[xs][mvOccupied->LightsPos - 1] * xs,
-                               mvOccupied->Lights[1 - xs][mvOccupied->LightsPos - 1] * (1 - xs));
+                p->RaLightsSet(mvOccupied->Tables->Lights[xs][mvOccupied->LightsPos - 1] * xs,
+                               mvOccupied->Tables->Lights[1 - xs][mvOccupied->LightsPos - 1] * (1 - xs));
             }
             p = (kier ? p->NextC(4) : p->PrevC(4));
         }
     }
     else // calosc
     {
-        p->RaLightsSet(mvOccupied->Lights[xs][mvOccupied->LightsPos - 1],
-                       mvOccupied->Lights[1 - xs][mvOccupied->LightsPos - 1]);
+        p->RaLightsSet(mvOccupied->Tables->Lights[xs][mvOccupied->LightsPos - 1],
+                       mvOccupied->Tables->Lights[1 - xs][mvOccupied->LightsPos - 1]);
     }
 };
 
@@ -253,6 +253,10 @@ bool TTrackFollower::Move(double fDistance, bool bPrimary)
                 pCurrentTrack->QueueEvents( pCurrentTrack->m_events2all, Owner, -1.0 );
             }
             fCurrentDistance = s;
+            if( Owner->MyTrack == pCurrentTrack ) {
+                // keep the vehicle in its place among other vehicles on the track
+                pCurrentTrack->occupancy_moved( Owner );
+            }
             return ComputatePosition(); // przeliczenie XYZ, true o ile nie wyjechał na NULL
         }
     }
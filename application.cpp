@@ -12,6 +12,8 @@ http://mozilla.org/MPL/2.0/.
 #include "scenarioloadermode.h"
 #include "drivermode.h"
 #include "editormode.h"
+#include "headlessmode.h"
+#include "benchmarkmode.h"
 
 #include "Globals.h"
 #include "simulation.h"
@@ -123,6 +125,7 @@ eu07_application::init( int Argc, char *Argv[] ) {
     WriteLog( "Authors: Marcin_EU, McZapkie, ABu, Winger, Tolaris, nbmx, OLO_EU, Bart, Quark-t, "
         "ShaXbee, Oli_EU, youBy, KURS90, Ra, hunter, szociu, Stele, Q, firleju and others\n" );
 
+#ifndef EU07_HEADLESS
     if( ( result = init_glfw() ) != 0 ) {
         return result;
     }
@@ -133,6 +136,10 @@ eu07_application::init( int Argc, char *Argv[] ) {
     if( ( result = init_audio() ) != 0 ) {
         return result;
     }
+#else
+    // unattended run, no window, graphics or audio
+    Global.bSoundEnabled = false;
+#endif
     m_taskqueue.init();
     if( ( result = init_modes() ) != 0 ) {
         return result;
@@ -144,6 +151,19 @@ eu07_application::init( int Argc, char *Argv[] ) {
 int
 eu07_application::run() {
 
+#ifdef EU07_HEADLESS
+    // unattended run, the mode decides when it's done
+    while( ( false == m_modestack.empty() )
+        && ( true == m_modes[ m_modestack.top() ]->update() ) ) {
+        simulation::Commands.update();
+    }
+    // build servers learn about failed runs from the exit code
+    return (
+        ( ( false == m_modestack.empty() )
+       && ( true == m_modes[ m_modestack.top() ]->failed() ) ) ?
+            1 :
+            0 );
+#endif
     // main application loop
     while( ( false == glfwWindowShouldClose( m_windows.front() ) )
         && ( false == m_modestack.empty() )
@@ -196,13 +216,17 @@ eu07_application::exit() {
     SafeDelete( simulation::Train );
     SafeDelete( simulation::Region );
 
+#ifndef EU07_HEADLESS
     ui_layer::shutdown();
 
     for( auto *window : m_windows ) {
         glfwDestroyWindow( window );
     }
     glfwTerminate();
+#endif
     m_taskqueue.exit();
+
+    CloseLogs();
 }
 
 void
@@ -396,11 +420,62 @@ eu07_application::init_settings( int Argc, char *Argv[] ) {
                 Global.asHumanCtrlVehicle = ToLower( Argv[ ++i ] );
             }
         }
+        else if( token == "-record" ) {
+            if( i + 1 < Argc ) {
+                Global.CommandRecordFile = Argv[ ++i ];
+                Global.Lockstep = true;
+            }
+        }
+        else if( token == "-replay" ) {
+            if( i + 1 < Argc ) {
+                Global.CommandReplayFile = Argv[ ++i ];
+            }
+        }
+#ifdef EU07_HEADLESS
+        else if( token == "-t" ) {
+            if( i + 1 < Argc ) {
+                Global.HeadlessDuration = std::max( 0.0, std::atof( Argv[ ++i ] ) );
+            }
+        }
+        else if( token == "-dt" ) {
+            if( i + 1 < Argc ) {
+                Global.HeadlessTimestep = clamp( std::atof( Argv[ ++i ] ), 0.001, 1.0 );
+            }
+        }
+#endif
+#ifdef EU07_BENCH
+        else if( token == "-fiz" ) {
+            if( i + 1 < Argc ) {
+                Global.BenchmarkVehicles.emplace_back( Argv[ ++i ] );
+            }
+        }
+        else if( token == "-o" ) {
+            if( i + 1 < Argc ) {
+                Global.BenchmarkOutput = Argv[ ++i ];
+            }
+        }
+        else if( token == "-r" ) {
+            if( i + 1 < Argc ) {
+                Global.BenchmarkRepetitions = clamp( std::atoi( Argv[ ++i ] ), 1, 1000 );
+            }
+        }
+#endif
         else {
             std::cout
                 << "usage: " << std::string( Argv[ 0 ] )
                 << " [-s sceneryfilepath]"
                 << " [-v vehiclename]"
+                << " [-record recordingfilepath]"
+                << " [-replay recordingfilepath]"
+#ifdef EU07_HEADLESS
+                << " [-t simulatedseconds]"
+                << " [-dt timestep]"
+#endif
+#ifdef EU07_BENCH
+                << " [-fiz vehiclefilepath]"
+                << " [-o outputfilepath]"
+                << " [-r repetitions]"
+#endif
                 << std::endl;
             return -1;
         }
@@ -521,18 +596,34 @@ eu07_application::init_modes() {
     // NOTE: we could delay creation/initialization until transition to specific mode is requested,
     // but doing it in one go at the start saves us some error checking headache down the road
 
+#ifndef EU07_HEADLESS
     // create all application behaviour modes
     m_modes[ mode::scenarioloader ] = std::make_shared<scenarioloader_mode>();
     m_modes[ mode::driver ] = std::make_shared<driver_mode>();
     m_modes[ mode::editor ] = std::make_shared<editor_mode>();
+#else
+    // unattended run needs only the mode which does it
+#ifndef EU07_BENCH
+    m_modes[ mode::headless ] = std::make_shared<headless_mode>();
+#else
+    m_modes[ mode::benchmark ] = std::make_shared<benchmark_mode>();
+#endif
+#endif
     // initialize the mode objects
     for( auto &mode : m_modes ) {
+        if( mode == nullptr ) { continue; }
         if( false == mode->init() ) {
             return -1;
         }
     }
     // activate the default mode
+#ifndef EU07_HEADLESS
     push_mode( mode::scenarioloader );
+#elif !defined( EU07_BENCH )
+    push_mode( mode::headless );
+#else
+    push_mode( mode::benchmark );
+#endif
 
     return 0;
 }
@@ -21,6 +21,8 @@ public:
         scenarioloader,
         driver,
         editor,
+        headless,
+        benchmark,
         count_
     };
 // constructors
@@ -63,6 +63,11 @@ public:
     virtual
     void
         on_event_poll() = 0;
+    // returns: true if the mode ran into an error which should be reported through the exit code of the application
+    virtual
+    bool
+        failed() const {
+            return false; }
 
 protected:
 // members
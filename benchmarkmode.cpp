@@ -0,0 +1,832 @@
+/*
+This Source Code Form is subject to the
+terms of the Mozilla Public License, v.
+2.0. If a copy of the MPL was not
+distributed with this file, You can
+obtain one at
+http://mozilla.org/MPL/2.0/.
+*/
+
+#include "stdafx.h"
+#include "benchmarkmode.h"
+
+#include "Globals.h"
+#include "simulation.h"
+#include "Event.h"
+#include "Track.h"
+#include "Segment.h"
+#include "parser.h"
+#include "scene.h"
+#include "Timer.h"
+#include "Logs.h"
+#include "McZapkie/MOVER.h"
+#include "McZapkie/brakepipe.h"
+
+namespace {
+
+// workload sizes. changing any of these invalidates comparisons with earlier results
+double const physicsstep { 1.0 / 100.0 }; // matches physics step of the driver mode
+std::size_t const vehiclesteps { 10000 };
+std::size_t const consistwagons { 40 };
+std::size_t const consistchargesteps { 6000 }; // brake pipe is charged for a minute before the measurement
+std::size_t const consiststeps { 2000 };
+double const brakepipetolerance { 0.01 }; // allowed difference between sequential and batched brake pipe update, in MPa
+std::size_t const frictionqueries { 100000 };
+std::size_t const segmentqueries { 20000 };
+std::size_t const parsernodes { 5000 };
+std::size_t const eventcount { 2000 };
+std::size_t const largeeventcount { 100000 }; // large signalling scenario
+double const eventspread { 60.0 }; // queued events are spread over this much of simulation time, in seconds
+double const eventstep { 0.1 };
+
+using vehicle_ptr = std::unique_ptr<TMoverParameters>;
+
+double
+nanoseconds( std::chrono::steady_clock::duration const Duration ) {
+
+    return std::chrono::duration_cast<std::chrono::duration<double, std::nano>>( Duration ).count();
+}
+
+// stores specified value where the compiler can't see it unused, so the calculations producing it aren't optimized away
+void
+do_not_optimize( double const Value ) {
+
+    static double volatile sink;
+    sink = Value;
+}
+
+// creates vehicle from specified .fiz file, prepared for run the same way as in scenario loading. returns: null on failure
+vehicle_ptr
+load_vehicle( std::string const &File, double const Velocity, int const Cab ) {
+
+    auto const separator { File.find_last_of( "/\\" ) };
+    auto const path { ( separator != std::string::npos ? File.substr( 0, separator + 1 ) : "" ) };
+    auto name { ( separator != std::string::npos ? File.substr( separator + 1 ) : File ) };
+    if( ( name.size() > 4 )
+     && ( ToLower( name.substr( name.size() - 4 ) ) == ".fiz" ) ) {
+        name.erase( name.size() - 4 );
+    }
+
+    auto vehicle { std::make_unique<TMoverParameters>( Velocity, name, name, Cab ) };
+    if( ( false == vehicle->LoadFIZ( path ) )
+     || ( false == vehicle->CheckLocomotiveParameters( true, 1 ) ) ) {
+        ErrorLog( "Bad benchmark: failed to load vehicle definition from file \"" + File + "\"" );
+        return nullptr;
+    }
+    vehicle->LocalBrakePosA = 0.0;
+    if( vehicle->BrakeCtrlPosNo > 0 ) {
+        vehicle->BrakeLevelSet( vehicle->Handle->GetPos( Cab != 0 ? bh_RP : bh_NP ) );
+    }
+    return vehicle;
+}
+
+// builds synthetic scenario text with specified number of track nodes
+std::string
+make_scenario( std::size_t const Nodecount ) {
+
+    std::string scenario;
+    for( std::size_t idx = 0; idx < Nodecount; ++idx ) {
+        auto const offset { std::to_string( idx * 100 ) + ".0" };
+        scenario +=
+            "// track " + std::to_string( idx ) + "\n"
+            "node -1 0 track_" + std::to_string( idx ) + " track normal 100.0 1.435 0.25 25 20 0 0 1\n"
+            "vis\n"
+            "rail_screw_used1.dds 4 TpD1.dds 0.2 0.5 1.1\n"
+            "0.0 0.0 " + offset + " 0.0\n"
+            "0.0 0.0 0.0\n"
+            "0.0 0.0 0.0\n"
+            "0.0 0.0 " + offset + " 0.0 0\n"
+            "velocity 100 /* speed limit */ event1 track_" + std::to_string( idx ) + "_enter\n"
+            "endtrack\n";
+    }
+    return scenario;
+}
+
+// text parser as it was before it read data from memory-mapped buffers, kept as reference for the parser benchmark
+// the stream is read one character at a time, and each include file opens its own stream
+class stream_parser {
+
+public:
+// constructors
+    stream_parser( std::string const &File, std::string const &Path, std::vector<std::string> Parameters = {} ) :
+        m_stream( Path + File ),
+        m_path( Path ),
+        m_parameters( std::move( Parameters ) )
+    {}
+// methods
+    // retrieves next token, in the same way as cParser::getToken<std::string>(). returns: empty string at the end of data
+    std::string
+        token() {
+            return read_token( true, separators ); }
+
+private:
+// methods
+    std::string
+        read_token( bool const Tolower, char const *Break ) {
+            std::string token;
+            if( m_include ) {
+                token = m_include->read_token( Tolower, Break );
+                if( true == token.empty() ) {
+                    m_include.reset();
+                }
+            }
+            if( true == token.empty() ) {
+                char c { 0 };
+                do {
+                    while( ( m_stream.peek() != EOF )
+                        && ( std::strchr( Break, c = m_stream.get() ) == nullptr ) ) {
+                        if( Tolower ) { c = std::tolower( c ); }
+                        token += c;
+                        if( true == find_quotes( token ) ) { continue; }
+                        if( true == trim_comments( token ) ) { break; }
+                    }
+                } while( ( true == token.empty() ) && ( m_stream.peek() != EOF ) );
+            }
+            if( false == m_parameters.empty() ) {
+                std::size_t position;
+                while( ( position = token.find( "(p" ) ) != std::string::npos ) {
+                    auto const end { token.find( ")", position ) };
+                    auto const index { static_cast<std::size_t>( std::atoi( token.substr( position + 2, end - ( position + 2 ) ).c_str() ) - 1 ) };
+                    token.erase( position, end - position + 1 );
+                    if( index < m_parameters.size() ) {
+                        token.insert( position, m_parameters[ index ] );
+                        // the old tokeniser lowercased only the part of the token up to the parameter length
+                        if( Tolower ) {
+                            for( ; position < m_parameters[ index ].size(); ++position ) {
+                                token[ position ] = std::tolower( token[ position ] );
+                            }
+                        }
+                    }
+                    else {
+                        token.insert( position, "none" );
+                    }
+                }
+            }
+            if( token == "include" ) {
+                auto includefile { read_token( Tolower, separators ) };
+                std::replace( std::begin( includefile ), std::end( includefile ), '\\', '/' );
+                std::vector<std::string> parameters;
+                auto parameter { read_token( false, separators ) };
+                while( ( false == parameter.empty() )
+                    && ( parameter != "end" ) ) {
+                    parameters.emplace_back( parameter );
+                    parameter = read_token( false, separators );
+                }
+                if( ( true == Global.bLoadTraction )
+                 || ( ( includefile.find( "tr/" ) == std::string::npos )
+                   && ( includefile.find( "tra/" ) == std::string::npos ) ) ) {
+                    m_include = std::make_unique<stream_parser>( includefile, m_path, parameters );
+                }
+                token = read_token( Tolower, Break );
+            }
+            return token; }
+    bool
+        find_quotes( std::string &Token ) {
+            auto const quote { Token.rfind( '\"' ) };
+            if( quote == std::string::npos ) { return false; }
+            Token.erase( quote, 1 );
+            char c { 0 };
+            while( ( m_stream.peek() != EOF )
+                && ( '\"' != ( c = m_stream.get() ) ) ) {
+                Token += c;
+            }
+            return true; }
+    bool
+        trim_comments( std::string &Token ) {
+            for( auto const &comment : m_comments ) {
+                auto const start { Token.rfind( comment.first ) };
+                if( start == std::string::npos ) { continue; }
+                skip_comment( comment.second );
+                Token.resize( start );
+                return true;
+            }
+            return false; }
+    void
+        skip_comment( std::string const &Endmark ) {
+            std::string input;
+            while( m_stream.peek() != EOF ) {
+                input += static_cast<char>( m_stream.get() );
+                if( input.find( Endmark ) != std::string::npos ) { break; }
+                if( input.size() >= Endmark.size() ) { input.erase( 0, 1 ); }
+            } }
+// members
+    static constexpr char const *separators { "\n\r\t ;" };
+    std::ifstream m_stream;
+    std::string m_path;
+    std::vector<std::string> m_parameters;
+    std::unique_ptr<stream_parser> m_include;
+    std::map<std::string, std::string> const m_comments {
+        { "/*", "*/" },
+        { "//", "\n" } };
+};
+
+} // namespace
+
+// initializes internal data structures of the mode. returns: true on success, false otherwise
+bool
+benchmark_mode::init() {
+    // nothing to do here
+    return true;
+}
+
+// mode-specific update of simulation data. returns: false on error or when the run is complete, true otherwise
+bool
+benchmark_mode::update() {
+
+    if( true == m_complete ) {
+        return false;
+    }
+
+    WriteLog( "\nRunning benchmarks, " + std::to_string( Global.BenchmarkRepetitions ) + " timed runs each..." );
+
+    if( false == Global.BenchmarkVehicles.empty() ) {
+        for( auto const &vehicle : Global.BenchmarkVehicles ) {
+            run_vehicle( vehicle );
+        }
+        run_consist( Global.BenchmarkVehicles.front(), Global.BenchmarkVehicles.back() );
+    }
+    else {
+        WriteLog( "No vehicle definitions specified, vehicle and consist benchmarks skipped" );
+    }
+    run_friction();
+    run_segment();
+    run_parser();
+    run_parser_file( Global.SceneryFile );
+    run_events( eventcount );
+    run_events( largeeventcount );
+
+    m_complete = true;
+    if( false == report() ) {
+        m_failed = true;
+    }
+
+    return false;
+}
+
+// maintenance method, called when the mode is activated
+void
+benchmark_mode::enter() {
+
+    m_complete = false;
+    m_failed = false;
+    m_results.clear();
+}
+
+// maintenance method, called when the mode is deactivated
+void
+benchmark_mode::exit() {
+    // nothing to do here
+}
+
+// times specified workload. Setup_ prepares state for single run, Body_ performs the run on it and returns time spent on measured work
+template <typename Setup_, typename Body_>
+benchmark_mode::benchmark_result &
+benchmark_mode::measure( std::string const &Name, std::string const &Subject, std::size_t const Operations, Setup_ Setup, Body_ Body ) {
+
+    benchmark_result result;
+    result.name = Name;
+    result.subject = Subject;
+    result.operations = Operations;
+    // first run warms up caches and isn't recorded
+    for( int run = 0; run <= Global.BenchmarkRepetitions; ++run ) {
+        auto state { Setup() };
+        auto const elapsed { Body( state ) };
+        if( run > 0 ) {
+            result.samples.emplace_back( nanoseconds( elapsed ) / std::max<std::size_t>( 1, Operations ) );
+        }
+    }
+    m_results.emplace_back( result );
+    return m_results.back();
+}
+
+// vehicle physics, TMoverParameters::ComputeTotalForce() and TMoverParameters::ComputeMovement()
+void
+benchmark_mode::run_vehicle( std::string const &File ) {
+
+    if( load_vehicle( File, 0.0, 1 ) == nullptr ) {
+        m_failed = true;
+        return;
+    }
+    // vehicle rolls at 60 km/h through a 600 m curve, under the catenary
+    auto const setup {
+        [&]() {
+            return load_vehicle( File, 60.0, 1 ); } };
+
+    TTrackShape shape;
+    shape.R = 600.0;
+    shape.Len = 1.0;
+    TTrackParam track;
+    track.Width = 1.435;
+    track.friction = 0.15;
+    track.CategoryFlag = 1;
+    track.QualityFlag = 20;
+    track.DamageFlag = 0;
+    track.Velmax = 100.0;
+    TLocation const location { 0.0, 0.0, 0.0 };
+
+    measure(
+        "mover.compute_total_force", File, vehiclesteps,
+        setup,
+        [&]( vehicle_ptr &Vehicle ) {
+            auto const start { clock::now() };
+            for( std::size_t step = 0; step < vehiclesteps; ++step ) {
+                Vehicle->ComputeTotalForce( physicsstep, physicsstep, true );
+            }
+            return clock::now() - start; } );
+
+    measure(
+        "mover.compute_movement", File, vehiclesteps,
+        setup,
+        [&]( vehicle_ptr &Vehicle ) {
+            TTractionParam traction;
+            traction.TractionVoltage = 0.95 * Vehicle->EnginePowerSource.MaxVoltage;
+            traction.TractionMaxCurrent = 7500;
+            traction.TractionResistivity = 0.3;
+            TRotation rotation { 0.0, 0.0, 0.0 };
+            auto const start { clock::now() };
+            for( std::size_t step = 0; step < vehiclesteps; ++step ) {
+                Vehicle->ComputeMovement( physicsstep, physicsstep, shape, track, traction, location, rotation );
+            }
+            return clock::now() - start; } );
+}
+
+// train brake pipe and brake cylinders of a consist, TMoverParameters::UpdatePipePressure() and TMoverParameters::UpdateBrakePressure(), with results of brake_pipe_solver checked against the sequential update
+void
+benchmark_mode::run_consist( std::string const &Locomotive, std::string const &Wagon ) {
+
+    if( ( load_vehicle( Locomotive, 0.0, 1 ) == nullptr )
+     || ( load_vehicle( Wagon, 0.0, 0 ) == nullptr ) ) {
+        m_failed = true;
+        return;
+    }
+    // locomotive with coupled wagons and charged brake pipe. the driver applies full service braking,
+    // then releases the brakes halfway through the run
+    auto const setup {
+        [&]() {
+            std::vector<vehicle_ptr> consist;
+            consist.emplace_back( load_vehicle( Locomotive, 0.0, 1 ) );
+            for( std::size_t idx = 0; idx < consistwagons; ++idx ) {
+                consist.emplace_back( load_vehicle( Wagon, 0.0, 0 ) );
+            }
+            auto const coupling { coupling::coupler | coupling::brakehose };
+            for( std::size_t idx = 1; idx < consist.size(); ++idx ) {
+                consist[ idx - 1 ]->Attach( end::rear, end::front, consist[ idx ].get(), coupling, true, false );
+                consist[ idx ]->Attach( end::front, end::rear, consist[ idx - 1 ].get(), coupling, true, false );
+            }
+            for( std::size_t step = 0; step < consistchargesteps; ++step ) {
+                for( auto &vehicle : consist ) { vehicle->UpdateBrakePressure( physicsstep ); }
+                for( auto &vehicle : consist ) { vehicle->UpdatePipePressure( physicsstep ); }
+            }
+            return consist; } };
+    // single simulation step of the consist. with the solver provided, the pipe update is completed by it for the whole consist. returns: time spent on brake and pipe updates
+    auto const advance {
+        []( std::vector<vehicle_ptr> &Consist, std::size_t const Step, brake_pipe_solver *Solver ) {
+            auto &locomotive { *Consist.front() };
+            if( ( Step == 0 ) || ( Step == consiststeps / 2 ) ) {
+                locomotive.BrakeLevelSet( locomotive.Handle->GetPos( Step == 0 ? bh_FB : bh_RP ) );
+            }
+            auto const brakestart { clock::now() };
+            for( auto &vehicle : Consist ) { vehicle->UpdateBrakePressure( physicsstep ); }
+            auto const pipestart { clock::now() };
+            for( auto &vehicle : Consist ) { vehicle->UpdatePipePressure( physicsstep ); }
+            if( Solver != nullptr ) {
+                for( auto &vehicle : Consist ) { Solver->insert( *vehicle ); }
+                Solver->solve( physicsstep );
+            }
+            auto const pipeend { clock::now() };
+            return std::make_pair( pipestart - brakestart, pipeend - pipestart ); } };
+    // both updates are made in every step, only the one under test is timed
+    auto const run {
+        [&]( std::vector<vehicle_ptr> &Consist, bool const Pipe, brake_pipe_solver *Solver ) {
+            for( auto &vehicle : Consist ) { vehicle->PipeFlowDeferred = ( Solver != nullptr ); }
+            clock::duration elapsed { 0 };
+            for( std::size_t step = 0; step < consiststeps; ++step ) {
+                auto const steptime { advance( Consist, step, Solver ) };
+                elapsed += (
+                    Pipe ?
+                        steptime.second :
+                        steptime.first );
+            }
+            return elapsed; } };
+
+    // the solver uses pressures of all hoses from the same moment, so its results drift slightly from the sequential update
+    // both are run side by side through the same steps, to make sure the drift stays within the tolerance
+    auto pipeerror { 0.0 };
+    auto brakeerror { 0.0 };
+    {
+        auto sequential { setup() };
+        auto batched { setup() };
+        for( auto &vehicle : batched ) { vehicle->PipeFlowDeferred = true; }
+        brake_pipe_solver solver;
+        for( std::size_t step = 0; step < consiststeps; ++step ) {
+            advance( sequential, step, nullptr );
+            advance( batched, step, &solver );
+            for( std::size_t idx = 0; idx < sequential.size(); ++idx ) {
+                pipeerror = std::max( pipeerror, std::abs( sequential[ idx ]->PipePress - batched[ idx ]->PipePress ) );
+                brakeerror = std::max( brakeerror, std::abs( sequential[ idx ]->BrakePress - batched[ idx ]->BrakePress ) );
+            }
+        }
+    }
+    auto const accuracy { "differs from sequential update up to " + to_string( pipeerror, 6 ) + " MPa in brake pipe, " + to_string( brakeerror, 6 ) + " MPa in brake cylinders" };
+    WriteLog( "brakes.update_pipe_pressure_batched: " + accuracy );
+    if( ( pipeerror > brakepipetolerance )
+     || ( brakeerror > brakepipetolerance ) ) {
+        m_failed = true;
+        ErrorLog( "Bad benchmark: batched brake pipe update exceeds tolerance (" + to_string( brakepipetolerance, 6 ) + " MPa), " + accuracy );
+    }
+
+    auto const subject { Locomotive + " + " + std::to_string( consistwagons ) + "x " + Wagon };
+
+    measure(
+        "brakes.update_pipe_pressure", subject, consiststeps,
+        setup,
+        [&]( std::vector<vehicle_ptr> &Consist ) {
+            return run( Consist, true, nullptr ); } );
+
+    measure(
+        "brakes.update_pipe_pressure_batched", subject, consiststeps,
+        setup,
+        [&]( std::vector<vehicle_ptr> &Consist ) {
+            brake_pipe_solver solver;
+            return run( Consist, true, &solver ); } )
+        .values = {
+            { "max_pipe_difference_mpa", pipeerror },
+            { "max_cylinder_difference_mpa", brakeerror } };
+
+    measure(
+        "brakes.update_brake_pressure", subject, consiststeps,
+        setup,
+        [&]( std::vector<vehicle_ptr> &Consist ) {
+            return run( Consist, false, nullptr ); } );
+}
+
+// brake shoe friction, TFricMat::GetFC() and friction_table::GetFC()
+void
+benchmark_mode::run_friction() {
+
+    std::vector<std::pair<std::string, std::shared_ptr<TFricMat>>> const materials {
+        { "P10Bg", std::make_shared<TP10Bg>() },
+        { "P10Bgu", std::make_shared<TP10Bgu>() },
+        { "P10yBg", std::make_shared<TP10yBg>() },
+        { "P10yBgu", std::make_shared<TP10yBgu>() } };
+    // queries sweep through force of 0-100 kN per shoe and velocity of 0-160 km/h
+    auto const run {
+        []( auto &Material ) {
+            double sum { 0.0 }; // keeps the calls from being optimized away
+            auto const start { clock::now() };
+            for( std::size_t idx = 0; idx < frictionqueries; ++idx ) {
+                sum += Material.GetFC( ( idx % 1000 ) * 0.1, ( idx / 1000 ) * 1.6 );
+            }
+            auto const elapsed { clock::now() - start };
+            do_not_optimize( sum );
+            return elapsed; } };
+
+    for( auto const &material : materials ) {
+        auto const table { friction_table::find( material.second ) };
+        auto const &subject { material.first };
+
+        measure(
+            "brakes.friction_exact", subject, frictionqueries,
+            [&]() { return material.second; },
+            [&]( std::shared_ptr<TFricMat> &Material ) {
+                return run( *Material ); } );
+
+        if( table == nullptr ) { continue; }
+
+        measure(
+            "brakes.friction_table", subject, frictionqueries,
+            [&]() { return table; },
+            [&]( std::shared_ptr<friction_table const> &Table ) {
+                return run( *Table ); } )
+            .values = {
+                { "max_interpolation_error", table->max_error() } };
+    }
+}
+
+// track geometry, TSegment::GetTFromS() and TSegment::RombergIntegral(), with accuracy of the arc length table checked against newton's method
+void
+benchmark_mode::run_segment() {
+
+    scene::node_data nodedata;
+    nodedata.name = "benchmark";
+    nodedata.type = "track";
+    TTrack track { nodedata };
+    // control point distance approximating circular arc of specified radius and angle
+    auto const handle {
+        []( double const Radius, double const Angle ) {
+            return Radius * 4.0 / 3.0 * std::tan( glm::radians( Angle ) * 0.25 ); } };
+    // representative shapes, the first one is used for timing
+    struct segment_shape {
+        std::string name;
+        std::array<Math3D::vector3, 4> points;
+    };
+    std::vector<segment_shape> const shapes {
+        // 90 degree arc of 300 m radius, climbing 2 m along the way
+        { "bezier arc, radius 300 m, 90 degrees", {
+            Math3D::vector3 { 0.0, 0.0, 0.0 }, Math3D::vector3 { 0.0, 0.0, handle( 300.0, 90.0 ) },
+            Math3D::vector3 { 300.0 - handle( 300.0, 90.0 ), 2.0, 300.0 }, Math3D::vector3 { 300.0, 2.0, 300.0 } } },
+        // tight arc, as found in sidings and yards
+        { "bezier arc, radius 150 m, 90 degrees", {
+            Math3D::vector3 { 0.0, 0.0, 0.0 }, Math3D::vector3 { 0.0, 0.0, handle( 150.0, 90.0 ) },
+            Math3D::vector3 { 150.0 - handle( 150.0, 90.0 ), 0.0, 150.0 }, Math3D::vector3 { 150.0, 0.0, 150.0 } } },
+        // mainline arc of large radius
+        { "bezier arc, radius 1500 m, 15 degrees", {
+            Math3D::vector3 { 0.0, 0.0, 0.0 }, Math3D::vector3 { 0.0, 0.0, handle( 1500.0, 15.0 ) },
+            Math3D::vector3 {
+                1500.0 * ( 1.0 - std::cos( glm::radians( 15.0 ) ) ) - handle( 1500.0, 15.0 ) * std::sin( glm::radians( 15.0 ) ),
+                0.0,
+                1500.0 * std::sin( glm::radians( 15.0 ) ) - handle( 1500.0, 15.0 ) * std::cos( glm::radians( 15.0 ) ) },
+            Math3D::vector3 { 1500.0 * ( 1.0 - std::cos( glm::radians( 15.0 ) ) ), 0.0, 1500.0 * std::sin( glm::radians( 15.0 ) ) } } },
+        // reverse curve between parallel tracks
+        { "bezier s-curve, 4.5 m offset over 120 m", {
+            Math3D::vector3 { 0.0, 0.0, 0.0 }, Math3D::vector3 { 0.0, 0.0, 40.0 },
+            Math3D::vector3 { 4.5, 0.0, 80.0 }, Math3D::vector3 { 4.5, 0.0, 120.0 } } },
+        // hand-made spline with uneven control points, so the curve parameter runs at varying speed
+        { "bezier arc, uneven control points", {
+            Math3D::vector3 { 0.0, 0.0, 0.0 }, Math3D::vector3 { 0.0, 0.0, 30.0 },
+            Math3D::vector3 { 50.0, 0.0, 300.0 }, Math3D::vector3 { 300.0, 0.0, 300.0 } } } };
+    auto const make_segment {
+        [&]( segment_shape const &Shape ) {
+            auto points { Shape.points };
+            auto segment { std::make_shared<TSegment>( &track ) };
+            segment->Init(
+                points[ 0 ], points[ 1 ], points[ 2 ], points[ 3 ],
+                2.0 );
+            return segment; } };
+
+    // the arc length table is compared with the newton's method it replaced, and with the arc length integrated for the result
+    // newton's method stops within 1 mm of the distance, so it can differ from the table by that much on top of the table error
+    auto const tablebound { Global.SplineTolerance };
+    auto const newtonbound { Global.SplineTolerance + 0.001 };
+    // the worst case over all shapes is reported along with the timings
+    auto maxtableerror { 0.0 };
+    auto maxnewtonerror { 0.0 };
+    for( auto const &shape : shapes ) {
+        auto const segment { make_segment( shape ) };
+        auto const length { segment->GetLength() };
+        auto tableerror { 0.0 }; // distance to the result along the curve, in metres
+        auto newtonerror { 0.0 }; // distance between both results along the curve, in metres
+        for( std::size_t idx = 0; idx <= segmentqueries / 10; ++idx ) {
+            auto const distance { length * idx / ( segmentqueries / 10 ) };
+            auto const t { segment->interpolate_arclength( distance ) };
+            tableerror = std::max(
+                tableerror,
+                std::abs( segment->RombergIntegral( 0.0, t ) - distance ) );
+            newtonerror = std::max(
+                newtonerror,
+                std::abs( t - segment->SolveTFromS( distance ) ) * segment->GetFirstDerivative( t ).Length() );
+        }
+        auto const accuracy { "conversion error up to " + to_string( tableerror, 6 ) + " m, " + to_string( newtonerror, 6 ) + " m from newton's method" };
+        WriteLog( "segment.arc_length_table (" + shape.name + ", " + to_string( length, 1 ) + " m): " + accuracy );
+        if( ( tableerror > tablebound )
+         || ( newtonerror > newtonbound ) ) {
+            m_failed = true;
+            ErrorLog( "Bad benchmark: arc length table for " + shape.name + " exceeds error bound (" + to_string( tablebound, 6 ) + " m, " + to_string( newtonbound, 6 ) + " m from newton's method), " + accuracy );
+        }
+        maxtableerror = std::max( maxtableerror, tableerror );
+        maxnewtonerror = std::max( maxnewtonerror, newtonerror );
+    }
+
+    auto const setup {
+        [&]() {
+            return make_segment( shapes.front() ); } };
+    auto const &subject { shapes.front().name };
+
+    measure(
+        "segment.get_t_from_s", subject, segmentqueries,
+        setup,
+        [&]( std::shared_ptr<TSegment> &Segment ) {
+            auto const length { Segment->GetLength() };
+            double sum { 0.0 }; // keeps the calls from being optimized away
+            auto const start { clock::now() };
+            for( std::size_t idx = 0; idx < segmentqueries; ++idx ) {
+                sum += Segment->GetTFromS( length * idx / segmentqueries );
+            }
+            auto const elapsed { clock::now() - start };
+            do_not_optimize( sum );
+            return elapsed; } )
+        .values = {
+            { "max_table_error_m", maxtableerror },
+            { "max_newton_difference_m", maxnewtonerror } };
+
+    measure(
+        "segment.romberg_integral", subject, segmentqueries,
+        setup,
+        [&]( std::shared_ptr<TSegment> &Segment ) {
+            double sum { 0.0 };
+            auto const start { clock::now() };
+            for( std::size_t idx = 0; idx < segmentqueries; ++idx ) {
+                sum += Segment->RombergIntegral( 0.0, static_cast<double>( idx ) / segmentqueries );
+            }
+            auto const elapsed { clock::now() - start };
+            do_not_optimize( sum );
+            return elapsed; } );
+}
+
+// text parser, cParser tokenising
+void
+benchmark_mode::run_parser() {
+
+    auto const scenario { make_scenario( parsernodes ) };
+    std::size_t tokencount { 0 };
+    {
+        cParser parser { scenario };
+        while( false == parser.getToken<std::string>().empty() ) {
+            ++tokencount;
+        }
+    }
+
+    measure(
+        "parser.tokenise", std::to_string( parsernodes ) + " track nodes, " + std::to_string( scenario.size() ) + " bytes", tokencount,
+        [&]() {
+            return std::make_unique<cParser>( scenario ); },
+        [&]( std::unique_ptr<cParser> &Parser ) {
+            std::string token;
+            auto const start { clock::now() };
+            do {
+                token = Parser->getToken<std::string>();
+            } while( false == token.empty() );
+            return clock::now() - start; } );
+}
+
+// scenario file with its includes, cParser compared with the stream-based tokeniser it replaced
+void
+benchmark_mode::run_parser_file( std::string const &File ) {
+
+    // both parsers have to see the same data, or the comparison is meaningless
+    std::size_t tokencount { 0 };
+    {
+        cParser parser { File, cParser::buffer_FILE, Global.asCurrentSceneryPath, Global.bLoadTraction };
+        if( false == parser.ok() ) {
+            WriteLog( "Scenario file \"" + File + "\" not found, scenario parser benchmark skipped" );
+            return;
+        }
+        while( false == parser.getToken<std::string>().empty() ) {
+            ++tokencount;
+        }
+    }
+    std::size_t referencecount { 0 };
+    {
+        stream_parser parser { File, Global.asCurrentSceneryPath };
+        while( false == parser.token().empty() ) {
+            ++referencecount;
+        }
+    }
+    if( referencecount != tokencount ) {
+        m_failed = true;
+        ErrorLog( "Bad benchmark: parser returned " + std::to_string( tokencount ) + " tokens from \"" + File + "\", reference tokeniser returned " + std::to_string( referencecount ) );
+    }
+
+    auto const subject { File + ", " + std::to_string( tokencount ) + " tokens" };
+
+    measure(
+        "parser.tokenise_file", subject, tokencount,
+        [&]() {
+            return std::make_unique<cParser>( File, cParser::buffer_FILE, Global.asCurrentSceneryPath, Global.bLoadTraction ); },
+        [&]( std::unique_ptr<cParser> &Parser ) {
+            std::string token;
+            auto const start { clock::now() };
+            do {
+                token = Parser->getToken<std::string>();
+            } while( false == token.empty() );
+            return clock::now() - start; } );
+
+    measure(
+        "parser.tokenise_file_stream", subject, referencecount,
+        [&]() {
+            return std::make_unique<stream_parser>( File, Global.asCurrentSceneryPath ); },
+        [&]( std::unique_ptr<stream_parser> &Parser ) {
+            std::string token;
+            auto const start { clock::now() };
+            do {
+                token = Parser->token();
+            } while( false == token.empty() );
+            return clock::now() - start; } );
+}
+
+// event queue, event_manager::AddToQuery() and event_manager::CheckQuery()
+void
+benchmark_mode::run_events( std::size_t const Count ) {
+
+    std::vector<basic_event *> events;
+    scene::scratch_data scratchpad;
+    for( std::size_t idx = 0; idx < Count; ++idx ) {
+        // names include the workload size, so events of each workload are separate
+        cParser input { "benchmark_" + std::to_string( Count ) + "_" + std::to_string( idx ) + " multiple 0.0 none endevent" };
+        auto *event { make_event( input, scratchpad ) };
+        event->deserialize( input, scratchpad );
+        if( false == simulation::Events.insert( event ) ) {
+            delete event;
+            continue;
+        }
+        event->init();
+        events.emplace_back( event );
+    }
+    // events are queued with pseudo-random delays, the same in every run
+    auto const delay {
+        []( std::size_t const Index ) {
+            return ( ( Index * 7919 ) % static_cast<std::size_t>( eventspread / eventstep ) ) * eventstep; } };
+    // runs the query until it's empty, so the next run starts with a clean slate
+    auto const drain {
+        []() {
+            Timer::StepTimers( eventspread * 2 );
+            simulation::Events.CheckQuery(); } };
+    auto const subject { std::to_string( events.size() ) + " events over " + to_string( eventspread, 0 ) + " s" };
+
+    measure(
+        "events.add_to_query", subject, events.size(),
+        [&]() {
+            drain();
+            return events.size(); },
+        [&]( std::size_t const & ) {
+            auto const start { clock::now() };
+            for( std::size_t idx = 0; idx < events.size(); ++idx ) {
+                simulation::Events.AddToQuery( events[ idx ], nullptr, delay( idx ) );
+            }
+            return clock::now() - start; } );
+
+    measure(
+        "events.check_query", subject, events.size(),
+        [&]() {
+            drain();
+            for( std::size_t idx = 0; idx < events.size(); ++idx ) {
+                simulation::Events.AddToQuery( events[ idx ], nullptr, delay( idx ) );
+            }
+            return events.size(); },
+        [&]( std::size_t const & ) {
+            clock::duration elapsed { 0 };
+            for( auto time = 0.0; time <= eventspread + eventstep; time += eventstep ) {
+                Timer::StepTimers( eventstep );
+                auto const start { clock::now() };
+                simulation::Events.CheckQuery();
+                elapsed += clock::now() - start;
+            }
+            return elapsed; } );
+
+    drain();
+}
+
+// sends collected results to the output file. returns: true on success
+bool
+benchmark_mode::report() const {
+
+    auto const escape {
+        []( std::string const &Text ) {
+            std::string output;
+            for( auto const c : Text ) {
+                if( ( c == '"' ) || ( c == '\\' ) ) { output += '\\'; }
+                output += c; }
+            return output; } };
+
+    std::ofstream output( Global.BenchmarkOutput, std::ios::trunc );
+    if( false == output.is_open() ) {
+        ErrorLog( "Bad file: failed to open benchmark output file \"" + Global.BenchmarkOutput + "\"" );
+        return false;
+    }
+
+    output
+        << "{\n"
+        << "  \"version\": \"" << escape( Global.asVersion ) << "\",\n"
+        << "  \"repetitions\": " << Global.BenchmarkRepetitions << ",\n"
+        << "  \"unit\": \"ns/op\",\n"
+        << "  \"benchmarks\": [";
+
+    auto first { true };
+    for( auto const &result : m_results ) {
+        auto samples { result.samples };
+        std::sort( std::begin( samples ), std::end( samples ) );
+        auto const mean { std::accumulate( std::begin( samples ), std::end( samples ), 0.0 ) / samples.size() };
+        auto variance { 0.0 };
+        for( auto const sample : samples ) {
+            variance += ( sample - mean ) * ( sample - mean );
+        }
+        variance /= samples.size();
+
+        output
+            << ( first ? "\n" : ",\n" )
+            << "    {\n"
+            << "      \"name\": \"" << escape( result.name ) << "\",\n"
+            << "      \"subject\": \"" << escape( result.subject ) << "\",\n"
+            << "      \"operations\": " << result.operations << ",\n"
+            << "      \"min\": " << to_string( samples.front(), 3 ) << ",\n"
+            << "      \"median\": " << to_string( samples[ samples.size() / 2 ], 3 ) << ",\n"
+            << "      \"mean\": " << to_string( mean, 3 ) << ",\n"
+            << "      \"stddev\": " << to_string( std::sqrt( variance ), 3 );
+        for( auto const &value : result.values ) {
+            output
+                << ",\n"
+                << "      \"" << escape( value.first ) << "\": " << to_string( value.second, 9 );
+        }
+        output
+            << "\n"
+            << "    }";
+        first = false;
+
+        WriteLog( result.name + " (" + result.subject + "): median " + to_string( samples[ samples.size() / 2 ], 3 ) + " ns/op" );
+    }
+    output << "\n  ]\n}\n";
+
+    WriteLog( "Benchmark results written to \"" + Global.BenchmarkOutput + "\"" );
+
+    return true;
+}
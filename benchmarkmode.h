@@ -0,0 +1,93 @@
+/*
+This Source Code Form is subject to the
+terms of the Mozilla Public License, v.
+2.0. If a copy of the MPL was not
+distributed with this file, You can
+obtain one at
+http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include "applicationmode.h"
+
+// runs fixed workloads through hot paths of the simulation, and writes their timings to a json file
+// each workload is prepared from scratch before every timed run, so the results are comparable between builds and machines
+class benchmark_mode : public application_mode {
+
+public:
+// methods
+    // initializes internal data structures of the mode. returns: true on success, false otherwise
+    bool
+        init() override;
+    // mode-specific update of simulation data. returns: false on error or when the run is complete, true otherwise
+    bool
+        update() override;
+    // maintenance method, called when the mode is activated
+    void
+        enter() override;
+    // maintenance method, called when the mode is deactivated
+    void
+        exit() override;
+    // input handlers
+    void
+        on_key( int const Key, int const Scancode, int const Action, int const Mods ) override { ; }
+    void
+        on_cursor_pos( double const Horizontal, double const Vertical ) override { ; }
+    void
+        on_mouse_button( int const Button, int const Action, int const Mods ) override { ; }
+    void
+        on_scroll( double const Xoffset, double const Yoffset ) override { ; }
+    void
+        on_event_poll() override { ; }
+    // returns: true if any of the benchmarks failed its correctness check, or the results couldn't be written
+    bool
+        failed() const override {
+            return m_failed; }
+
+private:
+// types
+    using clock = std::chrono::steady_clock;
+    // timings of single benchmark, in nanoseconds per operation
+    struct benchmark_result {
+        std::string name;
+        std::string subject; // data set used by the workload
+        std::size_t operations { 0 }; // number of operations in single timed run
+        std::vector<double> samples; // one per timed run
+        std::vector<std::pair<std::string, double>> values; // measured accuracy of the workload, written as separate fields
+    };
+// methods
+    // times specified workload. Setup_ prepares state for single run, Body_ performs the run on it and returns time spent on measured work
+    // returns: recorded result
+    template <typename Setup_, typename Body_>
+    benchmark_result &
+        measure( std::string const &Name, std::string const &Subject, std::size_t const Operations, Setup_ Setup, Body_ Body );
+    // vehicle physics, TMoverParameters::ComputeTotalForce() and TMoverParameters::ComputeMovement()
+    void
+        run_vehicle( std::string const &File );
+    // train brake pipe and brake cylinders of a consist, TMoverParameters::UpdatePipePressure() and TMoverParameters::UpdateBrakePressure(), with results of brake_pipe_solver checked against the sequential update
+    void
+        run_consist( std::string const &Locomotive, std::string const &Wagon );
+    // brake shoe friction, TFricMat::GetFC() and friction_table::GetFC()
+    void
+        run_friction();
+    // track geometry, TSegment::GetTFromS() and TSegment::RombergIntegral(), with accuracy of the arc length table checked against newton's method
+    void
+        run_segment();
+    // text parser, cParser tokenising
+    void
+        run_parser();
+    // scenario file with its includes, cParser compared with the stream-based tokeniser it replaced
+    void
+        run_parser_file( std::string const &File );
+    // event queue filled with specified number of events, event_manager::AddToQuery() and event_manager::CheckQuery()
+    void
+        run_events( std::size_t const Count );
+    // sends collected results to the output file. returns: true on success
+    bool
+        report() const;
+// members
+    bool m_complete { false };
+    bool m_failed { false };
+    std::vector<benchmark_result> m_results;
+};
@@ -9,6 +9,7 @@ http://mozilla.org/MPL/2.0/.
 
 #include "stdafx.h"
 #include "command.h"
+#include "commandrecording.h"
 
 #include "Globals.h"
 #include "Logs.h"
@@ -262,7 +263,19 @@ command_queue::push( command_data const &Command, std::size_t const Recipient )
 bool
 command_queue::pop( command_data &Command, std::size_t const Recipient ) {
 
+    auto const recorded { (
+        ( m_recording != nullptr )
+     && ( ( Recipient & static_cast<std::size_t>( command_target::vehicle ) ) != 0 ) ) };
+
     auto lookup = m_commands.find( Recipient );
+    if( ( true == recorded )
+     && ( true == m_recording->is_replaying() ) ) {
+        // vehicles receive what was recorded, live input is discarded
+        if( lookup != m_commands.end() ) {
+            lookup->second = commanddata_sequence();
+        }
+        return m_recording->next( m_step, Recipient, Command );
+    }
     if( lookup == m_commands.end() ) {
         // no command stack for this recipient, so no commands
         return false;
@@ -276,6 +289,10 @@ command_queue::pop( command_data &Command, std::size_t const Recipient ) {
     Command = commands.front();
     commands.pop();
 
+    if( true == recorded ) {
+        m_recording->add( m_step, Recipient, Command );
+    }
+
     return true;
 }
 
@@ -13,6 +13,8 @@ http://mozilla.org/MPL/2.0/.
 #include <queue>
 #include <unordered_set>
 
+class command_recording;
+
 enum class user_command {
 
     aidriverenable,
@@ -272,6 +274,14 @@ public:
     bool
         pop( command_data &Command, std::size_t const Recipient );
 	void update();
+    // attaches recording of commands retrieved by vehicles. when the recording is replayed, it replaces live input
+    void
+        attach( command_recording *Recording ) {
+            m_recording = Recording; }
+    // sets number of current simulation step, used to match retrieved commands with the recording
+    void
+        step( std::uint64_t const Step ) {
+            m_step = Step; }
 
 private:
 // types
@@ -283,6 +293,8 @@ private:
 	// TODO: this set should contain more than just user_command
 	// also, maybe that and all continuous input logic should be in command_relay?
 	std::unordered_set<user_command> m_active_continuous;
+    command_recording *m_recording { nullptr };
+    std::uint64_t m_step { 0 };
 };
 
 // NOTE: simulation should be a (light) wrapper rather than namespace so we could potentially instance it,
@@ -0,0 +1,137 @@
+/*
+This Source Code Form is subject to the
+terms of the Mozilla Public License, v.
+2.0. If a copy of the MPL was not
+distributed with this file, You can
+obtain one at
+http://mozilla.org/MPL/2.0/.
+*/
+
+#include "stdafx.h"
+#include "commandrecording.h"
+
+#include "Logs.h"
+#include "sn_utils.h"
+#include "utilities.h"
+
+namespace {
+
+std::uint32_t const recording_magic { MAKE_ID4( 'E', 'U', '7', 'R' ) };
+std::uint32_t const recording_version { 1 };
+
+void
+serialize( std::ostream &Output, SYSTEMTIME const &Time ) {
+
+    for( auto const item : { Time.wYear, Time.wMonth, Time.wDayOfWeek, Time.wDay, Time.wHour, Time.wMinute, Time.wSecond, Time.wMilliseconds } ) {
+        sn_utils::ls_uint16( Output, item );
+    }
+}
+
+void
+deserialize( std::istream &Input, SYSTEMTIME &Time ) {
+
+    for( auto *item : { &Time.wYear, &Time.wMonth, &Time.wDayOfWeek, &Time.wDay, &Time.wHour, &Time.wMinute, &Time.wSecond, &Time.wMilliseconds } ) {
+        *item = sn_utils::ld_uint16( Input );
+    }
+}
+
+} // namespace
+
+// starts new recording in specified file. returns: true on success
+bool
+command_recording::record( std::string const &File, run_setup const &Setup ) {
+
+    m_output.open( File, std::ios::binary | std::ios::trunc );
+    if( false == m_output.is_open() ) {
+        ErrorLog( "Bad file: failed to create command recording \"" + File + "\"" );
+        return false;
+    }
+    m_setup = Setup;
+
+    sn_utils::ls_uint32( m_output, recording_magic );
+    sn_utils::ls_uint32( m_output, recording_version );
+    sn_utils::s_str( m_output, m_setup.scenario );
+    sn_utils::ls_uint32( m_output, m_setup.seed );
+    sn_utils::ls_float64( m_output, m_setup.timestep );
+    serialize( m_output, m_setup.time );
+    sn_utils::ls_float32( m_output, m_setup.timeoffset );
+
+    WriteLog( "Recording vehicle commands to \"" + File + "\"" );
+    return true;
+}
+
+// loads recording from specified file, for replay. returns: true on success
+bool
+command_recording::replay( std::string const &File ) {
+
+    std::ifstream input( File, std::ios::binary );
+    if( ( false == input.is_open() )
+     || ( sn_utils::ld_uint32( input ) != recording_magic )
+     || ( sn_utils::ld_uint32( input ) != recording_version ) ) {
+        ErrorLog( "Bad file: failed to read command recording \"" + File + "\"" );
+        return false;
+    }
+    m_setup.scenario = sn_utils::d_str( input );
+    m_setup.seed = sn_utils::ld_uint32( input );
+    m_setup.timestep = sn_utils::ld_float64( input );
+    deserialize( input, m_setup.time );
+    m_setup.timeoffset = sn_utils::ld_float32( input );
+
+    m_commands.clear();
+    // the recording is written as the run goes, so it ends wherever the run did
+    while( input.peek() != std::char_traits<char>::eof() ) {
+        recorded_command command;
+        command.step = sn_utils::ld_uint64( input );
+        command.recipient = sn_utils::ld_uint64( input );
+        command.data.command = static_cast<user_command>( sn_utils::ld_uint32( input ) );
+        command.data.action = sn_utils::ld_int32( input );
+        command.data.param1 = sn_utils::ld_float64( input );
+        command.data.param2 = sn_utils::ld_float64( input );
+        command.data.time_delta = sn_utils::ld_float64( input );
+        if( false == input.good() ) {
+            // incomplete last entry, e.g. from a run which crashed
+            break;
+        }
+        m_commands.emplace_back( command );
+    }
+    m_replaying = true;
+
+    WriteLog( "Replaying " + std::to_string( m_commands.size() ) + " vehicle commands from \"" + File + "\"" );
+    return true;
+}
+
+// adds command received by specified recipient in specified step to the recording
+void
+command_recording::add( std::uint64_t const Step, std::size_t const Recipient, command_data const &Command ) {
+
+    if( false == m_output.is_open() ) { return; }
+
+    sn_utils::ls_uint64( m_output, Step );
+    sn_utils::ls_uint64( m_output, Recipient );
+    sn_utils::ls_uint32( m_output, static_cast<std::uint32_t>( Command.command ) );
+    sn_utils::ls_int32( m_output, Command.action );
+    sn_utils::ls_float64( m_output, Command.param1 );
+    sn_utils::ls_float64( m_output, Command.param2 );
+    sn_utils::ls_float64( m_output, Command.time_delta );
+}
+
+// retrieves next command recorded for specified recipient in specified step. returns: true on retrieval, false if there's nothing to retrieve
+bool
+command_recording::next( std::uint64_t const Step, std::size_t const Recipient, command_data &Command ) {
+
+    while( ( false == m_commands.empty() )
+        && ( m_commands.front().step < Step ) ) {
+        // nobody picked the command up in its step, so the replay already went different way than the recorded run
+        ErrorLog( "Replay mismatch: command recorded in step " + std::to_string( m_commands.front().step ) + " wasn't retrieved" );
+        m_commands.pop_front();
+    }
+    if( ( true == m_commands.empty() )
+     || ( m_commands.front().step > Step )
+     || ( m_commands.front().recipient != Recipient ) ) {
+        return false;
+    }
+    Command = m_commands.front().data;
+    m_commands.pop_front();
+
+    return true;
+}
@@ -0,0 +1,73 @@
+/*
+This Source Code Form is subject to the
+terms of the Mozilla Public License, v.
+2.0. If a copy of the MPL was not
+distributed with this file, You can
+obtain one at
+http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <string>
+
+#include "command.h"
+#include "winheaders.h"
+
+// vehicle control commands received by the simulation during lockstep run, with numbers of simulation steps they were received in
+// along with the random seed and start time of the run, it's enough to repeat the run exactly
+class command_recording {
+
+public:
+// types
+    // conditions of the run, which have to match for the replay to give the same results
+    struct run_setup {
+        std::string scenario;
+        std::uint32_t seed { 0 };
+        double timestep { 0.0 };
+        SYSTEMTIME time {}; // scenario clock at the start of the run
+        float timeoffset { 0.f }; // time shift applied to train timetables
+    };
+// methods
+    // starts new recording in specified file. returns: true on success
+    bool
+        record( std::string const &File, run_setup const &Setup );
+    // loads recording from specified file, for replay. returns: true on success
+    bool
+        replay( std::string const &File );
+    bool
+        is_recording() const {
+            return m_output.is_open(); }
+    bool
+        is_replaying() const {
+            return m_replaying; }
+    run_setup const &
+        setup() const {
+            return m_setup; }
+    // adds command received by specified recipient in specified step to the recording
+    void
+        add( std::uint64_t const Step, std::size_t const Recipient, command_data const &Command );
+    // retrieves next command recorded for specified recipient in specified step. returns: true on retrieval, false if there's nothing to retrieve
+    bool
+        next( std::uint64_t const Step, std::size_t const Recipient, command_data &Command );
+    // returns: true if all recorded commands were retrieved
+    bool
+        empty() const {
+            return m_commands.empty(); }
+
+private:
+// types
+    struct recorded_command {
+        std::uint64_t step;
+        std::size_t recipient;
+        command_data data;
+    };
+// members
+    run_setup m_setup;
+    std::ofstream m_output;
+    bool m_replaying { false };
+    std::deque<recorded_command> m_commands;
+};
@@ -90,6 +90,25 @@ driver_mode::driver_mode() {
 bool
 driver_mode::init() {
 
+    if( false == Global.CommandReplayFile.empty() ) {
+        // replay has to repeat conditions of the recorded run, so they're set up before the scenario is loaded
+        if( true == m_recording.replay( Global.CommandReplayFile ) ) {
+            auto const &setup { m_recording.setup() };
+            if( setup.scenario != Global.SceneryFile ) {
+                ErrorLog( "Replay mismatch: recording was made in scenario \"" + setup.scenario + "\"" );
+            }
+            if( setup.timestep != m_primaryupdaterate ) {
+                ErrorLog( "Replay mismatch: recording was made with time step of " + to_string( setup.timestep, 4 ) + " sec" );
+            }
+            Global.Lockstep = true;
+            Global.RandomSeed = setup.seed;
+            // scenario clock is restored on entering the mode, timetables are shifted by the recorded offset
+            Global.ScenarioTimeCurrent = false;
+            Global.ScenarioTimeOverride = std::numeric_limits<float>::quiet_NaN();
+            Global.ScenarioTimeOffset = setup.timeoffset;
+        }
+    }
+
     return m_input.init();
 }
 
@@ -97,9 +116,75 @@ driver_mode::init() {
 bool
 driver_mode::update() {
 
-    Timer::UpdateTimers(Global.iPause != 0);
     Timer::subsystem.sim_total.start();
 
+    auto const accelerated { Global.fTimeSpeed > 1.0 };
+
+    if( true == Global.Lockstep ) {
+        update_lockstep();
+    }
+    else if( true == accelerated ) {
+        update_accelerated();
+    }
+    else {
+        update_realtime();
+    }
+    simulation::Lights.update();
+
+    // render time routines follow:
+
+    auto const deltarealtime = Timer::GetDeltaRenderTime(); // nie uwzględnia pauzowania ani mnożenia czasu
+
+    // fixed step render time routines
+
+    fTime50Hz += deltarealtime; // w pauzie też trzeba zliczać czas, bo przy dużym FPS będzie problem z odczytem ramek
+    while( fTime50Hz >= 1.0 / 50.0 ) {
+#ifdef _WIN32
+        Console::Update(); // to i tak trzeba wywoływać
+#endif
+        ui::Transcripts.Update(); // obiekt obsługujący stenogramy dźwięków na ekranie
+        m_userinterface->update();
+        // decelerate camera
+        Camera.Velocity *= 0.65;
+        if( std::abs( Camera.Velocity.x ) < 0.01 ) { Camera.Velocity.x = 0.0; }
+        if( std::abs( Camera.Velocity.y ) < 0.01 ) { Camera.Velocity.y = 0.0; }
+        if( std::abs( Camera.Velocity.z ) < 0.01 ) { Camera.Velocity.z = 0.0; }
+        // decelerate debug camera too
+        DebugCamera.Velocity *= 0.65;
+        if( std::abs( DebugCamera.Velocity.x ) < 0.01 ) { DebugCamera.Velocity.x = 0.0; }
+        if( std::abs( DebugCamera.Velocity.y ) < 0.01 ) { DebugCamera.Velocity.y = 0.0; }
+        if( std::abs( DebugCamera.Velocity.z ) < 0.01 ) { DebugCamera.Velocity.z = 0.0; }
+
+        fTime50Hz -= 1.0 / 50.0;
+    }
+
+    // variable step render time routines
+
+    update_camera( deltarealtime );
+
+    simulation::Environment.update_precipitation(); // has to be launched after camera step to work properly
+
+    Timer::subsystem.sim_total.stop();
+
+    if( false == accelerated ) {
+        simulation::Region->update_sounds();
+    }
+    // sounds of accelerated simulation would be a garbled mess, so audio is suspended like during pause
+    audio::renderer.update( ( Global.iPause || accelerated ) ? 0.0 : deltarealtime );
+
+    GfxRenderer.Update( deltarealtime );
+
+    simulation::is_ready = true;
+
+    return true;
+}
+
+// advances simulation by the time elapsed since the previous frame, spread over steps of variable length
+void
+driver_mode::update_realtime() {
+
+    Timer::UpdateTimers(Global.iPause != 0);
+
     double const deltatime = Timer::GetDeltaTime(); // 0.0 gdy pauza
 
     if( Global.iPause == 0 ) {
@@ -111,7 +196,6 @@ driver_mode::update() {
 
     // fixed step, simulation time based updates
 //  m_primaryupdateaccumulator += dt; // unused for the time being
-    m_secondaryupdateaccumulator += deltatime;
 /*
     // NOTE: until we have no physics state interpolation during render, we need to rely on the old code,
     // as doing fixed step calculations but flexible step render results in ugly mini jitter
@@ -162,24 +246,38 @@ driver_mode::update() {
     Timer::subsystem.sim_dynamics.stop();
 
     // secondary fixed step simulation time routines
-    while( m_secondaryupdateaccumulator >= m_secondaryupdaterate ) {
+    update_secondary( deltatime );
 
-        // awaria PoKeys mogła włączyć pauzę - przekazać informację
-        if( Global.iMultiplayer ) // dajemy znać do serwera o wykonaniu
-            if( iPause != Global.iPause ) { // przesłanie informacji o pauzie do programu nadzorującego
-                multiplayer::WyslijParam( 5, 3 ); // ramka 5 z czasem i stanem zapauzowania
-                iPause = Global.iPause;
-            }
+    // variable step simulation time routines
 
-        // TODO: generic shake update pass for vehicles within view range
-        if( Camera.m_owner != nullptr ) {
-            Camera.m_owner->update_shake( m_secondaryupdaterate );
-        }
+    if( ( simulation::Train == nullptr ) && ( false == FreeFlyModeFlag ) ) {
+        // intercept cases when the driven train got removed after entering portal
+        InOutKey();
+    }
 
-        m_secondaryupdateaccumulator -= m_secondaryupdaterate; // these should be inexpensive enough we have no cap
+    if( Global.changeDynObj ) {
+        // ABu zmiana pojazdu - przejście do innego
+        ChangeDynamic();
     }
 
-    // variable step simulation time routines
+    if( simulation::Train != nullptr ) {
+        TSubModel::iInstance = reinterpret_cast<std::uintptr_t>( simulation::Train->Dynamic() );
+        simulation::Train->Update( deltatime );
+    }
+    else {
+        TSubModel::iInstance = 0;
+    }
+
+    simulation::Events.update();
+    simulation::Region->update_events();
+}
+
+// advances simulation in fixed steps independent of frame time, so runs with the same input give the same results
+// the steps are taken as the real time allows, and the simulation falls behind if they can't be completed in time
+void
+driver_mode::update_lockstep() {
+
+    m_primaryupdateaccumulator += Timer::UpdateRenderTimers( Global.iPause != 0 );
 
     if( ( simulation::Train == nullptr ) && ( false == FreeFlyModeFlag ) ) {
         // intercept cases when the driven train got removed after entering portal
@@ -191,61 +289,147 @@ driver_mode::update() {
         ChangeDynamic();
     }
 
+    // accelerated time gets proportionally more steps per frame
+    auto const stepcountlimit { static_cast<int>( 20 * std::max( 1.0, Global.fTimeSpeed ) ) };
+    auto stepcount { 0 };
+    while( m_primaryupdateaccumulator >= m_primaryupdaterate ) {
+        if( stepcount == stepcountlimit ) {
+            // limited number of steps per frame, to keep physics from hogging up all run time
+            m_primaryupdateaccumulator = 0.0;
+            break;
+        }
+        step_lockstep( m_primaryupdaterate );
+        m_primaryupdateaccumulator -= m_primaryupdaterate;
+        ++stepcount;
+    }
+}
+
+// performs single fixed step of lockstep simulation
+void
+driver_mode::step_lockstep( double const Deltatime ) {
+
+    // vehicle commands retrieved during the step are matched with the recording by the step number
+    simulation::Commands.step( m_lockstepcount );
+
+    Timer::StepTimers( Deltatime );
+    simulation::Time.update( Deltatime );
+    simulation::State.update_clocks();
+    simulation::Environment.update();
+
+    Timer::subsystem.sim_dynamics.start();
+    simulation::State.update( Deltatime, 1 );
+    Timer::subsystem.sim_dynamics.stop();
+
+    update_secondary( Deltatime );
+
     if( simulation::Train != nullptr ) {
         TSubModel::iInstance = reinterpret_cast<std::uintptr_t>( simulation::Train->Dynamic() );
-        simulation::Train->Update( deltatime );
+        simulation::Train->Update( Deltatime );
     }
     else {
         TSubModel::iInstance = 0;
     }
 
     simulation::Events.update();
-    simulation::Region->update_events();
-    simulation::Lights.update();
+    update_launchers();
 
-    // render time routines follow:
+    ++m_lockstepcount;
+}
 
-    auto const deltarealtime = Timer::GetDeltaRenderTime(); // nie uwzględnia pauzowania ani mnożenia czasu
+// advances simulation at accelerated rate, in slices of regular frame length, so AI and events keep their usual reaction time
+// the slices are taken until the real time budget of the frame runs out, the rest of the simulation time is skipped
+void
+driver_mode::update_accelerated() {
 
-    // fixed step render time routines
+    auto deltatime { Timer::UpdateRenderTimers( Global.iPause != 0 ) };
 
-    fTime50Hz += deltarealtime; // w pauzie też trzeba zliczać czas, bo przy dużym FPS będzie problem z odczytem ramek
-    while( fTime50Hz >= 1.0 / 50.0 ) {
-#ifdef _WIN32
-        Console::Update(); // to i tak trzeba wywoływać
-#endif
-        ui::Transcripts.Update(); // obiekt obsługujący stenogramy dźwięków na ekranie
-        m_userinterface->update();
-        // decelerate camera
-        Camera.Velocity *= 0.65;
-        if( std::abs( Camera.Velocity.x ) < 0.01 ) { Camera.Velocity.x = 0.0; }
-        if( std::abs( Camera.Velocity.y ) < 0.01 ) { Camera.Velocity.y = 0.0; }
-        if( std::abs( Camera.Velocity.z ) < 0.01 ) { Camera.Velocity.z = 0.0; }
-        // decelerate debug camera too
-        DebugCamera.Velocity *= 0.65;
-        if( std::abs( DebugCamera.Velocity.x ) < 0.01 ) { DebugCamera.Velocity.x = 0.0; }
-        if( std::abs( DebugCamera.Velocity.y ) < 0.01 ) { DebugCamera.Velocity.y = 0.0; }
-        if( std::abs( DebugCamera.Velocity.z ) < 0.01 ) { DebugCamera.Velocity.z = 0.0; }
+    if( ( simulation::Train == nullptr ) && ( false == FreeFlyModeFlag ) ) {
+        // intercept cases when the driven train got removed after entering portal
+        InOutKey();
+    }
 
-        fTime50Hz -= 1.0 / 50.0;
+    if( Global.changeDynObj ) {
+        // ABu zmiana pojazdu - przejście do innego
+        ChangeDynamic();
     }
 
-    // variable step render time routines
+    auto const framestart { std::chrono::steady_clock::now() };
+    while( deltatime > 0.0 ) {
+        auto const slicedeltatime { std::min( deltatime, m_acceleratedslice ) };
+        step_accelerated( slicedeltatime );
+        deltatime -= slicedeltatime;
+        if( std::chrono::duration<double>( std::chrono::steady_clock::now() - framestart ).count() > m_acceleratedbudget ) {
+            // simulation can't keep up with requested rate. slow it down rather than let the application become unresponsive
+            break;
+        }
+    }
+}
 
-    update_camera( deltarealtime );
+// performs single slice of accelerated simulation
+void
+driver_mode::step_accelerated( double const Deltatime ) {
 
-    simulation::Environment.update_precipitation(); // has to be launched after camera step to work properly
+    Timer::StepTimers( Deltatime );
+    simulation::Time.update( Deltatime );
+    simulation::State.update_clocks();
+    simulation::Environment.update();
 
-    Timer::subsystem.sim_total.stop();
+    // NOTE: slices are short enough to never need the chunked update of full physics mode
+    auto const updatecount { std::max( 1, static_cast<int>( std::ceil( Deltatime / m_primaryupdaterate ) ) ) };
+    Timer::subsystem.sim_dynamics.start();
+    simulation::State.update( Deltatime / updatecount, updatecount );
+    Timer::subsystem.sim_dynamics.stop();
 
-    simulation::Region->update_sounds();
-    audio::renderer.update( Global.iPause ? 0.0 : deltarealtime );
+    update_secondary( Deltatime );
 
-    GfxRenderer.Update( deltarealtime );
+    if( simulation::Train != nullptr ) {
+        TSubModel::iInstance = reinterpret_cast<std::uintptr_t>( simulation::Train->Dynamic() );
+        simulation::Train->Update( Deltatime );
+    }
+    else {
+        TSubModel::iInstance = 0;
+    }
 
-    simulation::is_ready = true;
+    simulation::Events.update();
+    update_launchers();
+}
 
-    return true;
+// activates event launchers near vehicles with a driver
+// camera follows the frame time, so it's no good for modes which perform several simulation updates per frame
+void
+driver_mode::update_launchers() {
+
+    m_launcherlocations.clear();
+    for( auto *vehicle : simulation::Vehicles.sequence() ) {
+        if( vehicle->Mechanik != nullptr ) {
+            auto const location { vehicle->GetPosition() };
+            m_launcherlocations.emplace_back( location.x, location.y, location.z );
+        }
+    }
+    simulation::Region->update_events( m_launcherlocations );
+}
+
+// runs fixed step routines of secondary importance, for specified simulation time
+void
+driver_mode::update_secondary( double const Deltatime ) {
+
+    m_secondaryupdateaccumulator += Deltatime;
+    while( m_secondaryupdateaccumulator >= m_secondaryupdaterate ) {
+
+        // awaria PoKeys mogła włączyć pauzę - przekazać informację
+        if( Global.iMultiplayer ) // dajemy znać do serwera o wykonaniu
+            if( iPause != Global.iPause ) { // przesłanie informacji o pauzie do programu nadzorującego
+                multiplayer::WyslijParam( 5, 3 ); // ramka 5 z czasem i stanem zapauzowania
+                iPause = Global.iPause;
+            }
+
+        // TODO: generic shake update pass for vehicles within view range
+        if( Camera.m_owner != nullptr ) {
+            Camera.m_owner->update_shake( m_secondaryupdaterate );
+        }
+
+        m_secondaryupdateaccumulator -= m_secondaryupdaterate; // these should be inexpensive enough we have no cap
+    }
 }
 
 // maintenance method, called when the mode is activated
@@ -313,6 +497,22 @@ driver_mode::enter() {
 
     Timer::ResetTimers();
 
+    if( ( true == Global.Lockstep )
+     && ( false == m_recording.is_recording() )
+     && ( m_lockstepcount == 0 ) ) {
+        if( true == m_recording.is_replaying() ) {
+            simulation::Time.init( m_recording.setup().time );
+            simulation::Commands.attach( &m_recording );
+        }
+        else if( false == Global.CommandRecordFile.empty() ) {
+            if( true == m_recording.record(
+                Global.CommandRecordFile,
+                { Global.SceneryFile, Global.RandomSeed, m_primaryupdaterate, simulation::Time.data(), Global.ScenarioTimeOffset } ) ) {
+                simulation::Commands.attach( &m_recording );
+            }
+        }
+    }
+
     set_picking( Global.ControlPicking );
 }
 
@@ -743,7 +943,7 @@ driver_mode::OnKeyDown(int cKey) {
             // przyspieszenie symulacji do testowania scenerii... uwaga na FPS!
             if( DebugModeFlag ) { 
 
-                if( Global.ctrlState ) { Global.fTimeSpeed = ( Global.shiftState ? 60.0 : 20.0 ); }
+                if( Global.ctrlState ) { Global.fTimeSpeed = ( Global.shiftState ? 50.0 : 20.0 ); }
                 else                   { Global.fTimeSpeed = ( Global.shiftState ? 5.0 : 1.0 ); }
             }
             break;
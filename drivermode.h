@@ -18,6 +18,7 @@ http://mozilla.org/MPL/2.0/.
 #include "Console.h"
 #include "Camera.h"
 #include "Classes.h"
+#include "commandrecording.h"
 
 class driver_mode : public application_mode {
 
@@ -83,6 +84,27 @@ private:
     };
 
 // methods
+    // advances simulation by the time elapsed since the previous frame, spread over steps of variable length
+    void
+        update_realtime();
+    // advances simulation in fixed steps independent of frame time, so runs with the same input give the same results
+    void
+        update_lockstep();
+    // performs single fixed step of lockstep simulation
+    void
+        step_lockstep( double const Deltatime );
+    // advances simulation at accelerated rate, in slices of regular frame length
+    void
+        update_accelerated();
+    // performs single slice of accelerated simulation
+    void
+        step_accelerated( double const Deltatime );
+    // activates event launchers near vehicles with a driver
+    void
+        update_launchers();
+    // runs fixed step routines of secondary importance, for specified simulation time
+    void
+        update_secondary( double const Deltatime );
     void update_camera( const double Deltatime );
     // handles vehicle change flag
     void OnKeyDown( int cKey );
@@ -107,5 +129,10 @@ private:
     double const m_secondaryupdaterate { 1.0 / 50.0 };
     double m_primaryupdateaccumulator { m_secondaryupdaterate }; // keeps track of elapsed simulation time, for core fixed step routines
     double m_secondaryupdateaccumulator { m_secondaryupdaterate }; // keeps track of elapsed simulation time, for less important fixed step routines
+    double const m_acceleratedslice { 1.0 / 20.0 }; // simulation time advanced at once in accelerated mode, comparable with regular frame
+    double const m_acceleratedbudget { 1.0 / 10.0 }; // real time (in seconds) accelerated simulation can take in a single frame
     int iPause { 0 }; // wykrywanie zmian w zapauzowaniu
+    command_recording m_recording; // vehicle commands received during lockstep run, or replayed from earlier run
+    std::uint64_t m_lockstepcount { 0 }; // number of fixed steps performed in lockstep mode
+    std::vector<glm::dvec3> m_launcherlocations; // positions activating event launchers in lockstep mode
 };
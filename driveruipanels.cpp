@@ -564,6 +564,15 @@ debug_panel::update_section_vehicle( std::vector<text_line> &Output ) {
 
     Output.emplace_back( m_buffer.data(), Global.UITextColor );
 
+    if( true == Global.AdaptiveStep ) {
+        auto const &substep { vehicle.substep() };
+        Output.emplace_back(
+            "Physics step: " + to_string( substep.step * 1000.0, 2 ) + " msec"
+            + ", error: " + to_string( substep.error, 2 )
+            + ", stiffness: " + to_string( substep.rate * substep.step, 2 ),
+            Global.UITextColor );
+    }
+
 }
 
 std::string
@@ -800,6 +809,20 @@ debug_panel::update_section_scenario( std::vector<text_line> &Output ) {
     auto textline =
         "vehicles: " + to_string( Timer::subsystem.sim_dynamics.average(), 2 ) + " msec"
         + " update total: " + to_string( Timer::subsystem.sim_total.average(), 2 ) + " msec";
+    textline +=
+        "\nVehicles active: " + std::to_string( simulation::Vehicles.active_count() )
+        + ", dormant: " + std::to_string( simulation::Vehicles.dormant_count() )
+        + ", reduced: " + std::to_string( simulation::Vehicles.reduced_count() )
+        + " (total: " + std::to_string( simulation::Vehicles.sequence().size() ) + ")";
+    if( true == Global.AdaptiveStep ) {
+        auto const &substeps { simulation::Vehicles.substeps() };
+        textline +=
+            "\nPhysics steps: " + std::to_string( substeps.steps ) + " (fixed: " + std::to_string( substeps.fixed_steps ) + ")"
+            + ", consists refined: " + std::to_string( substeps.refined )
+            + ", coarsened: " + std::to_string( substeps.coarsened )
+            + ", error: " + to_string( substeps.error, 2 )
+            + ", stiffness: " + to_string( substeps.stiffness, 2 );
+    }
 
     Output.emplace_back( textline, Global.UITextColor );
     // current luminance level
@@ -818,27 +841,26 @@ debug_panel::update_section_eventqueue( std::vector<text_line> &Output ) {
 
     // current event queue
     auto const time { Timer::GetTime() };
-    auto const *event { simulation::Events.begin() };
+    auto const events {
+        simulation::Events.queued(
+            29,
+            [&]( basic_event const *Event ) {
+                return ( ( false == Event->m_ignored )
+                      && ( false == Event->m_passive )
+                      && ( ( false == m_eventqueueactivevehicleonly )
+                        || ( Event->m_activator == m_input.vehicle ) ) ); } ) };
 
     Output.emplace_back( "Delay:   Event:", Global.UITextColor );
 
-    while( ( event != nullptr )
-        && ( Output.size() < 30 ) ) {
+    for( auto const *event : events ) {
 
-        if( ( false == event->m_ignored )
-         && ( false == event->m_passive )
-         && ( ( false == m_eventqueueactivevehicleonly )
-           || ( event->m_activator == m_input.vehicle ) ) ) {
+        auto const delay { "   " + to_string( std::max( 0.0, event->m_launchtime - time ), 1 ) };
+        textline = delay.substr( delay.length() - 6 )
+            + "   " + event->m_name
+            + ( event->m_activator ? " (by: " + event->m_activator->asName + ")" : "" )
+            + ( event->m_sibling ? " (joint event)" : "" );
 
-            auto const delay { "   " + to_string( std::max( 0.0, event->m_launchtime - time ), 1 ) };
-            textline = delay.substr( delay.length() - 6 )
-                + "   " + event->m_name
-                + ( event->m_activator ? " (by: " + event->m_activator->asName + ")" : "" )
-                + ( event->m_sibling ? " (joint event)" : "" );
-
-            Output.emplace_back( textline, Global.UITextColor );
-        }
-        event = event->m_next;
+        Output.emplace_back( textline, Global.UITextColor );
     }
     if( Output.size() == 1 ) {
         Output.front().data = "(no queued events)";
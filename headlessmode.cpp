@@ -0,0 +1,213 @@
+/*
+This Source Code Form is subject to the
+terms of the Mozilla Public License, v.
+2.0. If a copy of the MPL was not
+distributed with this file, You can
+obtain one at
+http://mozilla.org/MPL/2.0/.
+*/
+
+#include "stdafx.h"
+#include "headlessmode.h"
+
+#include "Globals.h"
+#include "simulation.h"
+#include "simulationtime.h"
+#include "simulationenvironment.h"
+#include "Event.h"
+#include "DynObj.h"
+#include "lightarray.h"
+#include "Timer.h"
+#include "Logs.h"
+
+namespace {
+
+double const primaryupdaterate { 1.0 / 100.0 }; // matches physics step of the driver mode
+
+double
+seconds( std::chrono::steady_clock::duration const Duration ) {
+
+    return std::chrono::duration_cast<std::chrono::duration<double>>( Duration ).count();
+}
+
+} // namespace
+
+// initializes internal data structures of the mode. returns: true on success, false otherwise
+bool
+headless_mode::init() {
+    // nothing to do here
+    return true;
+}
+
+// mode-specific update of simulation data. returns: false on error or when the run is complete, true otherwise
+bool
+headless_mode::update() {
+
+    if( false == m_loaded ) {
+        if( false == load() ) {
+            m_failed = true;
+            return false;
+        }
+        m_loaded = true;
+        return true;
+    }
+
+    if( m_simulationtime >= Global.HeadlessDuration ) {
+        report();
+        return false;
+    }
+
+    auto const deltatime { std::min( Global.HeadlessTimestep, Global.HeadlessDuration - m_simulationtime ) };
+    auto const timestart { clock::now() };
+    step( deltatime );
+    m_counters.total += seconds( clock::now() - timestart );
+    ++m_counters.steps;
+    m_simulationtime += deltatime;
+
+    return true;
+}
+
+// maintenance method, called when the mode is activated
+void
+headless_mode::enter() {
+
+    simulation::is_ready = false;
+    m_loaded = false;
+    m_failed = false;
+    m_simulationtime = 0.0;
+    m_counters = performance_counters();
+}
+
+// maintenance method, called when the mode is deactivated
+void
+headless_mode::exit() {
+    // nothing to do here
+}
+
+// loads the scenario. returns: true on success
+bool
+headless_mode::load() {
+
+    WriteLog( "\nLoading scenario \"" + Global.SceneryFile + "\" for unattended run..." );
+
+    auto const timestart { clock::now() };
+    if( false == simulation::State.deserialize( Global.SceneryFile ) ) {
+        ErrorLog( "Bad init: scenario loading failed" );
+        return false;
+    }
+    m_loadtime = seconds( clock::now() - timestart );
+    WriteLog( "Scenario loading time: " + to_string( m_loadtime, 2 ) + " seconds" );
+
+    simulation::Time.init();
+    simulation::Environment.init();
+    Timer::ResetTimers();
+    simulation::is_ready = true;
+
+    return true;
+}
+
+// performs single simulation step of specified length
+void
+headless_mode::step( double const Deltatime ) {
+
+    Timer::StepTimers( Deltatime );
+
+    simulation::Time.update( Deltatime );
+    simulation::State.update_clocks();
+    simulation::Environment.update();
+
+    // physics, split into the same slices as in the driver mode
+    auto const dynamicsstart { clock::now() };
+    auto updatecount { std::max( 1, static_cast<int>( std::ceil( Deltatime / primaryupdaterate ) ) ) };
+    auto const stepdeltatime { Deltatime / updatecount };
+    auto const update_state {
+        [&]( int const Iterationcount ) {
+            simulation::State.update( stepdeltatime, Iterationcount );
+            m_counters.physics_steps += simulation::Vehicles.substeps().steps;
+            m_counters.fixed_physics_steps += simulation::Vehicles.substeps().fixed_steps; } };
+    if( true == Global.FullPhysics ) {
+        while( updatecount >= 5 ) {
+            update_state( 5 );
+            updatecount -= 5;
+        }
+        if( updatecount ) {
+            update_state( updatecount );
+        }
+    }
+    else {
+        update_state( updatecount );
+    }
+    m_counters.dynamics += seconds( clock::now() - dynamicsstart );
+
+    auto const eventsstart { clock::now() };
+    simulation::Events.update();
+    m_counters.events += seconds( clock::now() - eventsstart );
+
+    // without camera, event launchers are activated by all vehicles with a driver
+    auto const launchersstart { clock::now() };
+    m_launcherlocations.clear();
+    for( auto *vehicle : simulation::Vehicles.sequence() ) {
+        if( vehicle->Mechanik != nullptr ) {
+            auto const location { vehicle->GetPosition() };
+            m_launcherlocations.emplace_back( location.x, location.y, location.z );
+        }
+    }
+    simulation::Region->update_events( m_launcherlocations );
+    m_counters.launchers += seconds( clock::now() - launchersstart );
+
+    simulation::Lights.update();
+}
+
+// sends collected performance counters to the log and the standard output
+void
+headless_mode::report() const {
+
+    auto const steps { std::max<std::size_t>( 1, m_counters.steps ) };
+    auto const milliseconds {
+        [&]( double const Seconds ) {
+            return to_string( 1000.0 * Seconds / steps, 3 ) + " ms"; } };
+
+    // memory used by vehicle physics data, with tables of vehicle types shared, and as if each vehicle had its own copy
+    auto const &vehicles { simulation::Vehicles.sequence() };
+    std::unordered_set<TMoverTables const *> types;
+    std::size_t sharedsize { 0 };
+    std::size_t unsharedsize { 0 };
+    for( auto const *vehicle : vehicles ) {
+        auto const *tables { vehicle->MoverParameters->Tables.get() };
+        unsharedsize += sizeof( TMoverParameters ) + tables->Size();
+        if( true == types.insert( tables ).second ) {
+            sharedsize += tables->Size();
+        }
+    }
+    sharedsize += vehicles.size() * sizeof( TMoverParameters );
+    auto const pervehicle {
+        [&]( std::size_t const Bytes ) {
+            return std::to_string( Bytes / std::max<std::size_t>( 1, vehicles.size() ) ) + " bytes"; } };
+
+    std::vector<std::string> lines {
+        "Unattended run of \"" + Global.SceneryFile + "\" complete",
+        "Scenario loading time: " + to_string( m_loadtime, 2 ) + " s",
+        "Simulated time: " + to_string( m_simulationtime, 2 ) + " s in " + std::to_string( m_counters.steps ) + " steps of " + to_string( Global.HeadlessTimestep, 3 ) + " s",
+        "Wall time: " + to_string( m_counters.total, 2 ) + " s, "
+            + to_string( m_counters.total > 0.0 ? m_simulationtime / m_counters.total : 0.0, 1 ) + "x real time",
+        "Average per step: total " + milliseconds( m_counters.total )
+            + ", dynamics " + milliseconds( m_counters.dynamics )
+            + ", events " + milliseconds( m_counters.events )
+            + ", launchers " + milliseconds( m_counters.launchers ),
+        "Vehicles: " + std::to_string( vehicles.size() )
+            + ", active: " + std::to_string( simulation::Vehicles.active_count() )
+            + ", dormant: " + std::to_string( simulation::Vehicles.dormant_count() )
+            + ", reduced: " + std::to_string( simulation::Vehicles.reduced_count() ),
+        "Vehicle data: " + pervehicle( sharedsize ) + " per vehicle with shared tables of " + std::to_string( types.size() ) + " vehicle types, "
+            + pervehicle( unsharedsize ) + " per vehicle without sharing" };
+    if( true == Global.AdaptiveStep ) {
+        lines.emplace_back(
+            "Adaptive physics: " + std::to_string( m_counters.physics_steps ) + " vehicle steps, "
+            + std::to_string( m_counters.fixed_physics_steps ) + " with fixed step length" );
+    }
+
+    for( auto const &line : lines ) {
+        WriteLog( line );
+        std::cout << line << std::endl;
+    }
+}
@@ -0,0 +1,78 @@
+/*
+This Source Code Form is subject to the
+terms of the Mozilla Public License, v.
+2.0. If a copy of the MPL was not
+distributed with this file, You can
+obtain one at
+http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include "applicationmode.h"
+
+// unattended simulation run without window, graphics and audio
+// loads the scenario, runs it for specified simulated time at maximum speed, then reports performance counters
+class headless_mode : public application_mode {
+
+public:
+// methods
+    // initializes internal data structures of the mode. returns: true on success, false otherwise
+    bool
+        init() override;
+    // mode-specific update of simulation data. returns: false on error or when the run is complete, true otherwise
+    bool
+        update() override;
+    // maintenance method, called when the mode is activated
+    void
+        enter() override;
+    // maintenance method, called when the mode is deactivated
+    void
+        exit() override;
+    // input handlers
+    void
+        on_key( int const Key, int const Scancode, int const Action, int const Mods ) override { ; }
+    void
+        on_cursor_pos( double const Horizontal, double const Vertical ) override { ; }
+    void
+        on_mouse_button( int const Button, int const Action, int const Mods ) override { ; }
+    void
+        on_scroll( double const Xoffset, double const Yoffset ) override { ; }
+    void
+        on_event_poll() override { ; }
+    // returns: true if the scenario failed to load
+    bool
+        failed() const override {
+            return m_failed; }
+
+private:
+// types
+    using clock = std::chrono::steady_clock;
+    // accumulated wall time spent in parts of the simulation update, in seconds
+    struct performance_counters {
+        double dynamics { 0.0 };
+        double events { 0.0 };
+        double launchers { 0.0 };
+        double total { 0.0 };
+        std::size_t steps { 0 };
+        std::size_t physics_steps { 0 }; // vehicle physics steps made by the adaptive update
+        std::size_t fixed_physics_steps { 0 }; // vehicle physics steps the fixed update would make in their place
+    };
+// methods
+    // loads the scenario. returns: true on success
+    bool
+        load();
+    // performs single simulation step of specified length
+    void
+        step( double const Deltatime );
+    // sends collected performance counters to the log and the standard output
+    void
+        report() const;
+// members
+    bool m_loaded { false };
+    bool m_failed { false };
+    double m_loadtime { 0.0 }; // wall time spent loading the scenario, in seconds
+    double m_simulationtime { 0.0 }; // simulated time elapsed since the start of the run, in seconds
+    performance_counters m_counters;
+    std::vector<glm::dvec3> m_launcherlocations; // points activating event launchers, scratchpad
+};
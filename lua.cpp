@@ -85,23 +85,21 @@ extern "C"
 
     EXPORT basic_event* scriptapi_event_find(const char* name)
     {
-        std::string str(name);
-        basic_event *e = simulation::Events.FindEvent(str);
+        basic_event *e = simulation::Events.FindEvent(std::string_view(name));
         if (e)
             return e;
         else
-            WriteLog("lua: missing event: " + str);
+            WriteLog("lua: missing event: " + std::string(name));
         return nullptr;
     }
 
     EXPORT TTrack* scriptapi_track_find(const char* name)
     {
-        std::string str(name);
-		TTrack *track = simulation::Paths.find(str);
+		TTrack *track = simulation::Paths.find(std::string_view(name));
         if (track)
             return track;
         else
-            WriteLog("lua: missing track: " + str);
+            WriteLog("lua: missing track: " + std::string(name));
         return nullptr;
     }
 
@@ -169,12 +167,11 @@ extern "C"
 
     EXPORT TMemCell* scriptapi_memcell_find(const char *name)
     {
-        std::string str(name);
-        TMemCell *mc = simulation::Memory.find(str);
+        TMemCell *mc = simulation::Memory.find(std::string_view(name));
         if (mc)
             return mc;
         else
-            WriteLog("lua: missing memcell: " + str);
+            WriteLog("lua: missing memcell: " + std::string(name));
         return nullptr;
     }
 
@@ -62,7 +62,7 @@ OnCommandGet(multiplayer::DaneRozkaz *pRozkaz)
                 std::string( pRozkaz->cString + 1, (unsigned)( pRozkaz->cString[ 0 ] ) ) + " rcvd" );
 
             if( Global.iMultiplayer ) {
-                auto *event = simulation::Events.FindEvent( std::string( pRozkaz->cString + 1, (unsigned)( pRozkaz->cString[ 0 ] ) ) );
+                auto *event = simulation::Events.FindEvent( std::string_view( pRozkaz->cString + 1, (unsigned)( pRozkaz->cString[ 0 ] ) ) );
                 if( event != nullptr ) {
                     if( ( typeid( *event ) == typeid( multi_event ) )
                      || ( typeid( *event ) == typeid( lights_event ) )
@@ -83,7 +83,7 @@ OnCommandGet(multiplayer::DaneRozkaz *pRozkaz)
                     std::string(pRozkaz->cString + 11 + i, (unsigned)(pRozkaz->cString[10 + i])) +
                     " rcvd");
                 // nazwa pojazdu jest druga
-                auto *vehicle = simulation::Vehicles.find( { pRozkaz->cString + 11 + i, (unsigned)pRozkaz->cString[ 10 + i ] } );
+                auto *vehicle = simulation::Vehicles.find( std::string_view( pRozkaz->cString + 11 + i, (unsigned)pRozkaz->cString[ 10 + i ] ) );
                 if( ( vehicle != nullptr )
                  && ( vehicle->Mechanik != nullptr ) ) {
                     vehicle->Mechanik->PutCommand(
@@ -100,7 +100,7 @@ OnCommandGet(multiplayer::DaneRozkaz *pRozkaz)
             CommLog(Now() + " " + to_string(pRozkaz->iComm) + " " +
                     std::string(pRozkaz->cString + 1, (unsigned)(pRozkaz->cString[0])) + " rcvd");
 
-            auto *track = simulation::Paths.find( std::string( pRozkaz->cString + 1, (unsigned)( pRozkaz->cString[ 0 ] ) ) );
+            auto *track = simulation::Paths.find( std::string_view( pRozkaz->cString + 1, (unsigned)( pRozkaz->cString[ 0 ] ) ) );
             if( ( track != nullptr )
              && ( track->IsEmpty() ) ) {
                 WyslijWolny( track->name() );
@@ -140,7 +140,7 @@ OnCommandGet(multiplayer::DaneRozkaz *pRozkaz)
                     auto *vehicle = (
                         pRozkaz->cString[ 1 ] == '*' ?
                             simulation::Vehicles.find( Global.asHumanCtrlVehicle ) :
-                            simulation::Vehicles.find( std::string{ pRozkaz->cString + 1, (unsigned)pRozkaz->cString[ 0 ] } ) );
+                            simulation::Vehicles.find( std::string_view( pRozkaz->cString + 1, (unsigned)pRozkaz->cString[ 0 ] ) ) );
                     if( vehicle != nullptr ) {
                         WyslijNamiary( vehicle ); // wysłanie informacji o pojeździe
                     }
@@ -181,7 +181,7 @@ OnCommandGet(multiplayer::DaneRozkaz *pRozkaz)
                 auto *lookup = (
                     pRozkaz->cString[ 2 ] == '*' ?
                         simulation::Vehicles.find( Global.asHumanCtrlVehicle ) : // nazwa pojazdu użytkownika
-                        simulation::Vehicles.find( std::string( pRozkaz->cString + 2, (unsigned)pRozkaz->cString[ 1 ] ) ) ); // nazwa pojazdu
+                        simulation::Vehicles.find( std::string_view( pRozkaz->cString + 2, (unsigned)pRozkaz->cString[ 1 ] ) ) ); // nazwa pojazdu
                 if( lookup == nullptr ) { break; } // nothing found, nothing to do
                 auto *d { lookup };
                 while( d != nullptr ) {
@@ -46,6 +46,21 @@ basic_vertex::deserialize( std::istream &s ) {
     texture.y = sn_utils::ld_float32( s );
 }
 
+void
+basic_vertex::deserialize( sn_reader &s ) {
+
+    position.x = sn_utils::ld_float32( s );
+    position.y = sn_utils::ld_float32( s );
+    position.z = sn_utils::ld_float32( s );
+
+    normal.x = sn_utils::ld_float32( s );
+    normal.y = sn_utils::ld_float32( s );
+    normal.z = sn_utils::ld_float32( s );
+
+    texture.x = sn_utils::ld_float32( s );
+    texture.y = sn_utils::ld_float32( s );
+}
+
 // generic geometry bank class, allows storage, update and drawing of geometry chunks
 
 // creates a new geometry chunk of specified type from supplied vertex data. returns: handle to the chunk
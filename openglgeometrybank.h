@@ -18,6 +18,8 @@ http://mozilla.org/MPL/2.0/.
 #endif
 #include "ResourceManager.h"
 
+class sn_reader;
+
 namespace gfx {
 
 struct basic_vertex {
@@ -32,6 +34,7 @@ struct basic_vertex {
     {}
     void serialize( std::ostream& ) const;
     void deserialize( std::istream& );
+    void deserialize( sn_reader& );
 };
 
 // data streams carried in a vertex
@@ -23,6 +23,68 @@ http://mozilla.org/MPL/2.0/.
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 // cParser -- generic class for parsing text data.
 
+std::unordered_map<std::string, cParser::preloaded_file> cParser::m_preloaded;
+std::mutex cParser::m_preloadedmutex;
+
+namespace {
+
+char const *separators { "\n\r\t ;" }; // default token separators, the only ones covered by preloaded token lists
+
+// returns names of files included by provided text, in order of appearance
+// NOTE: a lightweight approximation of the full parser; includes with names built from parameters aren't resolved
+std::vector<std::string>
+find_includes( std::string_view const Data, bool const Loadtraction ) {
+
+    std::vector<std::string> includes;
+    std::string token;
+    auto expectfile { false };
+    std::size_t idx { 0 };
+    auto const size { Data.size() };
+
+    while( idx < size ) {
+        auto const c { Data[ idx ] };
+        // comments
+        if( ( c == '/' ) && ( idx + 1 < size ) && ( Data[ idx + 1 ] == '/' ) ) {
+            idx = Data.find( '\n', idx );
+            if( idx == std::string_view::npos ) { break; }
+            continue;
+        }
+        if( ( c == '/' ) && ( idx + 1 < size ) && ( Data[ idx + 1 ] == '*' ) ) {
+            idx = Data.find( "*/", idx + 2 );
+            if( idx == std::string_view::npos ) { break; }
+            idx += 2;
+            continue;
+        }
+        // tokens
+        if( std::strchr( "\n\r\t ;", c ) != nullptr ) {
+            ++idx;
+            continue;
+        }
+        token.clear();
+        while( ( idx < size )
+            && ( std::strchr( "\n\r\t ;", Data[ idx ] ) == nullptr ) ) {
+            token += static_cast<char>( std::tolower( static_cast<unsigned char>( Data[ idx ] ) ) );
+            ++idx;
+        }
+        if( true == expectfile ) {
+            expectfile = false;
+            std::replace( token.begin(), token.end(), '\\', '/' );
+            if( ( token.find( "(p" ) == std::string::npos )
+             && ( ( true == Loadtraction )
+               || ( ( token.find( "tr/" ) == std::string::npos )
+                 && ( token.find( "tra/" ) == std::string::npos ) ) ) ) {
+                includes.emplace_back( token );
+            }
+        }
+        else if( token == "include" ) {
+            expectfile = true;
+        }
+    }
+    return includes;
+}
+
+} // namespace
+
 // constructors
 cParser::cParser( std::string const &Stream, buffertype const Type, std::string Path, bool const Loadtraction, std::vector<std::string> Parameters ) :
     mPath(Path),
@@ -35,7 +97,23 @@ cParser::cParser( std::string const &Stream, buffertype const Type, std::string
     switch (Type) {
         case buffer_FILE: {
             Path.append( Stream );
-            mStream = std::make_shared<std::ifstream>( Path );
+            {
+                // use copy of the file mapped ahead of time, if there's one
+                std::lock_guard<std::mutex> lock { m_preloadedmutex };
+                auto const lookup { m_preloaded.find( Path ) };
+                if( lookup != m_preloaded.end() ) {
+                    mFileBuffer = lookup->second.data;
+                    mTokens = lookup->second.tokens;
+                }
+            }
+            if( !mFileBuffer ) {
+                mFileBuffer = std::make_shared<mapped_file>( Path );
+            }
+            mFiles = std::make_shared<std::vector<std::string>>( 1, Path );
+            mBuffer = mFileBuffer->data();
+#ifdef _WIN32
+            mTextMode = true;
+#endif
             // content of *.inc files is potentially grouped together
             if( ( Stream.size() >= 4 )
              && ( ToLower( Stream.substr( Stream.size() - 4 ) ) == ".inc" ) ) {
@@ -45,7 +123,8 @@ cParser::cParser( std::string const &Stream, buffertype const Type, std::string
             break;
         }
         case buffer_TEXT: {
-            mStream = std::make_shared<std::istringstream>( Stream );
+            mTextBuffer = std::make_shared<std::string>( Stream );
+            mBuffer = *mTextBuffer;
             break;
         }
         default: {
@@ -53,16 +132,14 @@ cParser::cParser( std::string const &Stream, buffertype const Type, std::string
         }
     }
     // calculate stream size
-    if (mStream)
-    {
-        if( true == mStream->fail() ) {
-            ErrorLog( "Failed to open file \"" + Path + "\"" );
-        }
-        else {
-            mSize = mStream->rdbuf()->pubseekoff( 0, std::ios_base::end );
-            mStream->rdbuf()->pubseekoff( 0, std::ios_base::beg );
-            mLine = 1;
-        }
+    if( ( mFileBuffer )
+     && ( false == mFileBuffer->is_open() ) ) {
+        m_fail = true;
+        ErrorLog( "Failed to open file \"" + Path + "\"" );
+    }
+    else {
+        mSize = static_cast<std::streamoff>( mBuffer.size() );
+        mLine = 1;
     }
     // set parameter set if one was provided
     if( false == Parameters.empty() ) {
@@ -70,6 +147,18 @@ cParser::cParser( std::string const &Stream, buffertype const Type, std::string
     }
 }
 
+// opens provided file content for token scan only, without include processing or scene group setup
+cParser::cParser( std::shared_ptr<mapped_file> File ) :
+    mFileBuffer( std::move( File ) ) {
+
+    mBuffer = mFileBuffer->data();
+#ifdef _WIN32
+    mTextMode = true;
+#endif
+    mSize = static_cast<std::streamoff>( mBuffer.size() );
+    mLine = 1;
+}
+
 // destructor
 cParser::~cParser() {
 
@@ -181,22 +270,7 @@ std::string cParser::readToken( bool ToLower, const char *Break ) {
     }
     if( true == token.empty() ) {
         // get the token yourself if the delegation attempt failed
-        char c { 0 };
-        do {
-            while( mStream->peek() != EOF && strchr( Break, c = mStream->get() ) == NULL ) {
-                if( ToLower )
-                    c = tolower( c );
-                token += c;
-                if( findQuotes( token ) ) // do glue together words enclosed in quotes
-                    continue;
-                if( trimComments( token ) ) // don't glue together words separated with comment
-                    break;
-            }
-            if( c == '\n' ) {
-                // update line counter
-                ++mLine;
-            }
-        } while( token == "" && mStream->peek() != EOF ); // double check in case of consecutive separators
+        token = nextToken( ToLower, Break );
     }
 
     if( false == parameters.empty() ) {
@@ -236,6 +310,11 @@ std::string cParser::readToken( bool ToLower, const char *Break ) {
             }
             mIncludeParser = std::make_shared<cParser>( includefile, buffer_FILE, mPath, LoadTraction, includeparameters );
             mIncludeParser->autoclear( m_autoclear );
+            if( mFiles ) {
+                // included files are recorded in the list of their parent
+                mFiles->emplace_back( mPath + includefile );
+                mIncludeParser->mFiles = mFiles;
+            }
             if( mIncludeParser->mSize <= 0 ) {
                 ErrorLog( "Bad include: can't open file \"" + includefile + "\"" );
             }
@@ -251,10 +330,147 @@ std::string cParser::readToken( bool ToLower, const char *Break ) {
     return token;
 }
 
+// retrieves next token of the open file or text, either from the preloaded token list or by reading the buffer
+std::string cParser::nextToken( bool const ToLower, char const *Break ) {
+
+    if( ( mTokens )
+     && ( false == mCustomComments )
+     && ( std::strcmp( Break, separators ) == 0 ) ) {
+        auto const *span { findToken() };
+        // text glued from quotes keeps its case, so for lowercase tokens it has to be read again
+        if( ( span != nullptr )
+         && ( ( false == ToLower ) || ( false == span->quoted ) ) ) {
+            std::string token( mTokens->text, span->offset, span->length );
+            if( ToLower ) {
+                for( auto &c : token ) {
+                    c = tolower( c );
+                }
+            }
+            // update parser state the same way reading the buffer would
+            mPosition = span->end;
+            mLine += span->lines;
+            for( auto idx = 0; idx < span->eofhits; ++idx ) {
+                if( ( true == m_eof ) || ( true == m_fail ) ) { m_fail = true; }
+                else                                         { m_eof = true; }
+            }
+            ++mTokenIndex;
+            return token;
+        }
+    }
+    return scanToken( ToLower, Break );
+}
+
+// reads next token of the open file or text from the buffer
+std::string cParser::scanToken( bool const ToLower, char const *Break ) {
+
+    std::string token;
+    char c { 0 };
+    mQuoted = false;
+    // text glued from quotes can contain comment markers anywhere, otherwise new marker can only show up at the end of the token
+    auto fullcommentcheck { false };
+    do {
+        while( peekChar() != EOF && strchr( Break, c = getChar() ) == NULL ) {
+            if( ToLower )
+                c = tolower( c );
+            token += c;
+            if( findQuotes( token ) ) { // do glue together words enclosed in quotes
+                mQuoted = true;
+                fullcommentcheck = true;
+                continue;
+            }
+            if( true == (
+                    fullcommentcheck ?
+                        trimComments( token ) :
+                        trimTrailingComment( token ) ) ) // don't glue together words separated with comment
+                break;
+            fullcommentcheck = false;
+        }
+        if( c == '\n' ) {
+            // update line counter
+            ++mLine;
+        }
+    } while( token == "" && peekChar() != EOF ); // double check in case of consecutive separators
+
+    return token;
+}
+
+// returns preloaded token which starts at current read position, or null if there's no such token
+cParser::token_span const *
+cParser::findToken() {
+
+    auto const &spans { mTokens->spans };
+    auto const tokenstart { (
+        mTokenIndex == 0 ?
+            0 :
+            mTokenIndex <= spans.size() ?
+                spans[ mTokenIndex - 1 ].end :
+                mBuffer.size() ) };
+    if( tokenstart != mPosition ) {
+        // read position was moved by reads with other separators, look up token which starts where the previous one ended
+        if( mPosition == 0 ) {
+            mTokenIndex = 0;
+        }
+        else {
+            auto const lookup {
+                std::lower_bound(
+                    std::begin( spans ), std::end( spans ),
+                    mPosition,
+                    []( token_span const &Span, std::size_t const Position ) {
+                        return Span.end < Position; } ) };
+            if( ( lookup == std::end( spans ) )
+             || ( lookup->end != mPosition ) ) {
+                // current position is in the middle of a token
+                mTokenIndex = spans.size() + 1;
+                return nullptr;
+            }
+            mTokenIndex = static_cast<std::size_t>( lookup - std::begin( spans ) ) + 1;
+        }
+    }
+    return (
+        mTokenIndex < spans.size() ?
+            &spans[ mTokenIndex ] :
+            nullptr );
+}
+
+// reads whole content of provided file into a list of tokens
+std::shared_ptr<cParser::token_list const>
+cParser::tokenize( std::shared_ptr<mapped_file> const &File ) {
+
+    // token locations are stored as 32 bit values
+    if( File->size() > std::numeric_limits<std::uint32_t>::max() ) { return nullptr; }
+
+    auto tokens { std::make_shared<token_list>() };
+    cParser scanner( File );
+    while( true ) {
+        auto const line { scanner.mLine };
+        scanner.m_eof = false;
+        scanner.m_fail = false;
+        auto const token { scanner.scanToken( false, separators ) };
+        if( true == token.empty() ) { break; }
+
+        token_span span;
+        span.offset = static_cast<std::uint32_t>( tokens->text.size() );
+        span.length = static_cast<std::uint32_t>( token.size() );
+        span.end = static_cast<std::uint32_t>( scanner.mPosition );
+        span.lines = static_cast<std::uint32_t>( scanner.mLine - line );
+        span.eofhits = (
+            scanner.m_fail ? 2 :
+            scanner.m_eof ? 1 :
+            0 );
+        span.quoted = scanner.mQuoted;
+        tokens->text += token;
+        tokens->spans.emplace_back( span );
+    }
+    tokens->text.shrink_to_fit();
+    tokens->spans.shrink_to_fit();
+
+    return tokens;
+}
+
 std::string cParser::readQuotes(char const Quote) { // read the stream until specified char or stream end
     std::string token = "";
     char c { 0 };
-    while( mStream->peek() != EOF && Quote != (c = mStream->get()) ) { // get all chars until the quote mark
+    while( peekChar() != EOF && Quote != (c = getChar()) ) { // get all chars until the quote mark
         if( c == '\n' ) {
             // update line counter
             ++mLine;
@@ -265,12 +481,27 @@ std::string cParser::readQuotes(char const Quote) { // read the stream until spe
 }
 
 void cParser::skipComment( std::string const &Endmark ) { // pobieranie znaków aż do znalezienia znacznika końca
-    std::string input = "";
     char c { 0 };
+    if( Endmark.size() == 1 ) {
+        // single character markers, i.e. line ends, don't need the text buffer
+        auto const endmark { Endmark.front() };
+        while( peekChar() != EOF ) {
+            c = getChar();
+            if( c == '\n' ) {
+                // update line counter
+                ++mLine;
+            }
+            if( c == endmark ) {
+                break;
+            }
+        }
+        return;
+    }
+    std::string input = "";
     auto const endmarksize = Endmark.size();
-    while( mStream->peek() != EOF ) {
+    while( peekChar() != EOF ) {
         // o ile nie koniec pliku
-        c = mStream->get(); // pobranie znaku
+        c = getChar(); // pobranie znaku
         if( c == '\n' ) {
             // update line counter
             ++mLine;
@@ -280,17 +511,18 @@ void cParser::skipComment( std::string const &Endmark ) { // pobieranie znaków
             break;
         if( input.size() >= endmarksize ) {
             // keep the read text short, to avoid pointless string re-allocations on longer comments
-            input = input.substr( 1 );
+            input.erase( 0, 1 );
         }
     }
     return;
 }
 
 bool cParser::findQuotes( std::string &String ) {
+    // NOTE: quote marks are removed as soon as they're added, so the only one we can encounter is at the end of the string
+    if( ( false == String.empty() )
+     && ( String.back() == '\"' ) ) {
 
-    if( String.rfind( '\"' ) != std::string::npos ) {
-
-        String.erase( String.rfind( '\"' ), 1 );
+        String.pop_back();
         String += readQuotes();
         return true;
     }
@@ -311,9 +543,26 @@ bool cParser::trimComments(std::string &String)
     return false;
 }
 
+// variant of trimComments() for strings which are known to contain no comment markers except potentially at their end
+bool cParser::trimTrailingComment( std::string &String ) {
+
+    for( auto const &comment : mComments ) {
+        auto const &commentstart { comment.first };
+        if( ( String.size() >= commentstart.size() )
+         && ( String.compare( String.size() - commentstart.size(), commentstart.size(), commentstart ) == 0 ) ) {
+            skipComment( comment.second );
+            String.resize( String.size() - commentstart.size() );
+            return true;
+        }
+    }
+    return false;
+}
+
 int cParser::getProgress() const
 {
-    return static_cast<int>( mStream->rdbuf()->pubseekoff(0, std::ios_base::cur) * 100 / mSize );
+    if( mSize <= 0 ) { return 100; }
+
+    return static_cast<int>( static_cast<std::streamoff>( mPosition ) * 100 / mSize );
 }
 
 int cParser::getFullProgress() const {
@@ -344,6 +593,7 @@ std::size_t cParser::count() {
 void cParser::addCommentStyle( std::string const &Commentstart, std::string const &Commentend ) {
 
     mComments.insert( commentmap::value_type(Commentstart, Commentend) );
+    mCustomComments = true;
 }
 
 // returns name of currently open file, or empty string for text type stream
@@ -361,3 +611,92 @@ cParser::Line() const {
     if( mIncludeParser ) { return mIncludeParser->Line(); }
     else                 { return mLine; }
 }
+
+// returns list of files opened so far by the parser and its includes, or empty list for text type stream
+std::vector<std::string>
+cParser::Files() const {
+
+    return (
+        mFiles ?
+            *mFiles :
+            std::vector<std::string>() );
+}
+
+// maps and tokenises specified file and all files it includes, processing each level of includes on provided worker pool
+// mapped files and their token lists are shared with parsers opened afterwards, until release() is called
+cParser::preload_report
+cParser::preload( std::string const &Stream, std::string const &Path, bool const Loadtraction, threading::task_pool &Workers ) {
+
+    struct file_data {
+        std::string name;
+        preloaded_file file;
+        std::vector<std::string> includes;
+        double time { 0.0 };
+    };
+
+    preload_report report;
+    auto const timestart { std::chrono::steady_clock::now() };
+
+    std::vector<file_data> level { { Path + Stream, {}, {}, 0.0 } };
+    while( false == level.empty() ) {
+        // each file of current level is mapped, hashed, tokenised and scanned for includes independently...
+        Workers.run(
+            level.size(),
+            [&]( std::size_t const Index ) {
+                auto const timefile { std::chrono::steady_clock::now() };
+                auto &data { level[ Index ] };
+                data.file.data = std::make_shared<mapped_file>( data.name );
+                if( true == data.file.data->is_open() ) {
+                    // NOTE: hashing reads whole file, which also brings it into memory ahead of the parser
+                    data.file.hash = content_hash( data.file.data->data() );
+                    data.includes = find_includes( data.file.data->data(), Loadtraction );
+                    data.file.tokens = tokenize( data.file.data );
+                }
+                data.time = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - timefile ).count(); } );
+        // ...then the results are merged in order of appearance, and new includes form the next level
+        std::lock_guard<std::mutex> lock { m_preloadedmutex };
+        std::vector<file_data> nextlevel;
+        for( auto &data : level ) {
+            report.serial += data.time;
+            if( false == data.file.data->is_open() ) { continue; }
+            ++report.files;
+            report.bytes += data.file.data->size();
+            m_preloaded.emplace( data.name, data.file );
+        }
+        std::unordered_set<std::string> queued;
+        for( auto const &data : level ) {
+            for( auto const &include : data.includes ) {
+                auto const includepath { Path + include };
+                if( ( m_preloaded.find( includepath ) == m_preloaded.end() )
+                 && ( true == queued.emplace( includepath ).second ) ) {
+                    nextlevel.push_back( { includepath, {}, {}, 0.0 } );
+                }
+            }
+        }
+        level.swap( nextlevel );
+    }
+    report.wall = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - timestart ).count();
+
+    return report;
+}
+
+// releases files retained by preload()
+void
+cParser::release() {
+
+    std::lock_guard<std::mutex> lock { m_preloadedmutex };
+    m_preloaded.clear();
+}
+
+// retrieves size and content hash of specified preloaded file. returns: true if the file was preloaded, false otherwise
+bool
+cParser::preloaded( std::string const &File, std::uint64_t &Size, std::uint64_t &Hash ) {
+
+    std::lock_guard<std::mutex> lock { m_preloadedmutex };
+    auto const lookup { m_preloaded.find( File ) };
+    if( lookup == m_preloaded.end() ) { return false; }
+
+    Size = lookup->second.data->size();
+    Hash = lookup->second.hash;
+    return true;
+}
@@ -10,10 +10,18 @@ http://mozilla.org/MPL/2.0/.
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <fstream>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <mutex>
+
+class mapped_file;
+namespace threading {
+class task_pool;
+}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 // cParser -- generic class for parsing text data, either from file or provided string
@@ -27,6 +35,13 @@ class cParser //: public std::stringstream
         buffer_FILE,
         buffer_TEXT
     };
+    // summary of file preloading
+    struct preload_report {
+        std::size_t files { 0 }; // number of preloaded files
+        std::size_t bytes { 0 }; // total size of preloaded files
+        double serial { 0.0 }; // sum of processing times of individual files, in milliseconds
+        double wall { 0.0 }; // elapsed time of the whole preload, in milliseconds
+    };
     // constructors:
     cParser(std::string const &Stream, buffertype const Type = buffer_TEXT, std::string Path = "", bool const Loadtraction = true, std::vector<std::string> Parameters = std::vector<std::string>() );
     // destructor:
@@ -52,10 +67,10 @@ class cParser //: public std::stringstream
             return readToken() == Value; };
     bool
         eof() {
-            return mStream->eof(); };
+            return m_eof; };
     bool
         ok() {
-            return !mStream->fail(); };
+            return !m_fail; };
     cParser &
         autoclear( bool const Autoclear );
     bool
@@ -81,31 +96,122 @@ class cParser //: public std::stringstream
     std::string Name() const;
     // returns number of currently processed line
     std::size_t Line() const;
+    // returns list of files opened so far by the parser and its includes, or empty list for text type stream
+    std::vector<std::string> Files() const;
+    // maps and tokenises specified file and all files it includes, processing each level of includes on provided worker pool
+    // mapped files and their token lists are shared with parsers opened afterwards, until release() is called
+    static preload_report preload( std::string const &Stream, std::string const &Path, bool const Loadtraction, threading::task_pool &Workers );
+    // releases files retained by preload()
+    static void release();
+    // retrieves size and content hash of specified preloaded file. returns: true if the file was preloaded, false otherwise
+    static bool preloaded( std::string const &File, std::uint64_t &Size, std::uint64_t &Hash );
 
   private:
+    // types:
+    // location of a token read from the file with default separators
+    struct token_span {
+        std::uint32_t offset { 0 }; // start of token text in the text pool
+        std::uint32_t length { 0 }; // length of token text
+        std::uint32_t end { 0 }; // read position in the file after the token
+        std::uint32_t lines { 0 }; // number of line ends passed while reading the token
+        std::uint8_t eofhits { 0 }; // number of attempts to read past the end of data made while reading the token
+        bool quoted { false }; // token contains text glued from quotes, which isn't affected by lowercase conversion
+    };
+    // tokens of a whole file, read ahead of parsing
+    struct token_list {
+        std::string text; // text of all tokens, in original case
+        std::vector<token_span> spans;
+    };
+    struct preloaded_file {
+        std::shared_ptr<mapped_file> data;
+        std::shared_ptr<token_list const> tokens;
+        std::uint64_t hash { 0 };
+    };
+    // constructors:
+    // opens provided file content for token scan only, without include processing or scene group setup
+    explicit cParser( std::shared_ptr<mapped_file> File );
     // methods:
+    // returns next character of the buffer without removing it, or EOF
+    inline
+    int
+        peekChar() {
+            if( mPosition < mBuffer.size() ) {
+                auto const c { static_cast<unsigned char>( mBuffer[ mPosition ] ) };
+                // windows builds used to read the files in text mode, which turns line ends into plain \n
+                if( ( c == '\r' )
+                 && ( true == mTextMode )
+                 && ( mPosition + 1 < mBuffer.size() )
+                 && ( mBuffer[ mPosition + 1 ] == '\n' ) ) {
+                    return '\n';
+                }
+                return c;
+            }
+            // legacy stream behaviour; reaching the end sets eof flag, and any further read attempt marks the stream as failed
+            if( ( true == m_eof ) || ( true == m_fail ) ) { m_fail = true; }
+            else                                         { m_eof = true; }
+            return EOF; }
+    // removes next character from the buffer and returns it
+    inline
+    char
+        getChar() {
+            auto const c { peekChar() };
+            if( c == EOF ) {
+                m_fail = true;
+                return static_cast<char>( EOF );
+            }
+            mPosition += (
+                ( c == '\n' ) && ( mBuffer[ mPosition ] == '\r' ) ?
+                    2 :
+                    1 );
+            return static_cast<char>( c ); }
+    // converts next token to a number
+    template <typename Type_>
+    cParser &
+        readNumber( Type_ &Right );
     std::string readToken(bool ToLower = true, const char *Break = "\n\r\t ;");
+    // retrieves next token of the open file or text, either from the preloaded token list or by reading the buffer
+    std::string nextToken( bool const ToLower, char const *Break );
+    // reads next token of the open file or text from the buffer
+    std::string scanToken( bool const ToLower, char const *Break );
+    // returns preloaded token which starts at current read position, or null if there's no such token
+    token_span const * findToken();
+    // reads whole content of provided file into a list of tokens
+    static std::shared_ptr<token_list const> tokenize( std::shared_ptr<mapped_file> const &File );
     std::string readQuotes( char const Quote = '\"' );
     void skipComment( std::string const &Endmark );
     bool findQuotes( std::string &String );
     bool trimComments( std::string &String );
+    bool trimTrailingComment( std::string &String );
     std::size_t count();
     // members:
     bool m_autoclear { true }; // unretrieved tokens are discarded when another read command is issued (legacy behaviour)
     bool LoadTraction { true }; // load traction?
-    std::shared_ptr<std::istream> mStream; // relevant kind of buffer is attached on creation.
+    std::shared_ptr<mapped_file> mFileBuffer; // content of the open file, if any
+    std::shared_ptr<std::string> mTextBuffer; // provided text, for text type stream
+    std::string_view mBuffer; // processed data, either file or text
+    std::size_t mPosition { 0 }; // current read position in the buffer
+    bool mTextMode { false }; // \r\n line ends are read as \n
+    bool m_eof { false }; // attempt was made to read past the end of data
+    bool m_fail { false }; // data couldn't be retrieved
     std::string mFile; // name of the open file, if any
     std::string mPath; // path to open stream, for relative path lookups.
     std::streamoff mSize { 0 }; // size of open stream, for progress report.
     std::size_t mLine { 0 }; // currently processed line
     bool mIncFile { false }; // the parser is processing an *.inc file
+    bool mQuoted { false }; // last token read from the buffer contained text glued from quotes
+    bool mCustomComments { false }; // comment styles were added, which invalidates preloaded token list
+    std::shared_ptr<token_list const> mTokens; // tokens of the open file, if it was preloaded
+    std::size_t mTokenIndex { 0 }; // next preloaded token, if the read position wasn't moved by other reads
     typedef std::map<std::string, std::string> commentmap;
     commentmap mComments {
         commentmap::value_type( "/*", "*/" ),
         commentmap::value_type( "//", "\n" ) };
     std::shared_ptr<cParser> mIncludeParser; // child class to handle include directives.
+    std::shared_ptr<std::vector<std::string>> mFiles; // list of processed files, shared with child parsers
     std::vector<std::string> parameters; // parameter list for included file.
     std::deque<std::string> tokens;
+    static std::unordered_map<std::string, preloaded_file> m_preloaded; // files mapped ahead of parsing, shared with opened parsers
+    static std::mutex m_preloadedmutex; // parsers can be opened by model loader threads while the main thread preloads or releases files
 };
 
 template<typename Type_>
@@ -114,13 +220,87 @@ cParser::operator>>( Type_ &Right ) {
 
     if( true == this->tokens.empty() ) { return *this; }
 
-    std::stringstream converter( this->tokens.front() );
-    converter >> Right;
+    if constexpr( ( std::is_arithmetic<Type_>::value )
+               && ( false == std::is_same<Type_, bool>::value )
+               && ( false == std::is_same<Type_, char>::value )
+               && ( false == std::is_same<Type_, signed char>::value )
+               && ( false == std::is_same<Type_, unsigned char>::value ) ) {
+        // numbers are converted directly, without going through a stream
+        return readNumber( Right );
+    }
+    else {
+        std::stringstream converter( this->tokens.front() );
+        converter >> Right;
+        this->tokens.pop_front();
+
+        return *this;
+    }
+}
+
+// converts next token to a number, following the rules of stream extraction
+template<typename Type_>
+cParser&
+cParser::readNumber( Type_ &Right ) {
+
+    auto const &token { this->tokens.front() };
+    auto const *first { token.data() };
+    auto const *last { token.data() + token.size() };
+    // streams skip leading whitespace and accept explicit plus sign
+    while( ( first != last ) && ( std::isspace( static_cast<unsigned char>( *first ) ) ) ) { ++first; }
+    auto const negative { ( first != last ) && ( *first == '-' ) };
+    if( ( first != last ) && ( ( *first == '+' ) || ( ( *first == '-' ) && ( std::is_unsigned<Type_>::value ) ) ) ) { ++first; }
+
+    auto value { Type_( 0 ) };
+    if constexpr( std::is_integral<Type_>::value ) {
+        auto const result { std::from_chars( first, last, value ) };
+        if( result.ec == std::errc::result_out_of_range ) {
+            value = (
+                ( negative && std::is_signed<Type_>::value ) ?
+                    std::numeric_limits<Type_>::lowest() :
+                    std::numeric_limits<Type_>::max() );
+        }
+        else if( result.ec != std::errc() ) {
+            value = Type_( 0 );
+        }
+        else if( negative && std::is_unsigned<Type_>::value ) {
+            // streams accept negative values for unsigned types, wrapping them around
+            value = static_cast<Type_>( Type_( 0 ) - value );
+        }
+    }
+    else {
+        // unlike streams, the conversion accepts inf and nan, so these have to be filtered out
+        if( ( first != last )
+         && ( ( std::isdigit( static_cast<unsigned char>( *first ) ) )
+           || ( ( *first == '.' ) && ( first + 1 != last ) && ( std::isdigit( static_cast<unsigned char>( first[ 1 ] ) ) ) )
+           || ( ( *first == '-' ) && ( first + 1 != last ) && ( ( std::isdigit( static_cast<unsigned char>( first[ 1 ] ) ) ) || ( first[ 1 ] == '.' ) ) ) ) ) {
+#ifdef __cpp_lib_to_chars
+            auto const result { std::from_chars( first, last, value ) };
+            if( result.ec == std::errc::result_out_of_range ) {
+                // overflow is clamped to the type range, while underflow results in zero or denormal value
+                auto const fallback { std::strtold( first, nullptr ) };
+                value = (
+                    fallback > std::numeric_limits<Type_>::max() ? std::numeric_limits<Type_>::max() :
+                    fallback < std::numeric_limits<Type_>::lowest() ? std::numeric_limits<Type_>::lowest() :
+                    static_cast<Type_>( fallback ) );
+            }
+            else if( result.ec != std::errc() ) {
+                value = Type_( 0 );
+            }
+#else
+            // older standard libraries lack floating point support in from_chars
+            auto const hexadecimal { ( last - first > 1 ) && ( first[ 0 ] == '0' ) && ( ( first[ 1 ] == 'x' ) || ( first[ 1 ] == 'X' ) ) };
+            value = (
+                hexadecimal ?
+                    Type_( 0 ) :
+                    static_cast<Type_>( std::strtold( first, nullptr ) ) );
+#endif
+        }
+    }
+    Right = value;
     this->tokens.pop_front();
 
     return *this;
 }
-
 template<>
 cParser&
 cParser::operator>>( std::string &Right );
@@ -19,6 +19,7 @@ http://mozilla.org/MPL/2.0/.
 #include "Train.h"
 #include "DynObj.h"
 #include "AnimModel.h"
+#include "MdlMngr.h"
 #include "Traction.h"
 #include "application.h"
 #include "Logs.h"
@@ -417,6 +418,8 @@ opengl_renderer::Render() {
     if (gl_time_ready)
 		glBeginQuery(GL_TIME_ELAPSED, m_gltimequery);
 
+    m_textures.begin_frame();
+
     // fetch simulation data
     if( simulation::is_ready ) {
         m_sunlight = Global.DayLight;
@@ -2142,10 +2145,10 @@ opengl_renderer::Render( TAnimModel *Instance ) {
 
     Instance->RaAnimate( m_framestamp ); // jednorazowe przeliczenie animacji
     Instance->RaPrepare();
-    if( Instance->pModel ) {
+    if( Instance->Model() ) {
         // renderowanie rekurencyjne submodeli
         Render(
-            Instance->pModel,
+            Instance->Model(),
             Instance->Material(),
             distancesquared,
             Instance->location() - m_renderpass.camera.position(),
@@ -3009,7 +3012,7 @@ opengl_renderer::Render_precipitation() {
     }
     if( Global.Weather == "rain:" ) {
         // oddly enough random streaks produce more natural looking rain than ones the eye can follow
-        ::glRotated( Random() * 360, 0.0, 1.0, 0.0 );
+        ::glRotated( LocalRandom( 360.0 ), 0.0, 1.0, 0.0 );
     }
 
     // TBD: leave lighting on to allow vehicle lights to affect it?
@@ -3146,10 +3149,10 @@ opengl_renderer::Render_Alpha( TAnimModel *Instance ) {
     }
 
     Instance->RaPrepare();
-    if( Instance->pModel ) {
+    if( Instance->Model() ) {
         // renderowanie rekurencyjne submodeli
         Render_Alpha(
-            Instance->pModel,
+            Instance->Model(),
             Instance->Material(),
             distancesquared,
             Instance->location() - m_renderpass.camera.position(),
@@ -3829,6 +3832,9 @@ opengl_renderer::Update( double const Deltatime ) {
                 ::glEnable( GL_MULTISAMPLE );
     }
 
+    // hand over models loaded in the background
+    TModelsManager::update();
+
     if( ( true == Global.ResourceSweep )
      && ( true == simulation::is_ready ) ) {
         // garbage collection
@@ -3838,6 +3844,7 @@ opengl_renderer::Update( double const Deltatime ) {
 
     if( true == DebugModeFlag ) {
         m_debugtimestext += m_textures.info();
+        m_debugtimestext += TModelsManager::info();
     }
 
     if( ( true  == Global.ControlPicking )
@@ -25,7 +25,237 @@ namespace scene {
 
 std::string const EU07_FILEEXTENSION_REGION { ".sbt" };
 std::uint32_t const EU07_FILEHEADER { MAKE_ID4( 'E','U','0','7' ) };
-std::uint32_t const EU07_FILEVERSION_REGION { MAKE_ID4( 'S', 'B', 'T', 1 ) };
+std::uint32_t const EU07_FILEVERSION_REGION { MAKE_ID4( 'S', 'B', 'T', 2 ) };
+
+namespace {
+
+// returns name of region data file for specified scenario
+std::string
+region_file( std::string const &Scenariofile ) {
+
+    auto filename { Scenariofile };
+    while( filename[ 0 ] == '$' ) {
+        // trim leading $ char rainsted utility may add to the base name for modified .scn files
+        filename.erase( 0, 1 );
+    }
+    erase_extension( filename );
+    return Global.asCurrentSceneryPath + filename + EU07_FILEEXTENSION_REGION;
+}
+
+// retrieves size and content hash of specified file, using copy preloaded by the parser if possible
+void
+file_signature( std::string const &File, std::uint64_t &Size, std::uint64_t &Hash ) {
+
+    if( true == cParser::preloaded( File, Size, Hash ) ) { return; }
+
+    mapped_file const file { File };
+    Size = file.size();
+    Hash = content_hash( file.data() );
+}
+
+} // namespace
+
+// records provided files as sources of the cached content
+void
+content_cache::sources( std::vector<std::string> const &Files ) {
+
+    m_sources.clear();
+    std::unordered_set<std::string> processed;
+    for( auto const &file : Files ) {
+        // included files can show up on the list multiple times, but we need to check each only once
+        if( false == processed.emplace( file ).second ) { continue; }
+        source_file source { file };
+        file_signature( file, source.size, source.hash );
+        m_sources.emplace_back( source );
+    }
+    m_settings = settings();
+}
+
+// checks whether the content was created from current version of its source files, with current import settings
+bool
+content_cache::is_current() const {
+
+    if( m_settings != settings() ) { return false; }
+
+    for( auto const &source : m_sources ) {
+        std::uint64_t size, hash;
+        file_signature( source.name, size, hash );
+        if( ( size != source.size )
+         || ( hash != source.hash ) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// adds provided node to the cache, under specified type and name
+void
+content_cache::insert( std::string const &Type, std::string const &Name, basic_node const &Node ) {
+
+    sn_utils::s_str( m_data, Type );
+    sn_utils::s_str( m_data, Name );
+    Node.serialize( m_data );
+    ++m_count;
+}
+
+// adds provided event to the cache, under specified type and name
+void
+content_cache::insert( std::string const &Type, std::string const &Name, basic_event const &Event ) {
+
+    sn_utils::s_str( m_data, Type );
+    sn_utils::s_str( m_data, Name );
+    Event.serialize( m_data );
+    ++m_count;
+}
+
+// checks whether next cached item has specified type and name. returns: true if it does, false otherwise
+bool
+content_cache::match( std::string const &Type, std::string const &Name ) {
+
+    if( m_count == 0 ) { return false; }
+
+    auto const position { m_data.tellg() };
+    auto const type { sn_utils::d_str( m_data ) };
+    auto const name { sn_utils::d_str( m_data ) };
+    if( ( type == Type )
+     && ( name == Name ) ) {
+        --m_count;
+        return true;
+    }
+    // leave the item in place, in case the caller wants to try again with different parameters
+    m_data.clear();
+    m_data.seekg( position );
+    return false;
+}
+
+// stores content of the class in provided stream
+void
+content_cache::serialize( std::ostream &Output ) const {
+
+    // source files
+    sn_utils::ls_uint32( Output, static_cast<std::uint32_t>( m_sources.size() ) );
+    for( auto const &source : m_sources ) {
+        sn_utils::s_str( Output, source.name );
+        sn_utils::ls_uint64( Output, source.size );
+        sn_utils::ls_uint64( Output, source.hash );
+    }
+    sn_utils::s_str( Output, m_settings );
+    // cached items: item count, followed by size of item data, followed by item data
+    auto const data { m_data.str() };
+    sn_utils::ls_uint32( Output, m_count );
+    sn_utils::ls_uint64( Output, data.size() );
+    Output.write( data.data(), data.size() );
+}
+
+// restores content of the class from provided stream. cached items can be skipped, leaving only list of source files
+void
+content_cache::deserialize( std::istream &Input, bool const Skipcontent ) {
+
+    // source files
+    m_sources.clear();
+    auto sourcecount { sn_utils::ld_uint32( Input ) };
+    while( ( sourcecount-- )
+        && ( true == Input.good() ) ) {
+        source_file source;
+        source.name = sn_utils::d_str( Input );
+        source.size = sn_utils::ld_uint64( Input );
+        source.hash = sn_utils::ld_uint64( Input );
+        m_sources.emplace_back( source );
+    }
+    m_settings = sn_utils::d_str( Input );
+    // cached items
+    m_count = sn_utils::ld_uint32( Input );
+    auto const datasize { sn_utils::ld_uint64( Input ) };
+    if( true == Skipcontent ) {
+        m_count = 0;
+        Input.seekg( datasize, std::ios::cur );
+        return;
+    }
+    std::string data( datasize, '\0' );
+    Input.read( &data[ 0 ], datasize );
+    m_data.str( data );
+    m_data.clear();
+}
+
+// returns description of settings which affect content of imported nodes
+std::string
+content_cache::settings() {
+
+    return
+        "traction:" + std::to_string( Global.bLoadTraction )
+        + " trackbeds:" + std::to_string( Global.CreateSwitchTrackbeds )
+        + " splinefidelity:" + std::to_string( Global.SplineFidelity )
+        + " timeoffset:" + std::to_string( Global.ScenarioTimeOffset );
+}
+
+
+// adds provided launcher to the index
+void
+launcher_grid::insert( TEventLauncher *Launcher ) {
+
+    auto const range { launcher_grid::range( Launcher ) };
+    if( range <= 0.0 ) {
+        // launchers without activation range can be only activated by click
+        return;
+    }
+    auto const location { Launcher->location() };
+    for( auto x = coordinate( location.x - range ); x <= coordinate( location.x + range ); ++x ) {
+        for( auto z = coordinate( location.z - range ); z <= coordinate( location.z + range ); ++z ) {
+            // skip corner cells which don't touch the circle of activation range
+            auto const nearestx { clamp<double>( location.x, x * EU07_CELLSIZE, ( x + 1 ) * EU07_CELLSIZE ) };
+            auto const nearestz { clamp<double>( location.z, z * EU07_CELLSIZE, ( z + 1 ) * EU07_CELLSIZE ) };
+            if( ( nearestx - location.x ) * ( nearestx - location.x ) + ( nearestz - location.z ) * ( nearestz - location.z ) > range * range ) {
+                continue;
+            }
+            m_cells[ key( x, z ) ].emplace_back( Launcher );
+        }
+    }
+    ++m_count;
+}
+
+// finds launchers with activation range enclosing any of provided points. returns: list of launchers
+std::vector<TEventLauncher *> const &
+launcher_grid::find( std::vector<glm::dvec3> const &Points ) {
+
+    m_found.clear();
+    for( auto const &point : Points ) {
+        auto const lookup { m_cells.find( key( coordinate( point.x ), coordinate( point.z ) ) ) };
+        if( lookup == m_cells.end() ) { continue; }
+        for( auto *launcher : lookup->second ) {
+            auto const range { launcher_grid::range( launcher ) };
+            if( glm::length2( launcher->location() - point ) >= range * range ) { continue; }
+            // the same launcher can be in range of more than one point
+            if( std::find( std::begin( m_found ), std::end( m_found ), launcher ) != std::end( m_found ) ) { continue; }
+            m_found.emplace_back( launcher );
+        }
+    }
+    return m_found;
+}
+
+// returns key of the grid cell enclosing specified coordinates
+std::uint64_t
+launcher_grid::key( int const X, int const Z ) {
+
+    return ( static_cast<std::uint64_t>( static_cast<std::uint32_t>( X ) ) << 32 ) | static_cast<std::uint32_t>( Z );
+}
+
+// returns grid coordinate enclosing specified world coordinate
+int
+launcher_grid::coordinate( double const Value ) {
+
+    return static_cast<int>( std::floor( Value / EU07_CELLSIZE ) );
+}
+
+// returns activation range of specified launcher
+double
+launcher_grid::range( TEventLauncher const *Launcher ) {
+    // launchers with negative radius used to be active as long as the camera was in nearby sections, emulate that
+    return (
+        Launcher->dRadius < 0.0 ?
+            EU07_SECTIONSIZE :
+            std::sqrt( Launcher->dRadius ) );
+}
+
 
 // potentially activates event handler with the same name as provided node, and within handler activation range
 void
@@ -117,21 +347,6 @@ basic_cell::update_traction( TDynamicObject *Vehicle, int const Pantographindex
     }
 }
 
-// legacy method, updates sounds and polls event launchers within radius around specified point
-void
-basic_cell::update_events() {
-
-    // event launchers
-    for( auto *launcher : m_eventlaunchers ) {
-        if( ( true == ( launcher->check_activation() && launcher->check_conditions() ) )
-         && ( ( launcher->dRadius < 0.0 )
-           || ( SquareMagnitude( launcher->location() - Global.pCamera.Pos ) < launcher->dRadius ) ) ) {
-
-            launch_event( launcher );
-        }
-    }
-}
-
 // legacy method, updates sounds and polls event launchers within radius around specified point
 void
 basic_cell::update_sounds() {
@@ -401,31 +616,20 @@ basic_cell::insert( TMemCell *Memorycell ) {
 void
 basic_cell::erase( TAnimModel *Instance ) {
 
-    auto const flags = Instance->Flags();
-    auto alpha =
-        ( Instance->Material() != nullptr ?
-            Instance->Material()->textures_alpha :
-            0x30300030 );
-
-    if( alpha & flags & 0x2F2F002F ) {
-        // instance has translucent pieces
-        m_instancetranslucent.erase(
-            std::remove_if(
-                std::begin( m_instancetranslucent ), std::end( m_instancetranslucent ),
-                [=]( TAnimModel *instance ) {
-                    return instance == Instance; } ),
-            std::end( m_instancetranslucent ) );
-    }
-    alpha ^= 0x0F0F000F; // odwrócenie flag tekstur, aby wyłapać nieprzezroczyste
-    if( alpha & flags & 0x1F1F001F ) {
-        // instance has opaque pieces
-        m_instancesopaque.erase(
-            std::remove_if(
-                std::begin( m_instancesopaque ), std::end( m_instancesopaque ),
-                [=]( TAnimModel *instance ) {
-                    return instance == Instance; } ),
-            std::end( m_instancesopaque ) );
-    }
+    // NOTE: flags of the instance can change after insertion, if its model was still being loaded at the time
+    // so the instance is looked for in all render phases it could be placed in
+    m_instancetranslucent.erase(
+        std::remove_if(
+            std::begin( m_instancetranslucent ), std::end( m_instancetranslucent ),
+            [=]( TAnimModel *instance ) {
+                return instance == Instance; } ),
+        std::end( m_instancetranslucent ) );
+    m_instancesopaque.erase(
+        std::remove_if(
+            std::begin( m_instancesopaque ), std::end( m_instancesopaque ),
+            [=]( TAnimModel *instance ) {
+                return instance == Instance; } ),
+        std::end( m_instancesopaque ) );
     // TODO: update cell bounding area
 }
 
@@ -660,19 +864,6 @@ basic_section::update_traction( TDynamicObject *Vehicle, int const Pantographind
     }
 }
 
-// legacy method, polls event launchers within radius around specified point
-void
-basic_section::update_events( glm::dvec3 const &Location, float const Radius ) {
-
-    for( auto &cell : m_cells ) {
-
-        if( glm::length2( cell.area().center - Location ) < ( ( cell.area().radius + Radius ) * ( cell.area().radius + Radius ) ) ) {
-            // we reject cells which aren't within our area of interest
-            cell.update_events();
-        }
-    }
-}
-
 // legacy method, updates sounds within radius around specified point
 void
 basic_section::update_sounds( glm::dvec3 const &Location, float const Radius ) {
@@ -950,11 +1141,18 @@ basic_region::on_click( TAnimModel const *Instance ) {
 // legacy method, polls event launchers around camera
 void
 basic_region::update_events() {
-    // render events and sounds from sectors near enough to the viewer
-    auto const range = EU07_SECTIONSIZE; // arbitrary range
-    auto const &sectionlist = sections( Global.pCamera.Pos, range );
-    for( auto *section : sectionlist ) {
-        section->update_events( Global.pCamera.Pos, range );
+
+    update_events( { Global.pCamera.Pos } );
+}
+
+// polls event launchers with activation range enclosing any of provided points
+void
+basic_region::update_events( std::vector<glm::dvec3> const &Locations ) {
+
+    for( auto *launcher : m_launchers.find( Locations ) ) {
+        if( true == ( launcher->check_activation() && launcher->check_conditions() ) ) {
+            basic_cell::launch_event( launcher );
+        }
     }
 }
 
@@ -988,18 +1186,11 @@ basic_region::update_traction( TDynamicObject *Vehicle, int const Pantographinde
     }
 }
 
-// checks whether specified file is a valid region data file
+// checks whether specified file is a valid region data file, created from current version of the scenario files
 bool
 basic_region::is_scene( std::string const &Scenariofile ) const {
 
-    auto filename { Scenariofile };
-    while( filename[ 0 ] == '$' ) {
-        // trim leading $ char rainsted utility may add to the base name for modified .scn files
-        filename.erase( 0, 1 );
-    }
-    erase_extension( filename );
-    filename = Global.asCurrentSceneryPath + filename;
-    filename += EU07_FILEEXTENSION_REGION;
+    auto const filename { region_file( Scenariofile ) };
 
     if( false == FileExists( filename ) ) {
         return false;
@@ -1015,6 +1206,13 @@ basic_region::is_scene( std::string const &Scenariofile ) const {
         // wrong file type
         return false;
     }
+    // source files check
+    content_cache sources;
+    sources.deserialize( input, true );
+    if( false == sources.is_current() ) {
+        WriteLog( "Binary file \"" + filename + "\" is out of date and will be rebuilt" );
+        return false;
+    }
 
     return true;
 }
@@ -1023,21 +1221,16 @@ basic_region::is_scene( std::string const &Scenariofile ) const {
 void
 basic_region::serialize( std::string const &Scenariofile ) const {
 
-    auto filename { Scenariofile };
-    while( filename[ 0 ] == '$' ) {
-        // trim leading $ char rainsted utility may add to the base name for modified .scn files
-        filename.erase( 0, 1 );
-    }
-    erase_extension( filename );
-    filename = Global.asCurrentSceneryPath + filename;
-    filename += EU07_FILEEXTENSION_REGION;
+    auto const filename { region_file( Scenariofile ) };
 
     std::ofstream output { filename, std::ios::binary };
 
-    // region file version 1
+    // region file version 2
     // header: EU07SBT + version (0-255)
     sn_utils::ls_uint32( output, EU07_FILEHEADER );
     sn_utils::ls_uint32( output, EU07_FILEVERSION_REGION );
+    // source files and cached nodes
+    m_content.serialize( output );
     // sections
     // TBD, TODO: build table of sections and file offsets, if we postpone section loading until they're within range
     std::uint32_t sectioncount { 0 };
@@ -1062,19 +1255,12 @@ basic_region::serialize( std::string const &Scenariofile ) const {
 bool
 basic_region::deserialize( std::string const &Scenariofile ) {
 
-    auto filename { Scenariofile };
-    while( filename[ 0 ] == '$' ) {
-        // trim leading $ char rainsted utility may add to the base name for modified .scn files
-        filename.erase( 0, 1 );
-    }
-    erase_extension( filename );
-    filename = Global.asCurrentSceneryPath + filename;
-    filename += EU07_FILEEXTENSION_REGION;
+    auto const filename { region_file( Scenariofile ) };
 
     if( false == FileExists( filename ) ) {
         return false;
     }
-    // region file version 1
+    // region file version 2
     // file type and version check
     std::ifstream input( filename, std::ios::binary );
 
@@ -1087,6 +1273,8 @@ basic_region::deserialize( std::string const &Scenariofile ) {
         WriteLog( "Bad file: \"" + filename + "\" is of either unrecognized type or version" );
         return false;
     }
+    // source files and cached nodes, restored separately
+    content_cache().deserialize( input, true );
     // sections
     // TBD, TODO: build table of sections and file offsets, if we postpone section loading until they're within range
     // section count
@@ -1104,6 +1292,31 @@ basic_region::deserialize( std::string const &Scenariofile ) {
     return true;
 }
 
+// restores cached nodes and events from file with specified name. returns: true on success, false otherwise
+bool
+basic_region::deserialize_content( std::string const &Scenariofile ) {
+
+    auto const filename { region_file( Scenariofile ) };
+
+    if( false == FileExists( filename ) ) {
+        return false;
+    }
+    std::ifstream input( filename, std::ios::binary );
+
+    uint32_t headermain { sn_utils::ld_uint32( input ) };
+    uint32_t headertype { sn_utils::ld_uint32( input ) };
+
+    if( ( headermain != EU07_FILEHEADER
+     || ( headertype != EU07_FILEVERSION_REGION ) ) ) {
+        // wrong file type
+        WriteLog( "Bad file: \"" + filename + "\" is of either unrecognized type or version" );
+        return false;
+    }
+    m_content.deserialize( input );
+
+    return ( false == input.fail() );
+}
+
 // sends content of the class in legacy (text) format to provided stream
 void
 basic_region::export_as_text( std::ostream &Output ) const {
@@ -1291,6 +1504,20 @@ basic_region::insert( lines_node Lines, scratch_data &Scratchpad ) {
     }
 }
 
+// inserts provided event launcher in the region and in the launcher index
+void
+basic_region::insert( TEventLauncher *Launcher ) {
+
+    auto const location { Launcher->location() };
+    if( false == point_inside( location ) ) {
+        // NOTE: nodes placed outside of region boundaries are discarded
+        return;
+    }
+    // cell copy serves activation by click, the index serves activation by proximity
+    section( location ).insert( Launcher );
+    m_launchers.insert( Launcher );
+}
+
 // find a vehicle located neares to specified location, within specified radius, optionally discarding vehicles without drivers
 std::tuple<TDynamicObject *, float>
 basic_region::find_vehicle( glm::dvec3 const &Point, float const Radius, bool const Onlycontrolled, bool const Findbycoupler ) {
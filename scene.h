@@ -14,6 +14,7 @@ http://mozilla.org/MPL/2.0/.
 #include <array>
 #include <stack>
 #include <unordered_set>
+#include <unordered_map>
 
 #include "parser.h"
 #include "openglgeometrybank.h"
@@ -34,6 +35,7 @@ struct scratch_data {
     struct binary_data {
 
         bool terrain{ false };
+        bool nodes{ false }; // nodes and events are restored from binary copy of their definitions
     } binary;
 
     struct location_data {
@@ -58,6 +60,100 @@ struct scratch_data {
     bool initialized { false };
 };
 
+// binary copy of scenario nodes and events, replayed during scenario import in place of their text definitions
+class content_cache {
+
+public:
+// methods
+    // records provided files as sources of the cached content
+    void
+        sources( std::vector<std::string> const &Files );
+    // checks whether the content was created from current version of its source files, with current import settings
+    bool
+        is_current() const;
+    // adds provided node to the cache, under specified type and name
+    void
+        insert( std::string const &Type, std::string const &Name, basic_node const &Node );
+    // adds provided event to the cache, under specified type and name
+    void
+        insert( std::string const &Type, std::string const &Name, basic_event const &Event );
+    // checks whether next cached item has specified type and name. returns: true if it does, false otherwise
+    // NOTE: on success the data of the item can be retrieved from input()
+    bool
+        match( std::string const &Type, std::string const &Name );
+    // provides access to data of the matched item
+    std::istream &
+        input() {
+            return m_data; }
+    // returns number of cached items
+    std::uint32_t
+        size() const {
+            return m_count; }
+    // stores content of the class in provided stream
+    void
+        serialize( std::ostream &Output ) const;
+    // restores content of the class from provided stream. cached items can be skipped, leaving only list of source files
+    void
+        deserialize( std::istream &Input, bool const Skipcontent = false );
+
+private:
+// types
+    struct source_file {
+        std::string name;
+        std::uint64_t size { 0 };
+        std::uint64_t hash { 0 };
+    };
+// methods
+    // returns description of settings which affect content of imported nodes
+    static
+    std::string
+        settings();
+// members
+    std::vector<source_file> m_sources;
+    std::string m_settings;
+    std::stringstream m_data;
+    std::uint32_t m_count { 0 };
+};
+
+// spatial index of event launchers, holds each launcher in all grid cells overlapped by its activation range
+class launcher_grid {
+
+public:
+// methods
+    // adds provided launcher to the index
+    void
+        insert( TEventLauncher *Launcher );
+    // finds launchers with activation range enclosing any of provided points. returns: list of launchers
+    std::vector<TEventLauncher *> const &
+        find( std::vector<glm::dvec3> const &Points );
+    // returns number of indexed launchers
+    std::size_t
+        size() const {
+            return m_count; }
+
+private:
+// types
+    using launcher_sequence = std::vector<TEventLauncher *>;
+    using cell_map = std::unordered_map<std::uint64_t, launcher_sequence>;
+// methods
+    // returns key of the grid cell enclosing specified coordinates
+    static
+    std::uint64_t
+        key( int const X, int const Z );
+    // returns grid coordinate enclosing specified world coordinate
+    static
+    int
+        coordinate( double const Value );
+    // returns activation range of specified launcher
+    static
+    double
+        range( TEventLauncher const *Launcher );
+// members
+    cell_map m_cells;
+    launcher_sequence m_found; // results of the last query
+    std::size_t m_count { 0 };
+};
+
 // basic element of rudimentary partitioning scheme for the section. fixed size, no further subdivision
 // TBD, TODO: replace with quadtree scheme?
 class basic_cell {
@@ -74,9 +170,6 @@ public:
     // legacy method, finds and assigns traction piece to specified pantograph of provided vehicle
     void
         update_traction( TDynamicObject *Vehicle, int const Pantographindex );
-    // legacy method, polls event launchers within radius around specified point
-    void
-        update_events();
     // legacy method, updates sounds within radius around specified point
     void
         update_sounds();
@@ -156,6 +249,10 @@ public:
     bounding_area const &
         area() const {
             return m_area; }
+    // executes event assigned to specified launcher
+    static
+    void
+        launch_event( TEventLauncher *Launcher );
 private:
 // types
     using path_sequence = std::vector<TTrack *>;
@@ -167,8 +264,6 @@ private:
     using eventlauncher_sequence = std::vector<TEventLauncher *>;
     using memorycell_sequence = std::vector<TMemCell *>;
 // methods
-    void
-        launch_event( TEventLauncher *Launcher );
     void
         enclose_area( scene::basic_node *Node );
 // members
@@ -211,9 +306,6 @@ public:
     void
         update_traction( TDynamicObject *Vehicle, int const Pantographindex );
     // legacy method, updates sounds and polls event launchers within radius around specified point
-    void
-        update_events( glm::dvec3 const &Location, float const Radius );
-    // legacy method, updates sounds and polls event launchers within radius around specified point
     void
         update_sounds( glm::dvec3 const &Location, float const Radius );
     // legacy method, triggers radio-stop procedure for all vehicles in 2km radius around specified location
@@ -319,10 +411,13 @@ public:
     // legacy method, polls event launchers around camera
     void
         update_events();
+    // polls event launchers with activation range enclosing any of provided points
+    void
+        update_events( std::vector<glm::dvec3> const &Locations );
     // legacy method, updates sounds around camera
     void
         update_sounds();
-    // checks whether specified file is a valid region data file
+    // checks whether specified file is a valid region data file, created from current version of the scenario files
     bool
         is_scene( std::string const &Scenariofile ) const;
     // stores content of the class in file with specified name
@@ -331,6 +426,13 @@ public:
     // restores content of the class from file with specified name. returns: true on success, false otherwise
     bool
         deserialize( std::string const &Scenariofile );
+    // restores cached nodes and events from file with specified name. returns: true on success, false otherwise
+    bool
+        deserialize_content( std::string const &Scenariofile );
+    // provides access to binary copy of scenario nodes and events
+    content_cache &
+        content() {
+            return m_content; }
     // sends content of the class in legacy (text) format to provided stream
     void
         export_as_text( std::ostream &Output ) const;
@@ -356,6 +458,9 @@ public:
                 // TBD, TODO: clamp coordinates to region boundaries?
                 return; }
             section( location ).insert( Node ); }
+    // inserts provided event launcher in the region and in the launcher index
+    void
+        insert( TEventLauncher *Launcher );
     // inserts provided node in the region and registers its ends in lookup directory
     template <class Type_>
     void
@@ -411,6 +516,8 @@ private:
 // members
     section_array m_sections;
     region_scratchpad m_scratchpad;
+    content_cache m_content;
+    launcher_grid m_launchers; // launchers activated by proximity
 
 };
 
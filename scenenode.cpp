@@ -196,24 +196,24 @@ shape_node::import( cParser &Input, scene::node_data const &Nodedata ) {
         m_data.material != null_handle ?
             GfxRenderer.Material( m_data.material ).texture1 :
             null_handle );
-    auto const &texture = (
+    auto const *texture = (
         texturehandle ?
-            GfxRenderer.Texture( texturehandle ) :
-            opengl_texture() ); // dirty workaround for lack of better api
+            &GfxRenderer.Texture( texturehandle ) :
+            nullptr );
     bool const clamps = (
         texturehandle ?
-            texture.traits.find( 's' ) != std::string::npos :
+            texture->traits.find( 's' ) != std::string::npos :
             false );
     bool const clampt = (
         texturehandle ?
-            texture.traits.find( 't' ) != std::string::npos :
+            texture->traits.find( 't' ) != std::string::npos :
             false );
 
     // remainder of legacy 'problend' system -- geometry assigned a texture with '@' in its name is treated as translucent, opaque otherwise
     if( texturehandle != null_handle ) {
         m_data.translucent = (
-            ( ( texture.name.find( '@' ) != std::string::npos )
-           && ( true == texture.has_alpha ) ) ?
+            ( ( texture->name.find( '@' ) != std::string::npos )
+           && ( true == texture->has_alpha ) ) ?
                 true :
                 false );
     }
@@ -23,6 +23,7 @@ http://mozilla.org/MPL/2.0/.
 #include "lightarray.h"
 #include "scene.h"
 #include "Train.h"
+#include "Logs.h"
 
 namespace simulation {
 
@@ -46,6 +47,13 @@ bool is_ready { false };
 bool
 state_manager::deserialize( std::string const &Scenariofile ) {
 
+    // the simulation draws from a sequence of its own, so runs with the same seed and input give the same results
+    if( Global.RandomSeed == 0 ) {
+        Global.RandomSeed = static_cast<unsigned int>( std::time( nullptr ) );
+    }
+    Global.random_engine.seed( Global.RandomSeed );
+    WriteLog( "Random seed: " + std::to_string( Global.RandomSeed ) );
+
     return m_serializer.deserialize( Scenariofile );
 }
 
@@ -32,6 +32,20 @@ state_serializer::deserialize( std::string const &Scenariofile ) {
     SafeDelete( Region );
     Region = new scene::basic_region();
 
+    auto const timestart { std::chrono::steady_clock::now() };
+    {
+        // map and tokenise the scenario and its includes ahead of parsing. each level of includes is processed concurrently
+        threading::task_pool workers;
+        workers.resize( static_cast<std::size_t>( Global.ScenarioLoaderThreads ) );
+        auto const preload { cParser::preload( Scenariofile, Global.asCurrentSceneryPath, Global.bLoadTraction, workers ) };
+        WriteLog(
+            "Scenario files preloaded: " + std::to_string( preload.files ) + " files, "
+            + to_string( preload.bytes / 1048576.0, 1 ) + " MB; "
+            + to_string( preload.wall, 0 ) + " ms with " + std::to_string( workers.size() ) + " worker threads, "
+            + to_string( preload.serial, 0 ) + " ms serial time" );
+    }
+    auto const timepreload { std::chrono::steady_clock::now() };
+
     // TODO: check first for presence of serialized binary files
     // if this fails, fall back on the legacy text format
     scene::scratch_data importscratchpad;
@@ -40,19 +54,35 @@ state_serializer::deserialize( std::string const &Scenariofile ) {
         // compilation to binary file isn't supported for rainsted-created overrides
         // NOTE: we postpone actual loading of the scene until we process time, season and weather data
         importscratchpad.binary.terrain = Region->is_scene( Scenariofile ) ;
+        // nodes and events are replayed from the same file, in place of their text definitions
+        importscratchpad.binary.nodes = (
+            ( true == importscratchpad.binary.terrain )
+         && ( true == Region->deserialize_content( Scenariofile ) ) );
     }
     // NOTE: for the time being import from text format is a given, since we don't have full binary serialization
     cParser scenarioparser( Scenariofile, cParser::buffer_FILE, Global.asCurrentSceneryPath, Global.bLoadTraction );
 
-    if( false == scenarioparser.ok() ) { return false; }
+    if( false == scenarioparser.ok() ) {
+        cParser::release();
+        return false;
+    }
 
     deserialize( scenarioparser, importscratchpad );
     if( ( false == importscratchpad.binary.terrain )
      && ( Scenariofile != "$.scn" ) ) {
         // if we didn't find usable binary version of the scenario files, create them now for future use
         // as long as the scenario file wasn't rainsted-created base file override
+        Region->content().sources( scenarioparser.Files() );
         Region->serialize( Scenariofile );
     }
+    cParser::release();
+
+    auto const timeend { std::chrono::steady_clock::now() };
+    WriteLog(
+        "Scenario \"" + Scenariofile + "\" loaded in " + to_string( std::chrono::duration<double, std::milli>( timeend - timestart ).count(), 0 ) + " ms"
+        + " (preload: " + to_string( std::chrono::duration<double, std::milli>( timepreload - timestart ).count(), 0 ) + " ms"
+        + ", import: " + to_string( std::chrono::duration<double, std::milli>( timeend - timepreload ).count(), 0 ) + " ms)" );
+
     return true;
 }
 
@@ -110,6 +140,7 @@ state_serializer::deserialize( cParser &Input, scene::scratch_data &Scratchpad )
             ErrorLog( "Bad scenario: unexpected token \"" + token + "\" defined in file \"" + Input.Name() + "\" (line " + std::to_string( Input.Line() - 1 ) + ")" );
         }
 
+#ifndef EU07_HEADLESS
         timenow = std::chrono::steady_clock::now();
         if( std::chrono::duration_cast<std::chrono::milliseconds>( timenow - timelast ).count() >= 200 ) {
             timelast = timenow;
@@ -117,6 +148,7 @@ state_serializer::deserialize( cParser &Input, scene::scratch_data &Scratchpad )
             Application.set_progress( Input.getProgress(), Input.getFullProgress() );
             GfxRenderer.Render();
         }
+#endif
 
         token = Input.getToken<std::string>();
     }
@@ -260,7 +292,19 @@ state_serializer::deserialize_event( cParser &Input, scene::scratch_data &Scratc
         return;
     }
 
-    event->deserialize( Input, Scratchpad );
+    auto const cachekey { event->m_name + ':' + std::to_string( Input.Line() ) };
+    if( ( true == Scratchpad.binary.nodes )
+     && ( true == Region->content().match( "event", cachekey ) ) ) {
+        skip_until( Input, "endevent" );
+        event->deserialize( Region->content().input() );
+    }
+    else {
+        event->deserialize( Input, Scratchpad );
+        if( ( false == Scratchpad.binary.terrain )
+         && ( Scratchpad.name != "$.scn" ) ) {
+            Region->content().insert( "event", cachekey, *event );
+        }
+    }
 
     if( true == simulation::Events.insert( event ) ) {
         scene::Groups.insert( scene::Groups.handle(), event );
@@ -670,6 +714,10 @@ state_serializer::deserialize_path( cParser &Input, scene::scratch_data &Scratch
 
     // TODO: refactor track and wrapper classes and their de/serialization. do offset and rotation after deserialization is done
     auto *track = new TTrack( Nodedata );
+    auto const cachekey { Nodedata.name + ':' + std::to_string( Input.Line() ) };
+    if( true == restore_node( Input, Scratchpad, Nodedata.type, cachekey, "endtrack", *track ) ) {
+        return track;
+    }
     auto const offset { (
         Scratchpad.location.offset.empty() ?
             glm::dvec3 { 0.0 } :
@@ -678,6 +726,7 @@ state_serializer::deserialize_path( cParser &Input, scene::scratch_data &Scratch
                 Scratchpad.location.offset.top().y,
                 Scratchpad.location.offset.top().z } ) };
     track->Load( &Input, offset );
+    cache_node( Scratchpad, Nodedata.type, cachekey, *track );
 
     return track;
 }
@@ -691,11 +740,16 @@ state_serializer::deserialize_traction( cParser &Input, scene::scratch_data &Scr
     }
     // TODO: refactor track and wrapper classes and their de/serialization. do offset and rotation after deserialization is done
     auto *traction = new TTraction( Nodedata );
+    auto const cachekey { Nodedata.name + ':' + std::to_string( Input.Line() ) };
+    if( true == restore_node( Input, Scratchpad, Nodedata.type, cachekey, "endtraction", *traction ) ) {
+        return traction;
+    }
     auto offset = (
         Scratchpad.location.offset.empty() ?
             glm::dvec3() :
             Scratchpad.location.offset.top() );
     traction->Load( &Input, offset );
+    cache_node( Scratchpad, Nodedata.type, cachekey, *traction );
 
     return traction;
 }
@@ -709,9 +763,14 @@ state_serializer::deserialize_tractionpowersource( cParser &Input, scene::scratc
     }
 
     auto *powersource = new TTractionPowerSource( Nodedata );
+    auto const cachekey { Nodedata.name + ':' + std::to_string( Input.Line() ) };
+    if( true == restore_node( Input, Scratchpad, Nodedata.type, cachekey, "end", *powersource ) ) {
+        return powersource;
+    }
     powersource->Load( &Input );
     // adjust location
     powersource->location( transform( powersource->location(), Scratchpad ) );
+    cache_node( Scratchpad, Nodedata.type, cachekey, *powersource );
 
     return powersource;
 }
@@ -720,9 +779,14 @@ TMemCell *
 state_serializer::deserialize_memorycell( cParser &Input, scene::scratch_data &Scratchpad, scene::node_data const &Nodedata ) {
 
     auto *memorycell = new TMemCell( Nodedata );
+    auto const cachekey { Nodedata.name + ':' + std::to_string( Input.Line() ) };
+    if( true == restore_node( Input, Scratchpad, Nodedata.type, cachekey, "endmemcell", *memorycell ) ) {
+        return memorycell;
+    }
     memorycell->Load( &Input );
     // adjust location
     memorycell->location( transform( memorycell->location(), Scratchpad ) );
+    cache_node( Scratchpad, Nodedata.type, cachekey, *memorycell );
 
     return memorycell;
 }
@@ -730,6 +794,15 @@ state_serializer::deserialize_memorycell( cParser &Input, scene::scratch_data &S
 TEventLauncher *
 state_serializer::deserialize_eventlauncher( cParser &Input, scene::scratch_data &Scratchpad, scene::node_data const &Nodedata ) {
 
+    auto const cachekey { Nodedata.name + ':' + std::to_string( Input.Line() ) };
+    if( true == Scratchpad.binary.nodes ) {
+        auto *eventlauncher = new TEventLauncher( Nodedata );
+        if( true == restore_node( Input, Scratchpad, Nodedata.type, cachekey, "end", *eventlauncher ) ) {
+            return eventlauncher;
+        }
+        delete eventlauncher;
+    }
+
     glm::dvec3 location;
     Input.getTokens( 3 );
     Input
@@ -740,6 +813,7 @@ state_serializer::deserialize_eventlauncher( cParser &Input, scene::scratch_data
     auto *eventlauncher = new TEventLauncher( Nodedata );
     eventlauncher->Load( &Input );
     eventlauncher->location( transform( location, Scratchpad ) );
+    cache_node( Scratchpad, Nodedata.type, cachekey, *eventlauncher );
 
     return eventlauncher;
 }
@@ -747,6 +821,18 @@ state_serializer::deserialize_eventlauncher( cParser &Input, scene::scratch_data
 TAnimModel *
 state_serializer::deserialize_model( cParser &Input, scene::scratch_data &Scratchpad, scene::node_data const &Nodedata ) {
 
+    // terrain models are converted to shapes and discarded, so they don't go through the cache
+    auto const iscached { Nodedata.range_min >= 0.0 };
+    auto const cachekey { Nodedata.name + ':' + std::to_string( Input.Line() ) };
+    if( ( true == iscached )
+     && ( true == Scratchpad.binary.nodes ) ) {
+        auto *instance = new TAnimModel( Nodedata );
+        if( true == restore_node( Input, Scratchpad, Nodedata.type, cachekey, "endmodel", *instance ) ) {
+            return instance;
+        }
+        delete instance;
+    }
+
     glm::dvec3 location;
     glm::vec3 rotation;
     Input.getTokens( 4 );
@@ -761,6 +847,9 @@ state_serializer::deserialize_model( cParser &Input, scene::scratch_data &Scratc
 
     if( instance->Load( &Input, false ) ) {
         instance->location( transform( location, Scratchpad ) );
+        if( true == iscached ) {
+            cache_node( Scratchpad, Nodedata.type, cachekey, *instance );
+        }
     }
     else {
         // model nie wczytał się - ignorowanie node
@@ -934,6 +1023,33 @@ state_serializer::skip_until( cParser &Input, std::string const &Token ) {
     }
 }
 
+// restores provided node from binary copy of its definition, skipping the text definition. returns: true on success, false otherwise
+bool
+state_serializer::restore_node( cParser &Input, scene::scratch_data const &Scratchpad, std::string const &Type, std::string const &Key, std::string const &Terminator, scene::basic_node &Node ) {
+
+    if( ( false == Scratchpad.binary.nodes )
+     || ( false == Region->content().match( Type, Key ) ) ) {
+        // nodes without cached copy (e.g. ones which failed to load) fall back on the text definition
+        return false;
+    }
+    skip_until( Input, Terminator );
+    Node.deserialize( Region->content().input() );
+
+    return true;
+}
+
+// adds provided node to binary copy of scenario definitions, if one is being created
+void
+state_serializer::cache_node( scene::scratch_data const &Scratchpad, std::string const &Type, std::string const &Key, scene::basic_node const &Node ) {
+
+    // the copy is only stored along with the rest of the region file
+    if( ( true == Scratchpad.binary.terrain )
+     || ( Scratchpad.name == "$.scn" ) ) {
+        return;
+    }
+    Region->content().insert( Type, Key, Node );
+}
+
 // transforms provided location by specifed rotation and offset
 glm::dvec3
 state_serializer::transform( glm::dvec3 Location, scene::scratch_data const &Scratchpad ) {
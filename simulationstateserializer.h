@@ -59,6 +59,10 @@ private:
     sound_source * deserialize_sound( cParser &Input, scene::scratch_data &Scratchpad, scene::node_data const &Nodedata );
     // skips content of stream until specified token
     void skip_until( cParser &Input, std::string const &Token );
+    // restores provided node from binary copy of its definition, skipping the text definition. returns: true on success, false otherwise
+    bool restore_node( cParser &Input, scene::scratch_data const &Scratchpad, std::string const &Type, std::string const &Key, std::string const &Terminator, scene::basic_node &Node );
+    // adds provided node to binary copy of scenario definitions, if one is being created
+    void cache_node( scene::scratch_data const &Scratchpad, std::string const &Type, std::string const &Key, scene::basic_node const &Node );
     // transforms provided location by specifed rotation and offset
     glm::dvec3 transform( glm::dvec3 Location, scene::scratch_data const &Scratchpad );
 };
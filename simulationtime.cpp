@@ -21,10 +21,6 @@ scenario_time Time;
 
 void
 scenario_time::init() {
-    char monthdaycounts[ 2 ][ 13 ] = {
-        { 0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 },
-        { 0, 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 } };
-    ::memcpy( m_monthdaycounts, monthdaycounts, sizeof( monthdaycounts ) );
 
     // potentially adjust scenario clock
     auto const requestedtime { clamp_circular<int>( m_time.wHour * 60 + m_time.wMinute + Global.ScenarioTimeOffset * 60, 24 * 60 ) };
@@ -67,6 +63,23 @@ scenario_time::init() {
         m_time.wSecond = 0;
     }
 
+    init_calendar();
+}
+
+// sets the clock to specified date and time, e.g. the start time of a recorded run
+void
+scenario_time::init( SYSTEMTIME const &Time ) {
+
+    m_time = Time;
+    m_milliseconds = 0.0;
+
+    init_calendar();
+}
+
+// calculates day of year and time zone bias for current date
+void
+scenario_time::init_calendar() {
+
     m_yearday = year_day( m_time.wDay, m_time.wMonth, m_time.wYear );
 
     // calculate time zone bias
@@ -21,6 +21,9 @@ public:
         m_time.wHour = 10; m_time.wMinute = 30; }
     void
         init();
+    // sets the clock to specified date and time, e.g. the start time of a recorded run
+    void
+        init( SYSTEMTIME const &Time );
     void
         update( double const Deltatime );
     inline
@@ -67,11 +70,16 @@ private:
     // returns number of days between specified days of week
     int
         weekdays( int const First, int const Second ) const;
+    // calculates day of year and time zone bias for current date
+    void
+        init_calendar();
 
     SYSTEMTIME m_time;
     double m_milliseconds{ 0.0 };
     int m_yearday;
-    char m_monthdaycounts[ 2 ][ 13 ];
+    char m_monthdaycounts[ 2 ][ 13 ] {
+        { 0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 },
+        { 0, 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 } };
     double m_timezonebias{ 0.0 };
 };
 
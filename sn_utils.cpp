@@ -38,6 +38,18 @@ int32_t sn_utils::ld_int32(std::istream &s)
 	return reinterpret_cast<int32_t&>(v);
 }
 
+// deserialize little endian uint64
+uint64_t sn_utils::ld_uint64(std::istream &s)
+{
+	uint8_t buf[8];
+	s.read((char*)buf, 8);
+	uint64_t v = ((uint64_t)buf[7] << 56) | ((uint64_t)buf[6] << 48) |
+		         ((uint64_t)buf[5] << 40) | ((uint64_t)buf[4] << 32) |
+	             ((uint64_t)buf[3] << 24) | ((uint64_t)buf[2] << 16) |
+		         ((uint64_t)buf[1] << 8) | (uint64_t)buf[0];
+	return v;
+}
+
 // deserialize little endian ieee754 float32
 float sn_utils::ld_float32(std::istream &s)
 {
@@ -68,7 +80,7 @@ std::string sn_utils::d_str(std::istream &s)
 	while (true)
 	{
 		s.read(buf, 1);
-		if (buf[0] == 0)
+		if (!s || buf[0] == 0)
 			break;
 		r.push_back(buf[0]);
 	}
@@ -97,6 +109,90 @@ glm::vec4 sn_utils::d_vec4( std::istream& s)
         ld_float32(s) };
 }
 
+void sn_reader::check(std::size_t const Size) const
+{
+	if (Size > m_size - std::min(m_position, m_size))
+		throw std::runtime_error("sn: read past the end of data");
+}
+
+void sn_reader::read(void *Destination, std::size_t const Size)
+{
+	std::memcpy(Destination, skip(Size), Size);
+}
+
+char const *sn_reader::skip(std::size_t const Size)
+{
+	check(Size);
+	auto const *data = m_data + m_position;
+	m_position += Size;
+	return data;
+}
+
+void sn_reader::seek(std::size_t const Position)
+{
+	if (Position > m_size)
+		throw std::runtime_error("sn: seek past the end of data");
+	m_position = Position;
+}
+
+// deserialize little endian uint32
+uint32_t sn_utils::ld_uint32(sn_reader &s)
+{
+	auto const *buf = reinterpret_cast<uint8_t const *>(s.skip(4));
+	return ((uint32_t)buf[3] << 24) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[1] << 8) | (uint32_t)buf[0];
+}
+
+// deserialize little endian int32
+int32_t sn_utils::ld_int32(sn_reader &s)
+{
+	uint32_t v = ld_uint32(s);
+	return reinterpret_cast<int32_t&>(v);
+}
+
+// deserialize little endian ieee754 float32
+float sn_utils::ld_float32(sn_reader &s)
+{
+	uint32_t v = ld_uint32(s);
+	return reinterpret_cast<float&>(v);
+}
+
+// deserialize little endian ieee754 float64
+double sn_utils::ld_float64(sn_reader &s)
+{
+	auto const *buf = reinterpret_cast<uint8_t const *>(s.skip(8));
+	uint64_t v = ((uint64_t)buf[7] << 56) | ((uint64_t)buf[6] << 48) |
+		         ((uint64_t)buf[5] << 40) | ((uint64_t)buf[4] << 32) |
+	             ((uint64_t)buf[3] << 24) | ((uint64_t)buf[2] << 16) |
+		         ((uint64_t)buf[1] << 8) | (uint64_t)buf[0];
+	return reinterpret_cast<double&>(v);
+}
+
+// deserialize null-terminated string. string running to the end of data is accepted, same as for streams
+std::string sn_utils::d_str(sn_reader &s)
+{
+	auto const remaining = s.size() - s.tell();
+	auto const *data = s.skip(0);
+	auto const *terminator = static_cast<char const *>(std::memchr(data, 0, remaining));
+	auto const length = (terminator ? terminator - data : remaining);
+	s.skip(terminator ? length + 1 : length);
+	return std::string(data, length);
+}
+
+glm::vec4 sn_utils::d_vec4(sn_reader &s)
+{
+    return {
+        ld_float32(s),
+        ld_float32(s),
+        ld_float32(s),
+        ld_float32(s) };
+}
+
+bool sn_utils::is_little_endian()
+{
+	uint32_t const probe = 1;
+	return *reinterpret_cast<uint8_t const *>(&probe) == 1;
+}
+
 void sn_utils::ls_uint16(std::ostream &s, uint16_t v)
 {
 	uint8_t buf[2];
@@ -125,6 +221,20 @@ void sn_utils::ls_int32(std::ostream &s, int32_t v)
 	s.write((char*)buf, 4);
 }
 
+void sn_utils::ls_uint64(std::ostream &s, uint64_t v)
+{
+	uint8_t buf[8];
+	buf[0] = v;
+	buf[1] = v >> 8;
+	buf[2] = v >> 16;
+	buf[3] = v >> 24;
+	buf[4] = v >> 32;
+	buf[5] = v >> 40;
+	buf[6] = v >> 48;
+	buf[7] = v >> 56;
+	s.write((char*)buf, 8);
+}
+
 void sn_utils::ls_float32(std::ostream &s, float t)
 {
 	uint32_t v = reinterpret_cast<uint32_t&>(t);
@@ -4,12 +4,38 @@
 
 #include <string>
 
+// sequential reader of serialized data stored in a memory block, e.g. a mapped file
+// reads past the end of the block throw std::runtime_error
+class sn_reader
+{
+public:
+    sn_reader( char const *Data, std::size_t const Size ) :
+        m_data( Data ), m_size( Size )
+    {}
+    // copies specified number of bytes to provided destination
+    void read( void *Destination, std::size_t const Size );
+    // provides direct access to specified number of bytes at current position, and moves past them
+    char const *skip( std::size_t const Size );
+    void seek( std::size_t const Position );
+    std::size_t tell() const { return m_position; }
+    std::size_t size() const { return m_size; }
+
+private:
+    // throws if the block doesn't hold specified number of bytes past current position
+    void check( std::size_t const Size ) const;
+
+    char const *m_data;
+    std::size_t m_size;
+    std::size_t m_position { 0 };
+};
+
 class sn_utils
 {
 public:
 	static uint16_t ld_uint16(std::istream&);
 	static uint32_t ld_uint32(std::istream&);
 	static int32_t ld_int32(std::istream&);
+	static uint64_t ld_uint64(std::istream&);
 	static float ld_float32(std::istream&);
 	static double ld_float64(std::istream&);
 	static std::string d_str(std::istream&);
@@ -17,9 +43,19 @@ public:
     static glm::dvec3 d_dvec3(std::istream&);
     static glm::vec4 d_vec4(std::istream&);
 
+	static uint32_t ld_uint32(sn_reader&);
+	static int32_t ld_int32(sn_reader&);
+	static float ld_float32(sn_reader&);
+	static double ld_float64(sn_reader&);
+	static std::string d_str(sn_reader&);
+    static glm::vec4 d_vec4(sn_reader&);
+    // true if the memory layout of numbers on the host matches serialized data, allowing bulk copies
+    static bool is_little_endian();
+
 	static void ls_uint16(std::ostream&, uint16_t);
 	static void ls_uint32(std::ostream&, uint32_t);
 	static void ls_int32(std::ostream&, int32_t);
+	static void ls_uint64(std::ostream&, uint64_t);
 	static void ls_float32(std::ostream&, float);
 	static void ls_float64(std::ostream&, double);
 	static void s_str(std::ostream&, std::string);
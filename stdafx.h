@@ -43,6 +43,8 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <charconv>
 #include <array>
 #include <vector>
 #include <deque>
@@ -58,6 +60,7 @@
 #include <iterator>
 #include <random>
 #include <algorithm>
+#include <numeric>
 #include <functional>
 #include <regex>
 #include <limits>
@@ -66,6 +69,7 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <future>
 #include <typeinfo>
 
 #ifdef EU07_BUILD_STATIC
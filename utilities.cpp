@@ -17,6 +17,8 @@ Copyright (C) 2007-2014 Maciej Cierniak
 #include <sys/stat.h>
 #ifndef WIN32
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #endif
 
 #ifdef WIN32
@@ -103,10 +105,35 @@ bool ClearFlag( int &Flag, int const Value ) {
     }
 }
 
+namespace {
+// engine used by Random() calls made by the current thread, if different from the global one
+thread_local std::minstd_rand *random_source { nullptr };
+}
+
 double Random(double a, double b)
 {
     std::uniform_real_distribution<> dis(a, b);
-    return dis(Global.random_engine);
+    return (
+        random_source != nullptr ?
+            dis( *random_source ) :
+            dis( Global.random_engine ) );
+}
+
+double LocalRandom(double a, double b)
+{
+    std::uniform_real_distribution<> dis(a, b);
+    return dis( Global.local_random_engine );
+}
+
+random_scope::random_scope( std::minstd_rand &Engine ) :
+    m_previous( random_source ) {
+
+    random_source = &Engine;
+}
+
+random_scope::~random_scope() {
+
+    random_source = m_previous;
 }
 
 bool FuzzyLogic(double Test, double Threshold, double Probability)
@@ -368,6 +395,87 @@ last_modified( std::string const &Filename ) {
 		return 0;
 }
 
+// maps content of specified file. returns: true on success
+bool
+mapped_file::open( std::string const &Filename ) {
+
+    close();
+#ifdef _WIN32
+    m_file = ::CreateFileA( Filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+    if( m_file == INVALID_HANDLE_VALUE ) { return false; }
+    ::LARGE_INTEGER filesize;
+    if( FALSE == ::GetFileSizeEx( m_file, &filesize ) ) {
+        close();
+        return false;
+    }
+    m_size = static_cast<std::size_t>( filesize.QuadPart );
+    if( m_size > 0 ) {
+        // NOTE: mapping of an empty file fails, so it's skipped
+        m_mapping = ::CreateFileMappingA( m_file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        if( m_mapping != nullptr ) {
+            m_data = static_cast<char const *>( ::MapViewOfFile( m_mapping, FILE_MAP_READ, 0, 0, 0 ) );
+        }
+        if( m_data == nullptr ) {
+            close();
+            return false;
+        }
+    }
+#else
+    auto const file { ::open( Filename.c_str(), O_RDONLY ) };
+    if( file == -1 ) { return false; }
+    struct stat filestat;
+    if( ( ::fstat( file, &filestat ) != 0 )
+     || ( false == S_ISREG( filestat.st_mode ) ) ) {
+        ::close( file );
+        return false;
+    }
+    m_size = static_cast<std::size_t>( filestat.st_size );
+    if( m_size > 0 ) {
+        auto *data { ::mmap( nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0 ) };
+        if( data == MAP_FAILED ) {
+            ::close( file );
+            m_size = 0;
+            return false;
+        }
+        ::madvise( data, m_size, MADV_SEQUENTIAL );
+        m_data = static_cast<char const *>( data );
+    }
+    // the mapping stays valid after the file is closed
+    ::close( file );
+#endif
+    m_open = true;
+    return true;
+}
+
+void
+mapped_file::close() {
+
+#ifdef _WIN32
+    if( m_data != nullptr )                { ::UnmapViewOfFile( m_data ); }
+    if( m_mapping != nullptr )             { ::CloseHandle( m_mapping ); }
+    if( m_file != INVALID_HANDLE_VALUE )   { ::CloseHandle( m_file ); }
+    m_mapping = nullptr;
+    m_file = INVALID_HANDLE_VALUE;
+#else
+    if( m_data != nullptr ) { ::munmap( const_cast<char *>( m_data ), m_size ); }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+
+// returns 64-bit fnv-1a hash of provided data
+std::uint64_t
+content_hash( std::string_view const Data ) {
+
+    std::uint64_t hash { 14695981039346656037ULL };
+    for( auto const c : Data ) {
+        hash ^= static_cast<unsigned char>( c );
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
 // potentially erases file extension from provided file name. returns: true if extension was removed, false otherwise
 bool
 erase_extension( std::string &Filename ) {
@@ -463,3 +571,134 @@ deserialize_random_set( cParser &Input, char const *Break ) {
         return "";
     }
 }
+
+namespace threading {
+
+task_pool::~task_pool() {
+
+    stop();
+}
+
+// changes number of worker threads to specified value. 0 disables the pool, making all work execute on the calling thread
+void
+task_pool::resize( std::size_t const Count ) {
+
+    if( Count == m_workers.size() ) { return; }
+
+    stop();
+    m_exit = false;
+    for( std::size_t idx = 0; idx < Count; ++idx ) {
+        m_workers.emplace_back( &task_pool::work, this );
+    }
+}
+
+// queues specified task for execution on a worker thread, or executes it outright if the pool has no workers
+void
+task_pool::push( task Task ) {
+
+    if( true == m_workers.empty() ) {
+        Task();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_tasks.emplace_back( std::move( Task ) );
+    }
+    m_condition.notify_one();
+}
+
+// executes specified task Count times, passing it index of each run. the calling thread takes part in the work
+// returns after all runs are completed
+void
+task_pool::run( std::size_t const Count, std::function<void( std::size_t )> const &Task ) {
+
+    if( Count == 0 ) { return; }
+
+    if( ( true == m_workers.empty() )
+     || ( Count == 1 ) ) {
+        for( std::size_t idx = 0; idx < Count; ++idx ) {
+            Task( idx );
+        }
+        return;
+    }
+
+    // the state is shared with the helpers, as late starters can still peek at it after we're done
+    struct run_state {
+        std::atomic<std::size_t> next { 0 };
+        std::size_t completed { 0 };
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+    auto state { std::make_shared<run_state>() };
+    // each helper keeps picking indices until the range is exhausted
+    // NOTE: the task itself is only referenced while there's work left, i.e. before we return
+    auto const helper = [state, Count, &Task]() {
+        std::size_t done { 0 };
+        std::size_t idx;
+        while( ( idx = state->next++ ) < Count ) {
+            Task( idx );
+            ++done;
+        }
+        if( done > 0 ) {
+            std::lock_guard<std::mutex> lock( state->mutex );
+            state->completed += done;
+            if( state->completed == Count ) {
+                state->condition.notify_all();
+            }
+        } };
+
+    auto const helpercount { std::min( m_workers.size(), Count - 1 ) };
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        for( std::size_t idx = 0; idx < helpercount; ++idx ) {
+            m_tasks.emplace_back( helper );
+        }
+    }
+    m_condition.notify_all();
+    // the caller works too, rather than just wait
+    helper();
+
+    std::unique_lock<std::mutex> lock( state->mutex );
+    state->condition.wait(
+        lock,
+        [&]() {
+            return state->completed == Count; } );
+}
+
+void
+task_pool::work() {
+
+    while( true ) {
+        task task;
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+            m_condition.wait(
+                lock,
+                [this]() {
+                    return ( ( true == m_exit ) || ( false == m_tasks.empty() ) ); } );
+            if( true == m_tasks.empty() ) {
+                // exit flag is set and there's nothing left to do
+                return;
+            }
+            task = std::move( m_tasks.front() );
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+void
+task_pool::stop() {
+
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_exit = true;
+    }
+    m_condition.notify_all();
+    for( auto &worker : m_workers ) {
+        worker.join();
+    }
+    m_workers.clear();
+}
+
+} // threading
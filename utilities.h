@@ -67,6 +67,32 @@ inline double Random(double b)
 	return Random(0.0, b);
 }
 
+// random values for presentation (sounds, visual effects), drawn from a sequence which doesn't affect the simulation
+double LocalRandom(double a, double b);
+
+inline double LocalRandom(double b)
+{
+	return LocalRandom(0.0, b);
+}
+
+// redirects Random() calls made by the current thread to specified engine, for the lifetime of the object
+// allows objects updated on worker threads to draw from private sequences, independent of the update order
+class random_scope {
+
+public:
+// constructors
+    explicit random_scope( std::minstd_rand &Engine );
+// destructor
+    ~random_scope();
+// deleted
+    random_scope( random_scope const & ) = delete;
+    random_scope &operator=( random_scope const & ) = delete;
+
+private:
+// members
+    std::minstd_rand *m_previous;
+};
+
 inline double BorlandTime()
 {
     auto timesinceepoch = std::time( nullptr );
@@ -137,19 +163,24 @@ std::string Bezogonkow( std::string Input, bool const Underscorestospaces = fals
 inline
 std::string
 extract_value( std::string const &Key, std::string const &Input ) {
-    // NOTE, HACK: the leading space allows to uniformly look for " variable=" substring
-    std::string const input { " " + Input };
-    std::string value;
-    auto lookup = input.find( " " + Key + "=" );
-    if( lookup != std::string::npos ) {
-        value = input.substr( input.find_first_not_of( ' ', lookup + Key.size() + 2 ) );
-        lookup = value.find( ' ' );
-        if( lookup != std::string::npos ) {
+    // looks for " variable=" substring, or "variable=" at the start of the input
+    // NOTE: the input is searched in place, as vehicle definitions call this dozens of times for each line
+    auto lookup { Input.find( Key ) };
+    while( lookup != std::string::npos ) {
+        auto const valuestart { lookup + Key.size() };
+        if( ( ( lookup == 0 ) || ( Input[ lookup - 1 ] == ' ' ) )
+         && ( valuestart < Input.size() )
+         && ( Input[ valuestart ] == '=' ) ) {
+            auto const first { Input.find_first_not_of( ' ', valuestart + 1 ) };
+            if( first == std::string::npos ) {
+                return {};
+            }
             // trim everything past the value
-            value.erase( lookup );
+            return Input.substr( first, Input.find( ' ', first ) - first );
         }
+        lookup = Input.find( Key, lookup + 1 );
     }
-    return value;
+    return {};
 }
 
 template <typename Type_>
@@ -204,6 +235,52 @@ std::string substr_path( std::string const &Filename );
 // returns common prefix of two provided strings
 std::ptrdiff_t len_common_prefix( std::string const &Left, std::string const &Right );
 
+// read-only view of file content, mapped into memory
+class mapped_file {
+
+public:
+// constructors
+    mapped_file() = default;
+    explicit mapped_file( std::string const &Filename ) {
+        open( Filename ); }
+// destructor
+    ~mapped_file() {
+        close(); }
+// deleted
+    mapped_file( mapped_file const & ) = delete;
+    mapped_file &operator=( mapped_file const & ) = delete;
+// methods
+    // maps content of specified file. returns: true on success
+    bool
+        open( std::string const &Filename );
+    void
+        close();
+    bool
+        is_open() const {
+            return m_open; }
+    // returns: file content, or empty view if the file isn't open
+    std::string_view
+        data() const {
+            return { m_data, m_size }; }
+    std::size_t
+        size() const {
+            return m_size; }
+
+private:
+// members
+    char const *m_data { nullptr };
+    std::size_t m_size { 0 };
+    bool m_open { false };
+#ifdef _WIN32
+    HANDLE m_file { INVALID_HANDLE_VALUE };
+    HANDLE m_mapping { nullptr };
+#endif
+};
+
+// returns 64-bit fnv-1a hash of provided data
+std::uint64_t
+content_hash( std::string_view const Data );
+
 template <typename Type_>
 void SafeDelete( Type_ &Pointer ) {
     delete Pointer;
@@ -377,6 +454,48 @@ private:
     bool m_spurious { true };
 };
 
+// fixed set of worker threads executing queued tasks
+class task_pool {
+
+public:
+// types
+    using task = std::function<void()>;
+// constructors
+    task_pool() = default;
+// destructor
+    ~task_pool();
+// deleted
+    task_pool( task_pool const & ) = delete;
+    task_pool &operator=( task_pool const & ) = delete;
+// methods
+    // changes number of worker threads to specified value. 0 disables the pool, making all work execute on the calling thread
+    void
+        resize( std::size_t const Count );
+    std::size_t
+        size() const {
+            return m_workers.size(); }
+    // queues specified task for execution on a worker thread, or executes it outright if the pool has no workers
+    void
+        push( task Task );
+    // executes specified task Count times, passing it index of each run. the calling thread takes part in the work
+    // returns after all runs are completed
+    void
+        run( std::size_t const Count, std::function<void( std::size_t )> const &Task );
+
+private:
+// methods
+    void
+        work();
+    void
+        stop();
+// members
+    std::vector<std::thread> m_workers;
+    std::deque<task> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition; // wakes up the workers
+    bool m_exit { false }; // signals the workers to quit
+};
+
 } // threading
 
 //---------------------------------------------------------------------------
@@ -1,12 +1,16 @@
 #include "stdafx.h"
 #include "messaging.h"
 #include "utilities.h"
+#include "Logs.h"
 
 #pragma warning (disable: 4091)
 #include <dbghelp.h>
 
 LONG CALLBACK unhandled_handler(::EXCEPTION_POINTERS* e)
 {
+	// write out whatever is still waiting in the log queue
+	FlushLogs();
+
 	auto hDbgHelp = ::LoadLibraryA("dbghelp");
 	if (hDbgHelp == nullptr)
 		return EXCEPTION_CONTINUE_SEARCH;